@@ -0,0 +1,70 @@
+import os
+
+from paraview import servermanager
+from paraview import smtesting
+from paraview.benchmark import statebatching
+import paraview.simple as smp
+
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def getPipelines():
+    """Returns the number of proxies in each group and, for every source, its
+    name, its type, the names of its inputs, the number of points it produces
+    on the server and the number of views it is shown in."""
+    pxm = servermanager.ProxyManager()
+    groups = [(group, len(pxm.GetProxiesInGroup(group)))
+        for group in ("sources", "representations", "views", "lookup_tables")]
+    names = dict((source.SMProxy, name) for (name, _), source in smp.GetSources().items())
+    pipelines = []
+    for (name, _), source in sorted(smp.GetSources().items()):
+        inputs = []
+        if "Input" in source.ListProperties() and source.Input:
+            inputs = [names.get(getattr(source.Input, "SMProxy", None))]
+        source.UpdatePipeline()
+        numPoints = source.GetDataInformation().GetNumberOfPoints()
+        numViews = 0
+        for view in smp.GetRenderViews():
+            rep = servermanager.GetRepresentation(source, view)
+            numViews += 1 if rep and rep.Visibility else 0
+        pipelines.append((name, source.GetXMLName(), inputs, numPoints, numViews))
+    return groups, pipelines
+
+
+def runTest():
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+    smp.Connect(getHost(url), getPort(url))
+
+    smtesting.ProcessCommandLineArguments()
+    filename = os.path.join(smtesting.TempDir, "TestBatchedStatePushes.pvsm")
+    statebatching.create_state(filename, 20)
+
+    results = {}
+    for use_batching in (False, True):
+        _, messages = statebatching.time_load(filename, use_batching)
+        results[use_batching] = (messages, getPipelines())
+    os.remove(filename)
+
+    single, batched = results[False], results[True]
+    if len(single[1][1]) != 40 or single[1] != batched[1]:
+        raise smtesting.TestError("pipelines differ: %s != %s" % (single[1], batched[1]))
+    if batched[0] >= single[0]:
+        raise smtesting.TestError("expected fewer messages with batched pushes: %d >= %d" %
+            (batched[0], single[0]))
+    print("messages: %d without batching, %d with batching" % (single[0], batched[0]))
+
+    smp.Disconnect()
+
+
+runTest()
@@ -0,0 +1,75 @@
+# Tests streaming the blocks of a multiblock dataset to the client when the
+# blocks are split across the server ranks: once all blocks are streamed, the
+# rendered surfaces must match the ones rendered without streaming.
+
+from paraview import servermanager
+from paraview import smtesting
+import paraview.simple as smp
+
+
+# Make sure the test driver know that process has properly started
+print ("Process started")
+
+
+def getHost(url):
+   return url.split(':')[1][2:]
+
+
+def getPort(url):
+   return int(url.split(':')[2])
+
+
+def getRenderedBlocks(display):
+    """Returns the number of points and the bounds of each leaf rendered on the
+    client."""
+    rep = display.GetClientSideObject().GetActiveRepresentation()
+    data = rep.GetActor().GetMapper().GetInputDataObject(0, 0)
+    blocks = []
+    iter = data.NewIterator()
+    iter.InitTraversal()
+    while not iter.IsDoneWithTraversal():
+        leaf = iter.GetCurrentDataObject()
+        blocks.append((iter.GetCurrentFlatIndex(), leaf.GetNumberOfPoints(), leaf.GetBounds()))
+        iter.GoToNextItem()
+    return blocks
+
+
+def runTest():
+    options = servermanager.vtkRemotingCoreConfiguration.GetInstance()
+    url = options.GetServerURL()
+    smp.Connect(getHost(url), getPort(url))
+    smtesting.ProcessCommandLineArguments()
+
+    smp.GetSettingsProxy('GeneralSettings').EnableStreaming = 1
+
+    # The wavelets are split along z between the server ranks, and each rank
+    # holds a part of both blocks, at different distances from the camera.
+    wavelet1 = smp.Wavelet(WholeExtent=[-10, 10, -10, 10, -10, 10])
+    wavelet2 = smp.Wavelet(WholeExtent=[-10, 10, -10, 10, -40, -10])
+    group = smp.GroupDatasets(Input=[wavelet1, wavelet2])
+
+    view = smp.CreateRenderView()
+    # render on the client, with the blocks collected from all ranks.
+    view.RemoteRenderThreshold = 1000
+    display = smp.Show(group, view)
+    smp.Render(view)
+    expected = getRenderedBlocks(display)
+
+    display.UseBlockStreaming = 1
+    display.NumberOfStreamedBlocksPerPass = 1
+    smp.Render(view)
+    passes = 0
+    while view.SMProxy.StreamingUpdate(True) and passes < 10:
+        passes += 1
+    blocks = getRenderedBlocks(display)
+
+    if passes != 2:
+        raise smtesting.TestError("expected a pass per block, got %d" % passes)
+    if blocks != expected:
+        raise smtesting.TestError("streamed blocks differ: %s != %s" % (blocks, expected))
+
+    smp.GetSettingsProxy('GeneralSettings').EnableStreaming = 0
+    smp.Disconnect()
+
+
+runTest()
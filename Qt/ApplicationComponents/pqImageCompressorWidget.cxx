@@ -42,13 +42,16 @@ static const int NO_COMPRESSION = 0;
 static const int LZ4_COMPRESSION = 1;
 static const int SQUIRT_COMPRESSION = 2;
 static const int ZLIB_COMPRESSION = 3;
-static const int NVPIPE_COMPRESSION = 4;
+static const int DELTA_COMPRESSION = 4;
+static const int NVPIPE_COMPRESSION = 5;
 //-----------------------------------------------------------------------------
 
 class pqImageCompressorWidget::pqInternals
 {
 public:
   Ui::ImageCompressorWidget Ui;
+  // Not exposed in the UI, preserved from the configuration.
+  int KeyFrameInterval = 30;
 };
 
 //-----------------------------------------------------------------------------
@@ -122,6 +125,14 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
                     "\\s+"     // space
                     "([0-9]+)" // num-of-bits.
                     "$");
+  QRegExp deltaRegExp("^vtkDeltaImageCompressor"
+                      "\\s+"     // space
+                      "0"        // 0
+                      "\\s+"     // space
+                      "([0-9]+)" // num-of-bits.
+                      "\\s+"     // space
+                      "([0-9]+)" // key frame interval.
+                      "$");
   QRegExp nvpipeRegExp("^vtkNvPipeCompressor"
                        "\\s+"     // space
                        "0"        // 0
@@ -151,6 +162,13 @@ void pqImageCompressorWidget::setCompressorConfig(const QString& value)
     ui.zlibColorSpace->setValue(numBits);
     ui.zlibStripAlpha->setCheckState(stripAlpha ? Qt::Checked : Qt::Unchecked);
   }
+  else if (deltaRegExp.exactMatch(value))
+  {
+    int numBits = deltaRegExp.cap(1).toInt();
+    this->Internals->KeyFrameInterval = deltaRegExp.cap(2).toInt();
+    ui.compressionType->setCurrentIndex(DELTA_COMPRESSION);
+    ui.squirtColorSpace->setValue(numBits);
+  }
   else if (nvpipeRegExp.exactMatch(value))
   {
     int level = nvpipeRegExp.cap(1).toInt();
@@ -181,6 +199,11 @@ QString pqImageCompressorWidget::compressorConfig() const
         .arg(ui.zlibColorSpace->value())
         .arg(ui.zlibStripAlpha->isChecked() ? 1 : 0);
 
+    case DELTA_COMPRESSION:
+      return QString("vtkDeltaImageCompressor 0 %1 %2")
+        .arg(ui.squirtColorSpace->value())
+        .arg(this->Internals->KeyFrameInterval);
+
     case NVPIPE_COMPRESSION: // nvpipe
       return QString("vtkNvPipeCompressor 0 %1").arg(ui.nvpLevel->value());
   }
@@ -192,8 +215,10 @@ QString pqImageCompressorWidget::compressorConfig() const
 void pqImageCompressorWidget::currentIndexChanged(int index)
 {
   Ui::ImageCompressorWidget& ui = this->Internals->Ui;
-  ui.squirtLabel->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
-  ui.squirtColorSpace->setVisible(index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION);
+  const bool useColorSpace =
+    index == SQUIRT_COMPRESSION || index == LZ4_COMPRESSION || index == DELTA_COMPRESSION;
+  ui.squirtLabel->setVisible(useColorSpace);
+  ui.squirtColorSpace->setVisible(useColorSpace);
 
   ui.zlibLabel1->setVisible(index == ZLIB_COMPRESSION);
   ui.zlibLabel2->setVisible(index == ZLIB_COMPRESSION);
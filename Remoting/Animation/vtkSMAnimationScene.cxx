@@ -19,6 +19,7 @@
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVCameraAnimationCue.h"
+#include "vtkPVKeyFrameAnimationCueForProxies.h"
 #include "vtkPVLogger.h"
 #include "vtkSMProperty.h"
 #include "vtkSMPropertyHelper.h"
@@ -33,6 +34,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <set>
 #include <vector>
 
 bool vtkSMAnimationScene::GlobalUseGeometryCache;
@@ -48,6 +50,19 @@ bool vtkSMAnimationScene::GetGlobalUseGeometryCache()
   return vtkSMAnimationScene::GlobalUseGeometryCache;
 }
 
+int vtkSMAnimationScene::GlobalPrefetchCount = 2;
+//----------------------------------------------------------------------------
+void vtkSMAnimationScene::SetGlobalPrefetchCount(int val)
+{
+  vtkSMAnimationScene::GlobalPrefetchCount = std::max(val, 0);
+}
+
+//----------------------------------------------------------------------------
+int vtkSMAnimationScene::GetGlobalPrefetchCount()
+{
+  return vtkSMAnimationScene::GlobalPrefetchCount;
+}
+
 //----------------------------------------------------------------------------
 class vtkSMAnimationScene::vtkInternals
 {
@@ -60,6 +75,10 @@ public:
   typedef std::vector<vtkSmartPointer<vtkSMViewProxy>> VectorOfViews;
   VectorOfViews ViewModules;
 
+  // Times for which prefetch has already been requested during the current
+  // play.
+  std::set<double> PrefetchedTimes;
+
   void UpdateAllViews()
   {
     if (this->ViewModules.empty())
@@ -120,10 +139,43 @@ public:
       iter->GetPointer()->UpdateProperty("UseCache");
     }
   }
+
+  void PrefetchAllViews(double time)
+  {
+    vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "prefetch time %g for animation", time);
+    for (const auto& view : this->ViewModules)
+    {
+      view->Prefetch(time);
+    }
+  }
 };
 
 namespace
 {
+// Returns true if the cue does not change anything but the time for the
+// data-processing pipelines, i.e. the results for a future time can be computed
+// without ticking the cue.
+bool vtkIsSafeToPrefetch(vtkAnimationCue* cue, vtkSMProxy* timeKeeper)
+{
+  if (vtkPVCameraAnimationCue::SafeDownCast(cue) != nullptr)
+  {
+    return true;
+  }
+  if (auto pvcue = vtkPVAnimationCue::SafeDownCast(cue))
+  {
+    auto proxycue = vtkPVKeyFrameAnimationCueForProxies::SafeDownCast(cue);
+    return !pvcue->GetEnabled() ||
+      (proxycue && proxycue->GetUseAnimationTime() && proxycue->GetAnimatedProxy() == timeKeeper);
+  }
+#if VTK_MODULE_ENABLE_VTK_PythonInterpreter
+  if (auto pycue = vtkPythonAnimationCue::SafeDownCast(cue))
+  {
+    return !pycue->GetEnabled();
+  }
+#endif
+  return false;
+}
+
 // Helper class used by for_each() to call Tick on all cues if they are not
 // one of the "exception" classes.
 class vtkTickOnGenericCue
@@ -350,6 +402,7 @@ void vtkSMAnimationScene::SetTimeKeeper(vtkSMProxy* tkp)
 //----------------------------------------------------------------------------
 void vtkSMAnimationScene::TimeKeeperTimestepsChanged()
 {
+  this->Internals->PrefetchedTimes.clear();
   this->AnimationPlayer->RemoveAllTimeSteps();
   vtkSMPropertyHelper helper(this->TimeKeeper, "TimestepValues");
   for (unsigned int cc = 0; cc < helper.GetNumberOfElements(); cc++)
@@ -427,6 +480,7 @@ vtkSMViewProxy* vtkSMAnimationScene::GetViewProxy(unsigned int cc)
 void vtkSMAnimationScene::StartCueInternal()
 {
   this->Superclass::StartCueInternal();
+  this->Internals->PrefetchedTimes.clear();
 
   // Initialize all the animation cues.
   vtkInternals::VectorOfAnimationCues& cues = this->Internals->AnimationCues;
@@ -505,10 +559,59 @@ void vtkSMAnimationScene::TickInternal(double currenttime, double deltatime, dou
 
   if (caching_enabled)
   {
+    // Since the prefetch requests are processed on the data-server in order,
+    // they are handled while the views are still using the cache.
+    this->PrefetchTimeSteps(currenttime);
     this->Internals->PassUseCache(false);
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMAnimationScene::PrefetchTimeSteps(double currenttime)
+{
+  const int count = vtkSMAnimationScene::GlobalPrefetchCount;
+  if (count <= 0 || this->TimeKeeper == nullptr || this->Internals->ViewModules.empty() ||
+    !this->AnimationPlayer->GetInPlay() ||
+    this->AnimationPlayer->GetPlayMode() != vtkCompositeAnimationPlayer::SNAP_TO_TIMESTEPS)
+  {
+    return;
+  }
+
+  // In "Snap To TimeSteps" mode, the cache key is the timestep value itself.
+  // That's the time the data-server will be asked for as long as nothing other
+  // than the timekeeper's time is animated.
+  vtkInternals::VectorOfAnimationCues& cues = this->Internals->AnimationCues;
+  for (const auto& cue : cues)
+  {
+    if (!vtkIsSafeToPrefetch(cue, this->TimeKeeper))
+    {
+      return;
+    }
+  }
+
+  // TimestepValues are sorted, which is also what vtkTimestepsAnimationPlayer
+  // relies on.
+  const std::vector<double> timesteps =
+    vtkSMPropertyHelper(this->TimeKeeper, "TimestepValues").GetDoubleArray();
+  const double endtime = (this->PlaybackTimeWindow[0] <= this->PlaybackTimeWindow[1])
+    ? std::min(this->EndTime, this->PlaybackTimeWindow[1])
+    : this->EndTime;
+  const int stride = std::max(this->AnimationPlayer->GetStride(), 1);
+
+  auto iter = std::upper_bound(timesteps.begin(), timesteps.end(), currenttime);
+  std::size_t index = static_cast<std::size_t>(std::distance(timesteps.begin(), iter)) +
+    static_cast<std::size_t>(stride - 1);
+  for (int cc = 0; cc < count && index < timesteps.size() && timesteps[index] <= endtime;
+       ++cc, index += stride)
+  {
+    const double time = timesteps[index];
+    if (this->Internals->PrefetchedTimes.insert(time).second)
+    {
+      this->Internals->PrefetchAllViews(time);
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMAnimationScene::PrintSelf(ostream& os, vtkIndent indent)
 {
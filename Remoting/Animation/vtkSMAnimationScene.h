@@ -201,6 +201,19 @@ public:
   static bool GetGlobalUseGeometryCache();
   //@}
 
+  //@{
+  /**
+   * Set the number of timesteps ahead of the current one that the data-server
+   * is asked to prepare and cache while playing an animation. This is only
+   * used when geometry caching is enabled, the animation is played in "Snap To
+   * TimeSteps" mode and the session is connected to a remote server.
+   * Set to 0 to disable prefetching. Typically, one uses vtkPVGeneralSettings
+   * to change this rather than using this API directly.
+   */
+  static void SetGlobalPrefetchCount(int);
+  static int GetGlobalPrefetchCount();
+  //@}
+
 protected:
   vtkSMAnimationScene();
   ~vtkSMAnimationScene() override;
@@ -223,6 +236,12 @@ protected:
   void TimeKeeperTimestepsChanged();
   //@}
 
+  /**
+   * Called after the frame for `currenttime` has been rendered to request the
+   * data-server to prefetch the next few timesteps.
+   */
+  void PrefetchTimeSteps(double currenttime);
+
   bool LockStartTime;
   bool LockEndTime;
   bool InTick;
@@ -245,6 +264,7 @@ private:
   unsigned long TimestepValuesObserverID;
 
   static bool GlobalUseGeometryCache;
+  static int GlobalPrefetchCount;
 };
 
 #endif
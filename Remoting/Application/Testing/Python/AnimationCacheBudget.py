@@ -0,0 +1,86 @@
+from paraview.simple import *
+
+from paraview import smtesting
+from paraview.modules.vtkRemotingSettings import vtkPVGeneralSettings
+from paraview.modules.vtkRemotingViews import vtkPVDataDeliveryManager
+from paraview.vtk.vtkCommonCore import vtkIntArray
+from paraview.vtk.vtkParallelCore import vtkCommunicator
+
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+
+def AllReduce(value, operation):
+    if not pm.GetSymmetricMPIMode():
+        return value
+    source = vtkIntArray()
+    source.InsertNextValue(value)
+    dest = vtkIntArray()
+    pm.GetGlobalController().AllReduce(source, dest, operation)
+    return dest.GetValue(0)
+
+filename = smtesting.DataDir + '/Testing/Data/can.ex2'
+can_ex2 = OpenDataFile(filename)
+can_ex2.ApplyDisplacements = 0
+
+AnimationScene1 = GetAnimationScene()
+AnimationScene1.UpdateAnimationUsingDataTimeSteps()
+AnimationScene1.PlayMode = 'Snap To TimeSteps'
+
+Show()
+Render()
+
+update_counters = 0;
+def __request_data_callback(*args):
+    global update_counters
+    update_counters += 1
+
+oid = can_ex2.GetClientSideObject().AddObserver("StartEvent", __request_data_callback)
+
+vtkPVGeneralSettings.GetInstance().SetCacheGeometryForAnimation(True)
+
+#---------------------------------------------------------
+# Without a budget, the whole animation is cached.
+AnimationScene1.GoToFirst()
+AnimationScene1.Play()
+vtkPVDataDeliveryManager.ResetCacheStatistics()
+update_counters = 0
+AnimationScene1.GoToFirst()
+AnimationScene1.Play()
+assert update_counters == 0
+assert vtkPVDataDeliveryManager.GetNumberOfCacheHits() > 0
+assert vtkPVDataDeliveryManager.GetNumberOfCacheMisses() == 0
+assert vtkPVDataDeliveryManager.GetNumberOfCacheEvictions() == 0
+full_size = vtkPVDataDeliveryManager.GetCacheMemorySize()
+print("Cache size without budget: %d KiB" % full_size)
+
+#---------------------------------------------------------
+# With a budget smaller than the cached animation, least recently used time
+# steps get evicted and playing again needs updates.
+budget = max(1, full_size // (4 * 1024))
+renderViewSettings = GetSettingsProxy('RenderViewSettings')
+renderViewSettings.CacheMemoryBudget = budget
+AnimationScene1.GoToFirst()
+AnimationScene1.Play()
+assert vtkPVDataDeliveryManager.GetNumberOfCacheEvictions() > 0
+assert vtkPVDataDeliveryManager.GetCacheMemorySize() < full_size
+
+# All ranks evict the same entries.
+evictions = vtkPVDataDeliveryManager.GetNumberOfCacheEvictions()
+assert AllReduce(evictions, vtkCommunicator.MIN_OP) == AllReduce(evictions, vtkCommunicator.MAX_OP)
+
+update_counters = 0
+AnimationScene1.GoToFirst()
+AnimationScene1.Play()
+assert update_counters > 0
+
+#---------------------------------------------------------
+# The most recently used time step is still cached.
+update_counters = 0
+AnimationScene1.GoToPrevious()
+AnimationScene1.GoToNext()
+assert update_counters <= 1
+
+renderViewSettings.CacheMemoryBudget = 0
+vtkPVGeneralSettings.GetInstance().SetCacheGeometryForAnimation(False)
+can_ex2.GetClientSideObject().RemoveObserver(oid)
@@ -0,0 +1,125 @@
+# Tests the index file saved by vtkFileSeriesReader for the time values of
+# each file in the series: the time values are collected by all ranks, the
+# index is reused when the files and the reader are unchanged, and files that
+# changed as well as indices built with another reader state are scanned again.
+
+from paraview.simple import *
+from paraview import smtesting
+from paraview.vtk.vtkCommonCore import vtkDoubleArray, vtkPoints
+from paraview.vtk.vtkCommonDataModel import vtkPolyData
+from paraview.modules.vtkIOXML import vtkXMLPolyDataWriter
+import json, os, shutil
+
+smtesting.ProcessCommandLineArguments()
+
+pm = servermanager.vtkProcessModule.GetProcessModule()
+rank = pm.GetPartitionId()
+
+def Barrier():
+    if pm.GetSymmetricMPIMode():
+        pm.GetGlobalController().Barrier()
+
+def WriteFile(fname, time, npoints=1):
+    points = vtkPoints()
+    for i in range(npoints):
+        points.InsertNextPoint(i, 0, 0)
+    pd = vtkPolyData()
+    pd.SetPoints(points)
+    for name, value in (("TimeValue", time), ("OtherTime", 100 + time)):
+        array = vtkDoubleArray()
+        array.SetName(name)
+        array.InsertNextValue(value)
+        pd.GetFieldData().AddArray(array)
+    writer = vtkXMLPolyDataWriter()
+    writer.SetInputData(pd)
+    writer.SetFileName(fname)
+    writer.Write()
+
+def Open(**kwargs):
+    reader = XMLPolyDataReader(FileName=files, **kwargs)
+    reader.GetClientSideObject().SetUseIndexFile(True)
+    reader.UpdatePipelineInformation()
+    return reader
+
+def Check(reader, expected):
+    values = list(reader.TimestepValues)
+    if values != expected:
+        raise RuntimeError("rank %d: expected time steps %s, got %s" % (rank, expected, values))
+
+def LoadIndex():
+    with open(index_name, "r") as f:
+        return json.load(f)
+
+if pm.GetSymmetricMPIMode():
+    rootdir = os.path.join(smtesting.TempDir, "fileseriesindex-sym")
+else:
+    rootdir = os.path.join(smtesting.TempDir, "fileseriesindex")
+files = [os.path.join(rootdir, "series_%d.vtp" % i) for i in range(5)]
+index_name = os.path.join(rootdir, ".series_0.vtp.series-index")
+if rank == 0:
+    shutil.rmtree(rootdir, ignore_errors=True)
+    os.makedirs(rootdir)
+    for i, fname in enumerate(files):
+        WriteFile(fname, 0.5 * i)
+Barrier()
+
+# The index is disabled by default.
+reader = XMLPolyDataReader(FileName=files)
+Check(reader, [0.0, 0.5, 1.0, 1.5, 2.0])
+if reader.GetClientSideObject().GetUseIndexFile():
+    raise RuntimeError("the index file must be disabled by default")
+Delete(reader)
+if os.path.exists(index_name):
+    raise RuntimeError("no index file must be written by default")
+
+# The files are scanned by all ranks, and the index written by rank 0 has the
+# time values of all of them.
+reader = Open()
+Check(reader, [0.0, 0.5, 1.0, 1.5, 2.0])
+Delete(reader)
+if rank == 0:
+    index = LoadIndex()
+    for i, fname in enumerate(files):
+        if index["files"][fname]["time_steps"] != [0.5 * i]:
+            raise RuntimeError("missing or wrong index entry for '%s'" % fname)
+
+    # Alter the index: the new values are only reported if the index is used.
+    index["files"][files[3]]["time_steps"] = [1.6]
+    index["files"][files[3]]["time_range"] = [1.6, 1.6]
+    with open(index_name, "w") as f:
+        json.dump(index, f)
+Barrier()
+
+reader = Open()
+Check(reader, [0.0, 0.5, 1.0, 1.6, 2.0])
+Delete(reader)
+Barrier()
+
+# A file that changed since the index was written is scanned again.
+if rank == 0:
+    WriteFile(files[3], 1.75, npoints=10)
+Barrier()
+reader = Open()
+Check(reader, [0.0, 0.5, 1.0, 1.75, 2.0])
+Delete(reader)
+Barrier()
+if rank == 0 and LoadIndex()["files"][files[3]]["time_steps"] != [1.75]:
+    raise RuntimeError("the index was not updated for the changed file")
+
+# An index built with another reader state is not used.
+if rank == 0:
+    index = LoadIndex()
+    index["files"][files[2]]["time_steps"] = [1.1]
+    index["files"][files[2]]["time_range"] = [1.1, 1.1]
+    with open(index_name, "w") as f:
+        json.dump(index, f)
+Barrier()
+reader = Open(TimeArray="OtherTime")
+Check(reader, [100.0, 100.5, 101.0, 101.75, 102.0])
+Delete(reader)
+Barrier()
+if rank == 0 and LoadIndex()["files"][files[2]]["time_steps"] != [101.0]:
+    raise RuntimeError("the index was not rebuilt for the new reader state")
+
+if rank == 0:
+    shutil.rmtree(rootdir, ignore_errors=True)
@@ -0,0 +1,53 @@
+# Tests that the clip depths of fragments spanning several blocks are the
+# extent of the fragment along the clip plane normal, and not a sum over the
+# pieces of the fragment.
+from paraview.simple import *
+from paraview import smtesting
+from vtkmodules.vtkCommonDataModel import vtkDataObjectTreeIterator
+
+smtesting.ProcessCommandLineArguments()
+
+reader = OpenDataFile(smtesting.DataDir + '/Testing/Data/SPCTH/Dave_Karelitz_Small/spcth_a')
+reader.UpdatePipeline()
+fractions = [name for name in reader.CellData.keys() if 'volume fraction' in name.lower()]
+assert fractions, "no volume fraction array found."
+
+bounds = reader.GetDataInformation().GetBounds()
+origin = [0.5 * (bounds[0] + bounds[1]), 0.5 * (bounds[2] + bounds[3]),
+          0.5 * (bounds[4] + bounds[5])]
+normal = [1.0, 0.0, 0.0]
+tolerance = 0.01 * (bounds[1] - bounds[0])
+
+interface = MaterialInterfaceFilter(Input=reader)
+interface.SelectMaterialArray = fractions[:1]
+interface.ClipFunction = 'Plane'
+interface.ClipFunction.Origin = origin
+interface.ClipFunction.Normal = normal
+interface.UpdatePipeline()
+
+geometry = servermanager.Fetch(interface)
+iterator = vtkDataObjectTreeIterator()
+iterator.SetDataSet(geometry)
+iterator.VisitOnlyLeavesOn()
+iterator.InitTraversal()
+num_fragments = 0
+while not iterator.IsDoneWithTraversal():
+    fragment = iterator.GetCurrentDataObject()
+    iterator.GoToNextItem()
+    if fragment is None or fragment.GetNumberOfPoints() == 0:
+        continue
+    num_fragments += 1
+    depth_min = fragment.GetFieldData().GetArray('ClipDepthMin').GetValue(0)
+    depth_max = fragment.GetFieldData().GetArray('ClipDepthMax').GetValue(0)
+
+    # the depths are accumulated from the points of the fragment surface,
+    # starting from 0 for the maximum.
+    projections = [sum((p - o) * n for p, o, n in zip(fragment.GetPoint(i), origin, normal))
+                   for i in range(fragment.GetNumberOfPoints())]
+    lower = min(min(projections), 0.0) - tolerance
+    upper = max(max(projections), 0.0) + tolerance
+    if not (lower <= depth_min <= depth_max <= upper):
+        raise RuntimeError("Wrong clip depths [%g, %g] for a fragment spanning [%g, %g]." %
+                           (depth_min, depth_max, min(projections), max(projections)))
+
+assert num_fragments > 0, "no fragment extracted."
@@ -0,0 +1,233 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestInterpreterDispatch.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkClientServerInterpreter.h"
+#include "vtkClientServerStream.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+
+#include <cstring>
+
+namespace
+{
+class vtkDispatchTestObject : public vtkObject
+{
+public:
+  static vtkDispatchTestObject* New();
+  vtkTypeMacro(vtkDispatchTestObject, vtkObject);
+
+protected:
+  vtkDispatchTestObject() = default;
+  ~vtkDispatchTestObject() override = default;
+
+private:
+  vtkDispatchTestObject(const vtkDispatchTestObject&) = delete;
+  void operator=(const vtkDispatchTestObject&) = delete;
+};
+vtkStandardNewMacro(vtkDispatchTestObject);
+
+int BaseCalls = 0;
+int DerivedCalls = 0;
+
+// Mimic generated wrappers: the base handles "Base" with an int argument,
+// "Array" with an array of 3 ints and "Object" with any object, the derived
+// class handles "Derived", "Nested", "Array" with an array of 2 ints and
+// "Object" with a vtkDispatchTestObject, and forwards everything else to the
+// base by name.
+int BaseCommand(vtkClientServerInterpreter*, vtkObjectBase*, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  ++BaseCalls;
+  if (!strcmp("Base", method) && msg.GetNumberOfArguments(0) == 3)
+  {
+    int value;
+    if (msg.GetArgumentType(0, 2) == vtkClientServerStream::int32_value &&
+      msg.GetArgument(0, 2, &value))
+    {
+      result.Reset();
+      result << vtkClientServerStream::Reply << value << vtkClientServerStream::End;
+      return 1;
+    }
+  }
+  vtkTypeUInt32 length;
+  if (!strcmp("Array", method) && msg.GetNumberOfArguments(0) == 3 &&
+    msg.GetArgumentLength(0, 2, &length) && length == 3)
+  {
+    result.Reset();
+    result << vtkClientServerStream::Reply << 3 << vtkClientServerStream::End;
+    return 1;
+  }
+  vtkObjectBase* arg;
+  if (!strcmp("Object", method) && msg.GetNumberOfArguments(0) == 3 &&
+    msg.GetArgument(0, 2, &arg))
+  {
+    result.Reset();
+    result << vtkClientServerStream::Reply << 10 << vtkClientServerStream::End;
+    return 1;
+  }
+  result.Reset();
+  result << vtkClientServerStream::Error << "not found" << vtkClientServerStream::End;
+  return 0;
+}
+
+int DerivedCommand(vtkClientServerInterpreter* arlu, vtkObjectBase* ob, const char* method,
+  const vtkClientServerStream& msg, vtkClientServerStream& result, void*)
+{
+  ++DerivedCalls;
+  if (!strcmp("Derived", method) && msg.GetNumberOfArguments(0) == 2)
+  {
+    result.Reset();
+    result << vtkClientServerStream::Reply << 1 << vtkClientServerStream::End;
+    return 1;
+  }
+  vtkTypeUInt32 length;
+  if (!strcmp("Array", method) && msg.GetNumberOfArguments(0) == 3 &&
+    msg.GetArgumentLength(0, 2, &length) && length == 2)
+  {
+    result.Reset();
+    result << vtkClientServerStream::Reply << 2 << vtkClientServerStream::End;
+    return 1;
+  }
+  vtkObjectBase* arg;
+  if (!strcmp("Object", method) && msg.GetNumberOfArguments(0) == 3 &&
+    msg.GetArgument(0, 2, &arg) && vtkDispatchTestObject::SafeDownCast(arg))
+  {
+    result.Reset();
+    result << vtkClientServerStream::Reply << 11 << vtkClientServerStream::End;
+    return 1;
+  }
+  if (!strcmp("Nested", method) && msg.GetNumberOfArguments(0) == 2)
+  {
+    // resolved by a cached function that forwards to the base.
+    const int values[3] = { 1, 2, 3 };
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << ob << "Array"
+           << vtkClientServerStream::InsertArray(values, 3) << vtkClientServerStream::End;
+    arlu->ProcessStream(stream);
+    result.Reset();
+    result << vtkClientServerStream::Reply << 5 << vtkClientServerStream::End;
+    return 1;
+  }
+  const char* commandName = "vtkObject";
+  if (arlu->HasCommandFunction(commandName) &&
+    arlu->CallCommandFunction(commandName, ob, method, msg, result))
+  {
+    return 1;
+  }
+  return 0;
+}
+}
+
+#define TEST_ASSERT(cond)                                                                          \
+  if (!(cond))                                                                                     \
+  {                                                                                                \
+    cerr << "ERROR: Condition FAILED!! : " << #cond << endl;                                       \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+int TestInterpreterDispatch(int, char*[])
+{
+  vtkNew<vtkClientServerInterpreter> interp;
+  interp->AddCommandFunction("vtkObject", BaseCommand);
+  interp->AddCommandFunction("vtkDispatchTestObject", DerivedCommand);
+
+  vtkNew<vtkDispatchTestObject> obj;
+  int value = 0;
+
+  // First invoke walks the hierarchy, the second one goes straight to the
+  // base class command function.
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Base" << 42
+           << vtkClientServerStream::End;
+    TEST_ASSERT(interp->ProcessStream(stream));
+    TEST_ASSERT(interp->GetLastResult().GetArgument(0, 0, &value) && value == 42);
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheMisses() == 1);
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 1);
+  TEST_ASSERT(DerivedCalls == 1 && BaseCalls == 2);
+
+  // Same method with a different argument type is resolved separately, and
+  // failures are not cached.
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Base" << 4.2
+           << vtkClientServerStream::End;
+    TEST_ASSERT(!interp->ProcessStream(stream));
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheMisses() == 3);
+
+  // Methods handled by the receiver's own class are cached as well.
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Derived"
+           << vtkClientServerStream::End;
+    TEST_ASSERT(interp->ProcessStream(stream));
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 2);
+  TEST_ASSERT(interp->GetNumberOfProcessedMessages() == 6);
+
+  interp->ResetStatistics();
+  TEST_ASSERT(interp->GetNumberOfProcessedMessages() == 0);
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 0);
+
+  // Array lengths are part of the key, each length is resolved separately.
+  const int lengths[] = { 3, 3, 2, 2, 3 };
+  const int values[3] = { 1, 2, 3 };
+  for (int length : lengths)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Array"
+           << vtkClientServerStream::InsertArray(values, length) << vtkClientServerStream::End;
+    TEST_ASSERT(interp->ProcessStream(stream));
+    TEST_ASSERT(interp->GetLastResult().GetArgument(0, 0, &value) && value == length);
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheMisses() == 2);
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 3);
+
+  // A nested invoke hitting the cache must not resolve the enclosing one,
+  // otherwise "Nested" would be cached with the base command function and
+  // the second invoke would miss again.
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Nested"
+           << vtkClientServerStream::End;
+    TEST_ASSERT(interp->ProcessStream(stream));
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheMisses() == 3);
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 6);
+
+  // The classes of object arguments are part of the key: once "Object" is
+  // resolved on the base for a vtkObject argument, a vtkDispatchTestObject
+  // argument still reaches the overload of the derived class.
+  vtkNew<vtkObject> base;
+  vtkObjectBase* const args[] = { base.GetPointer(), base.GetPointer(), obj.GetPointer(),
+    obj.GetPointer() };
+  const int expected[] = { 10, 10, 11, 11 };
+  for (int cc = 0; cc < 4; ++cc)
+  {
+    vtkClientServerStream stream;
+    stream << vtkClientServerStream::Invoke << obj.GetPointer() << "Object" << args[cc]
+           << vtkClientServerStream::End;
+    TEST_ASSERT(interp->ProcessStream(stream));
+    TEST_ASSERT(interp->GetLastResult().GetArgument(0, 0, &value) && value == expected[cc]);
+  }
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheMisses() == 5);
+  TEST_ASSERT(interp->GetNumberOfInvokeCacheHits() == 8);
+  return EXIT_SUCCESS;
+}
@@ -24,10 +24,25 @@ struct Help
     {
       return false;
     }
-    if (!css.GetArgument(0, arg++, a, 2) || a[0] != 12 || a[1] != 3)
+    if (!css.GetArgument(0, arg, a, 2) || a[0] != 12 || a[1] != 3)
     {
       return false;
     }
+    // A view is only available when the array is suitably aligned in the
+    // stream, but must match the copied values when it is.
+    const T* view = nullptr;
+    vtkTypeUInt32 length = 0;
+    if (css.GetArgumentView(0, arg, &view, &length) &&
+      (length != 2 || view[0] != 12 || view[1] != 3))
+    {
+      return false;
+    }
+    // A scalar value can never be viewed as an array.
+    if (css.GetArgumentView(0, arg - 1, &view, &length))
+    {
+      return false;
+    }
+    ++arg;
     return true;
   }
 };
@@ -22,9 +22,11 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#include <chrono>
 #include <map>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 vtkStandardNewMacro(vtkClientServerInterpreter);
@@ -70,12 +72,76 @@ public:
   };
   typedef FunctionWithContext<vtkClientServerNewInstanceFunction> NewInstanceFunction;
   typedef FunctionWithContext<vtkClientServerCommandFunction> CommandFunction;
-  typedef std::map<std::string, const NewInstanceFunction*> NewInstanceFunctionsType;
-  typedef std::map<std::string, const CommandFunction*> ClassToFunctionMapType;
+  typedef std::unordered_map<std::string, const NewInstanceFunction*> NewInstanceFunctionsType;
+  typedef std::unordered_map<std::string, const CommandFunction*> ClassToFunctionMapType;
   typedef std::map<vtkTypeUInt32, vtkClientServerStream*> IDToMessageMapType;
   NewInstanceFunctionsType NewInstanceFunctions;
   ClassToFunctionMapType ClassToFunctionMap;
   IDToMessageMapType IDToMessageMap;
+
+  // Wrapped command functions handle the methods of their own class and
+  // forward anything else to the command functions of the superclasses, by
+  // name.  The command function that ended up handling an Invoke is cached
+  // here, keyed on the receiver's class, the method and the argument
+  // signature (see GetInvokeKey), so that repeated invokes call it directly
+  // instead of walking the class hierarchy again.
+  typedef std::unordered_map<std::string, const CommandFunction*> InvokeCacheType;
+  InvokeCacheType InvokeCache;
+
+  // Set by CallCommandFunction to the innermost command function that
+  // succeeded, i.e. the one that actually handled the method.
+  const CommandFunction* ResolvedCommand = nullptr;
+
+  // Dispatch statistics.
+  vtkTypeUInt64 NumberOfProcessedMessages = 0;
+  vtkTypeUInt64 NumberOfCommandLookups = 0;
+  vtkTypeUInt64 NumberOfInvokeCacheHits = 0;
+  vtkTypeUInt64 NumberOfInvokeCacheMisses = 0;
+  double ProcessingTime = 0.0;
+  int ProcessingDepth = 0;
+
+  // The wrapper functions select the method overload from the number,
+  // types, array lengths and object types of the arguments, hence all of
+  // these are part of the key. A function resolved on a superclass is thus
+  // never called for arguments that an overload of the receiver's class
+  // handles. Since array lengths make the number of keys unbounded, the cache
+  // is cleared once it holds MaximumInvokeCacheSize entries.
+  static constexpr size_t MaximumInvokeCacheSize = 4096;
+  static std::string GetInvokeKey(
+    const char* cname, const char* method, const vtkClientServerStream& msg)
+  {
+    std::string key = cname;
+    key += '\n';
+    key += method;
+    const int numArgs = msg.GetNumberOfArguments(0);
+    for (int a = 2; a < numArgs; ++a)
+    {
+      key += '\n';
+      key += std::to_string(static_cast<int>(msg.GetArgumentType(0, a)));
+      vtkTypeUInt32 length;
+      vtkObjectBase* obj;
+      if (msg.GetArgumentLength(0, a, &length))
+      {
+        key += ':';
+        key += std::to_string(length);
+      }
+      else if (msg.GetArgumentType(0, a) == vtkClientServerStream::vtk_object_pointer &&
+        msg.GetArgument(0, a, &obj))
+      {
+        key += ':';
+        key += obj ? obj->GetClassName() : "nullptr";
+      }
+    }
+    return key;
+  }
+
+  static int Call(const CommandFunction* n, vtkClientServerInterpreter* self, vtkObjectBase* ptr,
+    const char* method, const vtkClientServerStream& msg, vtkClientServerStream& result)
+  {
+    vtkClientServerCommandFunction function = n->Function;
+    void* ctx = n->Context ? n->Context->Context : nullptr;
+    return function(self, ptr, method, msg, result, ctx);
+  }
 };
 
 //----------------------------------------------------------------------------
@@ -253,6 +319,11 @@ int vtkClientServerInterpreter::ProcessOneMessage(const vtkClientServerStream& c
     this->LogStream->flush();
   }
 
+  // Time spent in nested messages is accounted for by the outermost one.
+  const auto start = std::chrono::steady_clock::now();
+  ++this->Internal->NumberOfProcessedMessages;
+  ++this->Internal->ProcessingDepth;
+
   // Look for known commands in the message.
   int result = 0;
   vtkClientServerStream::Commands cmd = css.GetCommand(message);
@@ -283,6 +354,12 @@ int vtkClientServerInterpreter::ProcessOneMessage(const vtkClientServerStream& c
     break;
   }
 
+  if (--this->Internal->ProcessingDepth == 0)
+  {
+    this->Internal->ProcessingTime +=
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  }
+
   // Log the result of the message.
   if (this->LogStream)
   {
@@ -350,10 +427,11 @@ int vtkClientServerInterpreter::ProcessCommandNew(const vtkClientServerStream& c
 
     // Find a NewInstance function that knows about the class.
     int created = 0;
-    if (this->Internal->NewInstanceFunctions.count(cname))
+    ++this->Internal->NumberOfCommandLookups;
+    auto niter = this->Internal->NewInstanceFunctions.find(cname);
+    if (niter != this->Internal->NewInstanceFunctions.end())
     {
-      const vtkClientServerInterpreterInternals::NewInstanceFunction* n =
-        this->Internal->NewInstanceFunctions[cname];
+      const vtkClientServerInterpreterInternals::NewInstanceFunction* n = niter->second;
       vtkClientServerNewInstanceFunction function = n->Function;
       void* ctx = n->Context ? n->Context->Context : nullptr;
       this->NewInstance(function(ctx), id);
@@ -421,8 +499,49 @@ int vtkClientServerInterpreter::ProcessCommandInvoke(const vtkClientServerStream
     // Find the command function for this object's type.
     if (obj && this->HasCommandFunction(obj->GetClassName()))
     {
-      if (this->CallCommandFunction(
-            obj->GetClassName(), obj, method, msg, *this->LastResultMessage))
+      auto& internal = *this->Internal;
+      std::string key = internal.GetInvokeKey(obj->GetClassName(), method, msg);
+      auto cached = internal.InvokeCache.find(key);
+      if (cached != internal.InvokeCache.end())
+      {
+        ++internal.NumberOfInvokeCacheHits;
+
+        // The method may itself process messages with this interpreter, which
+        // must not resolve on behalf of an enclosing invoke.
+        const auto resolved = internal.ResolvedCommand;
+        const int status =
+          internal.Call(cached->second, this, obj, method, msg, *this->LastResultMessage);
+        internal.ResolvedCommand = resolved;
+        if (status)
+        {
+          return 1;
+        }
+
+        // The cached function failed with the same argument signature it
+        // was resolved for. Evict it and look the method up again so that
+        // the error comes from the full lookup. The call may have changed the
+        // cache, hence the lookup by key.
+        internal.InvokeCache.erase(key);
+        this->LastResultMessage->Reset();
+      }
+
+      ++internal.NumberOfInvokeCacheMisses;
+
+      // The method may itself process messages with this interpreter.
+      const auto resolved = internal.ResolvedCommand;
+      internal.ResolvedCommand = nullptr;
+      const int status = this->CallCommandFunction(
+        obj->GetClassName(), obj, method, msg, *this->LastResultMessage);
+      if (status && internal.ResolvedCommand)
+      {
+        if (internal.InvokeCache.size() >= internal.MaximumInvokeCacheSize)
+        {
+          internal.InvokeCache.clear();
+        }
+        internal.InvokeCache.emplace(std::move(key), internal.ResolvedCommand);
+      }
+      internal.ResolvedCommand = resolved;
+      if (status)
       {
         return 1;
       }
@@ -778,6 +897,10 @@ void vtkClientServerInterpreter::AddCommandFunction(const char* cname,
 
   this->Internal->ClassToFunctionMap[cname] =
     new vtkClientServerInterpreterInternals::CommandFunction(func, context);
+
+  // A new command function may handle methods previously resolved by one
+  // of its superclasses.
+  this->Internal->InvokeCache.clear();
 }
 
 //----------------------------------------------------------------------------
@@ -787,6 +910,7 @@ bool vtkClientServerInterpreter::HasCommandFunction(const char* cname)
   {
     return false;
   }
+  ++this->Internal->NumberOfCommandLookups;
   return (this->Internal->ClassToFunctionMap.count(cname) > 0);
 }
 
@@ -794,6 +918,7 @@ bool vtkClientServerInterpreter::HasCommandFunction(const char* cname)
 int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObjectBase* ptr,
   const char* method, const vtkClientServerStream& msg, vtkClientServerStream& result)
 {
+  ++this->Internal->NumberOfCommandLookups;
   vtkClientServerInterpreterInternals::ClassToFunctionMapType::const_iterator f =
     this->Internal->ClassToFunctionMap.find(cname);
 
@@ -804,10 +929,15 @@ int vtkClientServerInterpreter::CallCommandFunction(const char* cname, vtkObject
   }
 
   const vtkClientServerInterpreterInternals::CommandFunction* n = f->second;
+  const int status = this->Internal->Call(n, this, ptr, method, msg, result);
 
-  vtkClientServerCommandFunction function = n->Function;
-  void* ctx = n->Context ? n->Context->Context : nullptr;
-  return function(this, ptr, method, msg, result, ctx);
+  // Superclass command functions are called from within this one, hence the
+  // first to succeed is the one that handled the method.
+  if (status && !this->Internal->ResolvedCommand)
+  {
+    this->Internal->ResolvedCommand = n;
+  }
+  return status;
 }
 
 void vtkClientServerInterpreter::AddNewInstanceFunction(const char* name,
@@ -1001,13 +1131,14 @@ vtkClientServerID vtkClientServerInterpreter::GetNextAvailableId()
 //----------------------------------------------------------------------------
 vtkObjectBase* vtkClientServerInterpreter::NewInstance(const char* classname)
 {
-  if (!this->Internal->NewInstanceFunctions.count(classname))
+  ++this->Internal->NumberOfCommandLookups;
+  auto iter = this->Internal->NewInstanceFunctions.find(classname);
+  if (iter == this->Internal->NewInstanceFunctions.end())
   {
     return nullptr;
   }
 
-  const vtkClientServerInterpreterInternals::NewInstanceFunction* n =
-    this->Internal->NewInstanceFunctions[classname];
+  const vtkClientServerInterpreterInternals::NewInstanceFunction* n = iter->second;
 
   vtkClientServerNewInstanceFunction function = n->Function;
   void* ctx = n->Context ? n->Context->Context : nullptr;
@@ -1015,8 +1146,53 @@ vtkObjectBase* vtkClientServerInterpreter::NewInstance(const char* classname)
   return function(ctx);
 }
 
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetNumberOfProcessedMessages() const
+{
+  return this->Internal->NumberOfProcessedMessages;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetNumberOfCommandLookups() const
+{
+  return this->Internal->NumberOfCommandLookups;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetNumberOfInvokeCacheHits() const
+{
+  return this->Internal->NumberOfInvokeCacheHits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkClientServerInterpreter::GetNumberOfInvokeCacheMisses() const
+{
+  return this->Internal->NumberOfInvokeCacheMisses;
+}
+
+//----------------------------------------------------------------------------
+double vtkClientServerInterpreter::GetProcessingTime() const
+{
+  return this->Internal->ProcessingTime;
+}
+
+//----------------------------------------------------------------------------
+void vtkClientServerInterpreter::ResetStatistics()
+{
+  this->Internal->NumberOfProcessedMessages = 0;
+  this->Internal->NumberOfCommandLookups = 0;
+  this->Internal->NumberOfInvokeCacheHits = 0;
+  this->Internal->NumberOfInvokeCacheMisses = 0;
+  this->Internal->ProcessingTime = 0.0;
+}
+
 //----------------------------------------------------------------------------
 void vtkClientServerInterpreter::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfProcessedMessages: " << this->GetNumberOfProcessedMessages() << endl;
+  os << indent << "NumberOfCommandLookups: " << this->GetNumberOfCommandLookups() << endl;
+  os << indent << "NumberOfInvokeCacheHits: " << this->GetNumberOfInvokeCacheHits() << endl;
+  os << indent << "NumberOfInvokeCacheMisses: " << this->GetNumberOfInvokeCacheMisses() << endl;
+  os << indent << "ProcessingTime: " << this->GetProcessingTime() << endl;
 }
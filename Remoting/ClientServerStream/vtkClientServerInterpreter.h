@@ -189,6 +189,27 @@ public:
    */
   vtkClientServerID GetNextAvailableId();
 
+  //@{
+  /**
+   * Statistics about message processing, to measure and tune the
+   * throughput of the interpreter, e.g. when loading state files.
+   * NumberOfProcessedMessages counts all messages processed, including
+   * messages processed while executing another one. ProcessingTime is the
+   * total wall-clock time, in seconds, spent processing messages.
+   * NumberOfCommandLookups counts the lookups of command and new-instance
+   * functions by class name. Invoke messages are dispatched through a cache
+   * of the command function that handled the same method for the same
+   * receiver class and argument types before; NumberOfInvokeCacheHits and
+   * NumberOfInvokeCacheMisses count how often that cache was used.
+   */
+  vtkTypeUInt64 GetNumberOfProcessedMessages() const;
+  vtkTypeUInt64 GetNumberOfCommandLookups() const;
+  vtkTypeUInt64 GetNumberOfInvokeCacheHits() const;
+  vtkTypeUInt64 GetNumberOfInvokeCacheMisses() const;
+  double GetProcessingTime() const;
+  void ResetStatistics();
+  //@}
+
 protected:
   // constructor and destructor
   vtkClientServerInterpreter();
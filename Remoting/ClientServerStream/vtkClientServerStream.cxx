@@ -24,6 +24,7 @@
 #include "vtkVariantExtract.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <sstream>
 #include <string>
 #include <typeinfo>
@@ -252,18 +253,86 @@ const vtkClientServerStreamInternals::ValueOffsetsType::size_type
   vtkClientServerStreamInternals::InvalidStartIndex =
     static_cast<vtkClientServerStreamInternals::ValueOffsetsType::size_type>(-1);
 
+//----------------------------------------------------------------------------
+// Streams are created and destroyed at a high rate, e.g. one per proxy
+// update, and each one grows its buffer from scratch.  Destroyed streams
+// hand their buffer to a small per-thread pool from which new streams take
+// one, so that steady-state streaming does not allocate.
+namespace
+{
+class vtkClientServerStreamBufferPool
+{
+public:
+  typedef vtkClientServerStreamInternals::DataType DataType;
+
+  // Buffers with a larger capacity are released rather than kept around.
+  static const size_t MaximumBufferCapacity = 1024 * 1024;
+  static const size_t MaximumNumberOfBuffers = 16;
+
+  ~vtkClientServerStreamBufferPool() { vtkClientServerStreamBufferPool::Destroyed() = true; }
+
+  // Give data a pooled buffer, or reserve a fresh one if the pool is empty.
+  static void Acquire(DataType& data, size_t size)
+  {
+    vtkClientServerStreamBufferPool* self = vtkClientServerStreamBufferPool::GetInstance();
+    if (self && !self->Buffers.empty())
+    {
+      self->Buffers.back().swap(data);
+      self->Buffers.pop_back();
+      data.clear();
+    }
+    data.reserve(size);
+  }
+
+  // Return the buffer of data to the pool.
+  static void Release(DataType& data)
+  {
+    vtkClientServerStreamBufferPool* self = vtkClientServerStreamBufferPool::GetInstance();
+    if (self && data.capacity() > 0 &&
+      data.capacity() <= vtkClientServerStreamBufferPool::MaximumBufferCapacity &&
+      self->Buffers.size() < vtkClientServerStreamBufferPool::MaximumNumberOfBuffers)
+    {
+      self->Buffers.push_back(DataType());
+      self->Buffers.back().swap(data);
+    }
+  }
+
+private:
+  // Streams may outlive the pool during thread or program exit, in which
+  // case they simply stop using it.
+  static bool& Destroyed()
+  {
+    static thread_local bool destroyed = false;
+    return destroyed;
+  }
+
+  static vtkClientServerStreamBufferPool* GetInstance()
+  {
+    if (vtkClientServerStreamBufferPool::Destroyed())
+    {
+      return nullptr;
+    }
+    static thread_local vtkClientServerStreamBufferPool instance;
+    return &instance;
+  }
+
+  std::vector<DataType> Buffers;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkClientServerStream::vtkClientServerStream(vtkObjectBase* owner)
 {
   // Initialize the internal representation of the stream.
   this->Internal = new vtkClientServerStreamInternals(owner);
-  this->Reserve(1024);
+  vtkClientServerStreamBufferPool::Acquire(this->Internal->Data, 1024);
   this->Reset();
 }
 
 //----------------------------------------------------------------------------
 vtkClientServerStream::~vtkClientServerStream()
 {
+  vtkClientServerStreamBufferPool::Release(this->Internal->Data);
   delete this->Internal;
 }
 
@@ -316,8 +385,16 @@ void vtkClientServerStream::Reserve(size_t size)
 //----------------------------------------------------------------------------
 void vtkClientServerStream::Reset()
 {
-  // Empty the entire stream.
-  vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  // Empty the entire stream.  The buffer is kept for reuse unless it grew
+  // large enough that holding on to it would waste memory.
+  if (this->Internal->Data.capacity() > vtkClientServerStreamBufferPool::MaximumBufferCapacity)
+  {
+    vtkClientServerStreamInternals::DataType().swap(this->Internal->Data);
+  }
+  else
+  {
+    this->Internal->Data.clear();
+  }
 
   this->Internal->ValueOffsets.erase(
     this->Internal->ValueOffsets.begin(), this->Internal->ValueOffsets.end());
@@ -1140,6 +1217,71 @@ VTK_CSS_GET_ARGUMENT_ARRAY(unsigned __int64)
 #endif
 #undef VTK_CSS_GET_ARGUMENT_ARRAY
 
+//----------------------------------------------------------------------------
+// Template and macro to implement GetArgumentView methods in the same way.
+template <class T>
+int vtkClientServerStreamGetArgumentView(const vtkClientServerStream* self, int midx,
+  int argument, const T** value, vtkTypeUInt32* length)
+{
+  typedef VTK_CSS_TYPENAME vtkTypeTraits<T>::SizedType Type;
+  if (const unsigned char* data =
+        vtkClientServerStreamInternals::GetValue(*self, midx, 1 + argument))
+  {
+    // Get the type of the value in the stream.
+    vtkTypeUInt32 tp;
+    memcpy(&tp, data, sizeof(tp));
+    data += sizeof(tp);
+
+    // Only an array of exactly this type can be viewed in place.
+    if (static_cast<vtkClientServerStream::Types>(tp) != vtkClientServerTypeTraits<Type>::Array())
+    {
+      return 0;
+    }
+
+    // Get the length of the array.
+    vtkTypeUInt32 len;
+    memcpy(&len, data, sizeof(len));
+    data += sizeof(len);
+
+    // Values are packed in the stream without padding, hence the array may
+    // not be aligned for its type.
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0)
+    {
+      return 0;
+    }
+
+    *value = reinterpret_cast<const T*>(data);
+    *length = len;
+    return 1;
+  }
+  return 0;
+}
+
+#define VTK_CSS_GET_ARGUMENT_VIEW(type)                                                            \
+  int vtkClientServerStream::GetArgumentView(                                                      \
+    int message, int argument, const type** value, vtkTypeUInt32* length) const                    \
+  {                                                                                                \
+    return vtkClientServerStreamGetArgumentView(this, message, argument, value, length);           \
+  }
+VTK_CSS_GET_ARGUMENT_VIEW(signed char)
+VTK_CSS_GET_ARGUMENT_VIEW(char)
+VTK_CSS_GET_ARGUMENT_VIEW(int)
+VTK_CSS_GET_ARGUMENT_VIEW(short)
+VTK_CSS_GET_ARGUMENT_VIEW(long)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned char)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned int)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned short)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned long)
+VTK_CSS_GET_ARGUMENT_VIEW(float)
+VTK_CSS_GET_ARGUMENT_VIEW(double)
+VTK_CSS_GET_ARGUMENT_VIEW(long long)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned long long)
+#if defined(VTK_TYPE_USE___INT64)
+VTK_CSS_GET_ARGUMENT_VIEW(__int64)
+VTK_CSS_GET_ARGUMENT_VIEW(unsigned __int64)
+#endif
+#undef VTK_CSS_GET_ARGUMENT_VIEW
+
 //----------------------------------------------------------------------------
 int vtkClientServerStream::GetArgument(int message, int argument, const char** value) const
 {
@@ -1510,12 +1652,12 @@ int vtkClientServerStream::SetData(const unsigned char* data, size_t length)
 {
   // Reset and remove the byte order entry from the stream.
   this->Reset();
-  this->Internal->Data.erase(this->Internal->Data.begin(), this->Internal->Data.end());
+  this->Internal->Data.clear();
 
   // Store the given data in the stream.
   if (data)
   {
-    this->Internal->Data.insert(this->Internal->Data.begin(), data, data + length);
+    this->Internal->Data.assign(data, data + length);
   }
 
   // Parse the stream to fill in ValueOffsets and MessageIndexes and
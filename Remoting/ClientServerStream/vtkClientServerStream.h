@@ -214,6 +214,46 @@ public:
    */
   int GetArgumentLength(int message, int argument, vtkTypeUInt32* length) const;
 
+  //@{
+  /**
+   * Get a read-only view of an array argument directly in the stream's
+   * buffer, avoiding the copy done by the GetArgument overloads above.
+   * Returns 1 and sets \a value and \a length only if the array stored in
+   * the stream has exactly the requested type and its data happens to be
+   * suitably aligned for that type; otherwise returns 0 and the caller must
+   * fall back to copying the array with GetArgument.  The view is
+   * invalidated when any further writing to the stream is done.  String
+   * arguments can already be viewed in place with the `const char**`
+   * overload of GetArgument.
+   */
+  int GetArgumentView(
+    int message, int argument, const signed char** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const char** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const short** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const int** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const long** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned char** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned short** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned int** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned long** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const float** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(int message, int argument, const double** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const long long** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned long long** value, vtkTypeUInt32* length) const;
+#if defined(VTK_TYPE_USE___INT64)
+  int GetArgumentView(
+    int message, int argument, const __int64** value, vtkTypeUInt32* length) const;
+  int GetArgumentView(
+    int message, int argument, const unsigned __int64** value, vtkTypeUInt32* length) const;
+#endif
+  //@}
+
   /**
    * Get the given argument in the given message as an object of a
    * particular vtkObjectBase type.  Returns whether the argument is
@@ -533,6 +573,57 @@ public:
 private:
   T* Data;
 };
+
+// Extract the given argument of the given message as read-only data
+// array.  Since the wrapped method cannot modify the data, it is used in
+// place in the message whenever the stream allows it and only copied
+// otherwise.  This is for use only in generated wrappers.
+template <class T>
+class vtkClientServerStreamDataArg<const T>
+{
+public:
+  vtkClientServerStreamDataArg(const vtkClientServerStream& msg, int message, int argument)
+    : Data(0)
+    , Copy(0)
+  {
+    vtkTypeUInt32 length = 0;
+    if (msg.GetArgumentView(message, argument, &this->Data, &length))
+    {
+      if (length == 0)
+      {
+        this->Data = 0;
+      }
+      return;
+    }
+
+    // Fall back to copying the data out of the message.
+    if (msg.GetArgumentLength(message, argument, &length) && length > 0)
+    {
+      try
+      {
+        this->Copy = new T[length];
+      }
+      catch (...)
+      {
+      }
+    }
+    if (this->Copy && !msg.GetArgument(message, argument, this->Copy, length))
+    {
+      delete[] this->Copy;
+      this->Copy = 0;
+    }
+    this->Data = this->Copy;
+  }
+
+  ~vtkClientServerStreamDataArg() { delete[] this->Copy; }
+
+  // Allow this object to be passed as if it were a pointer.
+  operator const T*() { return this->Data; }
+
+private:
+  const T* Data;
+  T* Copy;
+};
 #endif
 
 #endif
@@ -13,11 +13,14 @@
 
 =========================================================================*/
 #include "vtkFloatArray.h"
+#include "vtkMath.h"
 #include "vtkMathUtilities.h"
 #include "vtkNew.h"
 #include "vtkPVArrayInformation.h"
 #include "vtkSmartPointer.h"
 
+#include <cmath>
+
 vtkSmartPointer<vtkFloatArray> GetPolyData()
 {
   vtkIdType numPts = 101;
@@ -138,5 +141,64 @@ int TestPVArrayInformation(int, char*[])
     return EXIT_FAILURE;
   }
 
+  // Ranges of all components and of the magnitude, ignoring NaN.
+  vtkNew<vtkFloatArray> vectors;
+  vectors->SetNumberOfComponents(3);
+  vectors->InsertNextTuple3(3, 4, -1);
+  vectors->InsertNextTuple3(-2, vtkMath::Nan(), 5);
+  vectors->InsertNextTuple3(0, 0, vtkMath::Inf());
+  vtkNew<vtkPVArrayInformation> vinfo;
+  vinfo->CopyFromArray(vectors);
+  if (vinfo->GetComponentRange(0)[0] != -2.0 || vinfo->GetComponentRange(0)[1] != 3.0 ||
+    vinfo->GetComponentRange(1)[0] != 0.0 || vinfo->GetComponentRange(1)[1] != 4.0 ||
+    vinfo->GetComponentRange(2)[1] != vtkMath::Inf() ||
+    vinfo->GetComponentFiniteRange(2)[0] != -1.0 || vinfo->GetComponentFiniteRange(2)[1] != 5.0)
+  {
+    cerr << "ERROR: incorrect component ranges." << endl;
+    return EXIT_FAILURE;
+  }
+  if (!vtkMathUtilities::FuzzyCompare(vinfo->GetComponentRange(-1)[0], std::sqrt(26.0)) ||
+    vinfo->GetComponentRange(-1)[1] != vtkMath::Inf() ||
+    !vtkMathUtilities::FuzzyCompare(vinfo->GetComponentFiniteRange(-1)[1], std::sqrt(26.0)))
+  {
+    cerr << "ERROR: incorrect magnitude range." << endl;
+    return EXIT_FAILURE;
+  }
+  if (vectors->HasInformation() || vinfo->GetNumberOfInformationKeys() != 0)
+  {
+    cerr << "ERROR: cached ranges must not be stored in the array's information." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // Ranges are cached until the array is modified.
+  vectors->SetTypedComponent(0, 0, 10);
+  vinfo->Initialize();
+  vinfo->CopyFromArray(vectors);
+  if (vinfo->GetComponentRange(0)[1] != 3.0)
+  {
+    cerr << "ERROR: expected cached ranges for an unmodified array." << endl;
+    return EXIT_FAILURE;
+  }
+  vectors->Modified();
+  vinfo->Initialize();
+  vinfo->CopyFromArray(vectors);
+  if (vinfo->GetComponentRange(0)[1] != 10.0)
+  {
+    cerr << "ERROR: expected ranges to be recomputed for a modified array." << endl;
+    return EXIT_FAILURE;
+  }
+
+  // A copy of the array does not share the ranges cached for the array.
+  vtkNew<vtkFloatArray> copy;
+  copy->DeepCopy(vectors);
+  copy->SetTypedComponent(0, 0, 20);
+  vinfo->Initialize();
+  vinfo->CopyFromArray(copy);
+  if (vinfo->GetComponentRange(0)[1] != 20.0)
+  {
+    cerr << "ERROR: expected ranges to be computed for a copied array." << endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
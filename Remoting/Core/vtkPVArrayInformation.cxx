@@ -15,21 +15,30 @@
 #include "vtkPVArrayInformation.h"
 
 #include "vtkAbstractArray.h"
+#include "vtkArrayDispatch.h"
 #include "vtkClientServerStream.h"
 #include "vtkDataArray.h"
+#include "vtkDataArrayRange.h"
 #include "vtkGenericAttribute.h"
 #include "vtkInformation.h"
 #include "vtkInformationIterator.h"
 #include "vtkInformationKey.h"
+#include "vtkMath.h"
 #include "vtkNew.h"
 #include "vtkNumberToString.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVLogger.h"
 #include "vtkPVPostFilter.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
+#include "vtkWeakPointer.h"
 
 #include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <map>
+#include <mutex>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -51,6 +60,167 @@ vtkTuple<double, 2> MergeRanges(const vtkTuple<double, 2>& r1, const vtkTuple<do
   return vtkTuple<double, 2>({ std::min(r1[0], r2[0]), std::max(r1[1], r2[1]) });
 }
 
+/**
+ * Computes the range and the finite range of the magnitude and of every
+ * component in a single pass over the array. Ranges are stored as 4 values per
+ * component: range followed by finite range, starting with the magnitude.
+ */
+template <typename ArrayT>
+class ComponentRangesFunctor
+{
+  ArrayT* Array;
+  vtkSMPThreadLocal<std::vector<double>> TLRanges;
+
+  static void Update(double* ranges, double value)
+  {
+    if (!std::isnan(value))
+    {
+      ranges[0] = std::min(ranges[0], value);
+      ranges[1] = std::max(ranges[1], value);
+      if (vtkMath::IsFinite(value))
+      {
+        ranges[2] = std::min(ranges[2], value);
+        ranges[3] = std::max(ranges[3], value);
+      }
+    }
+  }
+
+public:
+  std::vector<double> Ranges;
+
+  ComponentRangesFunctor(ArrayT* array)
+    : Array(array)
+  {
+    const int numComponents = array->GetNumberOfComponents();
+    for (int cc = 0; cc <= numComponents; ++cc)
+    {
+      this->Ranges.insert(this->Ranges.end(),
+        { VTK_DOUBLE_MAX, VTK_DOUBLE_MIN, VTK_DOUBLE_MAX, VTK_DOUBLE_MIN });
+    }
+  }
+
+  void Initialize() { this->TLRanges.Local() = this->Ranges; }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    auto& ranges = this->TLRanges.Local();
+    const auto tuples = vtk::DataArrayTupleRange(this->Array, begin, end);
+    for (const auto tuple : tuples)
+    {
+      double squaredNorm = 0.0;
+      int comp = 0;
+      for (const auto component : tuple)
+      {
+        const double value = static_cast<double>(component);
+        squaredNorm += value * value;
+        Update(&ranges[4 * (++comp)], value);
+      }
+      Update(&ranges[0], std::sqrt(squaredNorm));
+    }
+  }
+
+  void Reduce()
+  {
+    for (const auto& ranges : this->TLRanges)
+    {
+      for (size_t cc = 0; cc < this->Ranges.size(); cc += 2)
+      {
+        this->Ranges[cc] = std::min(this->Ranges[cc], ranges[cc]);
+        this->Ranges[cc + 1] = std::max(this->Ranges[cc + 1], ranges[cc + 1]);
+      }
+    }
+
+    // like vtkDataArray::GetRange, the magnitude of a single component array is
+    // the component itself.
+    if (this->Ranges.size() == 8)
+    {
+      std::copy(this->Ranges.begin() + 4, this->Ranges.end(), this->Ranges.begin());
+    }
+  }
+};
+
+struct ComponentRangesWorker
+{
+  template <typename ArrayT>
+  void operator()(ArrayT* array, std::vector<double>& ranges)
+  {
+    ComponentRangesFunctor<ArrayT> functor(array);
+    vtkSMPTools::For(0, array->GetNumberOfTuples(), functor);
+    ranges = std::move(functor.Ranges);
+  }
+};
+
+/**
+ * Cache of the ranges computed by ComponentRangesFunctor, so that gathering
+ * information again on an unchanged array does not scan it again. The cache is
+ * kept aside rather than in the array's vtkInformation, which is copied along
+ * with the array. Entries are keyed on the array and are only valid as long as
+ * the array's MTime matches the one they were computed for; entries of deleted
+ * arrays are pruned as new ones are added.
+ */
+class ComponentRangesCache
+{
+  struct Entry
+  {
+    vtkWeakPointer<vtkDataArray> Array;
+    vtkMTimeType MTime;
+    std::vector<double> Ranges;
+  };
+  std::map<vtkDataArray*, Entry> Entries;
+  size_t PruneSize = 64;
+  std::mutex Mutex;
+
+public:
+  bool Get(vtkDataArray* array, std::vector<double>& ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    auto iter = this->Entries.find(array);
+    if (iter != this->Entries.end() && iter->second.Array.GetPointer() == array &&
+      iter->second.MTime == array->GetMTime())
+    {
+      ranges = iter->second.Ranges;
+      return true;
+    }
+    return false;
+  }
+
+  void Set(vtkDataArray* array, vtkMTimeType mtime, const std::vector<double>& ranges)
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (this->Entries.size() >= this->PruneSize)
+    {
+      for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+      {
+        iter = iter->second.Array.GetPointer() == nullptr ? this->Entries.erase(iter)
+                                                          : std::next(iter);
+      }
+      this->PruneSize = std::max<size_t>(64, 2 * this->Entries.size());
+    }
+    this->Entries[array] = Entry{ array, mtime, ranges };
+  }
+};
+
+/**
+ * Returns the ranges of `array`, as computed by ComponentRangesFunctor.
+ */
+std::vector<double> GetComponentRanges(vtkDataArray* array)
+{
+  static ComponentRangesCache cache;
+  std::vector<double> ranges;
+  if (cache.Get(array, ranges))
+  {
+    return ranges;
+  }
+
+  const vtkMTimeType mtime = array->GetMTime();
+  if (!vtkArrayDispatch::Dispatch::Execute(array, ComponentRangesWorker{}, ranges))
+  {
+    ComponentRangesWorker{}(array, ranges);
+  }
+  cache.Set(array, mtime, ranges);
+  return ranges;
+}
+
 } // end of namespace
 
 vtkStandardNewMacro(vtkPVArrayInformation);
@@ -293,11 +463,13 @@ void vtkPVArrayInformation::CopyFromArray(vtkAbstractArray* array)
   auto dataArray = vtkDataArray::SafeDownCast(array);
   if (dataArray && dataArray->IsNumeric())
   {
+    const auto ranges = ::GetComponentRanges(dataArray);
     for (int comp = -1; comp < numComponents; ++comp)
     {
       auto& compInfo = this->Components.at(comp + 1);
-      dataArray->GetRange(compInfo.Range.GetData(), comp);
-      dataArray->GetFiniteRange(compInfo.FiniteRange.GetData(), comp);
+      const double* compRanges = &ranges[4 * (comp + 1)];
+      compInfo.Range = vtkTuple<double, 2>({ compRanges[0], compRanges[1] });
+      compInfo.FiniteRange = vtkTuple<double, 2>({ compRanges[2], compRanges[3] });
     }
   }
   else if (auto sarray = vtkStringArray::SafeDownCast(array))
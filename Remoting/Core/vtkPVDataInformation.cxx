@@ -163,6 +163,10 @@ vtkStandardNewMacro(vtkPVDataInformation);
 vtkPVDataInformation::vtkPVDataInformation()
 {
   this->Initialize();
+
+  // AddInformation() only accumulates counts, bounds and array metadata, so
+  // partial results can be merged on intermediate ranks.
+  this->ReduceInTree = true;
 }
 
 //----------------------------------------------------------------------------
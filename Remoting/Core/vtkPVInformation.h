@@ -70,6 +70,22 @@ public:
   vtkGetMacro(RootOnly, int);
   //@}
 
+  //@{
+  /**
+   * Set/get whether partial information from satellites can be merged on
+   * intermediate ranks while collecting it on the root. When on, the session
+   * reduces information up a binary tree so that each rank only deserializes
+   * and merges O(log(N)) partial results, instead of the root merging the
+   * results from every rank. This requires that AddInformation() be
+   * associative, i.e. merging partial results in rank order gives the same
+   * result as merging each rank's result in turn. Default is off; subclasses
+   * that satisfy this requirement turn it on in their constructor.
+   */
+  vtkSetMacro(ReduceInTree, bool);
+  vtkGetMacro(ReduceInTree, bool);
+  vtkBooleanMacro(ReduceInTree, bool);
+  //@}
+
 protected:
   vtkPVInformation();
   ~vtkPVInformation() override;
@@ -77,6 +93,8 @@ protected:
   int RootOnly;
   vtkSetMacro(RootOnly, int);
 
+  bool ReduceInTree;
+
   vtkPVInformation(const vtkPVInformation&) = delete;
   void operator=(const vtkPVInformation&) = delete;
 };
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestExtractsDeliveryQueue.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Tests asynchronous delivery of extracts to a slow receiver: frames are
+// dropped once the queue is full, the queued bytes stay bounded, and the
+// frames that are delivered arrive in order, the latest one included.
+
+#include "vtkClientSocket.h"
+#include "vtkDummyController.h"
+#include "vtkExtractsDeliveryHelper.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPolyData.h"
+#include "vtkServerSocket.h"
+#include "vtkSmartPointer.h"
+#include "vtkSocketCommunicator.h"
+#include "vtkSocketController.h"
+#include "vtkTrivialProducer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return EXIT_FAILURE;                                                                           \
+  }
+
+namespace
+{
+constexpr int NumberOfFrames = 10;
+constexpr int MaximumNumberOfQueuedFrames = 2;
+
+// Large enough for a frame not to fit in the socket buffers, so that sending
+// blocks until the receiver reads it.
+constexpr vtkIdType FrameValues = 4 * 1024 * 1024;
+
+vtkSmartPointer<vtkPolyData> CreateFrame(int frame)
+{
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfValues(FrameValues);
+  values->FillValue(static_cast<float>(frame));
+  vtkNew<vtkIntArray> number;
+  number->SetName("Frame");
+  number->InsertNextValue(frame);
+  auto pd = vtkSmartPointer<vtkPolyData>::New();
+  pd->GetFieldData()->AddArray(values);
+  pd->GetFieldData()->AddArray(number);
+  return pd;
+}
+
+// Receives one frame per update on the simulation side, sleeping before each
+// of them, and records the number of each new extract received.
+void Receive(vtkServerSocket* socket, std::vector<int>* received)
+{
+  vtkSmartPointer<vtkClientSocket> clientSocket;
+  clientSocket.TakeReference(socket->WaitForConnection());
+  vtkNew<vtkSocketController> controller;
+  auto comm = vtkSocketCommunicator::SafeDownCast(controller->GetCommunicator());
+  comm->SetSocket(clientSocket);
+  comm->ServerSideHandshake();
+
+  vtkNew<vtkDummyController> parallelController;
+  vtkNew<vtkTrivialProducer> consumer;
+  vtkNew<vtkExtractsDeliveryHelper> helper;
+  helper->SetProcessIsProducer(false);
+  helper->SetParallelController(parallelController);
+  helper->SetSimulation2VisualizationController(controller);
+  helper->AddExtractConsumer("extract", consumer);
+
+  vtkDataObject* previous = nullptr;
+  for (int cc = 0; cc < NumberOfFrames; ++cc)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(cc == 0 ? 2000 : 50));
+    helper->Update();
+    vtkDataObject* current = consumer->GetOutputDataObject(0);
+    if (current && current != previous)
+    {
+      auto number = vtkIntArray::SafeDownCast(current->GetFieldData()->GetArray("Frame"));
+      received->push_back(number ? number->GetValue(0) : -1);
+      previous = current;
+    }
+  }
+}
+}
+
+int TestExtractsDeliveryQueue(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  vtkNew<vtkServerSocket> socket;
+  VERIFY(socket->CreateServer(0) == 0, "Failed to create the server socket.");
+
+  std::vector<int> received;
+  std::thread receiver(Receive, socket.GetPointer(), &received);
+
+  vtkNew<vtkSocketController> controller;
+  VERIFY(controller->ConnectTo("localhost", socket->GetServerPort()) != 0,
+    "Failed to connect to the receiver.");
+
+  vtkNew<vtkDummyController> parallelController;
+  vtkNew<vtkTrivialProducer> producer;
+  vtkNew<vtkExtractsDeliveryHelper> helper;
+  helper->SetProcessIsProducer(true);
+  helper->SetNumberOfSimulationProcesses(1);
+  helper->SetNumberOfVisualizationProcesses(1);
+  helper->SetParallelController(parallelController);
+  helper->SetSimulation2VisualizationController(controller);
+  helper->SetAsynchronousDelivery(true);
+  helper->SetMaximumNumberOfQueuedFrames(MaximumNumberOfQueuedFrames);
+  helper->SetDropPolicy(vtkExtractsDeliveryHelper::DROP_OLDEST);
+  helper->AddExtractProducer("extract", producer->GetOutputPort());
+
+  // The receiver sleeps long enough for all the frames to be queued before it
+  // reads the first one. The first frame is being sent meanwhile, hence the
+  // sleep to let the sending thread pick it, and at most
+  // MaximumNumberOfQueuedFrames others wait in the queue.
+  vtkTypeUInt64 frameSize = 0;
+  for (int cc = 0; cc < NumberOfFrames; ++cc)
+  {
+    producer->SetOutput(CreateFrame(cc));
+    VERIFY(helper->Update(), "Update failed.");
+    if (cc == 0)
+    {
+      frameSize = helper->GetNumberOfQueuedBytes();
+      VERIFY(frameSize >= sizeof(float) * FrameValues, "Expected the first frame to be queued.");
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+    const vtkTypeUInt64 numFrames = std::min(cc, MaximumNumberOfQueuedFrames) + 1;
+    VERIFY(
+      helper->GetNumberOfQueuedBytes() == numFrames * frameSize, "Wrong number of queued bytes.");
+  }
+  const vtkIdType dropped = helper->GetNumberOfDroppedFrames();
+  VERIFY(dropped == NumberOfFrames - MaximumNumberOfQueuedFrames - 1,
+    "Expected all frames but the ones fitting in the queue to be dropped.");
+
+  receiver.join();
+  for (int cc = 0; cc < 100 && helper->GetNumberOfQueuedBytes() > 0; ++cc)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  VERIFY(helper->GetNumberOfQueuedBytes() == 0, "Expected no queued bytes once all are sent.");
+  VERIFY(!helper->GetDeliveryFailed(), "Unexpected delivery failure.");
+
+  VERIFY(static_cast<vtkIdType>(received.size()) == NumberOfFrames - dropped,
+    "Expected every frame that is not dropped to be delivered.");
+  for (size_t cc = 1; cc < received.size(); ++cc)
+  {
+    VERIFY(received[cc - 1] < received[cc], "Frames delivered out of order.");
+  }
+  VERIFY(!received.empty() && received.front() == 0 && received.back() == NumberOfFrames - 1,
+    "Expected the first frame, already being sent, and the latest frame to be delivered.");
+  VERIFY(helper->GetNumberOfDroppedFrames() == dropped, "Unexpected frames dropped.");
+  return EXIT_SUCCESS;
+}
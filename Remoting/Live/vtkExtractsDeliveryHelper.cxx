@@ -16,12 +16,16 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkCellData.h"
+#include "vtkCharArray.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataSet.h"
 #include "vtkDataObject.h"
 #include "vtkDataObjectTypes.h"
+#include "vtkLogger.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPointData.h"
 #include "vtkSocketController.h"
@@ -29,7 +33,327 @@
 #include "vtkTrivialProducer.h"
 #include "vtkUnsignedCharArray.h"
 
+#include "vtk_lz4.h"
+
+#include <algorithm>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// An extract serialized on the simulation processes, ready to be sent.
+struct vtkSerializedExtract
+{
+  std::string Key;
+  std::string ClassName; // empty when there is no data object.
+  vtkSmartPointer<vtkCharArray> Buffer;
+};
+
+// The extracts of one vtkExtractsDeliveryHelper::Update().
+typedef std::vector<vtkSerializedExtract> vtkSerializedFrame;
+
+vtkSerializedExtract Serialize(const std::string& key, vtkDataObject* dObj)
+{
+  vtkSerializedExtract extract;
+  extract.Key = key;
+  extract.Buffer = vtkSmartPointer<vtkCharArray>::New();
+  if (dObj)
+  {
+    extract.ClassName = dObj->GetClassName();
+    vtkCommunicator::MarshalDataObject(dObj, extract.Buffer);
+  }
+  return extract;
+}
+
+vtkTypeUInt64 GetFrameSize(const vtkSerializedFrame& frame)
+{
+  vtkTypeUInt64 size = 0;
+  for (const auto& extract : frame)
+  {
+    size += static_cast<vtkTypeUInt64>(extract.Buffer->GetNumberOfValues());
+  }
+  return size;
+}
+
+// Sends a header (tag 12000) and a payload (tag 12001) for each extract,
+// followed by the "null" key marking the end of the frame. Payloads are LZ4
+// compressed if requested and if that makes them smaller.
+bool SendFrame(vtkSocketController* comm, const vtkSerializedFrame& frame, bool compress)
+{
+  for (const auto& extract : frame)
+  {
+    const vtkTypeUInt64 rawSize = static_cast<vtkTypeUInt64>(extract.Buffer->GetNumberOfValues());
+    const char* payload = extract.Buffer->GetPointer(0);
+    vtkTypeUInt64 payloadSize = rawSize;
+    int isCompressed = 0;
+    std::vector<char> compressed;
+    if (compress && rawSize > 0 && rawSize <= static_cast<vtkTypeUInt64>(LZ4_MAX_INPUT_SIZE))
+    {
+      compressed.resize(static_cast<size_t>(LZ4_compressBound(static_cast<int>(rawSize))));
+      const int size = LZ4_compress_default(payload, compressed.data(), static_cast<int>(rawSize),
+        static_cast<int>(compressed.size()));
+      if (size > 0 && static_cast<vtkTypeUInt64>(size) < rawSize)
+      {
+        payload = compressed.data();
+        payloadSize = static_cast<vtkTypeUInt64>(size);
+        isCompressed = 1;
+      }
+    }
+
+    vtkMultiProcessStream header;
+    header << extract.Key << extract.ClassName << isCompressed << rawSize << payloadSize;
+    if (!comm->Send(header, 1, 12000) ||
+      (payloadSize > 0 &&
+        !comm->Send(payload, static_cast<vtkIdType>(payloadSize), 1, 12001)))
+    {
+      return false;
+    }
+  }
+
+  // mark end.
+  vtkMultiProcessStream stream;
+  stream << std::string("null");
+  return comm->Send(stream, 1, 12000) != 0;
+}
+
+// Receives the payload announced by `header` and deserializes it.
+vtkSmartPointer<vtkDataObject> ReceiveExtract(
+  vtkSocketController* comm, vtkMultiProcessStream& header)
+{
+  std::string className;
+  int isCompressed = 0;
+  vtkTypeUInt64 rawSize = 0;
+  vtkTypeUInt64 payloadSize = 0;
+  header >> className >> isCompressed >> rawSize >> payloadSize;
+
+  vtkNew<vtkCharArray> buffer;
+  buffer->SetNumberOfValues(static_cast<vtkIdType>(rawSize));
+  if (isCompressed)
+  {
+    std::vector<char> payload(static_cast<size_t>(payloadSize));
+    comm->Receive(payload.data(), static_cast<vtkIdType>(payloadSize), 1, 12001);
+    if (LZ4_decompress_safe(payload.data(), buffer->GetPointer(0), static_cast<int>(payloadSize),
+          static_cast<int>(rawSize)) != static_cast<int>(rawSize))
+    {
+      vtkGenericWarningMacro("Failed to decompress extract.");
+      return nullptr;
+    }
+  }
+  else if (payloadSize > 0)
+  {
+    comm->Receive(buffer->GetPointer(0), static_cast<vtkIdType>(payloadSize), 1, 12001);
+  }
+
+  if (className.empty())
+  {
+    return nullptr;
+  }
+  vtkSmartPointer<vtkDataObject> dObj;
+  dObj.TakeReference(vtkDataObjectTypes::NewDataObject(className.c_str()));
+  if (!dObj || !vtkCommunicator::UnMarshalDataObject(buffer, dObj))
+  {
+    vtkGenericWarningMacro("Failed to deserialize extract of type " << className.c_str());
+    return nullptr;
+  }
+  return dObj;
+}
+}
+
+//*****************************************************************************
+// Frames waiting to be sent by a background thread when AsynchronousDelivery
+// is enabled. A dropped frame is replaced by an empty one so that the
+// visualization processes still receive one frame per Update().
+class vtkExtractsDeliveryHelper::vtkDeliveryQueue
+{
+public:
+  struct Entry
+  {
+    int Sequence = 0;
+    vtkSerializedFrame Frame;
+    vtkTypeUInt64 Size = 0;
+    bool Compress = false;
+    bool Dropped = false;
+    int NumberOfEmptyFrames = 0;
+  };
+
+  std::mutex Mutex;
+  std::condition_variable Condition;
+  std::deque<Entry> Entries;
+  std::thread Thread;
+  vtkSmartPointer<vtkSocketController> Controller;
+  bool Stop = false;
+  bool Failed = false;
+  int NextSequence = 0;
+  vtkTypeUInt64 QueuedBytes = 0;
+  vtkIdType DroppedFrames = 0;
+
+  ~vtkDeliveryQueue()
+  {
+    // frames still waiting are discarded; this waits for the frame being sent.
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+    }
+    this->Condition.notify_all();
+    if (this->Thread.joinable())
+    {
+      this->Thread.join();
+    }
+  }
+
+  void Start(vtkSocketController* comm)
+  {
+    this->Controller = comm;
+    this->Thread = std::thread(&vtkDeliveryQueue::Run, this);
+  }
+
+  // Queues the frame of the current Update(). This is collective over all
+  // simulation processes, so that they all drop the same frames, and must be
+  // called on all of them, `comm` being nullptr on those that do not send
+  // extracts.
+  void Enqueue(vtkMultiProcessController* parallelController, vtkSocketController* comm,
+    vtkSerializedFrame&& frame, int maxFrames, int dropPolicy, bool compress)
+  {
+    if (comm && !this->Thread.joinable())
+    {
+      this->Start(comm);
+    }
+
+    // Hold the lock until the frame is queued so that no waiting frame starts
+    // being sent while processes agree on the frame to drop.
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    int numPending = 0;
+    int oldestPending = VTK_INT_MAX;
+    for (const auto& entry : this->Entries)
+    {
+      if (!entry.Dropped)
+      {
+        oldestPending = std::min(oldestPending, entry.Sequence);
+        ++numPending;
+      }
+    }
+
+    // The newest of the oldest waiting frames of each process is waiting on
+    // all of them: frames are queued in order, and dropped on all processes.
+    int local[2] = { (numPending >= maxFrames || this->Failed) ? 1 : 0,
+      comm ? oldestPending : -1 };
+    int global[2] = { local[0], local[1] };
+    if (parallelController && parallelController->GetNumberOfProcesses() > 1)
+    {
+      parallelController->AllReduce(local, global, 2, vtkCommunicator::MAX_OP);
+    }
+
+    Entry entry;
+    entry.Sequence = this->NextSequence++;
+    entry.Compress = compress;
+    if (global[0] == 0)
+    {
+      entry.Frame = std::move(frame);
+    }
+    else
+    {
+      ++this->DroppedFrames;
+      if (dropPolicy == vtkExtractsDeliveryHelper::DROP_OLDEST && global[1] >= 0 &&
+        global[1] != VTK_INT_MAX)
+      {
+        this->Drop(global[1]);
+        entry.Frame = std::move(frame);
+      }
+      else
+      {
+        entry.Dropped = true;
+        entry.NumberOfEmptyFrames = 1;
+      }
+    }
+
+    if (comm && !this->Failed)
+    {
+      entry.Size = GetFrameSize(entry.Frame);
+      this->QueuedBytes += entry.Size;
+      if (entry.Dropped && !this->Entries.empty() && this->Entries.back().Dropped)
+      {
+        ++this->Entries.back().NumberOfEmptyFrames;
+      }
+      else
+      {
+        this->Entries.push_back(std::move(entry));
+      }
+      lock.unlock();
+      this->Condition.notify_one();
+    }
+  }
+
+private:
+  void Drop(int sequence)
+  {
+    for (auto& entry : this->Entries)
+    {
+      if (entry.Sequence == sequence && !entry.Dropped)
+      {
+        this->QueuedBytes -= entry.Size;
+        entry.Frame.clear();
+        entry.Size = 0;
+        entry.Dropped = true;
+        entry.NumberOfEmptyFrames = 1;
+        return;
+      }
+    }
+  }
+
+  void Run()
+  {
+    while (true)
+    {
+      Entry entry;
+      {
+        std::unique_lock<std::mutex> lock(this->Mutex);
+        this->Condition.wait(lock, [this]() { return this->Stop || !this->Entries.empty(); });
+        if (this->Stop)
+        {
+          return;
+        }
+        entry = std::move(this->Entries.front());
+        this->Entries.pop_front();
+      }
+
+      bool success = true;
+      if (entry.Dropped)
+      {
+        for (int cc = 0; cc < entry.NumberOfEmptyFrames && success; ++cc)
+        {
+          success = SendFrame(this->Controller, vtkSerializedFrame(), false);
+        }
+      }
+      else
+      {
+        success = SendFrame(this->Controller, entry.Frame, entry.Compress);
+      }
+
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->QueuedBytes -= entry.Size;
+      if (!success)
+      {
+        // the connection is gone, stop sending and drop everything else.
+        vtkLogF(ERROR,
+          "Failed to send extracts to the visualization processes; %d queued frame(s) and all "
+          "subsequent ones are discarded.",
+          static_cast<int>(this->Entries.size()));
+        this->Failed = true;
+        for (const auto& pending : this->Entries)
+        {
+          this->QueuedBytes -= pending.Size;
+        }
+        this->Entries.clear();
+        return;
+      }
+    }
+  }
+};
 
 vtkStandardNewMacro(vtkExtractsDeliveryHelper);
 //----------------------------------------------------------------------------
@@ -37,6 +361,10 @@ vtkExtractsDeliveryHelper::vtkExtractsDeliveryHelper()
   : ProcessIsProducer(true)
   , NumberOfSimulationProcesses(0)
   , NumberOfVisualizationProcesses(0)
+  , AsynchronousDelivery(false)
+  , MaximumNumberOfQueuedFrames(2)
+  , DropPolicy(DROP_OLDEST)
+  , CompressExtracts(false)
 {
   this->SetParallelController(vtkMultiProcessController::GetGlobalController());
 }
@@ -44,6 +372,39 @@ vtkExtractsDeliveryHelper::vtkExtractsDeliveryHelper()
 //----------------------------------------------------------------------------
 vtkExtractsDeliveryHelper::~vtkExtractsDeliveryHelper() = default;
 
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkExtractsDeliveryHelper::GetNumberOfQueuedBytes()
+{
+  if (!this->Queue)
+  {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(this->Queue->Mutex);
+  return this->Queue->QueuedBytes;
+}
+
+//----------------------------------------------------------------------------
+vtkIdType vtkExtractsDeliveryHelper::GetNumberOfDroppedFrames()
+{
+  if (!this->Queue)
+  {
+    return 0;
+  }
+  std::lock_guard<std::mutex> lock(this->Queue->Mutex);
+  return this->Queue->DroppedFrames;
+}
+
+//----------------------------------------------------------------------------
+bool vtkExtractsDeliveryHelper::GetDeliveryFailed()
+{
+  if (!this->Queue)
+  {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(this->Queue->Mutex);
+  return this->Queue->Failed;
+}
+
 //----------------------------------------------------------------------------
 void vtkExtractsDeliveryHelper::SetSimulation2VisualizationController(vtkSocketController* cont)
 {
@@ -196,23 +557,34 @@ bool vtkExtractsDeliveryHelper::Update()
     }
 
     vtkSocketController* comm = this->Simulation2VisualizationController;
+    vtkSerializedFrame frame;
     if (comm)
     {
       for (ExtractProducersType::iterator iter = this->ExtractProducers.begin();
            iter != this->ExtractProducers.end(); ++iter)
       {
-        vtkMultiProcessStream stream;
-        stream << iter->first;
-        comm->Send(stream, 1, 12000);
         vtkDataObject* dObj = (M > N)
           ? gathered_extracts[iter->first].GetPointer()
           : iter->second->GetProducer()->GetOutputDataObject(iter->second->GetIndex());
-        comm->Send(dObj, 1, 12001);
+        frame.push_back(Serialize(iter->first, dObj));
+      }
+    }
+
+    if (this->AsynchronousDelivery)
+    {
+      // hand the serialized extracts off to the sending thread.
+      if (!this->Queue)
+      {
+        this->Queue.reset(new vtkExtractsDeliveryHelper::vtkDeliveryQueue());
       }
-      // mark end.
-      vtkMultiProcessStream stream;
-      stream << std::string("null");
-      comm->Send(stream, 1, 12000);
+      this->Queue->Enqueue(this->ParallelController, comm, std::move(frame),
+        this->MaximumNumberOfQueuedFrames, this->DropPolicy, this->CompressExtracts);
+      retVal = !this->GetDeliveryFailed();
+    }
+    else if (comm && !SendFrame(comm, frame, this->CompressExtracts))
+    {
+      vtkErrorMacro("Failed to send extracts to the visualization processes.");
+      retVal = false;
     }
   }
   else
@@ -234,7 +606,7 @@ bool vtkExtractsDeliveryHelper::Update()
           break;
         }
         //        cout << "Received extract for: " << key.c_str() << endl;
-        vtkDataObject* extract = comm->ReceiveDataObject(1, 12001);
+        vtkSmartPointer<vtkDataObject> extract = ReceiveExtract(comm, stream);
         ExtractConsumersType::iterator iter;
         iter = this->ExtractConsumers.find(key);
         if (iter != this->ExtractConsumers.end())
@@ -262,7 +634,6 @@ bool vtkExtractsDeliveryHelper::Update()
             needToShare = 1;
           }
           data_types_stream << key.c_str() << extract->GetClassName() << needToShare;
-          extract->Delete();
         }
       }
       data_types_stream << "null";
@@ -325,4 +696,8 @@ bool vtkExtractsDeliveryHelper::Update()
 void vtkExtractsDeliveryHelper::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "AsynchronousDelivery: " << this->AsynchronousDelivery << endl;
+  os << indent << "MaximumNumberOfQueuedFrames: " << this->MaximumNumberOfQueuedFrames << endl;
+  os << indent << "DropPolicy: " << this->DropPolicy << endl;
+  os << indent << "CompressExtracts: " << this->CompressExtracts << endl;
 }
@@ -15,7 +15,19 @@
 /**
  * @class   vtkExtractsDeliveryHelper
  *
+ * Delivers extracts from the simulation processes to the visualization
+ * processes for Catalyst Live.
  *
+ * By default, extracts are sent during Update(), so the simulation waits for
+ * the visualization processes to receive them. With AsynchronousDelivery, the
+ * simulation processes instead queue the serialized extracts, which a
+ * background thread sends, and resume right away. At most
+ * MaximumNumberOfQueuedFrames frames wait in the queue; when it is full,
+ * either the oldest waiting frame or the new one is dropped, as chosen by
+ * DropPolicy, consistently across simulation processes. The visualization
+ * processes receive an empty frame in place of a dropped one and keep their
+ * previous extracts. Asynchronous delivery requires a connection dedicated to
+ * extracts, which vtkLiveInsituLink sets up when it is enabled.
  */
 
 #ifndef vtkExtractsDeliveryHelper_h
@@ -32,6 +44,7 @@ class vtkSocketController;
 class vtkTrivialProducer;
 
 #include <map>    // needed for typedef
+#include <memory> // needed for std::unique_ptr
 #include <string> // needed for typedef
 
 class VTKREMOTINGLIVE_EXPORT vtkExtractsDeliveryHelper : public vtkObject
@@ -62,7 +75,10 @@ public:
   void AddExtractProducer(const char* key, vtkAlgorithmOutput* producerPort);
 
   /**
-   * Returns true if the data has been made available.
+   * Returns true if the data has been made available. On the simulation
+   * processes, returns false when the extracts could not be sent; with
+   * AsynchronousDelivery, this is detected by the sending thread, which then
+   * reports the error and discards the extracts of this and later updates.
    */
   bool Update();
 
@@ -71,6 +87,67 @@ public:
   vtkSetMacro(NumberOfSimulationProcesses, int);
   vtkGetMacro(NumberOfSimulationProcesses, int);
 
+  //@{
+  /**
+   * When enabled, Update() queues the extracts and returns without waiting for
+   * them to be sent. This is only used on the simulation processes and must be
+   * set before the first Update(). Default is false.
+   */
+  vtkSetMacro(AsynchronousDelivery, bool);
+  vtkGetMacro(AsynchronousDelivery, bool);
+  //@}
+
+  //@{
+  /**
+   * Maximum number of frames, i.e. the extracts of one Update(), waiting to be
+   * sent when AsynchronousDelivery is enabled. Default is 2.
+   */
+  vtkSetClampMacro(MaximumNumberOfQueuedFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedFrames, int);
+  //@}
+
+  enum DropPolicies
+  {
+    DROP_OLDEST = 0,
+    DROP_LATEST = 1
+  };
+
+  //@{
+  /**
+   * Frame dropped when the queue is full: the oldest frame waiting to be
+   * sent, or the frame being queued. Default is DROP_OLDEST.
+   */
+  vtkSetClampMacro(DropPolicy, int, DROP_OLDEST, DROP_LATEST);
+  vtkGetMacro(DropPolicy, int);
+  //@}
+
+  //@{
+  /**
+   * When enabled, extracts are compressed using LZ4 before being sent. This
+   * is only used on the simulation processes. Default is false.
+   */
+  vtkSetMacro(CompressExtracts, bool);
+  vtkGetMacro(CompressExtracts, bool);
+  //@}
+
+  /**
+   * Returns the size, in bytes, of the serialized extracts queued or being
+   * sent when AsynchronousDelivery is enabled.
+   */
+  vtkTypeUInt64 GetNumberOfQueuedBytes();
+
+  /**
+   * Returns the number of frames dropped because the queue was full.
+   */
+  vtkIdType GetNumberOfDroppedFrames();
+
+  /**
+   * Returns true once sending queued extracts failed, e.g. because the
+   * connection to the visualization processes is gone, with
+   * AsynchronousDelivery enabled.
+   */
+  bool GetDeliveryFailed();
+
 protected:
   vtkExtractsDeliveryHelper();
   ~vtkExtractsDeliveryHelper() override;
@@ -94,7 +171,15 @@ protected:
   vtkSmartPointer<vtkSocketController> Simulation2VisualizationController;
   vtkSmartPointer<vtkMultiProcessController> ParallelController;
 
+  bool AsynchronousDelivery;
+  int MaximumNumberOfQueuedFrames;
+  int DropPolicy;
+  bool CompressExtracts;
+
 private:
+  class vtkDeliveryQueue;
+  std::unique_ptr<vtkDeliveryQueue> Queue;
+
   vtkExtractsDeliveryHelper(const vtkExtractsDeliveryHelper&) = delete;
   void operator=(const vtkExtractsDeliveryHelper&) = delete;
 };
@@ -326,6 +326,10 @@ vtkLiveInsituLink::vtkLiveInsituLink()
   , InsituXMLStateChanged(false)
   , ExtractsChanged(false)
   , SimulationPaused(0)
+  , AsynchronousDelivery(false)
+  , MaximumNumberOfQueuedFrames(2)
+  , DropPolicy(vtkExtractsDeliveryHelper::DROP_OLDEST)
+  , CompressExtracts(false)
   , InsituXMLState(nullptr)
   , URL(nullptr)
   , Internals(new vtkInternals())
@@ -563,6 +567,10 @@ void vtkLiveInsituLink::InsituConnect(vtkMultiProcessController* proc0NodesContr
 
   this->ExtractsDeliveryHelper = vtkSmartPointer<vtkExtractsDeliveryHelper>::New();
   this->ExtractsDeliveryHelper->SetProcessIsProducer(this->ProcessType == LIVE ? false : true);
+  this->ExtractsDeliveryHelper->SetAsynchronousDelivery(this->AsynchronousDelivery);
+  this->ExtractsDeliveryHelper->SetMaximumNumberOfQueuedFrames(this->MaximumNumberOfQueuedFrames);
+  this->ExtractsDeliveryHelper->SetDropPolicy(this->DropPolicy);
+  this->ExtractsDeliveryHelper->SetCompressExtracts(this->CompressExtracts);
 
   vtkMultiProcessController* parallelController = vtkMultiProcessController::GetGlobalController();
   int numProcs = parallelController->GetNumberOfProcesses();
@@ -629,9 +637,40 @@ void vtkLiveInsituLink::InsituConnect(vtkMultiProcessController* proc0NodesContr
       assert(num_procs_catalyst > 0 && num_procs_paraview > 0);
       if (myId == 0)
       {
-        // we'll piggy back on proc0NodesController to deliver extracts as well for this rank.
-        this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(
-          vtkSocketController::SafeDownCast(proc0NodesController));
+        int asynchronousDelivery = 0;
+        proc0NodesController->Receive(&asynchronousDelivery, 1, 1, 8004);
+        if (asynchronousDelivery)
+        {
+          // Catalyst sends extracts from a separate thread, which must not
+          // interleave with commands, so use a connection dedicated to them.
+          vtkNew<vtkServerSocket> socket;
+          socket->CreateServer(0);
+
+          vtkMultiProcessStream connectionMsg;
+          connectionMsg << std::string(vtksys::SystemInformation().GetHostname())
+                        << socket->GetServerPort();
+          proc0NodesController->Send(connectionMsg, 1, 98212);
+
+          auto clientSocket = socket->WaitForConnection();
+          if (!clientSocket)
+          {
+            abort();
+          }
+          vtkNew<vtkSocketController> sim2vis;
+          if (auto comm = vtkSocketCommunicator::SafeDownCast(sim2vis->GetCommunicator()))
+          {
+            comm->SetSocket(clientSocket);
+            comm->ServerSideHandshake();
+          }
+          clientSocket->Delete();
+          this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(sim2vis);
+        }
+        else
+        {
+          // we'll piggy back on proc0NodesController to deliver extracts as well for this rank.
+          this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(
+            vtkSocketController::SafeDownCast(proc0NodesController));
+        }
 
         // communicate between satellites to help them setup the catalyst-to-paraview socket
         // connections.
@@ -736,9 +775,30 @@ void vtkLiveInsituLink::InsituConnect(vtkMultiProcessController* proc0NodesContr
       // connect to the sim-nodes for data x'fer.
       if (myId == 0)
       {
-        // we'll piggy back on proc0NodesController to deliver extracts.
-        this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(
-          vtkSocketController::SafeDownCast(proc0NodesController));
+        int asynchronousDelivery = this->AsynchronousDelivery ? 1 : 0;
+        proc0NodesController->Send(&asynchronousDelivery, 1, 1, 8004);
+        if (asynchronousDelivery)
+        {
+          // extracts are sent from a separate thread, connect to the socket
+          // ParaView Live opened for them.
+          vtkMultiProcessStream connectionMsg;
+          proc0NodesController->Receive(connectionMsg, 1, 98212);
+          std::string hostname;
+          int port;
+          connectionMsg >> hostname >> port;
+          vtkNew<vtkSocketController> sim2vis;
+          if (!sim2vis->ConnectTo(hostname.c_str(), port))
+          {
+            abort();
+          }
+          this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(sim2vis);
+        }
+        else
+        {
+          // we'll piggy back on proc0NodesController to deliver extracts.
+          this->ExtractsDeliveryHelper->SetSimulation2VisualizationController(
+            vtkSocketController::SafeDownCast(proc0NodesController));
+        }
 
         // communicate between satellites.
         if (std::min(num_procs_paraview, num_procs_catalyst) > 1)
@@ -1226,6 +1286,16 @@ void vtkLiveInsituLink::UnRegisterExtract(vtkTrivialProducer* producer)
 void vtkLiveInsituLink::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "AsynchronousDelivery: " << this->AsynchronousDelivery << endl;
+  os << indent << "MaximumNumberOfQueuedFrames: " << this->MaximumNumberOfQueuedFrames << endl;
+  os << indent << "DropPolicy: " << this->DropPolicy << endl;
+  os << indent << "CompressExtracts: " << this->CompressExtracts << endl;
+}
+
+//----------------------------------------------------------------------------
+vtkExtractsDeliveryHelper* vtkLiveInsituLink::GetExtractsDeliveryHelper()
+{
+  return this->ExtractsDeliveryHelper;
 }
 //----------------------------------------------------------------------------
 bool vtkLiveInsituLink::FilterXMLState(vtkPVXMLElement* xmlState)
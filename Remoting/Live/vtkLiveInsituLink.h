@@ -109,6 +109,30 @@ public:
   void SetSimulationPaused(int paused);
   //@}
 
+  //@{
+  /**
+   * Extracts delivery settings used on the insitu processes, applied to the
+   * vtkExtractsDeliveryHelper created when connecting to ParaView Live. When
+   * AsynchronousDelivery is enabled, the root insitu process also delivers
+   * extracts on a connection of its own rather than on the one used for
+   * commands. See vtkExtractsDeliveryHelper for details.
+   */
+  vtkSetMacro(AsynchronousDelivery, bool);
+  vtkGetMacro(AsynchronousDelivery, bool);
+  vtkSetClampMacro(MaximumNumberOfQueuedFrames, int, 1, VTK_INT_MAX);
+  vtkGetMacro(MaximumNumberOfQueuedFrames, int);
+  vtkSetClampMacro(DropPolicy, int, 0, 1);
+  vtkGetMacro(DropPolicy, int);
+  vtkSetMacro(CompressExtracts, bool);
+  vtkGetMacro(CompressExtracts, bool);
+  //@}
+
+  /**
+   * Returns the helper delivering extracts while connected, e.g. to get its
+   * queued bytes and dropped frames counters, or nullptr.
+   */
+  vtkExtractsDeliveryHelper* GetExtractsDeliveryHelper();
+
   /**
    * Initializes the link. For in situ this returns true it there is a
    * connection and false otherwise. For live it always returns true.
@@ -242,6 +266,11 @@ protected:
   bool ExtractsChanged;
   int SimulationPaused;
 
+  bool AsynchronousDelivery;
+  int MaximumNumberOfQueuedFrames;
+  int DropPolicy;
+  bool CompressExtracts;
+
   char* InsituXMLState;
   vtkWeakPointer<vtkPVSessionBase> LiveSession;
   /**
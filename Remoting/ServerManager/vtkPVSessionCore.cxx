@@ -26,6 +26,7 @@
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVInformation.h"
+#include "vtkPVLogger.h"
 #include "vtkPVSession.h"
 #include "vtkPVSessionCoreInterpreterHelper.h"
 #include "vtkProcessModule.h"
@@ -42,6 +43,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #define LOG(x)                                                                                     \
   if (this->LogStream)                                                                             \
@@ -827,7 +829,8 @@ bool vtkPVSessionCore::GatherInformation(
     this->ParallelController->TriggerRMIOnAllChildren(&type, 1, ROOT_SATELLITE_RMI_TAG);
 
     vtkMultiProcessStream stream;
-    stream << information->GetClassName() << globalid;
+    stream << information->GetClassName() << globalid
+           << static_cast<int>(information->GetReduceInTree());
 
     // serialize information parameters so all processes have the same ivars.
     information->CopyParametersToStream(stream);
@@ -838,7 +841,13 @@ bool vtkPVSessionCore::GatherInformation(
   // Now collect local information.
   const bool status = this->GatherInformationInternal(information, globalid);
 
-  return (skip_satellites || this->CollectInformation(information)) && status;
+  if (skip_satellites)
+  {
+    return status;
+  }
+  const bool collected = information->GetReduceInTree() ? this->ReduceInformation(information)
+                                                        : this->CollectInformation(information);
+  return collected && status;
 }
 
 //----------------------------------------------------------------------------
@@ -849,22 +858,31 @@ void vtkPVSessionCore::GatherInformationStatelliteCallback()
 
   std::string classname;
   vtkTypeUInt32 globalid;
-  stream >> classname >> globalid;
+  int reduceInTree;
+  stream >> classname >> globalid >> reduceInTree;
 
   vtkSmartPointer<vtkObjectBase> o;
   o.TakeReference(vtkClientServerStreamInstantiator::CreateInstance(classname.c_str()));
   vtkPVInformation* info = vtkPVInformation::SafeDownCast(o);
   if (info)
   {
+    info->SetReduceInTree(reduceInTree != 0);
     info->CopyParametersFromStream(stream);
     this->GatherInformationInternal(info, globalid);
-    this->CollectInformation(info);
   }
   else
   {
     vtkErrorMacro("Could not gather information on Satellite.");
-    // let the parent know, otherwise root will hang.
-    this->CollectInformation(nullptr);
+  }
+
+  // participate in the collection even on failure, otherwise root will hang.
+  if (reduceInTree)
+  {
+    this->ReduceInformation(info);
+  }
+  else
+  {
+    this->CollectInformation(info);
   }
 }
 
@@ -972,6 +990,80 @@ bool vtkPVSessionCore::CollectInformation(vtkPVInformation* info)
   return true;
 }
 
+//----------------------------------------------------------------------------
+bool vtkPVSessionCore::ReduceInformation(vtkPVInformation* info)
+{
+  auto controller = this->ParallelController;
+  const int rank = controller->GetLocalProcessId();
+  const int nranks = controller->GetNumberOfProcesses();
+  if (nranks == 1)
+  {
+    /* short-circuit */
+    return true;
+  }
+
+  // Binomial tree: at level `step`, every rank that is a multiple of
+  // `2 * step` merges the partial result accumulated by `rank + step`, while
+  // that rank sends its partial result up and is done. Partial results are
+  // always merged in rank order, hence the root ends up with the same result
+  // as with the GatherV-based CollectInformation() as long as
+  // vtkPVInformation::AddInformation() is associative, but no rank ever
+  // merges more than log2(nranks) partial results.
+  vtkVLogScopeF(PARAVIEW_LOG_APPLICATION_VERBOSITY(), "reduce information `%s` in tree",
+    info ? info->GetClassName() : "(nullptr)");
+  for (int step = 1; step < nranks; step *= 2)
+  {
+    if (rank % (2 * step) != 0)
+    {
+      vtkClientServerStream stream;
+      if (info)
+      {
+        info->CopyToStream(&stream);
+      }
+
+      const unsigned char* data;
+      size_t length;
+      stream.GetData(&data, &length);
+
+      // an empty stream tells the parent that gathering failed on this rank.
+      vtkIdType local_length = info ? static_cast<vtkIdType>(length) : 0;
+      controller->Send(&local_length, 1, rank - step, ROOT_SATELLITE_INFO_TAG);
+      if (local_length > 0)
+      {
+        controller->Send(data, local_length, rank - step, ROOT_SATELLITE_INFO_TAG);
+      }
+      break;
+    }
+
+    const int child = rank + step;
+    if (child < nranks)
+    {
+      vtkIdType rcv_length = 0;
+      controller->Receive(&rcv_length, 1, child, ROOT_SATELLITE_INFO_TAG);
+      if (rcv_length <= 0)
+      {
+        continue;
+      }
+
+      std::vector<unsigned char> rcvbuffer(rcv_length);
+      controller->Receive(rcvbuffer.data(), rcv_length, child, ROOT_SATELLITE_INFO_TAG);
+      if (info)
+      {
+        vtkClientServerStream rcvStream;
+        rcvStream.SetData(rcvbuffer.data(), rcvbuffer.size());
+        vtkSmartPointer<vtkPVInformation> tempInfo;
+        tempInfo.TakeReference(info->NewInstance());
+        tempInfo->CopyFromStream(&rcvStream);
+        info->AddInformation(tempInfo);
+      }
+    }
+  }
+
+  // Barrier synchronization, same as CollectInformation().
+  controller->Barrier();
+  return true;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionCore::RegisterRemoteObject(vtkTypeUInt32 gid, vtkObject* obj)
 {
@@ -215,6 +215,13 @@ protected:
    */
   bool CollectInformation(vtkPVInformation*);
 
+  /**
+   * Gather information across MPI satellites by merging partial results up a
+   * binary tree rooted at rank 0. Used instead of CollectInformation() for
+   * information objects with vtkPVInformation::GetReduceInTree() set.
+   */
+  bool ReduceInformation(vtkPVInformation*);
+
   /**
    * Increment reference count of a local vtkSIObject.
    */
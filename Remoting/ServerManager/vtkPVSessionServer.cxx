@@ -525,22 +525,7 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     {
       std::string string;
       stream >> string;
-      vtkSMMessage msg;
-      msg.ParseFromString(string);
-
-      //      cout << "=================================" << endl;
-      //      msg.PrintDebugString();
-      //      cout << "=================================" << endl;
-
-      // Do we skip the processing ?
-      if (!this->Internal->StoreShareOnly(&msg))
-      {
-        this->PushState(&msg);
-      }
-
-      // Notify when ProxyManager state has changed
-      // or any other state change
-      this->NotifyOtherClients(&msg);
+      this->PushStateInternal(string);
     }
     break;
 
@@ -602,6 +587,60 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
     }
     break;
 
+    case vtkPVSessionServer::BATCH:
+    {
+      // Messages queued by the client while batching, in the order they were
+      // issued. Streams are sent inline rather than with a separate
+      // EXECUTE_STREAM_TAG message.
+      int count;
+      stream >> count;
+      for (int cc = 0; cc < count; ++cc)
+      {
+        int subtype;
+        stream >> subtype;
+        if (subtype == vtkPVSessionServer::PUSH)
+        {
+          std::string string;
+          stream >> string;
+          this->PushStateInternal(string);
+        }
+        else if (subtype == vtkPVSessionServer::REGISTER_SI ||
+          subtype == vtkPVSessionServer::UNREGISTER_SI)
+        {
+          std::string string;
+          stream >> string;
+          vtkSMMessage msg;
+          msg.ParseFromString(string);
+          if (subtype == vtkPVSessionServer::REGISTER_SI)
+          {
+            this->RegisterSIObject(&msg);
+          }
+          else
+          {
+            this->UnRegisterSIObject(&msg);
+          }
+        }
+        else if (subtype == vtkPVSessionServer::EXECUTE_STREAM)
+        {
+          int ignore_errors;
+          stream >> ignore_errors;
+          unsigned char* css_data = nullptr;
+          unsigned int size = 0;
+          stream.Pop(css_data, size);
+          vtkClientServerStream cssStream;
+          cssStream.SetData(css_data, size);
+          this->ExecuteStream(vtkPVSession::CLIENT_AND_SERVERS, cssStream, ignore_errors != 0);
+          delete[] css_data;
+        }
+        else
+        {
+          vtkErrorMacro("Unexpected message in batch: " << subtype);
+          break;
+        }
+      }
+    }
+    break;
+
     case vtkPVSessionServer::GATHER_INFORMATION:
     {
       std::string classname;
@@ -613,6 +652,23 @@ void vtkPVSessionServer::OnClientServerMessageRMI(void* message, int message_len
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkPVSessionServer::PushStateInternal(const std::string& message)
+{
+  vtkSMMessage msg;
+  msg.ParseFromString(message);
+
+  // Do we skip the processing ?
+  if (!this->Internal->StoreShareOnly(&msg))
+  {
+    this->PushState(&msg);
+  }
+
+  // Notify when ProxyManager state has changed
+  // or any other state change
+  this->NotifyOtherClients(&msg);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVSessionServer::SendLastResultToClient()
 {
@@ -641,6 +697,9 @@ void vtkPVSessionServer::GatherInformationInternal(vtkTypeUInt32 location, const
   {
     // ensures that the vtkPVInformation has the same ivars locally as on the
     // client.
+    int reduceInTree;
+    stream >> reduceInTree;
+    info->SetReduceInTree(reduceInTree != 0);
     info->CopyParametersFromStream(stream);
 
     this->GatherInformation(location, info, globalid);
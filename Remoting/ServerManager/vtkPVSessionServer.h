@@ -27,6 +27,7 @@
 
 #include "vtkPVSessionBase.h"
 #include "vtkRemotingServerManagerModule.h" //needed for exports
+#include <string>                           // for std::string
 
 class vtkMultiProcessController;
 class vtkMultiProcessStream;
@@ -83,6 +84,7 @@ public:
     REGISTER_SI = 16,
     UNREGISTER_SI = 17,
     LAST_RESULT = 18,
+    BATCH = 19,
     SERVER_NOTIFICATION_MESSAGE_RMI = 55624,
     CLIENT_SERVER_MESSAGE_RMI = 55625,
     CLOSE_SESSION = 55626,
@@ -151,6 +153,12 @@ protected:
    */
   void SendLastResultToClient();
 
+  /**
+   * Called when client triggers PushState(), either directly or as part of a
+   * batch of messages.
+   */
+  void PushStateInternal(const std::string& message);
+
   vtkMPIMToNSocketConnection* MPIMToNSocketConnection;
 
   bool MultipleConnection;
@@ -631,6 +631,10 @@ void vtkSMProxy::UpdatePropertyInformationInternal(vtkSMProperty* single_propert
 //---------------------------------------------------------------------------
 void vtkSMProxy::UpdateVTKObjects()
 {
+  // coalesce the pushes for this proxy, its subproxies and anything they
+  // trigger into a single message to the server(s).
+  vtkSMSessionBatchScope batch(this->GetSession());
+
   this->CreateVTKObjects();
   if (!this->ObjectsCreated || this->InUpdateVTKObjects || !this->ArePropertiesModified() ||
     this->Location == 0)
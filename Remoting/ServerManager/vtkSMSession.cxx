@@ -65,6 +65,8 @@ vtkSMSession::vtkSMSession(bool initialize_during_constructor /*=true*/,
 
   this->SessionProxyManager = nullptr;
   this->StateLocator = vtkSMStateLocator::New();
+  this->BatchDepth = 0;
+  this->UseBatchedPushes = true;
 
   // Create and setup deserializer for the local ProxyLocator
   vtkNew<vtkSMDeserializerProtobuf> deserializer;
@@ -124,6 +126,41 @@ void vtkSMSession::PushState(vtkSMMessage* msg)
   this->Superclass::PushState(msg);
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSession::BeginBatch()
+{
+  this->BatchDepth++;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::EndBatch()
+{
+  if (this->BatchDepth <= 0)
+  {
+    vtkErrorMacro("EndBatch() called without a matching BeginBatch().");
+    return;
+  }
+  if (this->BatchDepth == 1)
+  {
+    this->FlushBatch();
+  }
+  this->BatchDepth--;
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSession::SetUseBatchedPushes(bool use)
+{
+  if (this->UseBatchedPushes != use)
+  {
+    if (!use)
+    {
+      this->FlushBatch();
+    }
+    this->UseBatchedPushes = use;
+    this->Modified();
+  }
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSession::UpdateStateHistory(vtkSMMessage* msg)
 {
@@ -213,6 +250,8 @@ bool vtkSMSession::IsMPIInitialized(vtkTypeUInt32)
 void vtkSMSession::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseBatchedPushes: " << this->UseBatchedPushes << endl;
+  os << indent << "BatchDepth: " << this->BatchDepth << endl;
 }
 
 //----------------------------------------------------------------------------
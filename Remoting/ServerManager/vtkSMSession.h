@@ -107,6 +107,41 @@ public:
    */
   virtual unsigned int GetRenderClientMode();
 
+  //---------------------------------------------------------------------------
+  // API for batching state pushes.
+  //---------------------------------------------------------------------------
+
+  //@{
+  /**
+   * Begin/End a batch. While a batch is open, sessions connected to a remote
+   * server queue the server-side part of PushState() and ExecuteStream() calls
+   * and send them as a single message when the outermost batch ends, instead
+   * of one message per call. Anything that needs a reply from the server
+   * (PullState(), GatherInformation(), etc.) or that runs on the client first
+   * sends the queued messages, so the order of execution is unchanged.
+   * Batches nest; calls must be balanced. Use vtkSMSessionBatchScope to ensure
+   * that. The builtin session executes everything immediately.
+   */
+  void BeginBatch();
+  void EndBatch();
+  //@}
+
+  /**
+   * Returns true if a batch is open and UseBatchedPushes is enabled.
+   */
+  bool IsBatching() const { return this->BatchDepth > 0 && this->UseBatchedPushes; }
+
+  //@{
+  /**
+   * Enable/disable batching. When disabled, BeginBatch()/EndBatch() are
+   * no-ops. Mainly meant to compare the number of messages sent with and
+   * without batching. Disabling it sends any queued messages. Default is true.
+   */
+  void SetUseBatchedPushes(bool);
+  vtkGetMacro(UseBatchedPushes, bool);
+  vtkBooleanMacro(UseBatchedPushes, bool);
+  //@}
+
   //---------------------------------------------------------------------------
   // Undo/Redo related API.
   //---------------------------------------------------------------------------
@@ -321,13 +356,54 @@ protected:
    */
   void UpdateStateHistory(vtkSMMessage* msg);
 
+  /**
+   * Called when IsBatching() is about to become false, to send the queued
+   * messages. Does nothing by default.
+   */
+  virtual void FlushBatch() {}
+
   vtkSMSessionProxyManager* SessionProxyManager;
   vtkSMStateLocator* StateLocator;
   vtkSMProxyLocator* ProxyLocator;
 
+  int BatchDepth;
+  bool UseBatchedPushes;
+
 private:
   vtkSMSession(const vtkSMSession&) = delete;
   void operator=(const vtkSMSession&) = delete;
 };
 
+#if !defined(__VTK_WRAP__)
+/**
+ * vtkSMSessionBatchScope is a helper to open a batch on a session for the
+ * lifetime of the scope. It does nothing if the session is nullptr.
+ */
+class vtkSMSessionBatchScope
+{
+public:
+  vtkSMSessionBatchScope(vtkSMSession* session)
+    : Session(session)
+  {
+    if (this->Session)
+    {
+      this->Session->BeginBatch();
+    }
+  }
+  ~vtkSMSessionBatchScope()
+  {
+    if (this->Session)
+    {
+      this->Session->EndBatch();
+    }
+  }
+
+private:
+  vtkSMSessionBatchScope(const vtkSMSessionBatchScope&) = delete;
+  void operator=(const vtkSMSessionBatchScope&) = delete;
+
+  vtkSMSession* Session;
+};
+#endif
+
 #endif
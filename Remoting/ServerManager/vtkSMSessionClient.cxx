@@ -62,6 +62,24 @@ void RMICallback(
   self->OnServerNotificationMessageRMI(remoteArg, remoteArgLength);
 }
 };
+
+//****************************************************************************/
+class vtkSMSessionClient::vtkInternals
+{
+public:
+  struct QueuedMessage
+  {
+    int Type;
+    int IgnoreErrors;
+    std::string Message;
+    std::vector<unsigned char> Data;
+  };
+
+  // Messages queued while batching, for the data-server (0) and the
+  // render-server (1) connections.
+  std::vector<QueuedMessage> Queues[2];
+};
+
 //****************************************************************************/
 vtkStandardNewMacro(vtkSMSessionClient);
 vtkCxxSetObjectMacro(vtkSMSessionClient, RenderServerController, vtkMultiProcessController);
@@ -93,6 +111,8 @@ vtkSMSessionClient::vtkSMSessionClient()
   // Default value
   this->NoMoreDelete = false;
   this->NotBusy = 0;
+  this->NumberOfMessagesSent = 0;
+  this->Internals = new vtkInternals();
 }
 
 //----------------------------------------------------------------------------
@@ -121,11 +141,17 @@ vtkSMSessionClient::~vtkSMSessionClient()
 
   delete this->ServerLastInvokeResult;
   this->ServerLastInvokeResult = nullptr;
+  delete this->Internals;
+  this->Internals = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkMultiProcessController* vtkSMSessionClient::GetController(ServerFlags processType)
 {
+  // the caller may communicate with the server directly, so it must not get
+  // ahead of the queued messages.
+  this->FlushBatch();
+
   switch (processType)
   {
     case CLIENT:
@@ -534,6 +560,7 @@ bool vtkSMSessionClient::IsMPIInitialized(vtkTypeUInt32 servers)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::CloseSession()
 {
+  this->FlushBatch();
   if (this->DataServerController)
   {
     this->DataServerController->TriggerRMIOnAllChildren(vtkPVSessionServer::CLOSE_SESSION);
@@ -597,7 +624,15 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->IsBatching())
+  {
+    const std::string string = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->QueueMessage(controllers[cc], vtkPVSessionServer::PUSH, string);
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::PUSH);
@@ -606,8 +641,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
     stream.GetRawData(raw_message);
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->TriggerClientServerMessage(controllers[cc], raw_message);
     }
   }
 
@@ -639,13 +673,20 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
         msg.set_share_only(true);
         msg.set_client_id(this->ServerInformation->GetClientId());
 
-        vtkMultiProcessStream stream;
-        stream << static_cast<int>(vtkPVSessionServer::PUSH);
-        stream << msg.SerializeAsString();
-        std::vector<unsigned char> raw_message;
-        stream.GetRawData(raw_message);
-        this->DataServerController->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        if (this->IsBatching())
+        {
+          this->QueueMessage(
+            this->DataServerController, vtkPVSessionServer::PUSH, msg.SerializeAsString());
+        }
+        else
+        {
+          vtkMultiProcessStream stream;
+          stream << static_cast<int>(vtkPVSessionServer::PUSH);
+          stream << msg.SerializeAsString();
+          std::vector<unsigned char> raw_message;
+          stream.GetRawData(raw_message);
+          this->TriggerClientServerMessage(this->DataServerController, raw_message);
+        }
       }
       else if (!remoteObject)
       {
@@ -670,6 +711,7 @@ void vtkSMSessionClient::PushState(vtkSMMessage* message)
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PullState(vtkSMMessage* message)
 {
+  this->FlushBatch();
   this->StartBusyWork();
   vtkTypeUInt32 location = this->GetRealLocation(message->location());
   message->set_location(location);
@@ -698,8 +740,7 @@ void vtkSMSessionClient::PullState(vtkSMMessage* message)
     stream << message->SerializeAsString();
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    this->TriggerClientServerMessage(controller, raw_message);
 
     // Get the reply
     vtkMultiProcessStream replyStream;
@@ -739,6 +780,18 @@ void vtkSMSessionClient::ExecuteStream(
     controllers[num_controllers++] = this->RenderServerController;
   }
 
+  // What executes on the client may wait on the server, e.g. for data
+  // delivery, so such streams are never queued.
+  if (num_controllers > 0 && this->IsBatching() && (location & vtkPVSession::CLIENT) == 0)
+  {
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->QueueStream(controllers[cc], cssstream, ignore_errors);
+    }
+    return;
+  }
+
+  this->FlushBatch();
   if (num_controllers > 0)
   {
     const unsigned char* data;
@@ -753,8 +806,7 @@ void vtkSMSessionClient::ExecuteStream(
 
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->TriggerClientServerMessage(controllers[cc], raw_message);
       controllers[cc]->Send(
         data, static_cast<int>(size), 1, vtkPVSessionServer::EXECUTE_STREAM_TAG);
     }
@@ -769,6 +821,7 @@ void vtkSMSessionClient::ExecuteStream(
 //----------------------------------------------------------------------------
 const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 location)
 {
+  this->FlushBatch();
   this->StartBusyWork();
   location = this->GetRealLocation(location);
 
@@ -795,8 +848,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
     stream << static_cast<int>(vtkPVSessionServer::LAST_RESULT);
     std::vector<unsigned char> raw_message;
     stream.GetRawData(raw_message);
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    this->TriggerClientServerMessage(controller, raw_message);
 
     // Get the reply
     int size = 0;
@@ -817,6 +869,7 @@ const vtkClientServerStream& vtkSMSessionClient::GetLastResult(vtkTypeUInt32 loc
 bool vtkSMSessionClient::GatherInformation(
   vtkTypeUInt32 location, vtkPVInformation* information, vtkTypeUInt32 globalid)
 {
+  this->FlushBatch();
   this->StartBusyWork();
   if (this->RenderServerController == nullptr)
   {
@@ -847,7 +900,8 @@ bool vtkSMSessionClient::GatherInformation(
 
   vtkMultiProcessStream stream;
   stream << static_cast<int>(vtkPVSessionServer::GATHER_INFORMATION) << location
-         << information->GetClassName() << globalid;
+         << information->GetClassName() << globalid
+         << static_cast<int>(information->GetReduceInTree());
   information->CopyParametersToStream(stream);
   std::vector<unsigned char> raw_message;
   stream.GetRawData(raw_message);
@@ -869,8 +923,7 @@ bool vtkSMSessionClient::GatherInformation(
 
   if (controller)
   {
-    controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
-      vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+    this->TriggerClientServerMessage(controller, raw_message);
 
     int length2 = 0;
     controller->Receive(&length2, 1, 1, vtkPVSessionServer::REPLY_GATHER_INFORMATION_TAG);
@@ -930,7 +983,15 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->IsBatching())
+  {
+    const std::string string = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->QueueMessage(controllers[cc], vtkPVSessionServer::UNREGISTER_SI, string);
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::UNREGISTER_SI);
@@ -939,8 +1000,7 @@ void vtkSMSessionClient::UnRegisterSIObject(vtkSMMessage* message)
     stream.GetRawData(raw_message);
     for (int cc = 0; cc < num_controllers; cc++)
     {
-      controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-        static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+      this->TriggerClientServerMessage(controllers[cc], raw_message);
     }
   }
 
@@ -971,7 +1031,15 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   {
     controllers[num_controllers++] = this->RenderServerController;
   }
-  if (num_controllers > 0)
+  if (num_controllers > 0 && this->IsBatching())
+  {
+    const std::string string = message->SerializeAsString();
+    for (int cc = 0; cc < num_controllers; cc++)
+    {
+      this->QueueMessage(controllers[cc], vtkPVSessionServer::REGISTER_SI, string);
+    }
+  }
+  else if (num_controllers > 0)
   {
     vtkMultiProcessStream stream;
     stream << static_cast<int>(vtkPVSessionServer::REGISTER_SI);
@@ -982,8 +1050,7 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
     {
       if (controllers[cc] != nullptr)
       {
-        controllers[cc]->TriggerRMIOnAllChildren(&raw_message[0],
-          static_cast<int>(raw_message.size()), vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+        this->TriggerClientServerMessage(controllers[cc], raw_message);
       }
     }
   }
@@ -994,10 +1061,81 @@ void vtkSMSessionClient::RegisterSIObject(vtkSMMessage* message)
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::QueueMessage(
+  vtkMultiProcessController* controller, int type, const std::string& message)
+{
+  vtkInternals::QueuedMessage item;
+  item.Type = type;
+  item.IgnoreErrors = 0;
+  item.Message = message;
+  this->Internals->Queues[controller == this->DataServerController ? 0 : 1].push_back(item);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::QueueStream(
+  vtkMultiProcessController* controller, const vtkClientServerStream& stream, bool ignore_errors)
+{
+  const unsigned char* data;
+  size_t size;
+  stream.GetData(&data, &size);
+
+  vtkInternals::QueuedMessage item;
+  item.Type = vtkPVSessionServer::EXECUTE_STREAM;
+  item.IgnoreErrors = static_cast<int>(ignore_errors);
+  item.Data.assign(data, data + size);
+  this->Internals->Queues[controller == this->DataServerController ? 0 : 1].push_back(item);
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::FlushBatch()
+{
+  vtkMultiProcessController* controllers[2] = { this->DataServerController,
+    this->RenderServerController };
+  for (int cc = 0; cc < 2; cc++)
+  {
+    std::vector<vtkInternals::QueuedMessage> queue;
+    queue.swap(this->Internals->Queues[cc]);
+    if (queue.empty() || controllers[cc] == nullptr)
+    {
+      continue;
+    }
+
+    vtkMultiProcessStream stream;
+    stream << static_cast<int>(vtkPVSessionServer::BATCH) << static_cast<int>(queue.size());
+    for (auto& item : queue)
+    {
+      stream << item.Type;
+      if (item.Type == vtkPVSessionServer::EXECUTE_STREAM)
+      {
+        stream << item.IgnoreErrors;
+        stream.Push(item.Data.data(), static_cast<unsigned int>(item.Data.size()));
+      }
+      else
+      {
+        stream << item.Message;
+      }
+    }
+    std::vector<unsigned char> raw_message;
+    stream.GetRawData(raw_message);
+    this->TriggerClientServerMessage(controllers[cc], raw_message);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkSMSessionClient::TriggerClientServerMessage(
+  vtkMultiProcessController* controller, std::vector<unsigned char>& raw_message)
+{
+  controller->TriggerRMIOnAllChildren(&raw_message[0], static_cast<int>(raw_message.size()),
+    vtkPVSessionServer::CLIENT_SERVER_MESSAGE_RMI);
+  this->NumberOfMessagesSent++;
+}
+
 //----------------------------------------------------------------------------
 void vtkSMSessionClient::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfMessagesSent: " << this->NumberOfMessagesSent << endl;
 }
 //----------------------------------------------------------------------------
 vtkTypeUInt32 vtkSMSessionClient::GetNextGlobalUniqueIdentifier()
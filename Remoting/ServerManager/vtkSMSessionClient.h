@@ -25,6 +25,8 @@
 
 #include "vtkRemotingServerManagerModule.h" //needed for exports
 #include "vtkSMSession.h"
+#include <string> // for std::string
+#include <vector> // for std::vector
 
 class vtkMultiProcessController;
 class vtkPVServerInformation;
@@ -226,6 +228,13 @@ public:
 
   void OnServerNotificationMessageRMI(void* message, int message_length);
 
+  /**
+   * Returns the number of client-server messages sent to the server(s) so far,
+   * counting one per message per server connection. A batch counts as a
+   * single message. Useful to measure the effect of batching.
+   */
+  vtkGetMacro(NumberOfMessagesSent, vtkIdType);
+
 protected:
   vtkSMSessionClient();
   ~vtkSMSessionClient() override;
@@ -285,13 +294,36 @@ protected:
    */
   virtual void OnConnectionLost(vtkObject* caller, unsigned long eventid, void* calldata);
 
+  /**
+   * Sends the messages queued while batching.
+   */
+  void FlushBatch() override;
+
 private:
   vtkSMSessionClient(const vtkSMSessionClient&) = delete;
   void operator=(const vtkSMSessionClient&) = delete;
 
+  /**
+   * Queue a message (PUSH, REGISTER_SI or UNREGISTER_SI) or a stream to
+   * execute for the given controller, to be sent by FlushBatch().
+   */
+  void QueueMessage(vtkMultiProcessController* controller, int type, const std::string& message);
+  void QueueStream(vtkMultiProcessController* controller, const vtkClientServerStream& stream,
+    bool ignore_errors);
+
+  /**
+   * Triggers CLIENT_SERVER_MESSAGE_RMI on the controller with the given message.
+   */
+  void TriggerClientServerMessage(
+    vtkMultiProcessController* controller, std::vector<unsigned char>& raw_message);
+
   int NotBusy;
   vtkTypeUInt32 LastGlobalID;
   vtkTypeUInt32 LastGlobalIDAvailable;
+  vtkIdType NumberOfMessagesSent;
+
+  class vtkInternals;
+  vtkInternals* Internals;
 };
 
 #endif
@@ -39,6 +39,7 @@
 #include "vtkSMProxyManager.h"
 #include "vtkSMProxyProperty.h"
 #include "vtkSMProxySelectionModel.h"
+#include "vtkSMSession.h"
 #include "vtkSMSessionClient.h"
 #include "vtkSMSettingsProxy.h"
 #include "vtkSMStateLoader.h"
@@ -1230,6 +1231,9 @@ void vtkSMSessionProxyManager::LoadXMLState(vtkPVXMLElement* rootElement,
     return;
   }
 
+  // send the pushes for all proxies in the state as few messages as possible.
+  vtkSMSessionBatchScope batch(this->GetSession());
+
   bool prev = this->InLoadXMLState;
   this->InLoadXMLState = true;
   vtkSmartPointer<vtkSMStateLoader> spLoader;
@@ -165,6 +165,29 @@ bool vtkPVGeneralSettings::GetCacheGeometryForAnimation()
 #endif
 }
 
+//----------------------------------------------------------------------------
+void vtkPVGeneralSettings::SetAnimationPrefetchCount(int val)
+{
+  (void)val;
+#if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
+  if (vtkSMAnimationScene::GetGlobalPrefetchCount() != val)
+  {
+    vtkSMAnimationScene::SetGlobalPrefetchCount(val);
+    this->Modified();
+  }
+#endif
+}
+
+//----------------------------------------------------------------------------
+int vtkPVGeneralSettings::GetAnimationPrefetchCount()
+{
+#if VTK_MODULE_ENABLE_ParaView_RemotingAnimation
+  return vtkSMAnimationScene::GetGlobalPrefetchCount();
+#else
+  return 0;
+#endif
+}
+
 //----------------------------------------------------------------------------
 void vtkPVGeneralSettings::SetAnimationGeometryCacheLimit(unsigned long val)
 {
@@ -302,6 +325,7 @@ void vtkPVGeneralSettings::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "ScalarBarMode: " << this->ScalarBarMode << "\n";
   os << indent << "CacheGeometryForAnimation: " << this->CacheGeometryForAnimation << "\n";
   os << indent << "AnimationGeometryCacheLimit: " << this->AnimationGeometryCacheLimit << "\n";
+  os << indent << "AnimationPrefetchCount: " << this->GetAnimationPrefetchCount() << "\n";
   os << indent << "PropertiesPanelMode: " << this->PropertiesPanelMode << "\n";
   os << indent << "LockPanels: " << this->LockPanels << "\n";
 }
@@ -139,6 +139,15 @@ public:
   bool GetCacheGeometryForAnimation();
   //@}
 
+  //@{
+  /**
+   * Set the number of timesteps to prefetch on the server while playing an
+   * animation with geometry caching enabled.
+   */
+  void SetAnimationPrefetchCount(int val);
+  int GetAnimationPrefetchCount();
+  //@}
+
   //@{
   /**
    * Set the animation cache limit in KBs.
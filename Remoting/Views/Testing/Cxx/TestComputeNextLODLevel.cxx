@@ -0,0 +1,86 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestComputeNextLODLevel.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkInitializationHelper.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVRenderView.h"
+#include "vtkProcessModule.h"
+#include "vtkSMSession.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+bool Test()
+{
+  vtkNew<vtkPVRenderView> view;
+  view->SetLODTargetFrameTime(0.1);
+
+  // with a single level, there is nothing to pick from.
+  VERIFY(view->ComputeNextLODLevel(10.0) == 0, "Expected level 0 with a single level.");
+  VERIFY(view->ComputeNextLODLevel(0.0) == 0, "Expected level 0 with a single level.");
+
+  view->SetNumberOfLODLevels(3);
+  view->SetLODLevel(0);
+  VERIFY(view->ComputeNextLODLevel(0.2) == 1, "Expected a coarser level for a slow frame.");
+  VERIFY(view->ComputeNextLODLevel(0.08) == 0, "Expected the same level within the target.");
+  VERIFY(view->ComputeNextLODLevel(0.01) == 0, "Expected level 0 to be the finest.");
+
+  // the level changes by one step at a time.
+  view->SetLODLevel(1);
+  VERIFY(view->ComputeNextLODLevel(10.0) == 2, "Expected one step coarser.");
+  VERIFY(view->ComputeNextLODLevel(0.0) == 0, "Expected one step finer.");
+
+  // refining needs a frame faster than half the target, to not alternate
+  // between two levels.
+  VERIFY(view->ComputeNextLODLevel(0.1) == 1, "Expected the same level at the target.");
+  VERIFY(view->ComputeNextLODLevel(0.06) == 1, "Expected the same level above half the target.");
+  VERIFY(view->ComputeNextLODLevel(0.04) == 0, "Expected a finer level below half the target.");
+
+  view->SetLODLevel(2);
+  VERIFY(view->ComputeNextLODLevel(10.0) == 2, "Expected the coarsest level to be the last one.");
+
+  // a level left over from more levels is clamped to the coarsest one.
+  view->SetNumberOfLODLevels(2);
+  VERIFY(view->ComputeNextLODLevel(0.08) == 1, "Expected the level to be clamped.");
+  VERIFY(view->ComputeNextLODLevel(0.01) == 0, "Expected a finer level than the clamped one.");
+  return true;
+}
+}
+
+int TestComputeNextLODLevel(int vtkNotUsed(argc), char* argv[])
+{
+  vtkInitializationHelper::SetApplicationName("TestComputeNextLODLevel");
+  vtkInitializationHelper::SetOrganizationName("Humanity");
+  vtkInitializationHelper::Initialize(argv[0], vtkProcessModule::PROCESS_CLIENT);
+
+  bool success;
+  {
+    vtkNew<vtkSMSession> session;
+    vtkProcessModule::GetProcessModule()->RegisterSession(session);
+    session->Activate();
+    success = Test();
+    session->DeActivate();
+    vtkProcessModule::GetProcessModule()->UnRegisterSession(session);
+  }
+
+  vtkInitializationHelper::Finalize();
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,134 @@
+/*=========================================================================
+
+Program:   ParaView
+Module:    TestProminentValuesInformation.cxx
+
+Copyright (c) Kitware, Inc.
+All rights reserved.
+See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+This software is distributed WITHOUT ANY WARRANTY; without even
+the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkAbstractArray.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkNew.h"
+#include "vtkPVProminentValuesInformation.h"
+#include "vtkSmartPointer.h"
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Returns the number of prominent values found for `component`, -1 if none.
+vtkIdType GetNumberOfValues(vtkPVProminentValuesInformation* info, int component)
+{
+  vtkSmartPointer<vtkAbstractArray> values;
+  values.TakeReference(info->GetProminentComponentValues(component));
+  return values ? values->GetNumberOfTuples() : -1;
+}
+
+vtkSmartPointer<vtkPVProminentValuesInformation> Collect(
+  vtkAbstractArray* array, double uncertainty, double fraction, bool force = false)
+{
+  auto info = vtkSmartPointer<vtkPVProminentValuesInformation>::New();
+  info->SetNumberOfComponents(array->GetNumberOfComponents());
+  info->SetUncertainty(uncertainty);
+  info->SetFraction(fraction);
+  info->SetForce(force);
+  info->CopyDistinctValuesFromObject(array);
+  return info;
+}
+
+bool TestCategorical()
+{
+  // 5 values making up 20% of the array each, and 1 rare value.
+  vtkNew<vtkIntArray> array;
+  array->SetNumberOfTuples(1000000);
+  for (vtkIdType cc = 0; cc < array->GetNumberOfTuples(); ++cc)
+  {
+    array->SetValue(cc, static_cast<int>(cc % 5));
+  }
+  array->SetValue(12345, 100);
+
+  // inspecting every value finds the rare one too.
+  auto info = Collect(array, 0., 0.);
+  VERIFY(info->GetValid(), "expected valid information.");
+  VERIFY(GetNumberOfValues(info, 0) == 6, "expected all 6 values.");
+
+  // sampling finds all prominent values.
+  info = Collect(array, 1e-6, 1e-3);
+  VERIFY(info->GetValid(), "expected valid information.");
+  VERIFY(GetNumberOfValues(info, 0) >= 5, "expected the 5 prominent values.");
+  return true;
+}
+
+bool TestTooManyValues()
+{
+  vtkNew<vtkIntArray> array;
+  array->SetNumberOfComponents(2);
+  array->SetNumberOfTuples(100000);
+  for (vtkIdType cc = 0; cc < array->GetNumberOfTuples(); ++cc)
+  {
+    array->SetTypedComponent(cc, 0, static_cast<int>(cc % 1000));
+    array->SetTypedComponent(cc, 1, static_cast<int>(cc % 1000 % 3));
+  }
+
+  // the first component, and so the tuples, have too many values.
+  auto info = Collect(array, 0., 0.);
+  VERIFY(!info->GetValid(), "expected invalid information.");
+  VERIFY(GetNumberOfValues(info, -1) == -1 && GetNumberOfValues(info, 0) == -1,
+    "expected no values for the tuples and the first component.");
+  VERIFY(GetNumberOfValues(info, 1) == 3, "expected 3 values for the second component.");
+
+  // unless forced.
+  info = Collect(array, 0., 0., true);
+  VERIFY(info->GetValid(), "expected valid information.");
+  VERIFY(GetNumberOfValues(info, -1) == 1000 && GetNumberOfValues(info, 0) == 1000,
+    "expected 1000 values for the tuples and the first component.");
+  return true;
+}
+
+bool TestMerge()
+{
+  vtkNew<vtkIntArray> array0;
+  vtkNew<vtkIntArray> array1;
+  for (int cc = 0; cc < 20; ++cc)
+  {
+    array0->InsertNextValue(cc);
+    array1->InsertNextValue(cc + 10);
+  }
+
+  // 30 distinct values fit within the limit.
+  auto info = Collect(array0, 0., 0.);
+  info->AddInformation(Collect(array1, 0., 0.));
+  VERIFY(info->GetValid() && GetNumberOfValues(info, 0) == 30, "expected 30 values.");
+
+  // 40 do not, and merging stops once they are exceeded.
+  array1->Initialize();
+  for (int cc = 0; cc < 20; ++cc)
+  {
+    array1->InsertNextValue(cc + 20);
+  }
+  info = Collect(array0, 0., 0.);
+  info->AddInformation(Collect(array1, 0., 0.));
+  VERIFY(!info->GetValid() && GetNumberOfValues(info, 0) == -1, "expected too many values.");
+  info->AddInformation(Collect(array0, 0., 0.));
+  VERIFY(!info->GetValid() && GetNumberOfValues(info, 0) == -1, "expected too many values.");
+  return true;
+}
+}
+
+int TestProminentValuesInformation(int, char*[])
+{
+  return TestCategorical() && TestTooManyValues() && TestMerge() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
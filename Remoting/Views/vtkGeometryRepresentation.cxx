@@ -18,7 +18,9 @@
 #include "vtkAlgorithmOutput.h"
 #include "vtkBoundingBox.h"
 #include "vtkCallbackCommand.h"
+#include "vtkCellArray.h"
 #include "vtkCommand.h"
+#include "vtkCommunicator.h"
 #include "vtkCompositeDataDisplayAttributes.h"
 #include "vtkCompositePolyDataMapper2.h"
 #include "vtkDataAssembly.h"
@@ -41,8 +43,12 @@
 #include "vtkPVLODActor.h"
 #include "vtkPVLogger.h"
 #include "vtkPVRenderView.h"
+#include "vtkPVRenderViewSettings.h"
+#include "vtkPVStreamingMacros.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
 #include "vtkProperty.h"
 #include "vtkRenderer.h"
@@ -52,9 +58,11 @@
 #include "vtkSelectionNode.h"
 #include "vtkShaderProperty.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStreamingPriorityQueue.h"
 #include "vtkTexture.h"
 #include "vtkTransform.h"
 #include "vtkUnstructuredGrid.h"
+#include "vtkWeakPointer.h"
 
 #if VTK_MODULE_ENABLE_VTK_RenderingRayTracing
 #include "vtkOSPRayActorNode.h"
@@ -63,8 +71,15 @@
 #include <vtk_jsoncpp.h>
 #include <vtksys/SystemTools.hxx>
 
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <set>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -210,6 +225,373 @@ void vtkGeometryRepresentation::HandleGeometryRepresentationProgress(
   }
 }
 
+namespace
+{
+// Returns a polydata with the 12 edges of the given bounding box. This is used
+// as a placeholder for blocks whose surface has not been streamed yet.
+vtkSmartPointer<vtkPolyData> NewBoundingBoxOutline(const double bounds[6])
+{
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 2; ++i)
+      {
+        points->InsertNextPoint(bounds[i], bounds[2 + j], bounds[4 + k]);
+      }
+    }
+  }
+
+  static const vtkIdType edges[12][2] = { { 0, 1 }, { 2, 3 }, { 4, 5 }, { 6, 7 }, { 0, 2 },
+    { 1, 3 }, { 4, 6 }, { 5, 7 }, { 0, 4 }, { 1, 5 }, { 2, 6 }, { 3, 7 } };
+  vtkNew<vtkCellArray> lines;
+  for (const auto& edge : edges)
+  {
+    lines->InsertNextCell(2, edge);
+  }
+
+  auto outline = vtkSmartPointer<vtkPolyData>::New();
+  outline->SetPoints(points);
+  outline->SetLines(lines);
+  return outline;
+}
+
+// Replaces the leaves of `target` with the non-null leaves of `source` having
+// the same flat index. Both must share the same structure.
+void ReplaceLeaves(vtkMultiBlockDataSet* target, vtkMultiBlockDataSet* source)
+{
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(source->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    target->SetDataSet(iter, iter->GetCurrentDataObject());
+  }
+}
+
+// Returns a multiblock with the structure of `input` holding only the leaves
+// whose flat index is in `ids`.
+vtkSmartPointer<vtkMultiBlockDataSet> ExtractLeaves(
+  vtkMultiBlockDataSet* input, const std::set<unsigned int>& ids)
+{
+  auto subset = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  subset->CopyStructure(input);
+  vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+  iter.TakeReference(input->NewTreeIterator());
+  iter->VisitOnlyLeavesOn();
+  iter->SkipEmptyNodesOn();
+  for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+  {
+    if (ids.find(iter->GetCurrentFlatIndex()) != ids.end())
+    {
+      subset->SetDataSet(iter, iter->GetCurrentDataObject());
+    }
+  }
+  return subset;
+}
+}
+
+//*****************************************************************************
+// State used to stream the blocks of a multiblock dataset (see
+// vtkGeometryRepresentation::SetUseBlockStreaming).
+class vtkGeometryRepresentation::vtkStreamingInternals
+{
+public:
+  // Blocks left to stream, identified by their flat index. The queue is the
+  // same on all ranks, so that they stream the same blocks in each pass.
+  vtkStreamingPriorityQueue<> PriorityQueue;
+
+  // Blocks to extract in the current streaming pass.
+  std::set<unsigned int> RequestedBlocks;
+  bool InStreamingUpdate = false;
+
+  // Geometry given to the view on REQUEST_UPDATE, where blocks are bounding box
+  // outlines, and the same geometry with the streamed surfaces merged in.
+  vtkSmartPointer<vtkMultiBlockDataSet> InitialData;
+  vtkSmartPointer<vtkMultiBlockDataSet> StreamedData;
+
+  // Surfaces extracted by the last streaming pass.
+  vtkSmartPointer<vtkMultiBlockDataSet> StreamedPiece;
+
+  // On the rendering processes, the delivered geometry with the streamed
+  // pieces merged in, and the delivered data it was cloned from.
+  vtkSmartPointer<vtkMultiBlockDataSet> RenderedData;
+  vtkWeakPointer<vtkDataObject> RenderedSource;
+  vtkMTimeType RenderedSourceTime = 0;
+
+  void Reset()
+  {
+    this->PriorityQueue = vtkStreamingPriorityQueue<>();
+    this->RequestedBlocks.clear();
+    this->InitialData = nullptr;
+    this->StreamedData = nullptr;
+    this->StreamedPiece = nullptr;
+  }
+
+  // Returns a copy of `input` where each non-empty dataset leaf is replaced by
+  // the outline of its bounds, and queues these leaves for streaming.
+  vtkSmartPointer<vtkMultiBlockDataSet> InitializeQueue(vtkMultiBlockDataSet* input)
+  {
+    auto placeholders = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    placeholders->CopyStructure(input);
+
+    // Minimum and maximum points of the leaves on this process, by flat index.
+    std::vector<double> minima, maxima;
+    vtkSmartPointer<vtkDataObjectTreeIterator> iter;
+    iter.TakeReference(input->NewTreeIterator());
+    iter->VisitOnlyLeavesOn();
+    iter->SkipEmptyNodesOn();
+    for (iter->InitTraversal(); !iter->IsDoneWithTraversal(); iter->GoToNextItem())
+    {
+      auto ds = vtkDataSet::SafeDownCast(iter->GetCurrentDataObject());
+      if (ds == nullptr || ds->GetNumberOfPoints() == 0)
+      {
+        // nothing to stream, extract it right away.
+        placeholders->SetDataSet(iter, iter->GetCurrentDataObject());
+        continue;
+      }
+
+      double bounds[6];
+      ds->GetBounds(bounds);
+      const size_t index = iter->GetCurrentFlatIndex();
+      if (minima.size() < 3 * (index + 1))
+      {
+        minima.resize(3 * (index + 1), VTK_DOUBLE_MAX);
+        maxima.resize(3 * (index + 1), VTK_DOUBLE_MIN);
+      }
+      for (int cc = 0; cc < 3; ++cc)
+      {
+        minima[3 * index + cc] = bounds[2 * cc];
+        maxima[3 * index + cc] = bounds[2 * cc + 1];
+      }
+      placeholders->SetDataSet(iter, NewBoundingBoxOutline(bounds));
+    }
+
+    // A block may be split across ranks. The delivered block only holds all
+    // of its pieces if every rank streams it in the same pass, so the blocks
+    // are queued with their bounds over all ranks, giving all ranks the same
+    // priorities.
+    auto controller = vtkMultiProcessController::GetGlobalController();
+    if (controller && controller->GetNumberOfProcesses() > 1)
+    {
+      int size = static_cast<int>(minima.size());
+      int globalSize = 0;
+      controller->AllReduce(&size, &globalSize, 1, vtkCommunicator::MAX_OP);
+      minima.resize(globalSize, VTK_DOUBLE_MAX);
+      maxima.resize(globalSize, VTK_DOUBLE_MIN);
+      if (globalSize > 0)
+      {
+        std::vector<double> globalMinima(globalSize), globalMaxima(globalSize);
+        controller->AllReduce(
+          minima.data(), globalMinima.data(), globalSize, vtkCommunicator::MIN_OP);
+        controller->AllReduce(
+          maxima.data(), globalMaxima.data(), globalSize, vtkCommunicator::MAX_OP);
+        minima.swap(globalMinima);
+        maxima.swap(globalMaxima);
+      }
+    }
+
+    for (size_t index = 0; 3 * index < minima.size(); ++index)
+    {
+      const double* minPoint = &minima[3 * index];
+      const double* maxPoint = &maxima[3 * index];
+      if (minPoint[0] > maxPoint[0])
+      {
+        // no points on any rank.
+        continue;
+      }
+      vtkStreamingPriorityQueueItem item;
+      item.Identifier = static_cast<unsigned int>(index);
+      item.Bounds.SetBounds(
+        minPoint[0], maxPoint[0], minPoint[1], maxPoint[1], minPoint[2], maxPoint[2]);
+      this->PriorityQueue.push(item);
+    }
+    return placeholders;
+  }
+};
+
+//*****************************************************************************
+// Levels of decimated geometry built on the rendering processes from the
+// delivered LOD geometry (see vtkPVRenderView::SetNumberOfLODLevels). Level 0
+// is the delivered geometry itself, each next level is decimated with half the
+// LOD factor of the previous one.
+class vtkGeometryRepresentation::vtkLODHierarchy
+{
+public:
+  // Stops the worker thread, aborting the build it runs, and waits for it.
+  ~vtkLODHierarchy()
+  {
+    this->Reset();
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Stop = true;
+    }
+    this->Wake.notify_one();
+    if (this->Worker.joinable())
+    {
+      this->Worker.join();
+    }
+  }
+
+  // Returns the geometry to render for `level`, building the levels first if
+  // `source` changed since they were built. While they are built in the
+  // background, the coarsest level built so far is returned instead.
+  vtkDataObject* GetLevel(
+    vtkDataObject* source, int numLevels, int level, double factor, bool background)
+  {
+    if (source == nullptr)
+    {
+      this->Reset();
+      return nullptr;
+    }
+    if (source != this->Source || source->GetMTime() != this->SourceTime ||
+      numLevels != this->NumberOfLevels || factor != this->Factor)
+    {
+      this->Reset();
+      this->Source = source;
+      this->SourceTime = source->GetMTime();
+      this->NumberOfLevels = numLevels;
+      this->Factor = factor;
+
+      // the levels are decimated from a copy, since even reading the geometry
+      // while it is rendered is not safe e.g. cell arrays keep a traversal
+      // location.
+      this->Build = std::make_shared<vtkBuild>();
+      this->Build->Input = vtkSmartPointer<vtkDataObject>::Take(source->NewInstance());
+      this->Build->Input->DeepCopy(source);
+      this->Build->NumberOfLevels = numLevels;
+      this->Build->Factor = factor;
+      if (background)
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->Mutex);
+          this->Pending = this->Build;
+          if (!this->Worker.joinable())
+          {
+            this->Worker = std::thread(&vtkLODHierarchy::Run, this);
+          }
+        }
+        this->Wake.notify_one();
+      }
+      else
+      {
+        vtkLODHierarchy::BuildLevels(*this->Build);
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(this->Build->Mutex);
+    level = std::min(level, static_cast<int>(this->Build->Levels.size()));
+    return level > 0 ? this->Build->Levels[level - 1].GetPointer() : source;
+  }
+
+  // Discards the levels. A build still running in the background is aborted
+  // but not waited for, so that the render thread never blocks on it, and a
+  // build that has not started yet is dropped.
+  void Reset()
+  {
+    if (this->Build)
+    {
+      this->Build->Abort = true;
+      this->Build = nullptr;
+    }
+    {
+      std::lock_guard<std::mutex> lock(this->Mutex);
+      this->Pending = nullptr;
+    }
+    this->Source = nullptr;
+  }
+
+private:
+  // Levels built from a copy of the delivered geometry, shared with the
+  // worker thread.
+  struct vtkBuild
+  {
+    vtkSmartPointer<vtkDataObject> Input;
+    int NumberOfLevels = 1;
+    double Factor = 0.5;
+
+    // Levels built so far, after level 0.
+    std::vector<vtkSmartPointer<vtkDataObject>> Levels;
+    std::mutex Mutex;
+    std::atomic<bool> Abort{ false };
+  };
+
+  // Runs on the worker thread: builds the latest requested levels, one build
+  // at a time. Requests made while a build runs replace each other, so that
+  // only the last one is built next.
+  void Run()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    while (true)
+    {
+      this->Wake.wait(lock, [this]() { return this->Stop || this->Pending != nullptr; });
+      if (this->Stop)
+      {
+        return;
+      }
+      auto build = std::move(this->Pending);
+      this->Pending = nullptr;
+      lock.unlock();
+      vtkLODHierarchy::BuildLevels(*build);
+      build = nullptr;
+      lock.lock();
+    }
+  }
+
+  static void BuildLevels(vtkBuild& build)
+  {
+    // aborts the decimation in progress as soon as the build is discarded.
+    vtkNew<vtkCallbackCommand> abortCheck;
+    abortCheck->SetClientData(&build);
+    abortCheck->SetCallback([](vtkObject* caller, unsigned long, void* clientData, void*) {
+      if (static_cast<vtkBuild*>(clientData)->Abort)
+      {
+        vtkAlgorithm::SafeDownCast(caller)->SetAbortExecute(1);
+      }
+    });
+
+    // every level is decimated from the first one, which only this thread
+    // reads, rather than from the previous level which may be rendered.
+    double factor = build.Factor;
+    for (int cc = 1; cc < build.NumberOfLevels && !build.Abort; ++cc)
+    {
+      factor *= 0.5;
+      vtkNew<vtkGeometryRepresentation_detail::DecimationFilterType> decimator;
+      decimator->AddObserver(vtkCommand::ProgressEvent, abortCheck);
+      decimator->SetLODFactor(factor);
+      decimator->SetInputDataObject(build.Input);
+      decimator->Update();
+      if (build.Abort)
+      {
+        break;
+      }
+      vtkDataObject* output = decimator->GetOutputDataObject(0);
+      auto levelData = vtkSmartPointer<vtkDataObject>::Take(output->NewInstance());
+      levelData->ShallowCopy(output);
+
+      std::lock_guard<std::mutex> lock(build.Mutex);
+      build.Levels.push_back(levelData);
+    }
+    build.Input = nullptr;
+  }
+
+  vtkWeakPointer<vtkDataObject> Source;
+  vtkMTimeType SourceTime = 0;
+  int NumberOfLevels = 1;
+  double Factor = 0.5;
+  std::shared_ptr<vtkBuild> Build;
+
+  // A single worker thread per representation builds the levels in the
+  // background, started with the first background build.
+  std::thread Worker;
+  std::mutex Mutex;
+  std::condition_variable Wake;
+  std::shared_ptr<vtkBuild> Pending;
+  bool Stop = false;
+};
+
 //----------------------------------------------------------------------------
 vtkGeometryRepresentation::vtkGeometryRepresentation()
 {
@@ -261,6 +643,11 @@ vtkGeometryRepresentation::vtkGeometryRepresentation()
 
   this->UseDataPartitions = false;
 
+  this->UseBlockStreaming = false;
+  this->NumberOfStreamedBlocksPerPass = 8;
+  this->Streaming.reset(new vtkGeometryRepresentation::vtkStreamingInternals());
+  this->LODHierarchy.reset(new vtkGeometryRepresentation::vtkLODHierarchy());
+
   this->UseShaderReplacements = false;
   this->ShaderReplacementsString = "";
 
@@ -378,7 +765,16 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   {
     // provide the "geometry" to the view so the view can delivery it to the
     // rendering nodes as and when needed.
-    vtkPVView::SetPiece(inInfo, this, this->MultiBlockMaker->GetOutputDataObject(0));
+    // When streaming blocks, this is only the outlines of the blocks that are
+    // replaced by their surfaces in the following streaming passes.
+    const bool streamBlocks = this->IsStreamingBlocks();
+    vtkPVView::SetPiece(inInfo, this,
+      streamBlocks ? this->Streaming->InitialData.GetPointer()
+                   : this->MultiBlockMaker->GetOutputDataObject(0));
+    if (streamBlocks)
+    {
+      vtkPVRenderView::SetStreamable(inInfo, this, true);
+    }
 
     if (this->UseDataPartitions == true)
     {
@@ -446,15 +842,45 @@ int vtkGeometryRepresentation::ProcessViewRequest(
   }
   else if (request_type == vtkPVView::REQUEST_RENDER())
   {
-    auto data = vtkPVView::GetDeliveredPiece(inInfo, this);
+    vtkDataObject* data = vtkPVView::GetDeliveredPiece(inInfo, this);
     // vtkLogF(INFO, "%p: %s", (void*)data, this->GetLogName().c_str());
-    auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
-    this->Mapper->SetInputDataObject(data);
-    this->LODMapper->SetInputDataObject(dataLOD);
 
+    // Render the streamed blocks merged in, unless new data was delivered
+    // since they were.
+    auto& streaming = *this->Streaming;
+    if (streaming.RenderedData &&
+      (streaming.RenderedSource != data || data->GetMTime() != streaming.RenderedSourceTime))
+    {
+      streaming.RenderedData = nullptr;
+    }
+    if (streaming.RenderedData)
+    {
+      data = streaming.RenderedData;
+    }
     // This is called just before the vtk-level render. In this pass, we simply
     // pick the correct rendering mode and rendering parameters.
     bool lod = this->SuppressLOD ? false : (inInfo->Has(vtkPVRenderView::USE_LOD()) == 1);
+
+    // Render the LOD level picked by the view, if it uses more than one.
+    auto dataLOD = vtkPVView::GetDeliveredPieceLOD(inInfo, this);
+    if (lod && inInfo->Has(vtkPVRenderView::NUMBER_OF_LOD_LEVELS()))
+    {
+      dataLOD = this->LODHierarchy->GetLevel(dataLOD,
+        inInfo->Get(vtkPVRenderView::NUMBER_OF_LOD_LEVELS()),
+        inInfo->Get(vtkPVRenderView::LOD_LEVEL()), inInfo->Get(vtkPVRenderView::LOD_RESOLUTION()),
+        inInfo->Has(vtkPVRenderView::BUILD_LOD_LEVELS_IN_BACKGROUND()) == 1);
+    }
+    else if (lod)
+    {
+      this->LODHierarchy->Reset();
+    }
+    if (dataLOD != this->LODMapper->GetInputDataObject(0, 0))
+    {
+      // block attributes refer to the blocks of the rendered level.
+      this->UpdateBlockAttrLOD = true;
+    }
+    this->Mapper->SetInputDataObject(data);
+    this->LODMapper->SetInputDataObject(dataLOD);
     this->Actor->SetEnableLOD(lod ? 1 : 0);
     this->UpdateColoringParameters();
 
@@ -481,6 +907,41 @@ int vtkGeometryRepresentation::ProcessViewRequest(
       this->UpdateBlockAttrLOD = false;
     }
   }
+  else if (request_type == vtkPVRenderView::REQUEST_STREAMING_UPDATE())
+  {
+    if (this->IsStreamingBlocks())
+    {
+      double view_planes[24];
+      inInfo->Get(vtkPVRenderView::VIEW_PLANES(), view_planes);
+      if (this->StreamingUpdate(view_planes))
+      {
+        vtkPVRenderView::SetNextStreamedPiece(inInfo, this, this->Streaming->StreamedPiece);
+      }
+    }
+  }
+  else if (request_type == vtkPVRenderView::REQUEST_PROCESS_STREAMED_PIECE())
+  {
+    auto piece = vtkMultiBlockDataSet::SafeDownCast(
+      vtkPVRenderView::GetCurrentStreamedPiece(inInfo, this));
+    auto data = vtkMultiBlockDataSet::SafeDownCast(vtkPVView::GetDeliveredPiece(inInfo, this));
+    if (piece && data)
+    {
+      vtkStreamingStatusMacro(<< this << ": received new piece.");
+      auto& streaming = *this->Streaming;
+      if (streaming.RenderedData == nullptr || streaming.RenderedSource != data ||
+        data->GetMTime() != streaming.RenderedSourceTime)
+      {
+        vtkStreamingStatusMacro(<< this << ": cloning delivered data.");
+        streaming.RenderedData = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+        streaming.RenderedData->ShallowCopy(data);
+        streaming.RenderedSource = data;
+        streaming.RenderedSourceTime = data->GetMTime();
+      }
+
+      // replace the outlines with the surfaces of the streamed blocks.
+      ReplaceLeaves(streaming.RenderedData, piece);
+    }
+  }
 
   return 1;
 }
@@ -515,6 +976,42 @@ int vtkGeometryRepresentation::RequestUpdateExtent(
 int vtkGeometryRepresentation::RequestData(
   vtkInformation* request, vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
+  if (auto geomFilter = vtkPVGeometryFilter::SafeDownCast(this->GeometryFilter))
+  {
+    geomFilter->SetNumberOfThreads(
+      vtkPVRenderViewSettings::GetInstance()->GetGeometryFilterThreads());
+  }
+
+  auto& streaming = *this->Streaming;
+  if (streaming.InStreamingUpdate)
+  {
+    // Only extract the surfaces of the blocks requested by this streaming pass.
+    auto input = inputVector[0]->GetNumberOfInformationObjects() == 1
+      ? vtkMultiBlockDataSet::GetData(inputVector[0], 0)
+      : nullptr;
+    if (input)
+    {
+      this->GeometryFilter->SetInputDataObject(0, ExtractLeaves(input, streaming.RequestedBlocks));
+    }
+    else
+    {
+      vtkNew<vtkMultiBlockDataSet> placeholder;
+      this->GeometryFilter->SetInputDataObject(0, placeholder);
+    }
+    this->GeometryFilter->Modified();
+    this->MultiBlockMaker->Update();
+
+    auto output = vtkMultiBlockDataSet::SafeDownCast(this->MultiBlockMaker->GetOutputDataObject(0));
+    streaming.StreamedPiece = ExtractLeaves(output, streaming.RequestedBlocks);
+    if (streaming.StreamedData)
+    {
+      ReplaceLeaves(streaming.StreamedData, streaming.StreamedPiece);
+    }
+    return this->Superclass::RequestData(request, inputVector, outputVector);
+  }
+
+  streaming.Reset();
+  bool streamBlocks = false;
   if (inputVector[0]->GetNumberOfInformationObjects() == 1)
   {
     // vtkLogF(INFO, "%s->RequestData", this->GetLogName().c_str());
@@ -528,7 +1025,17 @@ int vtkGeometryRepresentation::RequestData(
         prod->SetWholeExtent(inInfo->Get(vtkStreamingDemandDrivenPipeline::WHOLE_EXTENT()));
       }
     }
-    this->GeometryFilter->SetInputConnection(this->GetInternalOutputPort());
+    auto input = vtkMultiBlockDataSet::GetData(inputVector[0], 0);
+    if (input && this->UseBlockStreaming && vtkPVView::GetEnableStreaming())
+    {
+      // start with the outlines of the blocks, surfaces are streamed later.
+      streamBlocks = true;
+      this->GeometryFilter->SetInputDataObject(0, streaming.InitializeQueue(input));
+    }
+    else
+    {
+      this->GeometryFilter->SetInputConnection(this->GetInternalOutputPort());
+    }
   }
   else
   {
@@ -540,9 +1047,74 @@ int vtkGeometryRepresentation::RequestData(
   // does use parallel communication (see #19963).
   this->GeometryFilter->Modified();
   this->MultiBlockMaker->Update();
+
+  if (streamBlocks)
+  {
+    auto output = vtkMultiBlockDataSet::SafeDownCast(this->MultiBlockMaker->GetOutputDataObject(0));
+    streaming.InitialData = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    streaming.InitialData->ShallowCopy(output);
+    streaming.StreamedData = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+    streaming.StreamedData->ShallowCopy(output);
+  }
   return this->Superclass::RequestData(request, inputVector, outputVector);
 }
 
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::IsStreamingBlocks() const
+{
+  return this->Streaming->InitialData != nullptr;
+}
+
+//----------------------------------------------------------------------------
+bool vtkGeometryRepresentation::StreamingUpdate(const double view_planes[24])
+{
+  auto& streaming = *this->Streaming;
+  assert(streaming.InStreamingUpdate == false);
+
+  // All ranks have the same blocks left (see InitializeQueue), and stream a
+  // piece together since vtkPVGeometryFilter communicates across ranks.
+  if (streaming.PriorityQueue.empty())
+  {
+    return false;
+  }
+
+  vtkStreamingStatusMacro(<< this << ": doing streaming-update.");
+  double clamp_bounds[6];
+  vtkMath::UninitializeBounds(clamp_bounds);
+  streaming.PriorityQueue.UpdatePriorities(view_planes, clamp_bounds);
+
+  streaming.RequestedBlocks.clear();
+  for (int cc = 0; cc < this->NumberOfStreamedBlocksPerPass && !streaming.PriorityQueue.empty();
+       ++cc)
+  {
+    streaming.RequestedBlocks.insert(streaming.PriorityQueue.top().Identifier);
+    streaming.PriorityQueue.pop();
+  }
+  vtkStreamingStatusMacro(<< this << ": requesting " << streaming.RequestedBlocks.size()
+                          << " block(s), " << streaming.PriorityQueue.size() << " left.");
+
+  streaming.InStreamingUpdate = true;
+
+  // This ensure that the representation re-executes.
+  this->MarkModified();
+
+  // Execute the pipeline.
+  this->Update();
+
+  streaming.InStreamingUpdate = false;
+  return true;
+}
+
+//----------------------------------------------------------------------------
+void vtkGeometryRepresentation::SetUseBlockStreaming(bool val)
+{
+  if (this->UseBlockStreaming != val)
+  {
+    this->UseBlockStreaming = val;
+    this->MarkModified();
+  }
+}
+
 //----------------------------------------------------------------------------
 bool vtkGeometryRepresentation::GetBounds(
   vtkDataObject* dataObject, double bounds[6], vtkCompositeDataDisplayAttributes* cdAttributes)
@@ -573,6 +1145,10 @@ bool vtkGeometryRepresentation::GetBounds(
 //----------------------------------------------------------------------------
 vtkDataObject* vtkGeometryRepresentation::GetRenderedDataObject(int vtkNotUsed(port))
 {
+  if (this->IsStreamingBlocks())
+  {
+    return this->Streaming->StreamedData;
+  }
   if (this->GeometryFilter->GetNumberOfInputConnections(0) > 0)
   {
     return this->MultiBlockMaker->GetOutputDataObject(0);
@@ -865,6 +1441,9 @@ bool vtkGeometryRepresentation::NeedsOrderedCompositing()
 void vtkGeometryRepresentation::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "UseBlockStreaming: " << this->UseBlockStreaming << endl;
+  os << indent << "NumberOfStreamedBlocksPerPass: " << this->NumberOfStreamedBlocksPerPass
+     << endl;
 }
 
 //****************************************************************************
@@ -1566,7 +2145,9 @@ void vtkGeometryRepresentation::ComputeVisibleDataBounds()
     // REQUEST_RENDER pass.  This constructs a dummy vtkCompositeDataDisplayAttributes
     // with only the visibilities set and calls the helper function to compute the visible
     // bounds with that.
-    vtkDataObject* dataObject = this->MultiBlockMaker->GetOutputDataObject(0);
+    vtkDataObject* dataObject = this->IsStreamingBlocks()
+      ? this->Streaming->InitialData.GetPointer()
+      : this->MultiBlockMaker->GetOutputDataObject(0);
     vtkNew<vtkCompositeDataDisplayAttributes> cdAttributes;
     this->PopulateBlockAttributes(cdAttributes, dataObject);
     this->GetBounds(dataObject, this->VisibleDataBounds, cdAttributes);
@@ -33,6 +33,7 @@
 #include "vtkRemotingViewsModule.h" // needed for exports
 #include "vtkVector.h"              // for vtkVector.
 
+#include <memory>        // needed for std::unique_ptr
 #include <set>           // needed for std::set
 #include <string>        // needed for std::string
 #include <unordered_map> // needed for std::unordered_map
@@ -343,6 +344,28 @@ public:
   vtkGetMacro(UseDataPartitions, bool);
   //@}
 
+  //@{
+  /**
+   * When enabled, and streaming is enabled (see vtkPVView::GetEnableStreaming),
+   * the surfaces of multiblock datasets are not extracted and delivered all at
+   * once. The first update only delivers the bounding box of each block. The
+   * surfaces of the blocks are then extracted and delivered over successive
+   * streaming passes, blocks covering most of the screen first.
+   * Default is false.
+   */
+  virtual void SetUseBlockStreaming(bool);
+  vtkGetMacro(UseBlockStreaming, bool);
+  //@}
+
+  //@{
+  /**
+   * Number of blocks extracted and delivered by each streaming pass when
+   * UseBlockStreaming is enabled. Default is 8.
+   */
+  vtkSetClampMacro(NumberOfStreamedBlocksPerPass, int, 1, VTK_INT_MAX);
+  vtkGetMacro(NumberOfStreamedBlocksPerPass, int);
+  //@}
+
   //@{
   /**
    * Specify whether or not to shader replacements string must be used.
@@ -459,6 +482,20 @@ protected:
    */
   virtual void SetPointArrayToProcess(int p, const char* val);
 
+  /**
+   * Returns true if the blocks of the current input are being streamed i.e.
+   * UseBlockStreaming is enabled, streaming is enabled and the input is a
+   * vtkMultiBlockDataSet.
+   */
+  bool IsStreamingBlocks() const;
+
+  /**
+   * Called on REQUEST_STREAMING_UPDATE. Updates the block priorities using the
+   * view planes and re-executes the representation to extract the surfaces of
+   * the next blocks. Returns true if a new piece was produced.
+   */
+  bool StreamingUpdate(const double view_planes[24]);
+
   vtkAlgorithm* GeometryFilter;
   vtkAlgorithm* MultiBlockMaker;
   vtkGeometryRepresentation_detail::DecimationFilterType* Decimator;
@@ -486,6 +523,9 @@ protected:
 
   bool UseDataPartitions;
 
+  bool UseBlockStreaming;
+  int NumberOfStreamedBlocksPerPass;
+
   bool UseShaderReplacements;
   std::string ShaderReplacementsString;
 
@@ -498,6 +538,12 @@ protected:
   std::unordered_map<std::string, vtkVector3d> BlockColors;
 
 private:
+  class vtkStreamingInternals;
+  std::unique_ptr<vtkStreamingInternals> Streaming;
+
+  class vtkLODHierarchy;
+  std::unique_ptr<vtkLODHierarchy> LODHierarchy;
+
   vtkGeometryRepresentation(const vtkGeometryRepresentation&) = delete;
   void operator=(const vtkGeometryRepresentation&) = delete;
 };
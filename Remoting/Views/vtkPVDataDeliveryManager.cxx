@@ -17,6 +17,7 @@
 
 #include "vtkAlgorithmOutput.h"
 #include "vtkInformation.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkPVDataRepresentation.h"
@@ -25,16 +26,78 @@
 #include "vtkSmartPointer.h"
 #include "vtkWeakPointer.h"
 
+#include <algorithm>
+#include <set>
+#include <tuple>
+
+//----------------------------------------------------------------------------
+vtkPVDataDeliveryManager::vtkInternals::vtkCacheState&
+vtkPVDataDeliveryManager::vtkInternals::GetCacheState()
+{
+  static vtkCacheState state;
+  return state;
+}
+
+//----------------------------------------------------------------------------
+std::vector<vtkPVDataDeliveryManager::vtkInternals::vtkCacheEntry>
+vtkPVDataDeliveryManager::vtkInternals::GetCacheEntries(vtkTypeUInt64& total)
+{
+  std::vector<vtkCacheEntry> entries;
+  for (auto internals : vtkInternals::GetCacheState().Managers)
+  {
+    for (const auto& ipair : internals->ItemsMap)
+    {
+      const unsigned int id = ipair.first.first;
+      auto reprIter = internals->RepresentationsMap.find(id);
+      vtkPVDataRepresentation* repr =
+        reprIter != internals->RepresentationsMap.end() ? reprIter->second.GetPointer() : nullptr;
+
+      // Merge full and low resolution data for the same cache key.
+      std::map<double, vtkCacheEntry> keyed;
+      for (const vtkItem* item : { &ipair.second.first, &ipair.second.second })
+      {
+        for (const auto& dpair : item->GetCacheEntries())
+        {
+          auto& entry = keyed
+                          .emplace(dpair.first,
+                            vtkCacheEntry{ internals, id, ipair.first.second, dpair.first, 0, 0 })
+                          .first->second;
+          entry.LastAccess = std::max(entry.LastAccess, dpair.second.LastAccess);
+          entry.Size += item->GetCacheEntrySize(dpair.first);
+        }
+      }
+
+      for (const auto& kpair : keyed)
+      {
+        total += kpair.second.Size;
+        // never evict the data the representation is currently using.
+        if (repr != nullptr && repr->GetCacheKey() != kpair.first)
+        {
+          entries.push_back(kpair.second);
+        }
+      }
+    }
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const vtkCacheEntry& a, const vtkCacheEntry& b) {
+    return std::tie(a.LastAccess, a.RepresentationId, a.Port, a.CacheKey) <
+      std::tie(b.LastAccess, b.RepresentationId, b.Port, b.CacheKey);
+  });
+  return entries;
+}
+
 //*****************************************************************************
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::vtkPVDataDeliveryManager()
   : Internals(new vtkInternals())
 {
+  vtkInternals::GetCacheState().Managers.insert(this->Internals);
 }
 
 //----------------------------------------------------------------------------
 vtkPVDataDeliveryManager::~vtkPVDataDeliveryManager()
 {
+  vtkInternals::GetCacheState().Managers.erase(this->Internals);
   delete this->Internals;
   this->Internals = nullptr;
 }
@@ -128,6 +191,7 @@ void vtkPVDataDeliveryManager::SetPiece(vtkPVDataRepresentation* repr, vtkDataOb
         this->SetPiece(repr, nullptr, true, 0, port);
       }
     }
+    item->Touch(cacheKey, ++vtkInternals::GetCacheState().Tick);
   }
   else
   {
@@ -153,6 +217,17 @@ bool vtkPVDataDeliveryManager::HasPiece(vtkPVDataRepresentation* repr, bool low_
   const auto cacheKey = this->GetCacheKey(repr);
   const bool val = item ? (item->GetDataObject(cacheKey) != nullptr) : false;
 
+  auto& cache = vtkInternals::GetCacheState();
+  if (val)
+  {
+    item->Touch(cacheKey, ++cache.Tick);
+    cache.Hits++;
+  }
+  else
+  {
+    cache.Misses++;
+  }
+
   vtkLogF(TRACE, "HasPiece %s (key=%g) : %d", repr->GetLogName().c_str(), cacheKey, val);
   return val;
 }
@@ -297,8 +372,126 @@ void vtkPVDataDeliveryManager::ClearCache(vtkPVDataRepresentation* repr)
   this->Internals->ClearCache(repr);
 }
 
+//----------------------------------------------------------------------------
+vtkIdType vtkPVDataDeliveryManager::GetCacheEntriesToEvict(
+  vtkTypeUInt64 budget, vtkMultiProcessStream& keys)
+{
+  vtkTypeUInt64 total = 0;
+  const auto entries = vtkInternals::GetCacheEntries(total);
+  vtkIdType count = 0;
+  for (const auto& entry : entries)
+  {
+    if (total <= budget)
+    {
+      break;
+    }
+    total -= entry.Size;
+    keys << entry.RepresentationId << entry.Port << entry.CacheKey;
+    ++count;
+  }
+  return count;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::EvictCacheEntries(const std::vector<vtkMultiProcessStream>& keys)
+{
+  std::set<std::tuple<unsigned int, int, double>> evict;
+  for (auto stream : keys)
+  {
+    while (!stream.Empty())
+    {
+      unsigned int id;
+      int port;
+      double cacheKey;
+      stream >> id >> port >> cacheKey;
+      evict.insert(std::make_tuple(id, port, cacheKey));
+    }
+  }
+  if (evict.empty())
+  {
+    return;
+  }
+
+  vtkTypeUInt64 total = 0;
+  const auto entries = vtkInternals::GetCacheEntries(total);
+  vtkVLogScopeF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(),
+    "evict %d cache entries (cache size=%llu KiB)", static_cast<int>(evict.size()),
+    static_cast<unsigned long long>(total));
+  auto& cache = vtkInternals::GetCacheState();
+  for (const auto& entry : entries)
+  {
+    if (evict.find(std::make_tuple(entry.RepresentationId, entry.Port, entry.CacheKey)) ==
+      evict.end())
+    {
+      continue;
+    }
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "evict: id=%u, port=%d, key=%g, size=%llu KiB",
+      entry.RepresentationId, entry.Port, entry.CacheKey,
+      static_cast<unsigned long long>(entry.Size));
+    for (const bool low_res : { false, true })
+    {
+      if (auto item = entry.Internals->GetItem(entry.RepresentationId, low_res, entry.Port))
+      {
+        item->ClearCache(entry.CacheKey);
+      }
+    }
+    cache.Evictions++;
+    cache.EvictedMemorySize += entry.Size;
+  }
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheMemorySize()
+{
+  vtkTypeUInt64 total = 0;
+  vtkInternals::GetCacheEntries(total);
+  return total;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheHits()
+{
+  return vtkInternals::GetCacheState().Hits;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheMisses()
+{
+  return vtkInternals::GetCacheState().Misses;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetNumberOfCacheEvictions()
+{
+  return vtkInternals::GetCacheState().Evictions;
+}
+
+//----------------------------------------------------------------------------
+vtkTypeUInt64 vtkPVDataDeliveryManager::GetCacheEvictedMemorySize()
+{
+  return vtkInternals::GetCacheState().EvictedMemorySize;
+}
+
+//----------------------------------------------------------------------------
+void vtkPVDataDeliveryManager::ResetCacheStatistics()
+{
+  auto& cache = vtkInternals::GetCacheState();
+  cache.Hits = cache.Misses = cache.Evictions = cache.EvictedMemorySize = 0;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVDataDeliveryManager::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheMemorySize: " << vtkPVDataDeliveryManager::GetCacheMemorySize() << endl;
+  os << indent << "NumberOfCacheHits: " << vtkPVDataDeliveryManager::GetNumberOfCacheHits()
+     << endl;
+  os << indent << "NumberOfCacheMisses: " << vtkPVDataDeliveryManager::GetNumberOfCacheMisses()
+     << endl;
+  os << indent
+     << "NumberOfCacheEvictions: " << vtkPVDataDeliveryManager::GetNumberOfCacheEvictions()
+     << endl;
+  os << indent
+     << "CacheEvictedMemorySize: " << vtkPVDataDeliveryManager::GetCacheEvictedMemorySize()
+     << endl;
 }
@@ -39,6 +39,7 @@ class vtkAlgorithmOutput;
 class vtkDataObject;
 class vtkExtentTranslator;
 class vtkInformation;
+class vtkMultiProcessStream;
 class vtkPVDataRepresentation;
 class vtkPVView;
 
@@ -107,6 +108,49 @@ public:
    */
   void ClearCache(vtkPVDataRepresentation* repr);
 
+  //@{
+  /**
+   * Data cached for cache keys other than the current one, e.g. the time steps
+   * of an animation being cached, is shared between all delivery managers in
+   * the process and can be kept within a memory budget by evicting the least
+   * recently used entries first. An entry is all the data, full and low
+   * resolution, pre and post delivery, for a representation's port and a cache
+   * key. Data for the current cache key of a representation is never evicted.
+   *
+   * Since evicting an entry forces the representation to update again when
+   * the cache key is used next, all processes must evict the same entries.
+   * Views first call `GetCacheEntriesToEvict` with the budget (in KiB) on all
+   * processes, which adds the keys of the least recently used entries beyond
+   * the budget to `keys` and returns their count. When any process has
+   * entries to evict, the views gather the keys from all processes and call
+   * `EvictCacheEntries` with them on all processes. Each process then evicts
+   * every entry it has for any of these keys, which identify an entry by the
+   * representation's unique identifier, the port and the cache key.
+   */
+  static vtkIdType GetCacheEntriesToEvict(vtkTypeUInt64 budget, vtkMultiProcessStream& keys);
+  static void EvictCacheEntries(const std::vector<vtkMultiProcessStream>& keys);
+  //@}
+
+  /**
+   * Returns the memory (in KiB) held by all delivery managers in the process
+   * for pieces and delivered pieces.
+   */
+  static vtkTypeUInt64 GetCacheMemorySize();
+
+  //@{
+  /**
+   * Statistics for the cache shared by all delivery managers in the process.
+   * Hits and misses count the times a representation did or did not find its
+   * data in the cache when updating. Evictions count entries evicted to keep
+   * within the budget, and evicted memory is in KiB.
+   */
+  static vtkTypeUInt64 GetNumberOfCacheHits();
+  static vtkTypeUInt64 GetNumberOfCacheMisses();
+  static vtkTypeUInt64 GetNumberOfCacheEvictions();
+  static vtkTypeUInt64 GetCacheEvictedMemorySize();
+  static void ResetCacheStatistics();
+  //@}
+
   //@{
   /**
    * Provides access to the producer port for the geometry of a registered
@@ -28,7 +28,9 @@
 #include <cassert> // for assert
 #include <map>     // for std::map
 #include <numeric> // for std::accumulate
+#include <set>     // for std::set
 #include <utility> // for std::pair
+#include <vector>  // for std::vector
 
 class vtkPVDataDeliveryManager::vtkInternals
 {
@@ -70,6 +72,9 @@ public:
     vtkMTimeType TimeStamp{ 0 };
     vtkMTimeType ActualMemorySize{ 0 };
 
+    // Tick of the last update that used this data, for LRU eviction.
+    vtkTypeUInt64 LastAccess{ 0 };
+
     // Arbitrary meta-data container.
     vtkSmartPointer<vtkInformation> Information;
   };
@@ -89,6 +94,38 @@ public:
     vtkItem() {}
 
     void ClearCache() { this->Data.clear(); }
+    void ClearCache(double cacheKey) { this->Data.erase(cacheKey); }
+
+    const std::map<double, vtkRepresentedData>& GetCacheEntries() const { return this->Data; }
+
+    void Touch(double cacheKey, vtkTypeUInt64 tick)
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter != this->Data.end())
+      {
+        iter->second.LastAccess = tick;
+      }
+    }
+
+    // Returns the memory (in KiB) held for the cache key, including delivered
+    // data objects.
+    vtkTypeUInt64 GetCacheEntrySize(double cacheKey) const
+    {
+      auto iter = this->Data.find(cacheKey);
+      if (iter == this->Data.end())
+      {
+        return 0;
+      }
+      vtkTypeUInt64 size = iter->second.ActualMemorySize;
+      for (const auto& dpair : iter->second.DeliveredDataObjects)
+      {
+        if (dpair.second != nullptr && dpair.second != iter->second.DataObject)
+        {
+          size += dpair.second->GetActualMemorySize();
+        }
+      }
+      return size;
+    }
 
     void SetDataObject(vtkDataObject* data, vtkInternals* helper, double cacheKey)
     {
@@ -290,6 +327,36 @@ public:
 
   ItemsMapType ItemsMap;
   RepresentationsMapType RepresentationsMap;
+
+  // State for the cache shared by all delivery managers in the process.
+  struct vtkCacheState
+  {
+    std::set<vtkInternals*> Managers;
+    vtkTypeUInt64 Tick{ 0 };
+
+    vtkTypeUInt64 Hits{ 0 };
+    vtkTypeUInt64 Misses{ 0 };
+    vtkTypeUInt64 Evictions{ 0 };
+    vtkTypeUInt64 EvictedMemorySize{ 0 };
+  };
+  static vtkCacheState& GetCacheState();
+
+  // All data for a representation's port and a cache key. Representation
+  // identifiers come from the proxies and are the same on all processes.
+  struct vtkCacheEntry
+  {
+    vtkInternals* Internals;
+    unsigned int RepresentationId;
+    int Port;
+    double CacheKey;
+    vtkTypeUInt64 LastAccess;
+    vtkTypeUInt64 Size;
+  };
+
+  // Returns the evictable cache entries of all delivery managers, sorted from
+  // least to most recently used, and adds the memory held by all entries to
+  // `total`.
+  static std::vector<vtkCacheEntry> GetCacheEntries(vtkTypeUInt64& total);
 };
 
 #endif // __WRAP__
@@ -34,12 +34,19 @@
 #include "vtkPVDataRepresentation.h"
 #include "vtkPVPostFilter.h"
 #include "vtkPointData.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
 #include "vtkVariant.h"
 #include "vtkVariantArray.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
 #include <map>
+#include <memory>
 #include <set>
 #include <sstream>
 #include <vector>
@@ -56,6 +63,162 @@ class vtkPVProminentValuesInformation::vtkInternalDistinctValues
 {
 };
 
+namespace
+{
+// Returns the number of tuples to draw so that a value making up at least
+// `fraction` of the tuples goes unnoticed with a probability of at most
+// `uncertainty`, i.e. the smallest n such that (1 - fraction)^n <= uncertainty.
+// Returns `numTuples` when every tuple must (or might as well) be inspected.
+vtkIdType GetNumberOfSamples(vtkIdType numTuples, double fraction, double uncertainty)
+{
+  if (uncertainty <= 0. || fraction <= 0.)
+  {
+    return numTuples;
+  }
+  if (uncertainty >= 1. || fraction >= 1.)
+  {
+    return std::min<vtkIdType>(1, numTuples);
+  }
+  const double n = std::ceil(std::log(uncertainty) / std::log1p(-fraction));
+  return n < static_cast<double>(numTuples) ? static_cast<vtkIdType>(n) : numTuples;
+}
+
+// splitmix64 finalizer, used to draw the tuples to sample independently on
+// each thread.
+inline vtkTypeUInt64 MixBits(vtkTypeUInt64 x)
+{
+  x += 0x9e3779b97f4a7c15ULL;
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+  return x ^ (x >> 31);
+}
+
+// Collects the distinct tuples (component -1, for arrays with more than one
+// component) and component values of an array. Either every tuple is visited,
+// or `NumberOfSamples` tuples are drawn uniformly with replacement. A
+// component is dropped as soon as any thread sees more than `MaxValues`
+// distinct values for it, and the traversal stops once all are dropped.
+class DistinctValuesCollector
+{
+public:
+  typedef std::map<int, std::set<std::vector<vtkVariant>>> ValueSets;
+
+  DistinctValuesCollector(vtkAbstractArray* array, vtkIdType numSamples, size_t maxValues)
+    : Array(array)
+    , NumberOfComponents(array->GetNumberOfComponents())
+    , NumberOfTuples(array->GetNumberOfTuples())
+    , NumberOfSamples(numSamples)
+    , MaxValues(maxValues)
+    , FirstComponent(array->GetNumberOfComponents() > 1 ? -1 : 0)
+    , Exceeded(new std::atomic<bool>[array->GetNumberOfComponents() + 1])
+    , NumberExceeded(0)
+  {
+    for (int c = this->FirstComponent; c < this->NumberOfComponents; ++c)
+    {
+      this->Exceeded[c + 1] = false;
+    }
+  }
+
+  void Initialize()
+  {
+    ValueSets& local = this->LocalValues.Local();
+    for (int c = this->FirstComponent; c < this->NumberOfComponents; ++c)
+    {
+      local[c];
+    }
+  }
+
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    ValueSets& local = this->LocalValues.Local();
+    const int nc = this->NumberOfComponents;
+    const int numTracked = nc - this->FirstComponent;
+    const bool sampling = this->NumberOfSamples < this->NumberOfTuples;
+    std::vector<vtkVariant> tuple(nc);
+    std::vector<vtkVariant> value(1);
+    for (vtkIdType cc = begin; cc < end && this->NumberExceeded < numTracked; ++cc)
+    {
+      const vtkIdType t = sampling
+        ? static_cast<vtkIdType>(MixBits(static_cast<vtkTypeUInt64>(cc)) %
+            static_cast<vtkTypeUInt64>(this->NumberOfTuples))
+        : cc;
+      for (int c = 0; c < nc; ++c)
+      {
+        tuple[c] = this->Array->GetVariantValue(t * nc + c);
+      }
+      if (this->FirstComponent < 0)
+      {
+        this->Insert(local, -1, tuple);
+      }
+      for (int c = 0; c < nc; ++c)
+      {
+        value[0] = tuple[c];
+        this->Insert(local, c, value);
+      }
+    }
+  }
+
+  void Reduce() {}
+
+  // Merges the values of all threads. Components with too many values are
+  // left out.
+  bool Merge(ValueSets& result)
+  {
+    bool valid = true;
+    for (int c = this->FirstComponent; c < this->NumberOfComponents; ++c)
+    {
+      std::set<std::vector<vtkVariant>>& merged = result[c];
+      for (auto iter = this->LocalValues.begin(); iter != this->LocalValues.end() &&
+           !this->Exceeded[c + 1];
+           ++iter)
+      {
+        for (const auto& entry : (*iter)[c])
+        {
+          if (merged.insert(entry).second && merged.size() > this->MaxValues)
+          {
+            this->Exceeded[c + 1] = true;
+            break;
+          }
+        }
+      }
+      if (this->Exceeded[c + 1])
+      {
+        result.erase(c);
+        valid = false;
+      }
+    }
+    return valid;
+  }
+
+  vtkIdType GetNumberOfSamples() const { return this->NumberOfSamples; }
+
+private:
+  void Insert(ValueSets& local, int c, const std::vector<vtkVariant>& entry)
+  {
+    if (this->Exceeded[c + 1])
+    {
+      return;
+    }
+    std::set<std::vector<vtkVariant>>& values = local[c];
+    if (values.insert(entry).second && values.size() > this->MaxValues &&
+      !this->Exceeded[c + 1].exchange(true))
+    {
+      ++this->NumberExceeded;
+    }
+  }
+
+  vtkAbstractArray* Array;
+  const int NumberOfComponents;
+  const vtkIdType NumberOfTuples;
+  const vtkIdType NumberOfSamples;
+  const size_t MaxValues;
+  const int FirstComponent;
+  std::unique_ptr<std::atomic<bool>[]> Exceeded;
+  std::atomic<int> NumberExceeded;
+  vtkSMPThreadLocal<ValueSets> LocalValues;
+};
+}
+
 vtkStandardNewMacro(vtkPVProminentValuesInformation);
 
 //----------------------------------------------------------------------------
@@ -280,6 +443,11 @@ void vtkPVProminentValuesInformation::CopyFromCompositeDataSet(vtkCompositeDataS
     other->Initialize();
     other->CopyFromLeafDataObject(node);
     this->AddInformation(other.GetPointer());
+    if (this->DistinctValues && this->DistinctValues->empty() && !this->Valid)
+    {
+      // every component has too many values, no need to look any further.
+      break;
+    }
   }
   iter->Delete();
 }
@@ -330,52 +498,25 @@ void vtkPVProminentValuesInformation::CopyDistinctValuesFromObject(vtkAbstractAr
   {
     this->DistinctValues = new vtkInternalDistinctValues;
   }
-  int nc = this->GetNumberOfComponents();
-  vtkNew<vtkVariantArray> cvalues;
-  std::vector<vtkVariant> tuple;
-  // bool tooManyValues;
-  for (int c = (nc > 1 ? -1 : 0); c < nc; ++c)
-  {
-    int tupleSize = c < 0 ? nc : 1;
-    tuple.resize(tupleSize);
-    std::set<std::vector<vtkVariant>>& compDistincts((*this->DistinctValues)[c]);
-    cvalues->Initialize();
-    unsigned int maxDiscreteValues = array->GetMaxDiscreteValues();
-    if (this->Force)
-    {
-      array->SetMaxDiscreteValues(VTK_UNSIGNED_INT_MAX);
-    }
-    array->GetProminentComponentValues(c, cvalues.GetPointer(), 0., 0.);
-    array->SetMaxDiscreteValues(maxDiscreteValues);
-    vtkIdType nt = cvalues->GetNumberOfTuples();
-    if (nt > 0)
-    {
-      for (vtkIdType t = 0; t < nt; ++t)
-      {
-        for (int i = 0; i < tupleSize; ++i)
-        {
-          tuple[i] = cvalues->GetValue(i + t * tupleSize);
-        }
-        compDistincts.insert(tuple);
-        /*
-        if (compDistincts.insert(tuple).second)
-          {
-          if ((tooManyValues =
-            compDistincts.size() > vtkAbstractArray::MAX_DISCRETE_VALUES))
-            break;
-          }
-          */
-      }
-      this->Valid = true;
-    }
-    else
-    {
-      // if there is no tuples provided, it means we were unable
-      // to determine the prominent values and this information
-      // is invalid
-      this->Valid = false;
-    }
+  if (array->GetNumberOfComponents() != this->GetNumberOfComponents())
+  {
+    // the array does not match the one values were requested for.
+    this->Valid = false;
+    return;
   }
+
+  // Rather than visiting every tuple, sample just enough tuples for values
+  // making up at least `Fraction` of the array to be found with a probability
+  // of at least `1 - Uncertainty`. Values that are prominent over a composite
+  // dataset are prominent in at least one of its blocks, so sampling each
+  // block this way keeps the bound for the whole dataset.
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  const size_t maxValues =
+    this->Force ? std::numeric_limits<size_t>::max() : array->GetMaxDiscreteValues();
+  DistinctValuesCollector collector(
+    array, GetNumberOfSamples(numTuples, this->Fraction, this->Uncertainty), maxValues);
+  vtkSMPTools::For(0, collector.GetNumberOfSamples(), collector);
+  this->Valid = collector.Merge(*this->DistinctValues);
 }
 
 //----------------------------------------------------------------------------
@@ -397,6 +538,11 @@ void vtkPVProminentValuesInformation::AddInformation(vtkPVInformation* info)
     // If this object is uninitialized, copy.
     this->DeepCopy(aInfo);
   }
+  else if (!this->Valid && !this->Force && this->DistinctValues->empty())
+  {
+    // Every component already has too many values, nothing left to merge.
+    return;
+  }
   else
   {
     // Add unique values to our own.
@@ -589,19 +735,19 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     return;
   }
 
-  for (int i = 0; i <= this->NumberOfComponents; ++i)
+  // Components missing on either side had too many values, and so does their
+  // union. Merging a component stops as soon as it has too many values.
+  vtkInternalDistinctValues::iterator cit = this->DistinctValues->begin();
+  while (cit != this->DistinctValues->end())
   {
-    vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(i);
-    vtkInternalDistinctValues::mapped_type::iterator
-      eit; // iterator over entries of component [ab]it->second.
-    bool tooManyValues = false;
-    if (bit != info->DistinctValues->end())
-    { // Add info's values to our list of unique keys
-      for (eit = bit->second.begin(); eit != bit->second.end(); ++eit)
+    vtkInternalDistinctValues::iterator bit = info->DistinctValues->find(cit->first);
+    bool tooManyValues = (bit == info->DistinctValues->end());
+    if (!tooManyValues)
+    {
+      for (const auto& entry : bit->second)
       {
-        if ((*this->DistinctValues)[i].insert(*eit).second &&
-          ((*this->DistinctValues)[i].size() > vtkAbstractArray::MAX_DISCRETE_VALUES &&
-            !this->Force))
+        if (cit->second.insert(entry).second && !this->Force &&
+          cit->second.size() > vtkAbstractArray::MAX_DISCRETE_VALUES)
         {
           tooManyValues = true;
           break;
@@ -612,9 +758,13 @@ void vtkPVProminentValuesInformation::AddDistinctValues(vtkPVProminentValuesInfo
     // If the union of values is too large, delete the list of values
     if (tooManyValues)
     {
-      this->DistinctValues->erase(i);
+      cit = this->DistinctValues->erase(cit);
       this->Valid = false;
     }
+    else
+    {
+      ++cit;
+    }
   }
 }
 
@@ -26,7 +26,12 @@
  * given confidence that dictates the number of samples required), then
  * the prominent values are also made available.
  *
- * This class uses vtkAbstractArray::GetProminentComponentValues().
+ * Rather than inspecting every value, tuples are sampled, with as many
+ * samples as needed for values making up at least Fraction of the array to be
+ * detected with a probability of at least 1 - Uncertainty. Samples are
+ * inspected in parallel using vtkSMPTools, and both the inspection and the
+ * merge of the values found on each block or process stop as soon as too many
+ * distinct values are found.
  */
 
 #ifndef vtkPVProminentValuesInformation_h
@@ -112,6 +112,7 @@
 #include "vtkOSPRayRendererNode.h"
 #endif
 
+#include <algorithm>
 #include <cassert>
 #include <map>
 #include <set>
@@ -319,6 +320,9 @@ vtkObjectFactoryNewMacro(vtkPVRenderView);
 vtkInformationKeyMacro(vtkPVRenderView, USE_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, USE_OUTLINE_FOR_LOD, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, LOD_RESOLUTION, Double);
+vtkInformationKeyMacro(vtkPVRenderView, NUMBER_OF_LOD_LEVELS, Integer);
+vtkInformationKeyMacro(vtkPVRenderView, LOD_LEVEL, Integer);
+vtkInformationKeyMacro(vtkPVRenderView, BUILD_LOD_LEVELS_IN_BACKGROUND, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, NEED_ORDERED_COMPOSITING, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, RENDER_EMPTY_IMAGES, Integer);
 vtkInformationKeyMacro(vtkPVRenderView, REQUEST_STREAMING_UPDATE, Request);
@@ -357,6 +361,10 @@ vtkPVRenderView::vtkPVRenderView()
   this->RemoteRenderingThreshold = 0;
   this->LODRenderingThreshold = 0;
   this->LODResolution = 0.5;
+  this->NumberOfLODLevels = 1;
+  this->LODTargetFrameTime = 0.05;
+  this->BuildLODLevelsInBackground = true;
+  this->LODLevel = 0;
   this->UseOutlineForLODRendering = false;
   this->UseLightKit = false;
   this->Interactor = nullptr;
@@ -1347,6 +1355,27 @@ void vtkPVRenderView::Update()
   this->AllReduce(lsize, gsize, vtkCommunicator::SUM_OP);
   const double geometry_size = gsize / 1024.0;
 
+  // Keep cached data within the memory budget. Evicting data makes the
+  // representation update again when that cache key is used next, so all
+  // processes must evict the same entries: the keys each process picks are
+  // gathered and all of them are evicted everywhere. The number of keys is
+  // reduced first, even without a budget, so that processes never disagree on
+  // whether to take part in the gather.
+  const vtkIdType budget = vtkPVRenderViewSettings::GetInstance()->GetCacheMemoryBudget();
+  vtkMultiProcessStream lkeys;
+  const vtkTypeUInt64 lcount = budget > 0
+    ? static_cast<vtkTypeUInt64>(
+        vtkPVDataDeliveryManager::GetCacheEntriesToEvict(budget * 1024, lkeys))
+    : 0;
+  vtkTypeUInt64 gcount;
+  this->AllReduce(lcount, gcount, vtkCommunicator::MAX_OP);
+  if (gcount > 0)
+  {
+    std::vector<vtkMultiProcessStream> gkeys;
+    this->AllGather(lkeys, gkeys);
+    vtkPVDataDeliveryManager::EvictCacheEntries(gkeys);
+  }
+
   // cout << "Full Geometry size: " << geometry_size << endl;
   // Update decisions about lod-rendering and remote-rendering.
   this->UseLODForInteractiveRender = this->ShouldUseLODRendering(geometry_size);
@@ -1429,6 +1458,24 @@ void vtkPVRenderView::UpdateLOD()
   vtkTimerLog::MarkEndEvent("RenderView::UpdateLOD");
 }
 
+//----------------------------------------------------------------------------
+int vtkPVRenderView::ComputeNextLODLevel(double lastFrameTime) const
+{
+  const int maxLevel = this->NumberOfLODLevels - 1;
+  const int level = std::min(this->LODLevel, maxLevel);
+  if (lastFrameTime > this->LODTargetFrameTime && level < maxLevel)
+  {
+    return level + 1;
+  }
+  // a level has a few times fewer triangles than the next finer one, only
+  // refine with enough headroom to not alternate between two levels.
+  if (lastFrameTime < 0.5 * this->LODTargetFrameTime && level > 0)
+  {
+    return level - 1;
+  }
+  return level;
+}
+
 //----------------------------------------------------------------------------
 void vtkPVRenderView::StillRender()
 {
@@ -1535,6 +1582,17 @@ void vtkPVRenderView::Render(bool interactive, bool skip_rendering)
   if (use_lod_rendering)
   {
     this->RequestInformation->Set(USE_LOD(), 1);
+    if (this->NumberOfLODLevels > 1 && !this->UseOutlineForLODRendering)
+    {
+      this->RequestInformation->Set(LOD_RESOLUTION(), this->LODResolution);
+      this->RequestInformation->Set(NUMBER_OF_LOD_LEVELS(), this->NumberOfLODLevels);
+      this->RequestInformation->Set(
+        LOD_LEVEL(), std::min(this->LODLevel, this->NumberOfLODLevels - 1));
+      if (this->BuildLODLevelsInBackground)
+      {
+        this->RequestInformation->Set(BUILD_LOD_LEVELS_IN_BACKGROUND(), 1);
+      }
+    }
   }
 
   // cout << "Using remote rendering: " << use_distributed_rendering << endl;
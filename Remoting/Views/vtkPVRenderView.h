@@ -272,6 +272,60 @@ public:
   vtkGetMacro(UseOutlineForLODRendering, bool);
   //@}
 
+  //@{
+  /**
+   * Get/Set the number of levels of simplified geometry used for LOD
+   * rendering. The first level is decimated using LODResolution, each of the
+   * following ones with half the resolution of the previous one. The level
+   * rendered during interaction is picked using LODTargetFrameTime. Ignored
+   * when UseOutlineForLODRendering is true. Default is 1.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(NumberOfLODLevels, int, 1, 8);
+  vtkGetMacro(NumberOfLODLevels, int);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the target time, in seconds, of interactive renders when more
+   * than one LOD level is used. A coarser level is rendered after an
+   * interactive render taking longer than this, and a finer one after an
+   * interactive render taking less than half of it. Default is 0.05.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(LODTargetFrameTime, double, 0.001, VTK_DOUBLE_MAX);
+  vtkGetMacro(LODTargetFrameTime, double);
+  //@}
+
+  //@{
+  /**
+   * When true, representations build the LOD levels after the first one in a
+   * background thread, and render the finest level already built until the
+   * requested one is available. Default is true.
+   * \note CallOnAllProcesses
+   */
+  vtkSetMacro(BuildLODLevelsInBackground, bool);
+  vtkGetMacro(BuildLODLevelsInBackground, bool);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the LOD level rendered by interactive renders, 0 being the finest
+   * level. vtkSMRenderViewProxy sets it before each interactive render, using
+   * ComputeNextLODLevel, so that all rendering processes use the same level.
+   * \note CallOnAllProcesses
+   */
+  vtkSetClampMacro(LODLevel, int, 0, VTK_INT_MAX);
+  vtkGetMacro(LODLevel, int);
+  //@}
+
+  /**
+   * Returns the LOD level the next interactive render should use given the
+   * time, in seconds, the last one took. The level changes by at most one so
+   * that the geometry is refined progressively as the frame time allows.
+   */
+  int ComputeNextLODLevel(double lastFrameTime) const;
+
   /**
    * Passes the compressor configuration to the client-server synchronizer, if
    * any. This affects the image compression used to relay images back to the
@@ -319,6 +373,18 @@ public:
    */
   static vtkInformationIntegerKey* USE_OUTLINE_FOR_LOD();
 
+  //@{
+  /**
+   * Indicate the number of LOD levels, the level to render and whether the
+   * levels are built in the background in REQUEST_RENDER() pass. Only set
+   * when USE_LOD() is set and more than one LOD level is used, along with
+   * LOD_RESOLUTION() which the first level was decimated with.
+   */
+  static vtkInformationIntegerKey* NUMBER_OF_LOD_LEVELS();
+  static vtkInformationIntegerKey* LOD_LEVEL();
+  static vtkInformationIntegerKey* BUILD_LOD_LEVELS_IN_BACKGROUND();
+  //@}
+
   /**
    * Representation can publish this key in their REQUEST_INFORMATION()
    * pass to indicate that the representation needs to disable
@@ -1235,6 +1301,10 @@ protected:
   bool Blur;
 
   double LODResolution;
+  int NumberOfLODLevels;
+  double LODTargetFrameTime;
+  bool BuildLODLevelsInBackground;
+  int LODLevel;
   bool UseLightKit;
 
   bool UsedLODForLastRender;
@@ -50,6 +50,8 @@ vtkPVRenderViewSettings::vtkPVRenderViewSettings()
   , PointPickingRadius(0)
   , DisableIceT(false)
   , EnableFastPreselection(false)
+  , CacheMemoryBudget(0)
+  , GeometryFilterThreads(0)
   , BackgroundColor{ 0, 0, 0 }
   , Background2Color{ 0, 0, 0 }
   , BackgroundColorMode(vtkPVRenderView::DEFAULT)
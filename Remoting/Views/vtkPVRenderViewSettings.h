@@ -113,6 +113,28 @@ public:
   vtkGetMacro(EnableFastPreselection, bool);
   //@}
 
+  //@{
+  /**
+   * Set the memory budget (in megabytes) for data cached by views, e.g. when
+   * caching geometry for animations. When exceeded, the least recently used
+   * cached data is released. 0 means no limit. See
+   * vtkPVDataDeliveryManager::GetCacheEntriesToEvict.
+   */
+  vtkSetClampMacro(CacheMemoryBudget, vtkIdType, 0, VTK_ID_MAX);
+  vtkGetMacro(CacheMemoryBudget, vtkIdType);
+  //@}
+
+  ///@{
+  /**
+   * Set the maximum number of threads used to extract the surfaces of the
+   * blocks of composite datasets for rendering. 0 means no limit and 1 extracts
+   * the surfaces serially. vtkGeometryRepresentation passes it to its
+   * vtkPVGeometryFilter, see vtkPVGeometryFilter::SetNumberOfThreads.
+   */
+  vtkSetClampMacro(GeometryFilterThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(GeometryFilterThreads, int);
+  ///@}
+
   ///@{
   /**
    * Used by vtkPVRenderView and other views to determine background color.
@@ -133,6 +155,8 @@ protected:
   int PointPickingRadius;
   bool DisableIceT;
   bool EnableFastPreselection;
+  vtkIdType CacheMemoryBudget;
+  int GeometryFilterThreads;
 
   double BackgroundColor[3];
   double Background2Color[3];
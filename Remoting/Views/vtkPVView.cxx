@@ -25,6 +25,7 @@
 #include "vtkMPIMoveData.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessStream.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
 #include "vtkOpenGLState.h"
 #include "vtkPVDataDeliveryManager.h"
@@ -478,6 +479,55 @@ void vtkPVView::Update()
   this->UpdateTimeStamp.Modified();
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::Prefetch(double time)
+{
+  if (!this->UseCache || !this->ViewTimeValid || this->ViewTime == time)
+  {
+    return;
+  }
+
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "%s: prefetch time %g",
+    this->GetLogName().c_str(), time);
+
+  const int num_reprs = this->GetNumberOfRepresentations();
+  const double view_time = this->GetViewTime();
+  const double cache_key = this->CacheKey;
+
+  // Use scratch information objects so that the reply from the last Update()
+  // is left untouched for the render passes.
+  vtkNew<vtkInformation> request;
+  vtkNew<vtkInformationVector> reply;
+
+  // Execute the pipelines for the requested time. Since representations save
+  // the results of the REQUEST_UPDATE pass keyed by the view's CacheKey, this
+  // deposits the data in the cache. Representations that are not temporal are
+  // not marked modified by SetUpdateTime() and hence keep their current key.
+  this->CacheKey = time;
+  for (int cc = 0; cc < num_reprs; cc++)
+  {
+    if (auto pvrepr = vtkPVDataRepresentation::SafeDownCast(this->GetRepresentation(cc)))
+    {
+      pvrepr->SetUpdateTime(time);
+    }
+  }
+  vtkTimerLog::MarkStartEvent("vtkPVView::Prefetch");
+  this->CallProcessViewRequest(vtkPVView::REQUEST_UPDATE(), request, reply);
+  vtkTimerLog::MarkEndEvent("vtkPVView::Prefetch");
+
+  // Restore the current time. The data for it is already cached, so this
+  // simply resets the representations to use the current cache key again.
+  this->CacheKey = cache_key;
+  for (int cc = 0; cc < num_reprs; cc++)
+  {
+    if (auto pvrepr = vtkPVDataRepresentation::SafeDownCast(this->GetRepresentation(cc)))
+    {
+      pvrepr->SetUpdateTime(view_time);
+    }
+  }
+  this->CallProcessViewRequest(vtkPVView::REQUEST_UPDATE(), request, reply);
+}
+
 //----------------------------------------------------------------------------
 void vtkPVView::SynchronizeRepresentationTemporalPipelineStates()
 {
@@ -838,6 +888,92 @@ void vtkPVView::AllReduce(
   vtkVLogF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "source=%llu, result=%llu", arg_source, dest);
 }
 
+//----------------------------------------------------------------------------
+void vtkPVView::AllGather(
+  const vtkMultiProcessStream& source, std::vector<vtkMultiProcessStream>& dest)
+{
+  assert(this->Session);
+  vtkVLogScopeF(PARAVIEW_LOG_RENDERING_VERBOSITY(), "all-gather");
+
+  // streams are exchanged with the client as a single stream holding their
+  // count followed by each of them.
+  auto pack = [](const std::vector<vtkMultiProcessStream>& streams) {
+    vtkMultiProcessStream packed;
+    packed << static_cast<int>(streams.size());
+    for (const auto& stream : streams)
+    {
+      packed << stream;
+    }
+    return packed;
+  };
+  auto unpack = [](vtkMultiProcessStream& packed, std::vector<vtkMultiProcessStream>& streams) {
+    int count;
+    packed >> count;
+    for (int cc = 0; cc < count; ++cc)
+    {
+      vtkMultiProcessStream stream;
+      packed >> stream;
+      streams.push_back(stream);
+    }
+  };
+
+  std::vector<vtkMultiProcessStream> streams;
+  auto pController = vtkMultiProcessController::GetGlobalController();
+  if (pController)
+  {
+    pController->Gather(source, streams, 0);
+  }
+  else
+  {
+    streams.push_back(source);
+  }
+  vtkMultiProcessStream packed = pack(streams);
+
+  auto cController = this->Session->GetController(vtkPVSession::CLIENT);
+  if (cController)
+  {
+    assert(pController == nullptr || pController->GetLocalProcessId() == 0);
+    cController->Send(packed, 1, 41236);
+    cController->Receive(packed, 1, 41237);
+  }
+
+  auto crController = this->Session->GetController(vtkPVSession::RENDER_SERVER_ROOT);
+  auto cdController = this->Session->GetController(vtkPVSession::DATA_SERVER_ROOT);
+  if (crController == cdController)
+  {
+    cdController = nullptr;
+  }
+
+  if (crController || cdController)
+  {
+    for (auto controller : { crController, cdController })
+    {
+      if (controller)
+      {
+        vtkMultiProcessStream remote;
+        controller->Receive(remote, 1, 41236);
+        unpack(remote, streams);
+      }
+    }
+    packed = pack(streams);
+    for (auto controller : { crController, cdController })
+    {
+      if (controller)
+      {
+        controller->Send(packed, 1, 41237);
+      }
+    }
+  }
+
+  if (pController)
+  {
+    pController->Broadcast(packed, 0);
+  }
+
+  dest.clear();
+  unpack(packed, dest);
+}
+
 //-----------------------------------------------------------------------------
 void vtkPVView::SetTileScale(int x, int y)
 {
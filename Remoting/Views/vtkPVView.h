@@ -30,11 +30,14 @@
 #include "vtkView.h"
 #include "vtkWeakPointer.h" // for vtkWeakPointer
 
+#include <vector> // for std::vector
+
 class vtkBoundingBox;
 class vtkInformation;
 class vtkInformationObjectBaseKey;
 class vtkInformationRequestKey;
 class vtkInformationVector;
+class vtkMultiProcessStream;
 class vtkPVDataDeliveryManager;
 class vtkPVDataRepresentation;
 class vtkPVSession;
@@ -120,6 +123,21 @@ public:
   vtkGetMacro(UseCache, bool);
   //@}
 
+  /**
+   * Prepares and caches the representations' data for the given time without
+   * rendering it. The data is stored in the delivery manager's cache with
+   * `time` as the cache key, so that a subsequent Update() with the same
+   * CacheKey skips executing the pipelines. This is used by
+   * vtkSMAnimationScene to let the data-server work ahead of the animation
+   * while the client is busy with the current frame. It is a no-op unless
+   * UseCache is true and the view time is valid.
+   *
+   * Unlike Update(), this method does not communicate with the client or the
+   * render-server and hence is safe to invoke asynchronously on the
+   * data-server processes alone.
+   */
+  virtual void Prefetch(double time);
+
   //@{
   /**
    * These methods are used to setup the view for capturing screen shots.
@@ -318,6 +336,12 @@ protected:
   void AllReduce(
     const vtkTypeUInt64 source, vtkTypeUInt64& dest, int operation, bool skip_data_server = false);
 
+  /**
+   * Gather the streams from all participating processes on all of them. The
+   * order of the streams in `dest` is the same on all processes.
+   */
+  void AllGather(const vtkMultiProcessStream& source, std::vector<vtkMultiProcessStream>& dest);
+
   //@{
   /**
    * Overridden to assign IDs to each representation. This assumes that
@@ -64,6 +64,7 @@
 #include "vtkSelection.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
+#include "vtkTimerLog.h"
 #include "vtkTransform.h"
 #include "vtkWeakPointer.h"
 
@@ -77,6 +78,8 @@ vtkSMRenderViewProxy::vtkSMRenderViewProxy()
   this->IsSelectionCached = false;
   this->NewMasterObserverId = 0;
   this->NeedsUpdateLOD = true;
+  this->InteractiveRenderStartTime = 0.0;
+  this->LastInteractiveRenderTime = 0.0;
   this->InteractorHelper->SetViewProxy(this);
 }
 
@@ -239,6 +242,22 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
     // for interactive renders, we need to determine if we are going to use LOD.
     // If so, we may need to update the LOD geometries.
     this->UpdateLOD();
+
+    // pick the LOD level from the time the last interactive render took. It is
+    // picked here, and not by each rendering process, so that they all
+    // render the same level.
+    const int level = rv->ComputeNextLODLevel(this->LastInteractiveRenderTime);
+    if (level != rv->GetLODLevel())
+    {
+      vtkClientServerStream stream;
+      stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "SetLODLevel" << level
+             << vtkClientServerStream::End;
+      this->ExecuteStream(stream, false, rv->GetInteractiveRenderProcesses());
+    }
+  }
+  if (interactive)
+  {
+    this->InteractiveRenderStartTime = vtkTimerLog::GetUniversalTime();
   }
 
   return interactive ? rv->GetInteractiveRenderProcesses() : rv->GetStillRenderProcesses();
@@ -247,6 +266,11 @@ vtkTypeUInt32 vtkSMRenderViewProxy::PreRender(bool interactive)
 //-----------------------------------------------------------------------------
 void vtkSMRenderViewProxy::PostRender(bool interactive)
 {
+  if (interactive)
+  {
+    this->LastInteractiveRenderTime =
+      vtkTimerLog::GetUniversalTime() - this->InteractiveRenderStartTime;
+  }
   vtkSMProxy* cameraProxy = this->GetSubProxy("ActiveCamera");
   cameraProxy->UpdatePropertyInformation();
   this->SynchronizeCameraProperties();
@@ -274,6 +274,11 @@ protected:
 
   bool NeedsUpdateLOD;
 
+  // Used to pick the LOD level of interactive renders (see
+  // vtkPVRenderView::SetNumberOfLODLevels).
+  double InteractiveRenderStartTime;
+  double LastInteractiveRenderTime;
+
 private:
   vtkSMRenderViewProxy(const vtkSMRenderViewProxy&) = delete;
   void operator=(const vtkSMRenderViewProxy&) = delete;
@@ -479,6 +479,22 @@ void vtkSMViewProxy::Update()
   }
 }
 
+//----------------------------------------------------------------------------
+void vtkSMViewProxy::Prefetch(double time)
+{
+  auto session = this->GetSession();
+  if (!this->ObjectsCreated || !session ||
+    (session->GetProcessRoles() & vtkPVSession::DATA_SERVER) != 0)
+  {
+    return;
+  }
+
+  vtkClientServerStream stream;
+  stream << vtkClientServerStream::Invoke << VTKOBJECT(this) << "Prefetch" << time
+         << vtkClientServerStream::End;
+  this->ExecuteStream(stream, false, vtkPVSession::DATA_SERVER);
+}
+
 //----------------------------------------------------------------------------
 vtkSMRepresentationProxy* vtkSMViewProxy::CreateDefaultRepresentation(
   vtkSMProxy* proxy, int outputPort)
@@ -82,6 +82,14 @@ public:
    */
   virtual void Update();
 
+  /**
+   * Calls vtkPVView::Prefetch on the data-server. The request is sent without
+   * waiting for a reply, hence the data-server can work on preparing the data
+   * for `time` while the client is busy. This is a no-op in builtin sessions
+   * since there's no idle server to do the work.
+   */
+  virtual void Prefetch(double time);
+
   /**
    * Returns true if the view can display the data produced by the producer's
    * port. Internally calls GetRepresentationType() and returns true only if the
@@ -26,6 +26,7 @@
 #include "vtkFieldData.h"
 #include "vtkIdTypeArray.h"
 #include "vtkInformation.h"
+#include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMarkSelectedRows.h"
 #include "vtkMemberFunctionCommand.h"
@@ -42,6 +43,7 @@
 #include "vtkSpreadSheetRepresentation.h"
 #include "vtkStringArray.h"
 #include "vtkTable.h"
+#include "vtkTableAlgorithm.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkVariant.h"
 
@@ -274,6 +276,131 @@ private:
   void operator=(const SpreadSheetViewMergeTables&) = delete;
 };
 vtkStandardNewMacro(SpreadSheetViewMergeTables);
+
+/**
+ * Removes the columns hidden in the view from the blocks so that they are not
+ * reduced nor delivered to the client. The columns used to identify rows for
+ * selection, and the internal columns of visible columns, are always kept.
+ */
+class SpreadSheetViewProjectColumns : public vtkTableAlgorithm
+{
+public:
+  static SpreadSheetViewProjectColumns* New();
+  vtkTypeMacro(SpreadSheetViewProjectColumns, vtkTableAlgorithm);
+
+  vtkSpreadSheetView* View = nullptr;
+
+  /**
+   * Updates the columns to remove. Returns true if they changed.
+   */
+  bool SetHiddenColumns(const std::set<std::string>& names, const std::set<std::string>& labels)
+  {
+    if (names == this->HiddenColumnsByName && labels == this->HiddenColumnsByLabel)
+    {
+      return false;
+    }
+    this->HiddenColumnsByName = names;
+    this->HiddenColumnsByLabel = labels;
+    this->Modified();
+    return true;
+  }
+
+protected:
+  SpreadSheetViewProjectColumns() = default;
+  ~SpreadSheetViewProjectColumns() override = default;
+
+  int RequestData(vtkInformation*, vtkInformationVector** inputVector,
+    vtkInformationVector* outputVector) override
+  {
+    auto input = vtkTable::GetData(inputVector[0], 0);
+    auto output = vtkTable::GetData(outputVector, 0);
+    output->Initialize();
+    output->GetFieldData()->ShallowCopy(input->GetFieldData());
+    for (vtkIdType cc = 0, max = input->GetNumberOfColumns(); cc < max; ++cc)
+    {
+      auto column = input->GetColumn(cc);
+      const char* name = column ? column->GetName() : nullptr;
+      if (name && std::strstr(name, "__vtkValidMask__") == name)
+      {
+        // masks follow the visibility of the column they apply to.
+        column = input->GetColumnByName(name + std::strlen("__vtkValidMask__"));
+        if (column && !this->IsHidden(column))
+        {
+          output->AddColumn(input->GetColumn(cc));
+        }
+      }
+      else if (column && !this->IsHidden(column))
+      {
+        output->AddColumn(column);
+      }
+    }
+    return 1;
+  }
+
+  bool IsHidden(vtkAbstractArray* column) const
+  {
+    const char* name = column->GetName();
+    if (name == nullptr || strcmp(name, "vtkOriginalProcessIds") == 0 ||
+      strcmp(name, "vtkCompositeIndexArray") == 0 || strcmp(name, "vtkOriginalIndices") == 0 ||
+      this->View->IsColumnInternal(name))
+    {
+      return false;
+    }
+    if (this->HiddenColumnsByName.find(name) != this->HiddenColumnsByName.end())
+    {
+      return true;
+    }
+
+    // same as vtkSpreadSheetView::GetColumnLabel, which relies on the column
+    // metadata only available on the client.
+    bool converted = false;
+    std::string label = ::get_userfriendly_name(name, this->View, &converted);
+    auto info = column->HasInformation() ? column->GetInformation() : nullptr;
+    if (!converted && info && info->Has(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME()) &&
+      info->Has(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) &&
+      info->Get(vtkSplitColumnComponents::ORIGINAL_COMPONENT_NUMBER()) >= 0)
+    {
+      label = info->Get(vtkSplitColumnComponents::ORIGINAL_ARRAY_NAME());
+    }
+    return this->HiddenColumnsByLabel.find(label) != this->HiddenColumnsByLabel.end();
+  }
+
+  std::set<std::string> HiddenColumnsByName;
+  std::set<std::string> HiddenColumnsByLabel;
+
+private:
+  SpreadSheetViewProjectColumns(const SpreadSheetViewProjectColumns&) = delete;
+  void operator=(const SpreadSheetViewProjectColumns&) = delete;
+};
+vtkStandardNewMacro(SpreadSheetViewProjectColumns);
+
+/// returns a table with `size` rows of `table` starting at `offset`.
+vtkSmartPointer<vtkTable> SliceRows(vtkTable* table, vtkIdType offset, vtkIdType size)
+{
+  auto slice = vtkSmartPointer<vtkTable>::New();
+  slice->GetFieldData()->ShallowCopy(table->GetFieldData());
+  const vtkIdType count = std::max(
+    static_cast<vtkIdType>(0), std::min(size, table->GetNumberOfRows() - offset));
+  for (vtkIdType cc = 0, max = table->GetNumberOfColumns(); cc < max; ++cc)
+  {
+    auto column = table->GetColumn(cc);
+    auto array = vtkSmartPointer<vtkAbstractArray>::Take(column->NewInstance());
+    array->SetName(column->GetName());
+    array->SetNumberOfComponents(column->GetNumberOfComponents());
+    array->CopyComponentNames(column);
+    if (column->HasInformation())
+    {
+      array->CopyInformation(column->GetInformation());
+    }
+    array->SetNumberOfTuples(count);
+    if (count > 0)
+    {
+      array->InsertTuples(0, count, offset, column);
+    }
+    slice->AddColumn(array);
+  }
+  return slice;
+}
 }
 
 class vtkSpreadSheetView::vtkInternals
@@ -330,15 +457,18 @@ class vtkSpreadSheetView::vtkInternals
   public:
     vtkSmartPointer<vtkTable> Dataobject;
     vtkTimeStamp RecentUseTime;
+    unsigned long Size = 0; // in KiB
   };
 
   typedef std::map<vtkIdType, CacheInfo> CacheType;
   CacheType CachedBlocks;
+  unsigned long CacheSize = 0; // in KiB
 
 public:
   void ClearCache()
   {
     this->CachedBlocks.clear();
+    this->CacheSize = 0;
     this->ColumnMetaData.clear();
     this->ColumnIndexMap.clear();
   }
@@ -395,29 +525,20 @@ public:
     return nullptr;
   }
 
-  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, vtkIdType max)
+  bool IsCached(vtkIdType blockId) const
+  {
+    return this->CachedBlocks.find(blockId) != this->CachedBlocks.end();
+  }
+
+  vtkTable* AddToCache(vtkIdType blockId, vtkTable* data, unsigned long cacheLimit)
   {
     CacheType::iterator iter = this->CachedBlocks.find(blockId);
     if (iter != this->CachedBlocks.end())
     {
+      this->CacheSize -= iter->second.Size;
       this->CachedBlocks.erase(iter);
     }
 
-    if (static_cast<vtkIdType>(this->CachedBlocks.size()) == max)
-    {
-      // remove least-recent-used block.
-      iter = this->CachedBlocks.begin();
-      CacheType::iterator iterToRemove = this->CachedBlocks.begin();
-      for (; iter != this->CachedBlocks.end(); ++iter)
-      {
-        if (iterToRemove->second.RecentUseTime > iter->second.RecentUseTime)
-        {
-          iterToRemove = iter;
-        }
-      }
-      this->CachedBlocks.erase(iterToRemove);
-    }
-
     CacheInfo info;
     vtkTable* clone = vtkTable::New();
 
@@ -446,7 +567,26 @@ public:
     }
     info.Dataobject = clone;
     clone->FastDelete();
+    info.Size = clone->GetActualMemorySize();
+
+    // remove least-recent-used blocks until the new block fits. The new block
+    // is always kept, even if it exceeds the limit on its own.
+    while (!this->CachedBlocks.empty() && this->CacheSize + info.Size > cacheLimit)
+    {
+      CacheType::iterator iterToRemove = this->CachedBlocks.begin();
+      for (iter = this->CachedBlocks.begin(); iter != this->CachedBlocks.end(); ++iter)
+      {
+        if (iterToRemove->second.RecentUseTime > iter->second.RecentUseTime)
+        {
+          iterToRemove = iter;
+        }
+      }
+      this->CacheSize -= iterToRemove->second.Size;
+      this->CachedBlocks.erase(iterToRemove);
+    }
+
     info.RecentUseTime.Modified();
+    this->CacheSize += info.Size;
     this->CachedBlocks[blockId] = info;
     this->MostRecentlyAccessedBlock = blockId;
     if (this->CachedBlocks.size() == 1)
@@ -480,6 +620,8 @@ public:
   }
 
   vtkIdType MostRecentlyAccessedBlock;
+  vtkIdType LastFetchedBlock = -1;
+  vtkNew<SpreadSheetViewProjectColumns> ColumnProjection;
   vtkWeakPointer<vtkSpreadSheetRepresentation> ActiveRepresentation;
   vtkCommand* Observer;
 
@@ -491,14 +633,14 @@ namespace
 {
 void FetchRMI(void* localArg, void* remoteArg, int remoteArgLength, int)
 {
-  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 2);
+  assert(remoteArgLength == sizeof(vtkTypeUInt64) * 3);
   (void)remoteArgLength;
 
   auto arg = reinterpret_cast<vtkTypeUInt64*>(remoteArg);
   vtkSpreadSheetView* self = reinterpret_cast<vtkSpreadSheetView*>(localArg);
   if (static_cast<vtkTypeUInt32>(self->GetIdentifier()) == arg[0])
   {
-    self->FetchBlockCallback(static_cast<vtkIdType>(arg[1]));
+    self->FetchBlockCallback(static_cast<vtkIdType>(arg[1]), static_cast<vtkIdType>(arg[2]));
   }
 }
 
@@ -568,6 +710,8 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   , ReductionFilter(vtkReductionFilter::New())
   , DeliveryFilter(vtkClientServerMoveData::New())
   , NumberOfRows(0)
+  , CacheLimit(65536)
+  , NumberOfPrefetchBlocks(2)
   , CRMICallbackTag(0)
   , PRMICallbackTag(0)
   , Identifier(0)
@@ -578,7 +722,9 @@ vtkSpreadSheetView::vtkSpreadSheetView()
   this->ReductionFilter->SetController(vtkMultiProcessController::GetGlobalController());
   this->ReductionFilter->SetPostGatherHelper(vtkNew<SpreadSheetViewMergeTables>().GetPointer());
   this->DeliveryFilter->SetOutputDataType(VTK_TABLE);
-  this->ReductionFilter->SetInputConnection(this->TableStreamer->GetOutputPort());
+  this->Internals->ColumnProjection->View = this;
+  this->Internals->ColumnProjection->SetInputConnection(this->TableStreamer->GetOutputPort());
+  this->ReductionFilter->SetInputConnection(this->Internals->ColumnProjection->GetOutputPort());
 
   this->Internals->MostRecentlyAccessedBlock = -1;
   this->Internals->Observer =
@@ -717,6 +863,8 @@ bool vtkSpreadSheetView::IsColumnInternal(const char* columnName)
 void vtkSpreadSheetView::PrintSelf(ostream& os, vtkIndent indent)
 {
   this->Superclass::PrintSelf(os, indent);
+  os << indent << "CacheLimit: " << this->CacheLimit << endl;
+  os << indent << "NumberOfPrefetchBlocks: " << this->NumberOfPrefetchBlocks << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -799,6 +947,17 @@ int vtkSpreadSheetView::StreamToClient()
     this->SomethingUpdated = true;
   }
   this->NumberOfRows = num_rows;
+
+  // hidden columns are not delivered, hence changing them requires fetching
+  // the blocks again. This is only done here so that all cached blocks always
+  // have the same columns.
+  auto& internals = *this->Internals;
+  if (internals.ColumnProjection->SetHiddenColumns(
+        internals.HiddenColumnsByName, internals.HiddenColumnsByLabel))
+  {
+    this->SomethingUpdated = true;
+  }
+
   if (this->SomethingUpdated)
   {
     this->ClearCache();
@@ -817,20 +976,56 @@ void vtkSpreadSheetView::OnRepresentationUpdated()
 //----------------------------------------------------------------------------
 vtkTable* vtkSpreadSheetView::FetchBlock(vtkIdType blockindex)
 {
-  vtkTable* block = this->Internals->GetDataObject(blockindex);
+  auto& internals = *this->Internals;
+  vtkTable* block = internals.GetDataObject(blockindex);
   if (!block)
   {
-    block = this->FetchBlockCallback(blockindex);
-    // use the block returned from the AddToCache since that is cleaned up
-    // to have columns in correct order.
-    block = this->Internals->AddToCache(blockindex, block, 10);
+    // fetch the neighbouring blocks that are not cached yet, in the direction
+    // the view is being scrolled, in the same round trip.
+    const vtkIdType blockSize = this->TableStreamer->GetBlockSize();
+    const vtkIdType lastBlock = this->NumberOfRows > 0 ? (this->NumberOfRows - 1) / blockSize : 0;
+    const vtkIdType step = blockindex < internals.LastFetchedBlock ? -1 : 1;
+    vtkIdType first = blockindex;
+    vtkIdType count = 1;
+    for (vtkIdType next = blockindex + step; count <= this->NumberOfPrefetchBlocks && next >= 0 &&
+         next <= lastBlock && !internals.IsCached(next);
+         next += step)
+    {
+      first = std::min(first, next);
+      ++count;
+    }
+    internals.LastFetchedBlock = blockindex;
+
+    block = this->FetchBlockCallback(first, count);
+    if (count > 1 && block)
+    {
+      // cache the prefetched blocks first so that the requested block is the
+      // most recently used one.
+      vtkSmartPointer<vtkTable> fetched = block;
+      for (vtkIdType cc = 0; cc < count; ++cc)
+      {
+        if (first + cc != blockindex)
+        {
+          internals.AddToCache(
+            first + cc, ::SliceRows(fetched, cc * blockSize, blockSize), this->CacheLimit);
+        }
+      }
+      block = internals.AddToCache(blockindex,
+        ::SliceRows(fetched, (blockindex - first) * blockSize, blockSize), this->CacheLimit);
+    }
+    else
+    {
+      // use the block returned from the AddToCache since that is cleaned up
+      // to have columns in correct order.
+      block = internals.AddToCache(blockindex, block, this->CacheLimit);
+    }
     this->InvokeEvent(vtkCommand::UpdateEvent, &blockindex);
   }
   return block;
 }
 
 //----------------------------------------------------------------------------
-vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
+vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex, vtkIdType numberOfBlocks)
 {
   // Sanity Check
   if (!this->Internals->ActiveRepresentation)
@@ -839,19 +1034,21 @@ vtkTable* vtkSpreadSheetView::FetchBlockCallback(vtkIdType blockindex)
   }
 
   // cout << "FetchBlockCallback" << endl;
-  vtkTypeUInt64 data[2] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex) };
+  vtkTypeUInt64 data[3] = { this->Identifier, static_cast<vtkTypeUInt64>(blockindex),
+    static_cast<vtkTypeUInt64>(numberOfBlocks) };
   if (auto dController = this->GetSession()->GetController(vtkPVSession::DATA_SERVER_ROOT))
   {
-    dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    dController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 3, FETCH_BLOCK_TAG);
   }
   auto pController = vtkMultiProcessController::GetGlobalController();
   if (pController && pController->GetLocalProcessId() == 0 &&
     pController->GetNumberOfProcesses() > 1)
   {
-    pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 2, FETCH_BLOCK_TAG);
+    pController->TriggerRMIOnAllChildren(data, sizeof(vtkTypeUInt64) * 3, FETCH_BLOCK_TAG);
   }
 
   this->TableStreamer->SetBlock(blockindex);
+  this->TableStreamer->SetNumberOfBlocks(static_cast<int>(numberOfBlocks));
   this->TableStreamer->Modified();
   this->TableSelectionMarker->SetFieldAssociation(this->FieldAssociation);
   this->ReductionFilter->Modified();
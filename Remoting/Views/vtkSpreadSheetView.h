@@ -212,6 +212,29 @@ public:
    */
   void SetBlockSize(vtkIdType val);
 
+  //@{
+  /**
+   * Get/Set the maximum size, in KiB, of the blocks cached on the client.
+   * The least recently used blocks are discarded first when the limit is
+   * reached. Default is 65536 (64 MiB).
+   * \note CallOnClient
+   */
+  vtkSetMacro(CacheLimit, unsigned long);
+  vtkGetMacro(CacheLimit, unsigned long);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the number of blocks following the requested one, in the
+   * direction the view is being scrolled, that are fetched along with it when
+   * it is not cached. Hidden columns are never delivered to the client, so the
+   * cost of prefetching only depends on the visible columns. Default is 2.
+   * \note CallOnClient
+   */
+  vtkSetClampMacro(NumberOfPrefetchBlocks, int, 0, 16);
+  vtkGetMacro(NumberOfPrefetchBlocks, int);
+  //@}
+
   /**
    * Export the contents of this view using the exporter.
    */
@@ -224,7 +247,7 @@ public:
   using Superclass::ClearCache;
 
   // INTERNAL METHOD. Don't call directly.
-  vtkTable* FetchBlockCallback(vtkIdType blockindex);
+  vtkTable* FetchBlockCallback(vtkIdType blockindex, vtkIdType numberOfBlocks = 1);
 
 protected:
   vtkSpreadSheetView();
@@ -249,6 +272,8 @@ protected:
   vtkReductionFilter* ReductionFilter;
   vtkClientServerMoveData* DeliveryFilter;
   vtkIdType NumberOfRows;
+  unsigned long CacheLimit;
+  int NumberOfPrefetchBlocks;
 
   unsigned long CRMICallbackTag;
   unsigned long PRMICallbackTag;
@@ -94,10 +94,15 @@ void output_temp(FILE* fp, int i, unsigned int argType, const char* Id, int coun
     return;
   }
 
-  /* Start pointer-to-data arguments.  */
+  /* Start pointer-to-data arguments.  Read-only data is used in place in
+     the message when possible.  */
   if (isPointerToData)
   {
     fprintf(fp, "vtkClientServerStreamDataArg<");
+    if ((argType & VTK_PARSE_CONST) != 0)
+    {
+      fprintf(fp, "const ");
+    }
   }
 
   if (argType & VTK_PARSE_UNSIGNED)
@@ -14,16 +14,18 @@
 =========================================================================*/
 #include "vtkAMRDualClip.h"
 #include "vtkAMRDualGridHelper.h"
-
-#include <vector>
+#include "vtkAMRDualPiecesInternal.h"
 
 // Pipeline & VTK
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVSMPToolsInternal.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -44,8 +46,12 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <memory>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkAMRDualClip);
 
@@ -98,6 +104,12 @@ public:
   // This is called multiple times to prepare for a new block.
   void Initialize(int xDualCellDim, int yDualCellDim, int zDualCellDim);
 
+  // Description:
+  // Allocates the point id arrays if needed and clears them. This has to be
+  // called before any point is looked up. Unlike the level mask, point ids
+  // are only needed while the block is processed.
+  void InitializePointIds();
+
   // Description:
   // Lookup and setting uses this pointer. Using a pointer keeps
   // the contour filter from having to lookup a point and second
@@ -120,9 +132,6 @@ public:
   // Used to share point ids between block locators.
   void SharePointIdsWithNeighbor(vtkAMRDualClipLocator* neighborLocator, int rx, int ry, int rz);
 
-  void ShareBlockLocatorWithNeighbor(
-    vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
-
   // The level mask could be a separate object, but it is used
   // by the locator to position points.
   // This computes just the center region.
@@ -611,6 +620,11 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
       delete[] this->YEdges;
       delete[] this->ZEdges;
       delete[] this->Corners;
+      this->XEdges = this->YEdges = this->ZEdges = nullptr;
+      this->Corners = nullptr;
+    }
+    if (this->LevelMaskArray)
+    {
       this->LevelMaskArray->Delete();
       this->LevelMaskArray = nullptr;
     }
@@ -623,10 +637,6 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
       this->YIncrement = this->DualCellDimensions[0] + 1;
       this->ZIncrement = this->YIncrement * (this->DualCellDimensions[1] + 1);
       this->ArrayLength = this->ZIncrement * (this->DualCellDimensions[2] + 1);
-      this->XEdges = new vtkIdType[this->ArrayLength];
-      this->YEdges = new vtkIdType[this->ArrayLength];
-      this->ZEdges = new vtkIdType[this->ArrayLength];
-      this->Corners = new vtkIdType[this->ArrayLength];
       this->LevelMaskArray = vtkUnsignedCharArray::New();
       this->LevelMaskArray->SetNumberOfTuples(this->ArrayLength);
       // 255 is a special value that means the pixel is uninitialized.
@@ -641,7 +651,18 @@ void vtkAMRDualClipLocator::Initialize(int xDualCellDim, int yDualCellDim, int z
       this->DualCellDimensions[2] = 0;
     }
   }
+}
 
+//----------------------------------------------------------------------------
+void vtkAMRDualClipLocator::InitializePointIds()
+{
+  if (this->XEdges == nullptr && this->ArrayLength > 0)
+  {
+    this->XEdges = new vtkIdType[this->ArrayLength];
+    this->YEdges = new vtkIdType[this->ArrayLength];
+    this->ZEdges = new vtkIdType[this->ArrayLength];
+    this->Corners = new vtkIdType[this->ArrayLength];
+  }
   for (int idx = 0; idx < this->ArrayLength; ++idx)
   {
     this->XEdges[idx] = this->YEdges[idx] = this->ZEdges[idx] = -1;
@@ -855,164 +876,86 @@ void vtkAMRDualClipLocator::SharePointIdsWithNeighbor(
   }
 }
 
-//----------------------------------------------------------------------------
-// This version works with higher level neighbor blocks.
-// Move the points on boundaries to neighbor locator so there will
-// not be duplicate coincident points between blocks.
-void vtkAMRDualClipLocator::ShareBlockLocatorWithNeighbor(
-  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor)
+//============================================================================
+// Tetrahedra generated from a single block. Point ids are local to the piece.
+// Points that a neighbor block may generate as well are kept with their key
+// so that the pieces can be merged when they are appended.
+class vtkAMRDualClipPiece
 {
-  vtkAMRDualClipLocator* blockLocator = vtkAMRDualClipGetBlockLocator(block);
-  vtkAMRDualClipLocator* neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
+public:
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Cells;
+  vtkNew<vtkIntArray> BlockIds;
+  vtkNew<vtkPointData> PointData;
+  vtkNew<vtkUnsignedCharArray> LevelMask;
+  std::vector<std::pair<vtkAMRDualPointKey, vtkIdType>> SharedPoints;
 
-  // Working on the logic to parallelize level mask.
-  if (blockLocator == nullptr || neighborLocator == nullptr)
-  { // This occurs if the block is owned by a different process.
-    return;
+  vtkAMRDualClipPiece(vtkCellData* attributes)
+  {
+    this->PointData->CopyAllocate(attributes);
+    this->LevelMask->SetName("LevelMask");
+    this->PointData->AddArray(this->LevelMask);
   }
 
-  // Compute the extent of the locator to copy.
-  // Moving too many will not hurt, so do not worry about which block owns the region.
-  // Start with the extent of the neighbor.  It is higher level.
-  int ext[6];
-
-  // Copy all possible overlap.
-  ext[0] = 0;
-  ext[1] = neighborLocator->DualCellDimensions[0];
-  ext[2] = 0;
-  ext[3] = neighborLocator->DualCellDimensions[1];
-  ext[4] = 0;
-  ext[5] = neighborLocator->DualCellDimensions[2];
+  vtkPointData* GetPointData() { return this->PointData; }
+};
 
-  // Now we need to convert the receiving low level block extent to the
-  // source high level block extent.
-  // Start with the out high level block.
-  ext[0] += neighbor->OriginIndex[0];
-  ext[1] += neighbor->OriginIndex[0];
-  ext[2] += neighbor->OriginIndex[1];
-  ext[3] += neighbor->OriginIndex[1];
-  ext[4] += neighbor->OriginIndex[2];
-  ext[5] += neighbor->OriginIndex[2];
-  // Convert to the in low level block index coordinate system.
-  int levelDiff = neighbor->Level - block->Level;
-  ext[0] = (ext[0] >> levelDiff) - block->OriginIndex[0];
-  ext[1] = (ext[1] >> levelDiff) - block->OriginIndex[0];
-  ext[2] = (ext[2] >> levelDiff) - block->OriginIndex[1];
-  ext[3] = (ext[3] >> levelDiff) - block->OriginIndex[1];
-  ext[4] = (ext[4] >> levelDiff) - block->OriginIndex[2];
-  ext[5] = (ext[5] >> levelDiff) - block->OriginIndex[2];
-  // Intersect with in (source) low level block.
-  if (ext[0] < 0)
-  {
-    ext[0] = 0;
-  }
-  if (ext[0] > blockLocator->DualCellDimensions[0])
-  {
-    ext[0] = blockLocator->DualCellDimensions[0];
-  }
-  if (ext[1] < 0)
-  {
-    ext[1] = 0;
-  }
-  if (ext[1] > blockLocator->DualCellDimensions[0])
-  {
-    ext[1] = blockLocator->DualCellDimensions[0];
-  }
-  if (ext[2] < 0)
-  {
-    ext[2] = 0;
-  }
-  if (ext[2] > blockLocator->DualCellDimensions[1])
-  {
-    ext[2] = blockLocator->DualCellDimensions[1];
-  }
-  if (ext[3] < 0)
-  {
-    ext[3] = 0;
-  }
-  if (ext[3] > blockLocator->DualCellDimensions[1])
-  {
-    ext[3] = blockLocator->DualCellDimensions[1];
-  }
-  if (ext[4] < 0)
-  {
-    ext[4] = 0;
-  }
-  if (ext[4] > blockLocator->DualCellDimensions[2])
-  {
-    ext[4] = blockLocator->DualCellDimensions[2];
+//============================================================================
+// Per-thread state used to clip one block at a time. The piece of the block
+// is only created once the block generates its first point.
+class vtkAMRDualClipWorkspace
+{
+public:
+  // Used for all blocks when points are not merged between blocks.
+  vtkAMRDualClipLocator SharedLocator;
+  vtkAMRDualClipLocator* Locator = nullptr;
+  std::unique_ptr<vtkAMRDualClipPiece> Piece;
+  vtkImageData* Image = nullptr;
+  bool MergePoints = false;
+  // Dual points at the corners of the current dual cell (level followed by
+  // global index) and whether they are close enough to the block boundary
+  // to be shared with a neighbor block.
+  int CornerDualPoints[8][4];
+  bool CornerShared[8];
+
+  vtkIdType InsertEdgePoint(int corner0, int corner1, const double pt[3])
+  {
+    vtkIdType ptId = this->InsertPoint(pt);
+    if (this->MergePoints && this->CornerShared[corner0] && this->CornerShared[corner1])
+    {
+      this->Piece->SharedPoints.emplace_back(
+        vtkAMRDualPointKey(this->CornerDualPoints[corner0], this->CornerDualPoints[corner1]),
+        ptId);
+    }
+    return ptId;
   }
-  if (ext[5] < 0)
+
+  vtkIdType InsertDualPoint(const int dualPoint[4], bool shared, const double pt[3])
   {
-    ext[5] = 0;
+    vtkIdType ptId = this->InsertPoint(pt);
+    if (this->MergePoints && shared)
+    {
+      this->Piece->SharedPoints.emplace_back(vtkAMRDualPointKey(dualPoint, dualPoint), ptId);
+    }
+    return ptId;
   }
-  if (ext[5] > blockLocator->DualCellDimensions[2])
+
+  void InsertCell(const vtkIdType pointIds[4], int blockId)
   {
-    ext[5] = blockLocator->DualCellDimensions[2];
+    this->Piece->Cells->InsertNextCell(4, pointIds);
+    this->Piece->BlockIds->InsertNextValue(blockId);
   }
 
-  vtkIdType pointId;
-  int xOut, yOut, zOut;
-  int inOffsetZ, inOffsetY, inOffsetX, outOffsetX, outOffsetY, outOffsetZ;
-  inOffsetZ = ext[0] + ext[2] * blockLocator->YIncrement + ext[4] * blockLocator->ZIncrement;
-  for (int zIn = ext[4]; zIn <= ext[5]; ++zIn)
+private:
+  vtkIdType InsertPoint(const double pt[3])
   {
-    inOffsetY = inOffsetZ;
-    // Compute the output index.
-    // Like the other places this locator indexconversion is done,
-    // The min ghost index is shifted to fit into the locator array.
-    zOut = ((zIn + block->OriginIndex[2]) << levelDiff) - neighbor->OriginIndex[2];
-    if (zOut < 0)
-    {
-      zOut = 0;
-    }
-    outOffsetZ = zOut * neighborLocator->ZIncrement;
-    for (int yIn = ext[2]; yIn <= ext[3]; ++yIn)
+    if (!this->Piece)
     {
-      inOffsetX = inOffsetY;
-      yOut = ((yIn + block->OriginIndex[1]) << levelDiff) - neighbor->OriginIndex[1];
-      if (yOut < 0)
-      {
-        yOut = 0;
-      }
-      outOffsetY = outOffsetZ + yOut * neighborLocator->YIncrement;
-      for (int xIn = ext[0]; xIn <= ext[1]; ++xIn)
-      {
-        xOut = ((xIn + block->OriginIndex[0]) << levelDiff) - neighbor->OriginIndex[0];
-        if (xOut < 0)
-        {
-          xOut = 0;
-        }
-        outOffsetX = outOffsetY + xOut;
-
-        pointId = blockLocator->XEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->XEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->YEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->YEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->ZEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->ZEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->Corners[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->Corners[outOffsetX] = pointId;
-        }
-
-        inOffsetX += 1;
-      }
-      inOffsetY += blockLocator->YIncrement;
+      this->Piece.reset(new vtkAMRDualClipPiece(this->Image->GetCellData()));
     }
-    inOffsetZ += blockLocator->ZIncrement;
+    return this->Piece->Points->InsertNextPoint(pt);
   }
-}
+};
 
 //============================================================================
 //----------------------------------------------------------------------------
@@ -1028,6 +971,7 @@ vtkAMRDualClip::vtkAMRDualClip()
   this->EnableDegenerateCells = 1;
   this->EnableMultiProcessCommunication = 0;
   this->EnableMergePoints = 0;
+  this->NumberOfThreads = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -1035,21 +979,12 @@ vtkAMRDualClip::vtkAMRDualClip()
   // Pipeline
   this->SetNumberOfOutputPorts(1);
 
-  this->LevelMaskPointArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualClip::~vtkAMRDualClip()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -1062,6 +997,7 @@ void vtkAMRDualClip::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableInternalDecimation: " << this->EnableInternalDecimation << endl;
   os << indent << "EnableDegenerateCells: " << this->EnableDegenerateCells << endl;
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
   os << indent << "Controller: " << this->Controller << endl;
 }
 
@@ -1184,51 +1120,94 @@ vtkMultiBlockDataSet* vtkAMRDualClip::DoRequestData(
   }
 
   vtkUnstructuredGrid* mesh = vtkUnstructuredGrid::New();
-  this->Points = vtkPoints::New();
-  this->Cells = vtkCellArray::New();
-  mesh->SetPoints(this->Points);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> cells;
+  mesh->SetPoints(points);
   mpds->SetPiece(0, mesh);
 
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  mesh->GetCellData()->AddArray(this->BlockIdCellArray);
-
-  this->LevelMaskPointArray = vtkUnsignedCharArray::New();
-  this->LevelMaskPointArray->SetName("LevelMask");
-  mesh->GetPointData()->AddArray(this->LevelMaskPointArray);
-
-  this->Mesh = mesh;
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  vtkNew<vtkIntArray> blockIdCellArray;
+  blockIdCellArray->SetName("BlockIds");
+  mesh->GetCellData()->AddArray(blockIdCellArray);
 
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
-  int numBlocks;
-  int blockId;
-
-  // Add each block.
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
   for (int level = 0; level < numLevels; ++level)
   {
-    numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
-    for (blockId = 0; blockId < numBlocks; ++blockId)
+    int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
+    for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      // Remote blocks are only to setup local block bit flags.
+      if (block->Image && block->Image->GetCellData()->GetArray(arrayNameToProcess))
+      {
+        blocks.push_back(block);
+        blockIds.push_back(blockId);
+      }
     }
   }
+  vtkIdType numBlocks = static_cast<vtkIdType>(blocks.size());
 
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
-  this->LevelMaskPointArray->Delete();
-  this->LevelMaskPointArray = nullptr;
-
-  mesh->SetCells(VTK_TETRA, this->Cells);
+  if (this->EnableMergePoints)
+  {
+    // The ghost regions of a level mask are copied from the center region of
+    // the neighbors. Compute the center regions of all blocks first, then
+    // fill in the ghost regions, so that blocks can then be clipped in any order.
+    auto computeLevelMasks = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        vtkAMRDualGridHelperBlock* block = blocks[cc];
+        vtkAMRDualClipGetBlockLocator(block)->ComputeLevelMask(
+          block->Image->GetCellData()->GetArray(arrayNameToProcess), this->IsoValue,
+          this->EnableInternalDecimation);
+      }
+    };
+    vtkPVSMPToolsInternal::For(this->NumberOfThreads, numBlocks, computeLevelMasks);
+    auto initializeLevelMasks = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        this->InitializeLevelMask(blocks[cc]);
+      }
+    };
+    vtkPVSMPToolsInternal::For(this->NumberOfThreads, numBlocks, initializeLevelMasks);
+  }
 
+  // Clip the blocks concurrently, each one into its own piece. The pieces
+  // are then appended in the order the blocks used to be processed in.
+  std::vector<std::unique_ptr<vtkAMRDualClipPiece>> pieces(blocks.size());
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualClipWorkspace>> workspaces;
+  auto clipBlocks = [&](vtkIdType begin, vtkIdType end) {
+    std::shared_ptr<vtkAMRDualClipWorkspace>& ws = workspaces.Local();
+    if (!ws)
+    {
+      ws = std::make_shared<vtkAMRDualClipWorkspace>();
+    }
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      this->ProcessBlock(blocks[cc], blockIds[cc], arrayNameToProcess, ws.get());
+      pieces[cc] = std::move(ws->Piece);
+    }
+  };
+  vtkPVSMPToolsInternal::For(this->NumberOfThreads, numBlocks, clipBlocks);
+  // Drop the tetrahedra that collapse once their points are merged.
+  auto keepTetra = [](vtkIdType, const vtkIdType* ids) {
+    return ids[0] != ids[1] && ids[0] != ids[2] && ids[0] != ids[3] && ids[1] != ids[2] &&
+      ids[1] != ids[3] && ids[2] != ids[3];
+  };
+  if (!vtkAMRDualAppendPieces(
+        pieces, mesh->GetPoints(), mesh->GetPointData(), cells, blockIdCellArray, keepTetra))
+  {
+    // The attributes of the pieces are allocated from the block they come
+    // from, an empty output still gets the arrays of the input.
+    vtkNew<vtkUnsignedCharArray> levelMaskPointArray;
+    levelMaskPointArray->SetName("LevelMask");
+    mesh->GetPointData()->AddArray(levelMaskPointArray);
+    this->InitializeCopyAttributes(hbdsInput, mesh);
+  }
+
+  mesh->SetCells(VTK_TETRA, cells);
   mesh->Delete();
-  this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Cells->Delete();
-  this->Cells = nullptr;
 
   mpds->Delete();
   this->Helper->Delete();
@@ -1253,56 +1232,12 @@ void vtkDualGridContourCastCornerValues(T* ptr, vtkIdType offsets[8], double val
   values[7] = (double)(ptr[offsets[7]]);
 }
 
-//----------------------------------------------------------------------------
-void vtkAMRDualClip::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
-{
-  vtkAMRDualGridHelperBlock* neighbor;
-  // Blocks are processed low level to high so, we only need to share
-  // the locator with blocks in the same level or higher.
-  int numLevels = this->Helper->GetNumberOfLevels();
-  int xMid, yMid, zMid;
-  int xMin, xMax, yMin, yMax, zMin, zMax;
-
-  for (int level = block->Level; level < numLevels; ++level)
-  {
-    // Neighborhood.
-    int levelDiff = level - block->Level;
-    xMid = block->GridIndex[0];
-    xMin = (xMid << levelDiff) - 1;
-    xMax = (xMid + 1) << levelDiff;
-    yMid = block->GridIndex[1];
-    yMin = (yMid << levelDiff) - 1;
-    yMax = (yMid + 1) << levelDiff;
-    zMid = block->GridIndex[2];
-    zMin = (zMid << levelDiff) - 1;
-    zMax = (zMid + 1) << levelDiff;
-
-    // Lets just start with neighbors in the same level.
-    for (int iz = zMin; iz <= zMax; ++iz)
-    {
-      for (int iy = yMin; iy <= yMax; ++iy)
-      {
-        for (int ix = xMin; ix <= xMax; ++ix)
-        {
-          if ((ix >> levelDiff) != xMid || (iy >> levelDiff) != yMid || (iz >> levelDiff) != zMid)
-          {
-            neighbor = this->Helper->GetBlock(level, ix, iy, iz);
-            // The unused center flag is used as a flag to indicate
-            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1])
-            {
-              vtkAMRDualClipLocator* blockLocator = vtkAMRDualClipGetBlockLocator(block);
-              blockLocator->ShareBlockLocatorWithNeighbor(block, neighbor);
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
 //----------------------------------------------------------------------------
 // This is called before we start processing a block to make sure
 // the locator is initialized in center and ghost regions.
+// It only writes to the level mask of the block and reads the center region
+// of the neighbors, so it can be called concurrently for different blocks
+// once the center regions of all blocks are computed.
 void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
 {
   vtkImageData* image = block->Image;
@@ -1350,9 +1285,9 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
           {
             // I could further prune and only copy to regions I own.
             neighbor = this->Helper->GetBlock(level, ix, iy, iz);
-            // If the neighbor was already processed, then its level mask
-            // was copied to this block already.
-            if (neighbor && neighbor->RegionBits[1][1][1] != 0)
+            // The center region of the neighbor is already computed, so
+            // ComputeLevelMask below returns right away.
+            if (neighbor)
             {
               neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
               image = neighbor->Image;
@@ -1400,61 +1335,8 @@ void vtkAMRDualClip::InitializeLevelMask(vtkAMRDualGridHelperBlock* block)
 }
 
 //----------------------------------------------------------------------------
-// This is called after we finished processing a block to share the locator
-// level mask with neighbors before we delete the locator.
-void vtkAMRDualClip::ShareLevelMask(vtkAMRDualGridHelperBlock* block)
-{
-  vtkAMRDualGridHelperBlock* neighbor;
-  vtkAMRDualClipLocator* neighborLocator;
-  int numLevels = this->Helper->GetNumberOfLevels();
-
-  // We need to check for neighbors in higher or equal
-  // to our level.  When blocks from different levels share a border
-  // the high level block always owns the shared region.
-  int xMid, yMid, zMid;
-  int xMin, xMax, yMin, yMax, zMin, zMax;
-
-  for (int level = block->Level; level < numLevels; ++level)
-  {
-    // Neighborhood.
-    int levelDiff = level - block->Level;
-    xMid = block->GridIndex[0];
-    xMin = (xMid << levelDiff) - 1;
-    xMax = (xMid + 1) << levelDiff;
-    yMid = block->GridIndex[1];
-    yMin = (yMid << levelDiff) - 1;
-    yMax = (yMid + 1) << levelDiff;
-    zMid = block->GridIndex[2];
-    zMin = (zMid << levelDiff) - 1;
-    zMax = (zMid + 1) << levelDiff;
-
-    for (int iz = zMin; iz <= zMax; ++iz)
-    {
-      for (int iy = yMin; iy <= yMax; ++iy)
-      {
-        for (int ix = xMin; ix <= xMax; ++ix)
-        {
-          if ((ix >> levelDiff) != xMid || (iy >> levelDiff) != yMid || (iz >> levelDiff) != zMid)
-          {
-            // I could further prune and only copy to regions owned by neighbor.
-            neighbor = this->Helper->GetBlock(level, ix, iy, iz);
-            // If the neighbor was already processed, then its level mask
-            // was copied to this block already.
-            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1] != 0)
-            {
-              neighborLocator = vtkAMRDualClipGetBlockLocator(neighbor);
-              neighborLocator->CopyNeighborLevelMask(neighbor, block);
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-//----------------------------------------------------------------------------
-void vtkAMRDualClip::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+void vtkAMRDualClip::ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId,
+  const char* arrayNameToProcess, vtkAMRDualClipWorkspace* ws)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -1482,23 +1364,24 @@ void vtkAMRDualClip::ProcessBlock(
   --extent[3];
   --extent[5];
 
-  // Locator merges points in this block.
+  // Locator merges points in this block. Points shared with neighbor blocks
+  // are merged when the pieces are appended.
   // Input the dimensions of the dual cells with ghosts.
   if (this->EnableMergePoints)
   {
-    this->InitializeLevelMask(block);
-    this->BlockLocator = vtkAMRDualClipGetBlockLocator(block);
+    // The level mask was already initialized in center and ghost regions.
+    ws->Locator = vtkAMRDualClipGetBlockLocator(block);
   }
   else
   { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualClipLocator;
-    }
-    this->BlockLocator->Initialize(
-      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    // this->BlockLocator->CopyRegionLevelDifferences(block);
-  }
+    ws->Locator = &ws->SharedLocator;
+    ws->Locator->Initialize(extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
+    // ws->Locator->CopyRegionLevelDifferences(block);
+  }
+  ws->Locator->InitializePointIds();
+  ws->Piece.reset();
+  ws->Image = image;
+  ws->MergePoints = this->EnableMergePoints != 0;
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
   // Dual cells are shifted half a pixel.
@@ -1573,7 +1456,7 @@ void vtkAMRDualClip::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + yInc + zInc;
           cornerOffsets[7] = xOffset + 1 + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray, ws);
         }
         xOffset += 1; // xInc
       }
@@ -1584,20 +1467,12 @@ void vtkAMRDualClip::ProcessBlock(
 
   if (this->EnableMergePoints)
   {
-    this->ShareLevelMask(block);
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
     // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
+    // The level masks of the neighbors were initialized before any block
+    // was processed, so they do not need it either.
+    delete ws->Locator;
+    ws->Locator = nullptr;
     block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
   }
 }
 
@@ -1605,7 +1480,8 @@ void vtkAMRDualClip::ProcessBlock(
 // Not implemented as optimally as we could.  It can be improved by making
 // a fast path for internal cells (with no degeneracies).
 void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray,
+  vtkAMRDualClipWorkspace* ws)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1782,13 +1658,21 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     {
       nz = 1;
     }
-
+    // Only dual points in the two outer layers of the block can be at the
+    // end of an edge a neighbor block generates points on too.
+    ws->CornerShared[c] = px <= ghostDualPointIndexRange[0] + 1 ||
+      px >= ghostDualPointIndexRange[1] - 1 || py <= ghostDualPointIndexRange[2] + 1 ||
+      py >= ghostDualPointIndexRange[3] - 1 || pz <= ghostDualPointIndexRange[4] + 1 ||
+      pz >= ghostDualPointIndexRange[5] - 1;
+
+    int* dualPoint = ws->CornerDualPoints[c];
     if (block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask)
     { // point lies in lower level neighbor.
       int levelDiff = block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask;
       px = px >> levelDiff;
       py = py >> levelDiff;
       pz = pz >> levelDiff;
+      dualPoint[0] = block->Level - levelDiff;
       // Shift half a pixel to get center of cell (dual point).
       if (levelDiff == 1)
       { // This is the most common case; avoid extra multiplications.
@@ -1808,12 +1692,16 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     }
     else
     {
+      dualPoint[0] = block->Level;
       // How do I chop the cells in half on the boundaries?
       // Move the origin and change spacing.
       cornerPoints[c << 2] = origin[0] + spacing[0] * ((double)(px) + dx);
       cornerPoints[(c << 2) | 1] = origin[1] + spacing[1] * ((double)(py) + dy);
       cornerPoints[(c << 2) | 2] = origin[2] + spacing[2] * ((double)(pz) + dz);
     }
+    dualPoint[1] = px;
+    dualPoint[2] = py;
+    dualPoint[3] = pz;
   }
   // We have the points, now contour the cell.
   // Get edges.
@@ -1833,8 +1721,8 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
       // convert from VTK corner ids to bit (x,y,z) corner ids.
       if (casePtId < 8)
       { // Corner (internal point)
-        ptIdPtr = this->BlockLocator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
-        levelMaskValue = this->BlockLocator->GetLevelMaskValue(
+        ptIdPtr = ws->Locator->GetCornerPointer(x, y, z, casePtId, block->OriginIndex);
+        levelMaskValue = ws->Locator->GetLevelMaskValue(
           x + ((casePtId & 1) ? 1 : 0), y + ((casePtId & 2) ? 1 : 0), z + ((casePtId & 4) ? 1 : 0));
         if (levelMaskValue == 0)
         { // bug !!!!! trying to figure out what is going on.
@@ -1886,7 +1774,11 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           pt[0] = origin[0] + spacing[0] * (double)(1 << levelDiff) * ((double)(px) + dx);
           pt[1] = origin[1] + spacing[1] * (double)(1 << levelDiff) * ((double)(py) + dy);
           pt[2] = origin[2] + spacing[2] * (double)(1 << levelDiff) * ((double)(pz) + dz);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          // Decimated points can be merged with points of a neighbor block
+          // even when they are not close to the boundary of this block.
+          int dualPoint[4] = { block->Level - levelDiff, px, py, pz };
+          bool shared = ws->CornerShared[casePtId] || levelDiff > 0;
+          *ptIdPtr = ws->InsertDualPoint(dualPoint, shared, pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1900,14 +1792,14 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Averaging could be a pre processing step but we would have to modify input attributes
           // .......
           vtkIdType offset = cornerOffsets[casePtId];
-          this->Mesh->GetPointData()->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
+          ws->Piece->PointData->CopyData(block->Image->GetCellData(), offset, *ptIdPtr);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          ws->Piece->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       else
       { // Edge (clipped cell, point on iso surface)
-        ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, casePtId - 8);
+        ptIdPtr = ws->Locator->GetEdgePointer(x, y, z, casePtId - 8);
         if (*ptIdPtr == -1)
         {
           int edge = casePtId - 8;
@@ -1924,7 +1816,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
             cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
           pt[2] =
             cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-          *ptIdPtr = this->Points->InsertNextPoint(pt);
+          *ptIdPtr = ws->InsertEdgePoint(pt1Idx >> 2, pt2Idx >> 2, pt);
           if (pt[1] > 100000.0)
           {
             cerr << "bug\n";
@@ -1934,10 +1826,10 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
           // Find the offsets of the two attributes to interpolate
           vtkIdType offset0 = cornerOffsets[pt1Idx >> 2];
           vtkIdType offset1 = cornerOffsets[pt2Idx >> 2];
-          this->Mesh->GetPointData()->InterpolateEdge(
+          ws->Piece->PointData->InterpolateEdge(
             block->Image->GetCellData(), *ptIdPtr, offset0, offset1, k);
 
-          this->LevelMaskPointArray->InsertNextValue(levelMaskValue);
+          ws->Piece->LevelMask->InsertNextValue(levelMaskValue);
         }
       }
       pointIds[ii] = *ptIdPtr;
@@ -1945,8 +1837,7 @@ void vtkAMRDualClip::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int block
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[0] != pointIds[3] &&
       pointIds[1] != pointIds[2] && pointIds[1] != pointIds[3] && pointIds[2] != pointIds[3])
     {
-      this->Cells->InsertNextCell(4, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      ws->InsertCell(pointIds, blockId);
     }
   }
 }
@@ -21,6 +21,10 @@
  * transitions are handled correctly, and second is that internal
  * cells are decimated.  I use a variation of degenerate points/cells
  * used for level transitions.
+ *
+ * Blocks are clipped concurrently using vtkSMPTools, each into its own
+ * piece. The pieces are appended in block order, which keeps the output
+ * independent of the number of threads.
  */
 
 #ifndef vtkAMRDualClip_h
@@ -47,6 +51,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualClipLocator;
+class vtkAMRDualClipWorkspace;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualClip : public vtkMultiBlockDataSetAlgorithm
 {
@@ -85,6 +90,16 @@ public:
   vtkBooleanMacro(EnableMergePoints, int);
   //@}
 
+  //@{
+  /**
+   * Set the maximum number of threads used to clip the blocks
+   * concurrently. 0 (default) uses all the threads available to vtkSMPTools,
+   * 1 clips the blocks serially.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -99,9 +114,7 @@ protected:
   int EnableDegenerateCells;
   int EnableMultiProcessCommunication;
   int EnableMergePoints;
-
-  // Needed for copying cell data to point data.
-  vtkUnstructuredGrid* Mesh;
+  int NumberOfThreads;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -116,15 +129,17 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
-  void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
-
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Clips a single block into the piece of the given workspace. Blocks can
+   * be processed concurrently as long as each thread uses its own workspace.
+   */
+  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName,
+    vtkAMRDualClipWorkspace* ws);
 
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray, vtkAMRDualClipWorkspace* ws);
 
   void InitializeLevelMask(vtkAMRDualGridHelperBlock* block);
-  void ShareLevelMask(vtkAMRDualGridHelperBlock* block);
   void DistributeLevelMasks();
 
   // void DebugCases();
@@ -132,14 +147,8 @@ protected:
   // void MirrorCases();
   // void AddGlyph(double x, double y, double z);
 
-  // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
-  vtkUnsignedCharArray* LevelMaskPointArray;
-
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
-  vtkPoints* Points;
-  vtkCellArray* Cells;
 
   vtkMultiProcessController* Controller;
 
@@ -148,8 +157,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualClipLocator* BlockLocator;
-
 private:
   vtkAMRDualClip(const vtkAMRDualClip&) = delete;
   void operator=(const vtkAMRDualClip&) = delete;
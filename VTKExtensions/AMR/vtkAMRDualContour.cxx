@@ -14,15 +14,18 @@
 =========================================================================*/
 #include "vtkAMRDualContour.h"
 #include "vtkAMRDualGridHelper.h"
-#include <vector>
+#include "vtkAMRDualPiecesInternal.h"
 
 // Pipeline & VTK
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMarchingCubesTriangleCases.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVSMPToolsInternal.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -36,6 +39,7 @@
 #include "vtkDataSet.h"
 #include "vtkFloatArray.h"
 #include "vtkImageData.h"
+#include "vtkIntArray.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkNonOverlappingAMR.h"
@@ -44,8 +48,12 @@
 #include "vtkUniformGrid.h"
 #include "vtkUnsignedCharArray.h"
 #include "vtkUnstructuredGrid.h"
+#include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <memory>
+#include <utility>
+#include <vector>
 
 vtkStandardNewMacro(vtkAMRDualContour);
 
@@ -100,9 +108,6 @@ public:
   void SharePointIdsWithNeighbor(
     vtkAMRDualContourEdgeLocator* neighborLocator, int rx, int ry, int rz);
 
-  void ShareBlockLocatorWithNeighbor(
-    vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor);
-
 private:
   int DualCellDimensions[3];
   // Increments for translating 3d to 1d.  XIncrement = 1;
@@ -431,182 +436,98 @@ vtkIdType* vtkAMRDualContourEdgeLocator::GetCornerPointer(
   return this->Corners + (xCell + (yCell * this->YIncrement) + (zCell * this->ZIncrement));
 }
 
-//----------------------------------------------------------------------------
-vtkAMRDualContourEdgeLocator* vtkAMRDualContourGetBlockLocator(vtkAMRDualGridHelperBlock* block)
-{
-  if (block->UserData == nullptr)
-  {
-    vtkImageData* image = block->Image;
-    if (image == nullptr)
-    { // Remote blocks are only to setup local block bit flags.
-      return nullptr;
-    }
-    int extent[6];
-    // This is the same as the cell extent of the original grid (with ghosts).
-    image->GetExtent(extent);
-    --extent[1];
-    --extent[3];
-    --extent[5];
-
-    vtkAMRDualContourEdgeLocator* locator = new vtkAMRDualContourEdgeLocator;
-    block->UserData = (void*)(locator); // Block owns it now.
-    locator->Initialize(extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    locator->CopyRegionLevelDifferences(block);
-    return locator;
-  }
-  return (vtkAMRDualContourEdgeLocator*)(block->UserData);
-}
-
-//----------------------------------------------------------------------------
-// This version works with higher level neighbor blocks.
-void vtkAMRDualContourEdgeLocator::ShareBlockLocatorWithNeighbor(
-  vtkAMRDualGridHelperBlock* block, vtkAMRDualGridHelperBlock* neighbor)
+//============================================================================
+// Surface generated from a single block. Point ids are local to the piece.
+// Points that a neighbor block may generate as well are kept with their key
+// so that the pieces can be merged when they are appended.
+class vtkAMRDualContourPiece
 {
-  vtkAMRDualContourEdgeLocator* blockLocator = vtkAMRDualContourGetBlockLocator(block);
-  vtkAMRDualContourEdgeLocator* neighborLocator = vtkAMRDualContourGetBlockLocator(neighbor);
-
-  // Compute the extent of the locator to copy.
-  // Moving too many will not hurt, so do not worry about which block owns the region.
-  // Start with the extent of the neighbor.  It is higher level.
-  int ext[6];
-
-  // Copy all possible overlap.
-  ext[0] = 0;
-  ext[1] = neighborLocator->DualCellDimensions[0];
-  ext[2] = 0;
-  ext[3] = neighborLocator->DualCellDimensions[1];
-  ext[4] = 0;
-  ext[5] = neighborLocator->DualCellDimensions[2];
+public:
+  vtkNew<vtkPolyData> Mesh;
+  vtkNew<vtkPoints> Points;
+  vtkNew<vtkCellArray> Cells;
+  vtkNew<vtkIntArray> BlockIds;
+  std::vector<std::pair<vtkAMRDualPointKey, vtkIdType>> SharedPoints;
 
-  // Now we need to convert the receiving low level block extent to the
-  // source high level block extent.
-  // Start with the out high level block.
-  ext[0] += neighbor->OriginIndex[0];
-  ext[1] += neighbor->OriginIndex[0];
-  ext[2] += neighbor->OriginIndex[1];
-  ext[3] += neighbor->OriginIndex[1];
-  ext[4] += neighbor->OriginIndex[2];
-  ext[5] += neighbor->OriginIndex[2];
-  // Convert to the in low level block index coordinate system.
-  int levelDiff = neighbor->Level - block->Level;
-  ext[0] = (ext[0] >> levelDiff) - block->OriginIndex[0];
-  ext[1] = (ext[1] >> levelDiff) - block->OriginIndex[0];
-  ext[2] = (ext[2] >> levelDiff) - block->OriginIndex[1];
-  ext[3] = (ext[3] >> levelDiff) - block->OriginIndex[1];
-  ext[4] = (ext[4] >> levelDiff) - block->OriginIndex[2];
-  ext[5] = (ext[5] >> levelDiff) - block->OriginIndex[2];
-  // Intersect with in (source) low level block.
-  if (ext[0] < 0)
-  {
-    ext[0] = 0;
-  }
-  if (ext[0] > blockLocator->DualCellDimensions[0])
-  {
-    ext[0] = blockLocator->DualCellDimensions[0];
-  }
-  if (ext[1] < 0)
-  {
-    ext[1] = 0;
-  }
-  if (ext[1] > blockLocator->DualCellDimensions[0])
-  {
-    ext[1] = blockLocator->DualCellDimensions[0];
-  }
-  if (ext[2] < 0)
-  {
-    ext[2] = 0;
-  }
-  if (ext[2] > blockLocator->DualCellDimensions[1])
-  {
-    ext[2] = blockLocator->DualCellDimensions[1];
-  }
-  if (ext[3] < 0)
-  {
-    ext[3] = 0;
-  }
-  if (ext[3] > blockLocator->DualCellDimensions[1])
+  vtkAMRDualContourPiece(vtkCellData* attributes)
   {
-    ext[3] = blockLocator->DualCellDimensions[1];
+    this->BlockIds->SetName("BlockIds");
+    this->Mesh->SetPoints(this->Points);
+    this->Mesh->SetPolys(this->Cells);
+    this->Mesh->GetCellData()->AddArray(this->BlockIds);
+    this->Mesh->GetPointData()->CopyAllocate(attributes);
   }
-  if (ext[4] < 0)
-  {
-    ext[4] = 0;
-  }
-  if (ext[4] > blockLocator->DualCellDimensions[2])
-  {
-    ext[4] = blockLocator->DualCellDimensions[2];
+
+  vtkPointData* GetPointData() { return this->Mesh->GetPointData(); }
+};
+
+//============================================================================
+// Per-thread state used to contour one block at a time. The piece of the
+// block is only created once the block generates its first point, which
+// keeps the many blocks that do not intersect the surface cheap.
+class vtkAMRDualContourWorkspace
+{
+public:
+  vtkAMRDualContourEdgeLocator Locator;
+  std::unique_ptr<vtkAMRDualContourPiece> Piece;
+  vtkImageData* Image = nullptr;
+  bool MergePoints = false;
+  // Dual points at the corners of the current dual cell (level followed by
+  // global index) and whether they are close enough to the block boundary
+  // to be shared with a neighbor block.
+  int CornerDualPoints[8][4];
+  bool CornerShared[8];
+
+  // Prepares the workspace for a new block.
+  void Initialize(vtkAMRDualGridHelperBlock* block, int extent[6], bool mergePoints)
+  {
+    this->Locator.Initialize(extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
+    this->Locator.CopyRegionLevelDifferences(block);
+    this->Piece.reset();
+    this->Image = block->Image;
+    this->MergePoints = mergePoints;
+  }
+
+  vtkIdType InsertEdgePoint(int corner0, int corner1, const double pt[3])
+  {
+    vtkIdType ptId = this->InsertPoint(pt);
+    if (this->MergePoints && this->CornerShared[corner0] && this->CornerShared[corner1])
+    {
+      this->Piece->SharedPoints.emplace_back(
+        vtkAMRDualPointKey(this->CornerDualPoints[corner0], this->CornerDualPoints[corner1]),
+        ptId);
+    }
+    return ptId;
   }
-  if (ext[5] < 0)
+
+  vtkIdType InsertCornerPoint(int corner, const double pt[3])
   {
-    ext[5] = 0;
+    vtkIdType ptId = this->InsertPoint(pt);
+    if (this->MergePoints && this->CornerShared[corner])
+    {
+      this->Piece->SharedPoints.emplace_back(
+        vtkAMRDualPointKey(this->CornerDualPoints[corner], this->CornerDualPoints[corner]),
+        ptId);
+    }
+    return ptId;
   }
-  if (ext[5] > blockLocator->DualCellDimensions[2])
+
+  void InsertFace(int ptCount, const vtkIdType* pointIds, int blockId)
   {
-    ext[5] = blockLocator->DualCellDimensions[2];
+    this->Piece->Cells->InsertNextCell(ptCount, pointIds);
+    this->Piece->BlockIds->InsertNextValue(blockId);
   }
 
-  vtkIdType pointId;
-  int xOut, yOut, zOut;
-  int inOffsetZ, inOffsetY, inOffsetX, outOffsetX, outOffsetY, outOffsetZ;
-  inOffsetZ = ext[0] + ext[2] * blockLocator->YIncrement + ext[4] * blockLocator->ZIncrement;
-  for (int zIn = ext[4]; zIn <= ext[5]; ++zIn)
+private:
+  vtkIdType InsertPoint(const double pt[3])
   {
-    inOffsetY = inOffsetZ;
-    // Compute the output index.
-    // Like the other places this locator indexconversion is done,
-    // The min ghost index is shifted to fit into the locator array.
-    zOut = ((zIn + block->OriginIndex[2]) << levelDiff) - neighbor->OriginIndex[2];
-    if (zOut < 0)
+    if (!this->Piece)
     {
-      zOut = 0;
-    }
-    outOffsetZ = zOut * neighborLocator->ZIncrement;
-    for (int yIn = ext[2]; yIn <= ext[3]; ++yIn)
-    {
-      inOffsetX = inOffsetY;
-      yOut = ((yIn + block->OriginIndex[1]) << levelDiff) - neighbor->OriginIndex[1];
-      if (yOut < 0)
-      {
-        yOut = 0;
-      }
-      outOffsetY = outOffsetZ + yOut * neighborLocator->YIncrement;
-      for (int xIn = ext[0]; xIn <= ext[1]; ++xIn)
-      {
-        xOut = ((xIn + block->OriginIndex[0]) << levelDiff) - neighbor->OriginIndex[0];
-        if (xOut < 0)
-        {
-          xOut = 0;
-        }
-        outOffsetX = outOffsetY + xOut;
-
-        pointId = blockLocator->XEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->XEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->YEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->YEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->ZEdges[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->ZEdges[outOffsetX] = pointId;
-        }
-        pointId = blockLocator->Corners[inOffsetX];
-        if (pointId >= 0)
-        {
-          neighborLocator->Corners[outOffsetX] = pointId;
-        }
-
-        inOffsetX += 1;
-      }
-      inOffsetY += blockLocator->YIncrement;
+      this->Piece.reset(new vtkAMRDualContourPiece(this->Image->GetCellData()));
     }
-    inOffsetZ += blockLocator->ZIncrement;
+    return this->Piece->Points->InsertNextPoint(pt);
   }
-}
+};
 
 //============================================================================
 //----------------------------------------------------------------------------
@@ -623,6 +544,7 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->EnableMultiProcessCommunication = 1;
   this->EnableMergePoints = 1;
   this->TriangulateCap = 1;
+  this->NumberOfThreads = 0;
 
   this->Controller = nullptr;
   this->SetController(vtkMultiProcessController::GetGlobalController());
@@ -631,20 +553,13 @@ vtkAMRDualContour::vtkAMRDualContour()
   this->SetNumberOfOutputPorts(1);
 
   this->TemperatureArray = nullptr;
-  this->BlockIdCellArray = nullptr;
   this->Helper = nullptr;
-
-  this->BlockLocator = nullptr;
+  this->Mesh = nullptr;
 }
 
 //----------------------------------------------------------------------------
 vtkAMRDualContour::~vtkAMRDualContour()
 {
-  if (this->BlockLocator)
-  {
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-  }
   this->SetController(nullptr);
 }
 
@@ -661,6 +576,7 @@ void vtkAMRDualContour::PrintSelf(ostream& os, vtkIndent indent)
   os << indent << "EnableMergePoints: " << this->EnableMergePoints << endl;
   os << indent << "TriangulateCap: " << this->TriangulateCap << endl;
   os << indent << "SkipGhostCopy: " << this->SkipGhostCopy << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -793,43 +709,69 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
   mpds->SetNumberOfPieces(0);
 
   this->Mesh = vtkPolyData::New();
-  this->Points = vtkPoints::New();
-  this->Faces = vtkCellArray::New();
-  this->Mesh->SetPoints(this->Points);
-  this->Mesh->SetPolys(this->Faces);
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkCellArray> faces;
+  this->Mesh->SetPoints(points);
+  this->Mesh->SetPolys(faces);
   mpds->SetPiece(0, this->Mesh);
 
-  this->InitializeCopyAttributes(hbdsInput, this->Mesh);
-
   // For debugging.
-  this->BlockIdCellArray = vtkIntArray::New();
-  this->BlockIdCellArray->SetName("BlockIds");
-  this->Mesh->GetCellData()->AddArray(this->BlockIdCellArray);
+  vtkNew<vtkIntArray> blockIdCellArray;
+  blockIdCellArray->SetName("BlockIds");
+  this->Mesh->GetCellData()->AddArray(blockIdCellArray);
 
   // Loop through blocks
   int numLevels = hbdsInput->GetNumberOfLevels();
-
-  // Add each block.
+  std::vector<vtkAMRDualGridHelperBlock*> blocks;
+  std::vector<int> blockIds;
   for (int level = 0; level < numLevels; ++level)
   {
     int numBlocks = this->Helper->GetNumberOfBlocksInLevel(level);
     for (int blockId = 0; blockId < numBlocks; ++blockId)
     {
       vtkAMRDualGridHelperBlock* block = this->Helper->GetBlock(level, blockId);
-      this->ProcessBlock(block, blockId, arrayNameToProcess);
+      // Remote blocks are only to setup local block bit flags.
+      if (block->Image)
+      {
+        blocks.push_back(block);
+        blockIds.push_back(blockId);
+      }
     }
   }
 
-  this->FinalizeCopyAttributes(this->Mesh);
-  this->BlockIdCellArray->Delete();
-  this->BlockIdCellArray = nullptr;
+  // Contour the blocks concurrently, each one into its own piece. The pieces
+  // are then appended in the order the blocks used to be processed in.
+  std::vector<std::unique_ptr<vtkAMRDualContourPiece>> pieces(blocks.size());
+  vtkSMPThreadLocal<std::shared_ptr<vtkAMRDualContourWorkspace>> workspaces;
+  auto contourBlocks = [&](vtkIdType begin, vtkIdType end) {
+    std::shared_ptr<vtkAMRDualContourWorkspace>& ws = workspaces.Local();
+    if (!ws)
+    {
+      ws = std::make_shared<vtkAMRDualContourWorkspace>();
+    }
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      this->ProcessBlock(blocks[cc], blockIds[cc], arrayNameToProcess, ws.get());
+      pieces[cc] = std::move(ws->Piece);
+    }
+  };
+  vtkPVSMPToolsInternal::For(
+    this->NumberOfThreads, static_cast<vtkIdType>(blocks.size()), contourBlocks);
+  // Drop the triangles that collapse once their points are merged.
+  auto keepFace = [](vtkIdType npts, const vtkIdType* ids) {
+    return npts != 3 || (ids[0] != ids[1] && ids[0] != ids[2] && ids[1] != ids[2]);
+  };
+  if (!vtkAMRDualAppendPieces(pieces, this->Mesh->GetPoints(), this->Mesh->GetPointData(),
+        this->Mesh->GetPolys(), blockIdCellArray, keepFace))
+  {
+    // The attributes of the pieces are allocated from the block they come
+    // from, an empty output still gets the arrays of the input.
+    this->InitializeCopyAttributes(hbdsInput, this->Mesh);
+  }
 
+  this->FinalizeCopyAttributes(this->Mesh);
   this->Mesh->Delete();
   this->Mesh = nullptr;
-  this->Points->Delete();
-  this->Points = nullptr;
-  this->Faces->Delete();
-  this->Faces = nullptr;
 
   mpds->Delete();
 
@@ -837,55 +779,8 @@ vtkMultiBlockDataSet* vtkAMRDualContour::DoRequestData(
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block)
-{
-  vtkAMRDualGridHelperBlock* neighbor;
-  // Blocks are processed low level to high so, we only need to share
-  // the locator with blocks in the same level or higher.
-  int numLevels = this->Helper->GetNumberOfLevels();
-  int xMid, yMid, zMid;
-  int xMin, xMax, yMin, yMax, zMin, zMax;
-
-  for (int level = block->Level; level < numLevels; ++level)
-  {
-    // Neighborhood.
-    int levelDiff = level - block->Level;
-    xMid = block->GridIndex[0];
-    xMin = (xMid << levelDiff) - 1;
-    xMax = (xMid + 1) << levelDiff;
-    yMid = block->GridIndex[1];
-    yMin = (yMid << levelDiff) - 1;
-    yMax = (yMid + 1) << levelDiff;
-    zMid = block->GridIndex[2];
-    zMin = (zMid << levelDiff) - 1;
-    zMax = (zMid + 1) << levelDiff;
-
-    // Lets just start with neighbors in the same level.
-    for (int iz = zMin; iz <= zMax; ++iz)
-    {
-      for (int iy = yMin; iy <= yMax; ++iy)
-      {
-        for (int ix = xMin; ix <= xMax; ++ix)
-        {
-          if ((ix >> levelDiff) != xMid || (iy >> levelDiff) != yMid || (iz >> levelDiff) != zMid)
-          {
-            neighbor = this->Helper->GetBlock(level, ix, iy, iz);
-            // The unused center flag is used as a flag to indicate
-            if (neighbor && neighbor->Image && neighbor->RegionBits[1][1][1])
-            {
-              vtkAMRDualContourEdgeLocator* blockLocator = vtkAMRDualContourGetBlockLocator(block);
-              blockLocator->ShareBlockLocatorWithNeighbor(block, neighbor);
-            }
-          }
-        }
-      }
-    }
-  }
-}
-
-//----------------------------------------------------------------------------
-void vtkAMRDualContour::ProcessBlock(
-  vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayNameToProcess)
+void vtkAMRDualContour::ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId,
+  const char* arrayNameToProcess, vtkAMRDualContourWorkspace* ws)
 {
   vtkImageData* image = block->Image;
   if (image == nullptr)
@@ -912,22 +807,10 @@ void vtkAMRDualContour::ProcessBlock(
   --extent[3];
   --extent[5];
 
-  // Locator merges points in this block.
+  // Locator merges points in this block. Points shared with neighbor blocks
+  // are merged when the pieces are appended.
   // Input the dimensions of the dual cells with ghosts.
-  if (this->EnableMergePoints)
-  {
-    this->BlockLocator = vtkAMRDualContourGetBlockLocator(block);
-  }
-  else
-  { // Shared locator.
-    if (this->BlockLocator == nullptr)
-    {
-      this->BlockLocator = new vtkAMRDualContourEdgeLocator;
-    }
-    this->BlockLocator->Initialize(
-      extent[1] - extent[0], extent[3] - extent[2], extent[5] - extent[4]);
-    this->BlockLocator->CopyRegionLevelDifferences(block);
-  }
+  ws->Initialize(block, extent, this->EnableMergePoints != 0);
   image->GetOrigin(origin);
   spacing = image->GetSpacing();
   // Dual cells are shifted half a pixel.
@@ -1007,7 +890,7 @@ void vtkAMRDualContour::ProcessBlock(
           cornerOffsets[5] = xOffset + 1 + zInc;
           cornerOffsets[6] = xOffset + 1 + yInc + zInc;
           cornerOffsets[7] = xOffset + yInc + zInc;
-          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray);
+          this->ProcessDualCell(block, blockId, x, y, z, cornerOffsets, volumeFractionArray, ws);
         }
         xOffset += 1; // xInc
       }
@@ -1015,23 +898,6 @@ void vtkAMRDualContour::ProcessBlock(
     }
     zOffset += zInc;
   }
-
-  if (this->EnableMergePoints)
-  {
-    // Copy point ids into neighbor locators.
-    this->ShareBlockLocatorWithNeighbors(block);
-    // We are done.  We no longer need the locator for this block.
-    delete this->BlockLocator;
-    this->BlockLocator = nullptr;
-    block->UserData = nullptr;
-    // Lets use this unused flag (owner of center region/block) to indicate
-    // that the block is already processes.
-    // This will keep neighbors from recreating the locator.
-    // Another option would be to create the locator object for
-    // all blocks but do not allocate until needed.  Then the existence of the locator
-    // would tell whether the block was processed.
-    block->RegionBits[1][1][1] = 0;
-  }
 }
 
 //----------------------------------------------------------------------------
@@ -1092,7 +958,8 @@ static int vtkAMRDualLegacyIdToBitIdMap[8] = { 0, 1, 3, 2, 4, 5, 7, 6 };
 // a fast path for internal cells (with no degeneracies).
 // Corner offsets are absolute (relative to origin / 0).
 void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y,
-  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray)
+  int z, vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray,
+  vtkAMRDualContourWorkspace* ws)
 {
   // compute the case index
   vtkImageData* image = block->Image;
@@ -1271,13 +1138,21 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     {
       nz = 1;
     }
-
+    // Only dual points in the two outer layers of the block can be at the
+    // end of an edge a neighbor block generates points on too.
+    ws->CornerShared[c] = px <= ghostDualPointIndexRange[0] + 1 ||
+      px >= ghostDualPointIndexRange[1] - 1 || py <= ghostDualPointIndexRange[2] + 1 ||
+      py >= ghostDualPointIndexRange[3] - 1 || pz <= ghostDualPointIndexRange[4] + 1 ||
+      pz >= ghostDualPointIndexRange[5] - 1;
+
+    int* dualPoint = ws->CornerDualPoints[c];
     if (block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask)
     { // point lies in lower level neighbor.
       int levelDiff = block->RegionBits[nx][ny][nz] & vtkAMRRegionBitsDegenerateMask;
       px = px >> levelDiff;
       py = py >> levelDiff;
       pz = pz >> levelDiff;
+      dualPoint[0] = block->Level - levelDiff;
       // Shift half a pixel to get center of cell (dual point).
       if (levelDiff == 1)
       { // This is the most common case; avoid extra multiplications.
@@ -1296,12 +1171,16 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     }
     else
     {
+      dualPoint[0] = block->Level;
       // How do I chop the cells in half on the bondaries?
       // Move the tmp origin and change spacing.
       cornerPoints[c << 2] = tmp[0] + spacing[0] * ((double)(px) + dx);
       cornerPoints[(c << 2) | 1] = tmp[1] + spacing[1] * ((double)(py) + dy);
       cornerPoints[(c << 2) | 2] = tmp[2] + spacing[2] * ((double)(pz) + dz);
     }
+    dualPoint[1] = px;
+    dualPoint[2] = py;
+    dualPoint[3] = pz;
   }
 
   // We have the points, now contour the cell.
@@ -1329,7 +1208,7 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
     // Only permanently keep locator for edges shared between two blocks.
     for (int ii = 0; ii < 3; ++ii, ++edge) // insert triangle
     {
-      vtkIdType* ptIdPtr = this->BlockLocator->GetEdgePointer(x, y, z, *edge);
+      vtkIdType* ptIdPtr = ws->Locator.GetEdgePointer(x, y, z, *edge);
 
       if (*ptIdPtr == -1)
       {
@@ -1357,31 +1236,31 @@ void vtkAMRDualContour::ProcessDualCell(vtkAMRDualGridHelperBlock* block, int bl
           cornerPoints[pt1Idx | 1] + k * (cornerPoints[pt2Idx | 1] - cornerPoints[pt1Idx | 1]);
         pt[2] =
           cornerPoints[pt1Idx | 2] + k * (cornerPoints[pt2Idx | 2] - cornerPoints[pt1Idx | 2]);
-        *ptIdPtr = this->Points->InsertNextPoint(pt);
+        *ptIdPtr = ws->InsertEdgePoint(pt1Idx >> 2, pt2Idx >> 2, pt);
         // Interpolate attributes
         // Find the offsets of the two attributes to interpolate
         vtkIdType offset0 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][0]];
         vtkIdType offset1 = cornerOffsets[vtkAMRDualIsoEdgeToVTKPointsTable[*edge][1]];
-        this->InterpolateAttributes(block->Image, offset0, offset1, k, this->Mesh, *ptIdPtr);
+        this->InterpolateAttributes(block->Image, offset0, offset1, k, ws->Piece->Mesh, *ptIdPtr);
       }
       edgePointIds[*edge] = pointIds[ii] = *ptIdPtr;
     }
     if (pointIds[0] != pointIds[1] && pointIds[0] != pointIds[2] && pointIds[1] != pointIds[2])
     {
-      this->Faces->InsertNextCell(3, pointIds);
-      this->BlockIdCellArray->InsertNextValue(blockId);
+      ws->InsertFace(3, pointIds, blockId);
     }
   }
 
   if (this->EnableCapping)
   {
     this->CapCell(x, y, z, cubeBoundaryBits, cubeCase, edgePointIds, cornerPoints, cornerOffsets,
-      blockId, block->Image);
+      blockId, block->Image, ws);
   }
 }
 
 //----------------------------------------------------------------------------
-void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId)
+void vtkAMRDualContour::AddCapPolygon(
+  int ptCount, vtkIdType* pointIds, int blockId, vtkAMRDualContourWorkspace* ws)
 {
   if (this->TriangulateCap)
   {
@@ -1397,8 +1276,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          ws->InsertFace(3, tri, blockId);
         }
       }
       else
@@ -1408,16 +1286,14 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          ws->InsertFace(3, tri, blockId);
         }
         tri[0] = pointIds[high];
         tri[1] = pointIds[high + 1];
         tri[2] = pointIds[low];
         if (tri[0] != tri[1] && tri[0] != tri[2] && tri[1] != tri[2])
         {
-          this->Faces->InsertNextCell(3, tri);
-          this->BlockIdCellArray->InsertNextValue(blockId);
+          ws->InsertFace(3, tri, blockId);
         }
       }
       ++low;
@@ -1427,8 +1303,7 @@ void vtkAMRDualContour::AddCapPolygon(int ptCount, vtkIdType* pointIds, int bloc
   else
   {
     // Do not worry about degenerate polygons in this path.
-    this->Faces->InsertNextCell(ptCount, pointIds);
-    this->BlockIdCellArray->InsertNextValue(blockId);
+    ws->InsertFace(ptCount, pointIds, blockId);
   }
 }
 
@@ -1455,7 +1330,9 @@ void vtkAMRDualContour::CapCell(
   // For block id array (for debugging).  I should just make this an ivar.
   int blockId,
   // For passing attributes to output mesh
-  vtkDataSet* inData)
+  vtkDataSet* inData,
+  // Locator and piece of the block
+  vtkAMRDualContourWorkspace* ws)
 {
   int cornerIdx;
   vtkIdType* ptIdPtr;
@@ -1474,12 +1351,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1489,7 +1366,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1510,12 +1387,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPXCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1525,7 +1402,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1547,12 +1424,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1562,7 +1439,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1584,12 +1461,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPYCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1599,7 +1476,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1620,12 +1497,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoNZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1635,7 +1512,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
@@ -1657,12 +1534,12 @@ void vtkAMRDualContour::CapCell(
         if (*capPtr < 4)
         {
           cornerIdx = (vtkAMRDualIsoPZCapEdgeMap[*capPtr]);
-          ptIdPtr = this->BlockLocator->GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
+          ptIdPtr = ws->Locator.GetCornerPointer(cellX, cellY, cellZ, cornerIdx);
           if (*ptIdPtr == -1)
           {
-            *ptIdPtr = this->Points->InsertNextPoint(cornerPoints + (cornerIdx << 2));
-            this->CopyAttributes(
-              inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]], this->Mesh, *ptIdPtr);
+            *ptIdPtr = ws->InsertCornerPoint(cornerIdx, cornerPoints + (cornerIdx << 2));
+            this->CopyAttributes(inData, cornerOffsets[vtkAMRDualLegacyIdToBitIdMap[cornerIdx]],
+              ws->Piece->Mesh, *ptIdPtr);
           }
           pointIds[ptCount++] = *ptIdPtr;
         }
@@ -1672,7 +1549,7 @@ void vtkAMRDualContour::CapCell(
         }
         ++capPtr;
       }
-      this->AddCapPolygon(ptCount, pointIds, blockId);
+      this->AddCapPolygon(ptCount, pointIds, blockId, ws);
       if (*capPtr == -1)
       {
         ++capPtr;
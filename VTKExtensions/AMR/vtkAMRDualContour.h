@@ -21,6 +21,10 @@
  * a particle index as part of the cell data of the output.  It computes
  * the volume of each particle from the volume fraction.
  *
+ * Blocks are contoured concurrently using vtkSMPTools, each into its own
+ * piece. The pieces are appended in block order, which keeps the output
+ * independent of the number of threads.
+ *
  * This will turn on validation and debug i/o of the filter.
  * \code{.cpp}
  * #define vtkAMRDualContourDEBUG
@@ -52,6 +56,7 @@ class vtkAMRDualGridHelper;
 class vtkAMRDualGridHelperBlock;
 class vtkAMRDualGridHelperFace;
 class vtkAMRDualContourEdgeLocator;
+class vtkAMRDualContourWorkspace;
 
 class VTKPVVTKEXTENSIONSAMR_EXPORT vtkAMRDualContour : public vtkMultiBlockDataSetAlgorithm
 {
@@ -112,6 +117,16 @@ public:
   vtkBooleanMacro(SkipGhostCopy, int);
   //@}
 
+  //@{
+  /**
+   * Set the maximum number of threads used to contour the blocks
+   * concurrently. 0 (default) uses all the threads available to vtkSMPTools,
+   * 1 contours the blocks serially.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
   vtkGetObjectMacro(Controller, vtkMultiProcessController);
   virtual void SetController(vtkMultiProcessController*);
 
@@ -128,6 +143,7 @@ protected:
   int EnableMergePoints;
   int TriangulateCap;
   int SkipGhostCopy;
+  int NumberOfThreads;
 
   int RequestData(vtkInformation*, vtkInformationVector**, vtkInformationVector*) override;
 
@@ -150,14 +166,17 @@ protected:
   int FillInputPortInformation(int port, vtkInformation* info) override;
   int FillOutputPortInformation(int port, vtkInformation* info) override;
 
-  void ShareBlockLocatorWithNeighbors(vtkAMRDualGridHelperBlock* block);
-
-  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName);
+  /**
+   * Contours a block into the piece of the workspace. This is called
+   * concurrently for different blocks with different workspaces.
+   */
+  void ProcessBlock(vtkAMRDualGridHelperBlock* block, int blockId, const char* arrayName,
+    vtkAMRDualContourWorkspace* ws);
 
   void ProcessDualCell(vtkAMRDualGridHelperBlock* block, int blockId, int x, int y, int z,
-    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray);
+    vtkIdType cornerOffsets[8], vtkDataArray* volumeFractionArray, vtkAMRDualContourWorkspace* ws);
 
-  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId);
+  void AddCapPolygon(int ptCount, vtkIdType* pointIds, int blockId, vtkAMRDualContourWorkspace* ws);
 
   // This method is getting too many arguments!
   // Capping was an after thought...
@@ -177,17 +196,16 @@ protected:
     // For block id array (for debugging).  I should just make this an ivar.
     int blockId,
     // For passing attributes to output mesh
-    vtkDataSet* inData);
+    vtkDataSet* inData,
+    // Locator and piece of the block
+    vtkAMRDualContourWorkspace* ws);
 
   // Stuff exclusively for debugging.
-  vtkIntArray* BlockIdCellArray;
   vtkFloatArray* TemperatureArray;
 
   // Ivars used to reduce method parrameters.
   vtkAMRDualGridHelper* Helper;
   vtkPolyData* Mesh;
-  vtkPoints* Points;
-  vtkCellArray* Faces;
 
   vtkMultiProcessController* Controller;
 
@@ -196,8 +214,6 @@ protected:
   int* MessageBuffer;
   int* MessageBufferLength;
 
-  vtkAMRDualContourEdgeLocator* BlockLocator;
-
   // Stuff for passing cell attributes to point attributes.
   void InitializeCopyAttributes(vtkNonOverlappingAMR* hbdsInput, vtkDataSet* mesh);
   void InterpolateAttributes(vtkDataSet* uGrid, vtkIdType offset0, vtkIdType offset1, double k,
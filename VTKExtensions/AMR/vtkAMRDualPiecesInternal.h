@@ -0,0 +1,172 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkAMRDualPiecesInternal.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// Helpers shared by vtkAMRDualContour and vtkAMRDualClip to process blocks
+// concurrently, each into its own piece, and append the pieces afterwards.
+// This header is private and not installed.
+
+#ifndef vtkAMRDualPiecesInternal_h
+#define vtkAMRDualPiecesInternal_h
+
+#include "vtkCellArray.h"         // for vtkCellArray
+#include "vtkDataSetAttributes.h" // for vtkDataSetAttributes::FieldList
+#include "vtkIntArray.h"          // for vtkIntArray
+#include "vtkPointData.h"         // for vtkPointData
+#include "vtkPoints.h"            // for vtkPoints
+
+#include <algorithm>     // for std::lexicographical_compare
+#include <functional>    // for std::hash
+#include <memory>        // for std::unique_ptr
+#include <unordered_map> // for std::unordered_map
+#include <utility>       // for std::pair
+#include <vector>        // for std::vector
+
+//============================================================================
+// Identifies a point of the output independently of the block generating it.
+// Points are interpolated on the edge between two dual points (input cells),
+// each stored as its level followed by its global index in that level.
+// Points placed on a dual point use it for both ends.
+class vtkAMRDualPointKey
+{
+public:
+  int Ends[8];
+
+  vtkAMRDualPointKey(const int* end0, const int* end1)
+  {
+    // Order the ends so that both directions of an edge give the same key.
+    if (std::lexicographical_compare(end1, end1 + 4, end0, end0 + 4))
+    {
+      std::swap(end0, end1);
+    }
+    std::copy(end0, end0 + 4, this->Ends);
+    std::copy(end1, end1 + 4, this->Ends + 4);
+  }
+
+  bool operator==(const vtkAMRDualPointKey& other) const
+  {
+    return std::equal(this->Ends, this->Ends + 8, other.Ends);
+  }
+};
+
+struct vtkAMRDualPointKeyHash
+{
+  size_t operator()(const vtkAMRDualPointKey& key) const
+  {
+    size_t hash = 0;
+    for (int ii = 0; ii < 8; ++ii)
+    {
+      hash ^= std::hash<int>()(key.Ends[ii]) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+    }
+    return hash;
+  }
+};
+
+//----------------------------------------------------------------------------
+// Appends the pieces to `points`, `outPD`, `cells` and `blockIds` in block
+// order. A point generated by several blocks is only added once, by the first
+// block generating it, and cells for which `keepCell(npts, ids)` is false once
+// their points are merged are dropped. Returns false when there is no piece to
+// append.
+//
+// PieceT provides the `Points`, `Cells`, `BlockIds` and `SharedPoints` of the
+// piece, the latter pairing the key of the points a neighbor block may
+// generate as well with their id in the piece, and `GetPointData()`.
+template <typename PieceT, typename KeepCellT>
+bool vtkAMRDualAppendPieces(std::vector<std::unique_ptr<PieceT>>& pieces, vtkPoints* points,
+  vtkPointData* outPD, vtkCellArray* cells, vtkIntArray* blockIds, KeepCellT keepCell)
+{
+  vtkDataSetAttributes::FieldList fieldList(static_cast<int>(pieces.size()));
+  vtkIdType numPoints = 0;
+  int numPieces = 0;
+  for (auto& piece : pieces)
+  {
+    if (piece)
+    {
+      if (numPieces++ == 0)
+      {
+        fieldList.InitializeFieldList(piece->GetPointData());
+      }
+      else
+      {
+        fieldList.IntersectFieldList(piece->GetPointData());
+      }
+      numPoints += piece->Points->GetNumberOfPoints();
+    }
+  }
+  if (numPieces == 0)
+  {
+    return false;
+  }
+
+  outPD->CopyAllocate(fieldList, numPoints);
+  points->Allocate(numPoints);
+
+  std::unordered_map<vtkAMRDualPointKey, vtkIdType, vtkAMRDualPointKeyHash> sharedPointIds;
+  std::vector<vtkIdType> pointMap;
+  std::vector<vtkIdType> ids;
+  int pieceIdx = 0;
+  for (auto& piece : pieces)
+  {
+    if (!piece)
+    {
+      continue;
+    }
+    vtkIdType numPiecePoints = piece->Points->GetNumberOfPoints();
+    pointMap.assign(numPiecePoints, -1);
+    for (const auto& shared : piece->SharedPoints)
+    {
+      auto iter = sharedPointIds.find(shared.first);
+      if (iter != sharedPointIds.end())
+      {
+        pointMap[shared.second] = iter->second;
+      }
+    }
+    vtkPointData* inPD = piece->GetPointData();
+    for (vtkIdType ptId = 0; ptId < numPiecePoints; ++ptId)
+    {
+      if (pointMap[ptId] < 0)
+      {
+        pointMap[ptId] = points->InsertNextPoint(piece->Points->GetPoint(ptId));
+        outPD->CopyData(fieldList, inPD, pieceIdx, ptId, pointMap[ptId]);
+      }
+    }
+    for (const auto& shared : piece->SharedPoints)
+    {
+      sharedPointIds.emplace(shared.first, pointMap[shared.second]);
+    }
+
+    vtkIdType npts;
+    const vtkIdType* pts;
+    vtkIdType cellId = 0;
+    for (piece->Cells->InitTraversal(); piece->Cells->GetNextCell(npts, pts); ++cellId)
+    {
+      ids.resize(npts);
+      for (vtkIdType ii = 0; ii < npts; ++ii)
+      {
+        ids[ii] = pointMap[pts[ii]];
+      }
+      if (keepCell(npts, ids.data()))
+      {
+        cells->InsertNextCell(npts, ids.data());
+        blockIds->InsertNextValue(piece->BlockIds->GetValue(cellId));
+      }
+    }
+    piece.reset();
+    ++pieceIdx;
+  }
+  return true;
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkAMRDualPiecesInternal.h
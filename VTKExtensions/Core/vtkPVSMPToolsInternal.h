@@ -0,0 +1,59 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkPVSMPToolsInternal.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+// vtkSMPTools helpers shared by ParaView filters. This header is private and
+// not installed.
+
+#ifndef vtkPVSMPToolsInternal_h
+#define vtkPVSMPToolsInternal_h
+
+#include "vtkSMPTools.h" // for vtkSMPTools
+#include "vtkType.h"     // for vtkIdType
+
+namespace vtkPVSMPToolsInternal
+{
+/**
+ * Calls `functor(begin, end)` over [0, size) using at most `numberOfThreads`
+ * threads: 0 for no limit, 1 to run serially on the calling thread.
+ *
+ * The number of threads used by vtkSMPTools is a process-wide setting, so a
+ * limit is honored by splitting the range in as many contiguous chunks, each
+ * processed by a single call to `functor`. Items are expected to be costly,
+ * e.g. blocks of a composite dataset, and are scheduled one at a time.
+ */
+template <typename FunctorT>
+void For(int numberOfThreads, vtkIdType size, FunctorT& functor)
+{
+  if (numberOfThreads == 1 || size < 2)
+  {
+    functor(0, size);
+  }
+  else if (numberOfThreads <= 0 || numberOfThreads >= size)
+  {
+    vtkSMPTools::For(0, size, 1, functor);
+  }
+  else
+  {
+    vtkSMPTools::For(0, numberOfThreads, 1, [&](vtkIdType first, vtkIdType last) {
+      for (vtkIdType chunk = first; chunk < last; ++chunk)
+      {
+        functor(chunk * size / numberOfThreads, (chunk + 1) * size / numberOfThreads);
+      }
+    });
+  }
+}
+}
+
+#endif
+// VTK-HeaderTest-Exclude: vtkPVSMPToolsInternal.h
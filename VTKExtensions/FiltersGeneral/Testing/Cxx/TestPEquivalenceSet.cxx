@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPEquivalenceSet.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkEquivalenceSet.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPEquivalenceSet.h"
+
+namespace
+{
+// Records the equivalences found by process `rank`. Each process numbers 10
+// fragments, shares a fragment with the next process and another with all
+// processes. The last process records a few more ids so that the ranges of
+// ids owned by each process do not match the ranges numbered by each process.
+void AddEquivalences(vtkEquivalenceSet* set, int rank, int numRanks)
+{
+  const int first = 10 * rank;
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    set->AddEquivalence(first + cc, first + cc);
+  }
+  if (rank + 1 < numRanks)
+  {
+    set->AddEquivalence(first + 9, first + 10);
+  }
+  if (rank > 0)
+  {
+    set->AddEquivalence(first + 2, first - 3);
+  }
+  set->AddEquivalence(first + 5, 3);
+  if (rank % 2 == 1)
+  {
+    set->AddEquivalence(first + 7, first + 1);
+  }
+  if (rank == numRanks - 1)
+  {
+    set->AddEquivalence(first + 14, first + 12);
+  }
+}
+
+bool TestResolveEquivalences(int rank, int numRanks)
+{
+  vtkNew<vtkPEquivalenceSet> set;
+  AddEquivalences(set, rank, numRanks);
+  const int numberOfSets = set->ResolveEquivalences();
+
+  // every process must get the set ids of a serial resolution.
+  vtkNew<vtkEquivalenceSet> expected;
+  for (int cc = 0; cc < numRanks; ++cc)
+  {
+    AddEquivalences(expected, cc, numRanks);
+  }
+  expected->ResolveEquivalences();
+
+  if (numberOfSets != expected->GetNumberOfResolvedSets() ||
+    set->GetNumberOfResolvedSets() != expected->GetNumberOfResolvedSets())
+  {
+    vtkLogF(ERROR, "expected %d sets, got %d.", expected->GetNumberOfResolvedSets(),
+      set->GetNumberOfResolvedSets());
+    return false;
+  }
+  for (int id = 0; id < set->GetNumberOfMembers(); ++id)
+  {
+    if (set->GetEquivalentSetId(id) != expected->GetEquivalentSetId(id))
+    {
+      vtkLogF(ERROR, "id %d: expected set %d, got %d.", id, expected->GetEquivalentSetId(id),
+        set->GetEquivalentSetId(id));
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int TestPEquivalenceSet(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestResolveEquivalences(contr->GetLocalProcessId(), contr->GetNumberOfProcesses());
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -13,10 +13,108 @@
 
 =========================================================================*/
 #include "vtkPEquivalenceSet.h"
+#include "vtkCommunicator.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
 #include "vtkObjectFactory.h"
 
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+#include "vtkMPICommunicator.h"
+#include "vtkMPIController.h"
+#endif
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+const int VTK_EQUIVALENCE_SET_TAG = 475893745;
+
+//----------------------------------------------------------------------------
+// Sends send[proc] to every process proc and receives what every process sent
+// to this one in recv[proc]. Processes first agree on the number of messages
+// each of them receives, then only non-empty buffers are sent, each preceded by
+// a header holding the sender id and the buffer length.
+void Exchange(vtkMultiProcessController* controller, std::vector<std::vector<int>>& send,
+  std::vector<std::vector<int>>& recv)
+{
+  const int numProcs = controller->GetNumberOfProcesses();
+  const int myProc = controller->GetLocalProcessId();
+  recv.assign(numProcs, std::vector<int>());
+  recv[myProc].swap(send[myProc]);
+
+  std::vector<int> sends(numProcs, 0);
+  std::vector<int> receives(numProcs, 0);
+  std::vector<std::array<int, 2>> headers(numProcs);
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    sends[proc] = send[proc].empty() ? 0 : 1;
+    headers[proc] = { { myProc, static_cast<int>(send[proc].size()) } };
+  }
+  controller->AllReduce(sends.data(), receives.data(), numProcs, vtkCommunicator::SUM_OP);
+  const int numberOfMessages = receives[myProc];
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  vtkMPIController* mpiController = vtkMPIController::SafeDownCast(controller);
+  std::vector<vtkMPICommunicator::Request> requests;
+#endif
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    if (!sends[proc])
+    {
+      continue;
+    }
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+    if (mpiController)
+    {
+      requests.resize(requests.size() + 2);
+      mpiController->NoBlockSend(
+        headers[proc].data(), 2, proc, VTK_EQUIVALENCE_SET_TAG, requests[requests.size() - 2]);
+      mpiController->NoBlockSend(send[proc].data(), headers[proc][1], proc,
+        VTK_EQUIVALENCE_SET_TAG + 1, requests.back());
+      continue;
+    }
+#endif
+    // Other controllers buffer their messages, so blocking sends are fine.
+    controller->Send(headers[proc].data(), 2, proc, VTK_EQUIVALENCE_SET_TAG);
+    controller->Send(send[proc].data(), headers[proc][1], proc, VTK_EQUIVALENCE_SET_TAG + 1);
+  }
+
+  for (int cc = 0; cc < numberOfMessages; ++cc)
+  {
+    int header[2];
+    controller->Receive(
+      header, 2, vtkMultiProcessController::ANY_SOURCE, VTK_EQUIVALENCE_SET_TAG);
+    recv[header[0]].resize(header[1]);
+    controller->Receive(recv[header[0]].data(), header[1], header[0], VTK_EQUIVALENCE_SET_TAG + 1);
+  }
+
+#if VTK_MODULE_ENABLE_VTK_ParallelMPI
+  for (auto& request : requests)
+  {
+    request.Wait();
+  }
+#endif
+  for (auto& buffer : send)
+  {
+    buffer.clear();
+  }
+}
+
+//----------------------------------------------------------------------------
+// Returns true on any process when `value` is true on at least one of them.
+bool AnyProcess(vtkMultiProcessController* controller, bool value)
+{
+  int local = value ? 1 : 0;
+  int global = 0;
+  controller->AllReduce(&local, &global, 1, vtkCommunicator::MAX_OP);
+  return global != 0;
+}
+}
+
 vtkStandardNewMacro(vtkPEquivalenceSet);
 
 vtkPEquivalenceSet::vtkPEquivalenceSet() = default;
@@ -28,55 +126,278 @@ void vtkPEquivalenceSet::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
 }
 
+//----------------------------------------------------------------------------
+// The global set covers the ids [0, numberOfMembers), with numberOfMembers the
+// largest number of members of all processes. The ids are split in contiguous
+// ranges, each owned by one process. An owner only keeps the ids of its range
+// that are equivalent to a smaller id, along with that id, and processes only
+// exchange these sparse equivalences.
 int vtkPEquivalenceSet::ResolveEquivalences()
 {
   vtkMultiProcessController* controller = vtkMultiProcessController::GetGlobalController();
-  int myProc = controller->GetLocalProcessId();
-  int numProcs = controller->GetNumberOfProcesses();
+  if (!controller || controller->GetNumberOfProcesses() <= 1)
+  {
+    return this->Superclass::ResolveEquivalences();
+  }
+  const int myProc = controller->GetLocalProcessId();
+  const int numProcs = controller->GetNumberOfProcesses();
+
+  int localMembers = this->GetNumberOfMembers();
+  int numberOfMembers = 0;
+  controller->AllReduce(&localMembers, &numberOfMembers, 1, vtkCommunicator::MAX_OP);
+  const int rangeSize = std::max(
+    1, static_cast<int>((static_cast<vtkIdType>(numberOfMembers) + numProcs - 1) / numProcs));
+  auto owner = [rangeSize](int id) { return id / rangeSize; };
+
+  std::vector<std::vector<int>> send(numProcs);
+  std::vector<std::vector<int>> recv;
+
+  // Send every local member that is not the smallest of its local set, along
+  // with that smallest member, to the owner of the member. Members only point
+  // to smaller ids, so collapsing the chains in order finds the smallest one.
+  for (int id = 0; id < localMembers; ++id)
+  {
+    const int ref = this->EquivalenceArray->GetValue(id);
+    if (ref != id)
+    {
+      const int smallest = this->EquivalenceArray->GetValue(ref);
+      this->EquivalenceArray->SetValue(id, smallest);
+      send[owner(id)].push_back(id);
+      send[owner(id)].push_back(smallest);
+    }
+  }
+
+  // Merge the equivalences of the owned ids. Like EquateInternal, an id only
+  // points to a smaller one, and replacing the reference of an id forwards the
+  // equivalence of the old and new references to the owner of the larger one.
+  std::unordered_map<int, int> references;
+  auto hasForwarded = [&send]() {
+    return std::any_of(send.begin(), send.end(),
+      [](const std::vector<int>& buffer) { return !buffer.empty(); });
+  };
+  do
+  {
+    Exchange(controller, send, recv);
+    std::vector<std::pair<int, int>> pending;
+    for (const auto& buffer : recv)
+    {
+      for (size_t cc = 0; cc + 1 < buffer.size(); cc += 2)
+      {
+        pending.emplace_back(buffer[cc], buffer[cc + 1]);
+      }
+    }
+    while (!pending.empty())
+    {
+      const auto equivalence = pending.back();
+      pending.pop_back();
+      auto iter = references.find(equivalence.first);
+      if (iter == references.end())
+      {
+        references.emplace(equivalence);
+        continue;
+      }
+      if (iter->second == equivalence.second)
+      {
+        continue;
+      }
+      const int smaller = std::min(iter->second, equivalence.second);
+      const int larger = std::max(iter->second, equivalence.second);
+      iter->second = smaller;
+      if (owner(larger) == myProc)
+      {
+        pending.emplace_back(larger, smaller);
+      }
+      else
+      {
+        send[owner(larger)].push_back(larger);
+        send[owner(larger)].push_back(smaller);
+      }
+    }
+  } while (AnyProcess(controller, hasForwarded()));
 
-  vtkIntArray* workingSet = vtkIntArray::New();
-  workingSet->SetNumberOfComponents(1);
+  // The owned ids that are not the smallest of their set, sorted, with the id
+  // they reference.
+  std::vector<std::pair<int, int>> members(references.begin(), references.end());
+  references.clear();
+  std::sort(members.begin(), members.end());
+  const int numberOfOwnedMembers = static_cast<int>(members.size());
+  auto countBelow = [&members](int id) {
+    return static_cast<int>(
+      std::lower_bound(members.begin(), members.end(), std::make_pair(id, VTK_INT_MIN)) -
+      members.begin());
+  };
+  auto find = [&](int id) {
+    const int index = countBelow(id);
+    return (index < numberOfOwnedMembers && members[index].first == id) ? index : -1;
+  };
 
-  int tag = 475893745;
-  int pivot = (numProcs + 1) / 2;
-  while (pivot > 0 && myProc < (pivot * 2))
+  // Replace the references by the smallest member of each set. Owned
+  // references are followed locally, the others by asking their owner for
+  // their own reference until it is known to be the smallest member.
+  std::vector<char> resolved(numberOfOwnedMembers, 0);
+  bool unresolved;
+  do
   {
-    int tuples;
-    if (myProc >= pivot)
+    unresolved = false;
+    for (int cc = 0; cc < numberOfOwnedMembers; ++cc)
+    {
+      if (resolved[cc])
+      {
+        continue;
+      }
+      const int ref = members[cc].second;
+      if (owner(ref) != myProc)
+      {
+        send[owner(ref)].push_back(ref);
+        unresolved = true;
+        continue;
+      }
+      const int index = find(ref);
+      if (index < 0)
+      {
+        resolved[cc] = 1;
+        continue;
+      }
+      // ref < members[cc].first, so it was already processed.
+      members[cc].second = members[index].second;
+      resolved[cc] = resolved[index];
+      if (!resolved[cc])
+      {
+        send[owner(members[cc].second)].push_back(members[cc].second);
+        unresolved = true;
+      }
+    }
+    if (!AnyProcess(controller, unresolved))
     {
-      tuples = this->EquivalenceArray->GetNumberOfTuples();
-      controller->Send(&tuples, 1, myProc - pivot, tag + pivot + 0);
-      controller->Send(this->EquivalenceArray, myProc - pivot, tag + pivot + 1);
+      break;
     }
-    else if ((myProc + pivot) < numProcs)
+
+    Exchange(controller, send, recv);
+    for (int proc = 0; proc < numProcs; ++proc)
     {
-      controller->Receive(&tuples, 1, myProc + pivot, tag + pivot + 0);
-      workingSet->SetNumberOfTuples(tuples);
+      auto& requests = recv[proc];
+      std::sort(requests.begin(), requests.end());
+      requests.erase(std::unique(requests.begin(), requests.end()), requests.end());
+      for (const int id : requests)
+      {
+        const int index = find(id);
+        send[proc].push_back(id);
+        send[proc].push_back(index < 0 ? id : members[index].second);
+        send[proc].push_back(index < 0 ? 1 : resolved[index]);
+      }
+    }
+    Exchange(controller, send, recv);
+    std::unordered_map<int, std::pair<int, char>> replies;
+    for (const auto& buffer : recv)
+    {
+      for (size_t cc = 0; cc + 2 < buffer.size(); cc += 3)
+      {
+        replies[buffer[cc]] = std::make_pair(buffer[cc + 1], static_cast<char>(buffer[cc + 2]));
+      }
+    }
+    for (int cc = 0; cc < numberOfOwnedMembers; ++cc)
+    {
+      auto iter = resolved[cc] ? replies.end() : replies.find(members[cc].second);
+      if (iter != replies.end())
+      {
+        members[cc].second = iter->second.first;
+        resolved[cc] = iter->second.second;
+      }
+    }
+  } while (true);
 
-      controller->Receive(workingSet, myProc + pivot, tag + pivot + 1);
-      while (workingSet->GetNumberOfTuples() > this->EquivalenceArray->GetNumberOfTuples())
+  // Sets are numbered in the order of their smallest member, which is its id
+  // minus the number of smaller ids that are not the smallest of their set.
+  std::vector<int> counts(numProcs, 0);
+  controller->AllGather(&numberOfOwnedMembers, counts.data(), 1);
+  int offset = 0;
+  int total = 0;
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    offset += proc < myProc ? counts[proc] : 0;
+    total += counts[proc];
+  }
+  this->NumberOfResolvedSets = numberOfMembers - total;
+
+  // Ask the owner of the smallest member of each set for the set id.
+  for (const auto& member : members)
+  {
+    send[owner(member.second)].push_back(member.second);
+  }
+  Exchange(controller, send, recv);
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    auto& requests = recv[proc];
+    std::sort(requests.begin(), requests.end());
+    requests.erase(std::unique(requests.begin(), requests.end()), requests.end());
+    for (const int id : requests)
+    {
+      send[proc].push_back(id);
+      send[proc].push_back(id - offset - countBelow(id));
+    }
+  }
+  Exchange(controller, send, recv);
+  std::unordered_map<int, int> setIds;
+  for (const auto& buffer : recv)
+  {
+    for (size_t cc = 0; cc + 1 < buffer.size(); cc += 2)
+    {
+      setIds[buffer[cc]] = buffer[cc + 1];
+    }
+  }
+  for (auto& member : members)
+  {
+    member.second = setIds[member.second];
+  }
+  setIds.clear();
+
+  // Fetch the set ids of the local members from their owners. An owner
+  // replies with the number of smaller ids that are not the smallest of their
+  // set followed by the set ids of such ids, from which all other set ids of
+  // the range follow.
+  for (int proc = 0; localMembers > 0 && proc <= owner(localMembers - 1); ++proc)
+  {
+    send[proc].push_back(proc * rangeSize);
+    send[proc].push_back(std::min((proc + 1) * rangeSize, localMembers));
+  }
+  Exchange(controller, send, recv);
+  for (int proc = 0; proc < numProcs; ++proc)
+  {
+    const auto& request = recv[proc];
+    if (request.size() == 2)
+    {
+      const int first = countBelow(request[0]);
+      const int last = countBelow(request[1]);
+      send[proc].push_back(offset + first);
+      for (int cc = first; cc < last; ++cc)
+      {
+        send[proc].push_back(members[cc].first);
+        send[proc].push_back(members[cc].second);
+      }
+    }
+  }
+  Exchange(controller, send, recv);
+  for (int proc = 0; localMembers > 0 && proc <= owner(localMembers - 1); ++proc)
+  {
+    const auto& reply = recv[proc];
+    int below = reply[0];
+    size_t next = 1;
+    const int last = std::min((proc + 1) * rangeSize, localMembers);
+    for (int id = proc * rangeSize; id < last; ++id)
+    {
+      if (next + 1 < reply.size() && reply[next] == id)
       {
-        this->EquivalenceArray->InsertNextTuple1(0);
+        this->EquivalenceArray->SetValue(id, reply[next + 1]);
+        next += 2;
+        ++below;
       }
-      for (int i = 0; i < workingSet->GetNumberOfTuples(); i++)
+      else
       {
-        int workingVal = workingSet->GetValue(i);
-        if (workingVal == 0)
-        {
-          continue;
-        }
-        int existingVal = this->EquivalenceArray->GetValue(i);
-        this->EquivalenceArray->SetValue(i, workingVal);
-        if (existingVal != 0 && existingVal < workingVal)
-        {
-          this->EquateInternal(existingVal, workingVal);
-        }
+        this->EquivalenceArray->SetValue(id, id - below);
       }
     }
-    pivot /= 2;
   }
-  controller->Broadcast(this->EquivalenceArray, 0);
 
-  this->Superclass::ResolveEquivalences();
-  return 1;
+  this->Resolved = 1;
+  return this->NumberOfResolvedSets;
 }
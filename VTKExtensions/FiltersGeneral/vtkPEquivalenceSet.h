@@ -17,6 +17,11 @@
  * @brief   distributed method of Equivalence
  *
  * Same as EquivalenceSet, but resolving is a global operation.
+ *
+ * Resolving is a distributed union-find: the ids are split in contiguous
+ * ranges, each owned by one process, and processes only exchange the ids that
+ * are equivalent to a smaller id. Once resolved, each process only holds the
+ * set ids of its own members, numbered consistently on all processes.
  * .SEE vtkEquivalenceSet
  */
 
@@ -34,6 +39,7 @@ public:
   static vtkPEquivalenceSet* New();
 
   // Globally equivalent set IDs are reassigned to be sequential.
+  // This is a collective operation. Returns the global number of sets.
   int ResolveEquivalences() override;
 
 protected:
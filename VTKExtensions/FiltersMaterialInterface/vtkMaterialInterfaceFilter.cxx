@@ -20,6 +20,9 @@
 #include "vtkMultiProcessController.h"
 #include "vtkObject.h"
 #include "vtkObjectFactory.h"
+#include "vtkPVLogger.h"
+#include "vtkSMPThreadLocal.h"
+#include "vtkSMPTools.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 // PV interface
 #include "vtkCallbackCommand.h"
@@ -72,6 +75,7 @@
 // STL
 #include <fstream>
 using std::ofstream;
+#include <memory>
 #include <sstream>
 using std::ostringstream;
 #include <vector>
@@ -1540,6 +1544,155 @@ int vtkMaterialInterfaceFilterRingBuffer::Pop(vtkMaterialInterfaceFilterIterator
 
 //============================================================================
 
+//----------------------------------------------------------------------------
+// The fragments found in a single block. Ids are local to the block until the
+// fragments of all blocks are gathered.
+class vtkMaterialInterfaceFilterBlockFragments
+{
+public:
+  std::vector<vtkPolyData*> Meshes;
+  std::vector<double> Volumes;
+  std::vector<double> ClipDepthMaximums;
+  std::vector<double> ClipDepthMinimums;
+  std::vector<double> Moments; // =(Myz, Mxz, Mxy, m) for each fragment
+  // one flat array of tuples for each integrated array
+  std::vector<std::vector<double>> VolumeWtdAvgs;
+  std::vector<std::vector<double>> MassWtdAvgs;
+  std::vector<std::vector<double>> Sums;
+};
+
+//----------------------------------------------------------------------------
+// Everything the breadth first search modifies while building the fragments
+// of a block. Each thread has its own, so that blocks are processed
+// concurrently.
+class vtkMaterialInterfaceFilterWorkspace
+{
+public:
+  vtkMaterialInterfaceFilterWorkspace();
+
+  // Size the accumulators for the arrays being integrated.
+  void Initialize(bool clipWithPlane, bool computeMoments,
+    const std::vector<vtkDoubleArray*>& volumeWtdAvgs,
+    const std::vector<vtkDoubleArray*>& massWtdAvgs, const std::vector<vtkDoubleArray*>& sums);
+  // Move the current fragment mesh and accumulators into Fragments,
+  // then clear the accumulators.
+  void SaveFragment();
+
+  vtkMaterialInterfaceFilterRingBuffer Queue;
+  // Ivars for computing the point on corners and edges of a face.
+  vtkMaterialInterfaceFilterIterator FaceNeighbors[32];
+  double FaceCornerPoints[12];
+  double FaceEdgePoints[12];
+  int FaceEdgeFlags[4];
+
+  // Results for the block being processed.
+  vtkMaterialInterfaceFilterBlockFragments* Fragments;
+  // Block local id of the current fragment, its mesh and accumulators.
+  int FragmentId;
+  vtkPolyData* CurrentFragmentMesh;
+  double FragmentVolume;
+  double ClipDepthMin;
+  double ClipDepthMax;
+  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
+  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
+  std::vector<std::vector<double>> FragmentMassWtdAvg;
+  std::vector<std::vector<double>> FragmentSum;
+
+private:
+  bool ClipWithPlane;
+  bool ComputeMoments;
+};
+
+//----------------------------------------------------------------------------
+vtkMaterialInterfaceFilterWorkspace::vtkMaterialInterfaceFilterWorkspace()
+{
+  this->Fragments = nullptr;
+  this->FragmentId = 0;
+  this->CurrentFragmentMesh = nullptr;
+  this->FragmentVolume = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  this->ClipDepthMax = 0.0;
+  this->FragmentMoment.resize(4, 0.0);
+  this->ClipWithPlane = false;
+  this->ComputeMoments = false;
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterWorkspace::Initialize(bool clipWithPlane, bool computeMoments,
+  const std::vector<vtkDoubleArray*>& volumeWtdAvgs,
+  const std::vector<vtkDoubleArray*>& massWtdAvgs, const std::vector<vtkDoubleArray*>& sums)
+{
+  this->ClipWithPlane = clipWithPlane;
+  this->ComputeMoments = computeMoments;
+  this->FragmentVolumeWtdAvg.resize(volumeWtdAvgs.size());
+  for (size_t i = 0; i < volumeWtdAvgs.size(); ++i)
+  {
+    this->FragmentVolumeWtdAvg[i].resize(volumeWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  this->FragmentMassWtdAvg.resize(massWtdAvgs.size());
+  for (size_t i = 0; i < massWtdAvgs.size(); ++i)
+  {
+    this->FragmentMassWtdAvg[i].resize(massWtdAvgs[i]->GetNumberOfComponents(), 0.0);
+  }
+  this->FragmentSum.resize(sums.size());
+  for (size_t i = 0; i < sums.size(); ++i)
+  {
+    this->FragmentSum[i].resize(sums[i]->GetNumberOfComponents(), 0.0);
+  }
+}
+
+//----------------------------------------------------------------------------
+void vtkMaterialInterfaceFilterWorkspace::SaveFragment()
+{
+  vtkMaterialInterfaceFilterBlockFragments* fragments = this->Fragments;
+  // the id is implicit given by its position in the vector, but only
+  // until fragments are resolved.
+  this->CurrentFragmentMesh->Squeeze();
+  fragments->Meshes.push_back(this->CurrentFragmentMesh);
+  this->CurrentFragmentMesh = nullptr;
+  fragments->Volumes.push_back(this->FragmentVolume);
+  this->FragmentVolume = 0.0;
+  if (this->ClipWithPlane)
+  {
+    fragments->ClipDepthMaximums.push_back(this->ClipDepthMax);
+    fragments->ClipDepthMinimums.push_back(this->ClipDepthMin);
+  }
+  this->ClipDepthMax = 0.0;
+  this->ClipDepthMin = VTK_FLOAT_MAX;
+  if (this->ComputeMoments)
+  {
+    fragments->Moments.insert(
+      fragments->Moments.end(), this->FragmentMoment.begin(), this->FragmentMoment.end());
+    FillVector(this->FragmentMoment, 0.0);
+  }
+  fragments->VolumeWtdAvgs.resize(this->FragmentVolumeWtdAvg.size());
+  for (size_t i = 0; i < this->FragmentVolumeWtdAvg.size(); ++i)
+  {
+    std::vector<double>& accumulator = this->FragmentVolumeWtdAvg[i];
+    fragments->VolumeWtdAvgs[i].insert(
+      fragments->VolumeWtdAvgs[i].end(), accumulator.begin(), accumulator.end());
+    FillVector(accumulator, 0.0);
+  }
+  fragments->MassWtdAvgs.resize(this->FragmentMassWtdAvg.size());
+  for (size_t i = 0; i < this->FragmentMassWtdAvg.size(); ++i)
+  {
+    std::vector<double>& accumulator = this->FragmentMassWtdAvg[i];
+    fragments->MassWtdAvgs[i].insert(
+      fragments->MassWtdAvgs[i].end(), accumulator.begin(), accumulator.end());
+    FillVector(accumulator, 0.0);
+  }
+  fragments->Sums.resize(this->FragmentSum.size());
+  for (size_t i = 0; i < this->FragmentSum.size(); ++i)
+  {
+    std::vector<double>& accumulator = this->FragmentSum[i];
+    fragments->Sums[i].insert(fragments->Sums[i].end(), accumulator.begin(), accumulator.end());
+    FillVector(accumulator, 0.0);
+  }
+  ++this->FragmentId;
+}
+
+//============================================================================
+
 //----------------------------------------------------------------------------
 // Description:
 // Construct object with initial range (0,1) and single contour value
@@ -1548,16 +1701,6 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
 {
   this->Controller = vtkMultiProcessController::GetGlobalController();
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
-  this->ShareGhostBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
-  this->NumberOfBlocks = 0;
-  this->NumberOfGhostBlocks = 0;
-  this->ProcessBlocksTimer = vtkSmartPointer<vtkTimerLog>::New();
-  this->ResolveEquivalencesTimer = vtkSmartPointer<vtkTimerLog>::New();
-#endif
-
 #ifdef vtkMaterialInterfaceFilterDEBUG
   int myProcId = this->Controller->GetLocalProcessId();
   this->MyPid = WritePidFile(this->Controller->GetCommunicator(), "mif.pid");
@@ -1608,17 +1751,13 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
   this->FragmentVolumes = nullptr;
-  this->FragmentMoment.resize(4, 0.0);
   this->FragmentMoments = nullptr;
   this->FragmentAABBCenters = nullptr;
   this->FragmentOBBs = nullptr;
   this->FragmentSplitGeometry = nullptr;
 
   // Keep depth of crater along clip plane normal.
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
   this->ClipDepthMaximums = nullptr;
   this->ClipDepthMinimums = nullptr;
 
@@ -1633,10 +1772,6 @@ vtkMaterialInterfaceFilter::vtkMaterialInterfaceFilter()
   this->ResolvedFragmentCenters = nullptr;
   this->ResolvedFragmentOBBs = nullptr;
 
-  this->FaceNeighbors = new vtkMaterialInterfaceFilterIterator[32];
-
-  this->CurrentFragmentMesh = nullptr;
-
   this->NVolumeWtdAvgs = 0;
   this->NToSum = 0;
   this->ComputeMoments = false;
@@ -1679,9 +1814,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   this->RootSpacing[0] = this->RootSpacing[1] = this->RootSpacing[2] = 1.0;
 
   this->FragmentId = 0;
-  this->FragmentVolume = 0.0;
-  this->ClipDepthMax = 0.0;
-  this->ClipDepthMin = VTK_FLOAT_MAX;
 
   this->SetClipFunction(nullptr);
 
@@ -1699,9 +1831,6 @@ vtkMaterialInterfaceFilter::~vtkMaterialInterfaceFilter()
   delete this->EquivalenceSet;
   this->EquivalenceSet = nullptr;
 
-  delete[] this->FaceNeighbors;
-  this->FaceNeighbors = nullptr;
-
   // clean up PV interface
   this->MaterialArraySelection->RemoveObserver(this->SelectionObserver);
   this->MaterialArraySelection->Delete();
@@ -1847,11 +1976,7 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
   int myProc = this->Controller->GetLocalProcessId();
   int numProcs = this->Controller->GetNumberOfProcesses();
   vtkMaterialInterfaceFilterHalfSphere* sphere = nullptr;
-
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer->StartTimer();
-#endif
+  vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "initialize-blocks");
 
   // leaving this logic alone rather than moving it into the
   // this->ClipFunction conditional because I don't know enough of the class to
@@ -2022,36 +2147,17 @@ int vtkMaterialInterfaceFilter::InitializeBlocks(vtkNonOverlappingAMR* input,
     this->AddBlock(block, this->GetBlockGhostLevel());
   }
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->InitializeBlocksTimer->StopTimer();
-#endif
-
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->ShareGhostBlocksTimer->StartTimer();
-#endif
-
   // cerr << "start ghost blocks\n" << endl;
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->NumberOfBlocks = this->NumberOfInputBlocks;
-#endif
-
   // Broadcast all of the block meta data to all processes.
   // Setup ghost layer blocks.
   // Remove this until the local version is working again.....
   if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
   {
+    vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "share-ghost-blocks");
     this->ShareGhostBlocks();
   }
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->ShareGhostBlocksTimer->StopTimer();
-#endif
-
   return VTK_OK;
 }
 
@@ -2878,10 +2984,8 @@ void vtkMaterialInterfaceFilter::ShareGhostBlocks()
   // Process, extent
   // ...
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->NumberOfGhostBlocks = this->GhostBlocks.size();
-#endif
+  vtkVLogF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "%d ghost blocks",
+    static_cast<int>(this->GhostBlocks.size()));
 
   /*
 
@@ -3214,14 +3318,11 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 {
   this->FragmentId = 0;
 
-  this->FragmentVolume = 0.0;
   ReNewVtkPointer(this->FragmentVolumes);
   this->FragmentVolumes->SetName("Volume");
 
   if (this->ClipWithPlane)
   {
-    this->ClipDepthMax = 0.0;
-    this->ClipDepthMin = VTK_FLOAT_MAX;
     ReNewVtkPointer(this->ClipDepthMaximums);
     ReNewVtkPointer(this->ClipDepthMinimums);
     this->ClipDepthMaximums->SetName("ClipDepthMax");
@@ -3230,8 +3331,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 
   if (this->ComputeMoments)
   {
-    this->FragmentMoment.clear();
-    this->FragmentMoment.resize(4, 0.0);
     ReNewVtkPointer(this->FragmentMoments);
     this->FragmentMoments->SetNumberOfComponents(4);
     this->FragmentMoments->SetName("Moments");
@@ -3269,8 +3368,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
   // Configure data structures
   // 1) Volume weighted average of attribute over the
   // fragment set up containers
-  this->FragmentVolumeWtdAvg.clear();
-  this->FragmentVolumeWtdAvg.resize(this->NVolumeWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentVolumeWtdAvgs);
   this->FragmentVolumeWtdAvgs.resize(this->NVolumeWtdAvgs);
   // set up data array and accumulator for each weighted average
@@ -3292,13 +3389,9 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "VolumeWeightedAverage-" << thisArrayName;
     this->FragmentVolumeWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentVolumeWtdAvg[j].resize(nComp, 0.0);
   }
   // 2) Mass weighted average of attribute over the fragment
   // set up containers
-  this->FragmentMassWtdAvg.clear();
-  this->FragmentMassWtdAvg.resize(this->NMassWtdAvgs);
   ClearVectorOfVtkPointers(this->FragmentMassWtdAvgs);
   this->FragmentMassWtdAvgs.resize(this->NMassWtdAvgs);
   // set up data array and accumulator for each weighted average
@@ -3320,13 +3413,9 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "MassWeightedAverage-" << thisArrayName;
     this->FragmentMassWtdAvgs[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentMassWtdAvg[j].resize(nComp, 0.0);
   }
   // 3) Summation of attribute over the fragment
   // set up containers
-  this->FragmentSum.clear();
-  this->FragmentSum.resize(this->NToSum);
   ClearVectorOfVtkPointers(this->FragmentSums);
   this->FragmentSums.resize(this->NToSum);
   // set up data array and accumulator for each weighted average
@@ -3348,8 +3437,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
     ostringstream osIntegratedArrayName;
     osIntegratedArrayName << "Summation-" << thisArrayName;
     this->FragmentSums[j]->SetName(osIntegratedArrayName.str().c_str());
-    // accumulator
-    this->FragmentSum[j].resize(nComp, 0.0);
   }
 
   // 4) Unique list of integrated attributes
@@ -3381,12 +3468,6 @@ void vtkMaterialInterfaceFilter::PrepareForPass(vtkNonOverlappingAMR* hbdsInput,
 int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
   vtkInformationVector** inputVector, vtkInformationVector* outputVector)
 {
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  this->NumberOfBlocks = 0;
-  this->NumberOfGhostBlocks = 0;
-#endif
-
   if (this->ClipFunction)
   {
     vtkSphere* s = vtkSphere::SafeDownCast(this->ClipFunction);
@@ -3572,41 +3653,21 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
 
     //
     this->ProgressBlockInc = this->ProgressMaterialInc / (double)this->NumberOfInputBlocks / 2.0;
-//
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ProcessBlocksTimer->StartTimer();
-#endif
-    int blockId;
-    for (blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
-    {
-      // build fragments
-      this->ProcessBlock(blockId);
-    }
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ProcessBlocksTimer->StopTimer();
-#endif
+    // build fragments
+    this->BuildFragments();
     // char tmp[128];
     // sprintf(tmp, "C:/Law/tmp/mifSurface%d.vtp", this->Controller->GetLocalProcessId());
     // this->SaveBlockSurfaces(tmp);
     // sprintf(tmp, "C:/Law/tmp/mifGhost%d.vtp", this->Controller->GetLocalProcessId());
     // this->SaveGhostSurfaces(tmp);
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ResolveEquivalencesTimer->StartTimer();
-#endif
-
     // resolve: Merge local and remote geometry
     // correct integrated attributes, finialize integrations
-    this->PrepareForResolveEquivalences();
-    this->ResolveEquivalences();
-
-#ifdef vtkMaterialInterfaceFilterPROFILE
-    // Lets profile to see what takes the most time for large number of processes.
-    this->ResolveEquivalencesTimer->StopTimer();
-#endif
+    {
+      vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "resolve-equivalences");
+      this->PrepareForResolveEquivalences();
+      this->ResolveEquivalences();
+    }
 
     // update the resolved fragment count, so that next pass will start
     // where we left off here
@@ -3662,97 +3723,140 @@ int vtkMaterialInterfaceFilter::RequestData(vtkInformation* vtkNotUsed(request),
        << " MTime: " << this->GetMTime() << "." << endl;
 #endif
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  double initializeTime, shareGhostBlocksTime, processBlocksTime, resolveEquivalencesTime;
-  unsigned long numberOfBlocks, numberOfGhostBlocks;
-  initializeTime = this->InitializeBlocksTimer->GetElapsedTime();
-  shareGhostBlocksTime = this->ShareGhostBlocksTimer->GetElapsedTime();
-  processBlocksTime = this->ProcessBlocksTimer->GetElapsedTime();
-  resolveEquivalencesTime = this->ResolveEquivalencesTimer->GetElapsedTime();
-  numberOfBlocks = this->NumberOfBlocks;
-  numberOfGhostBlocks = this->NumberOfGhostBlocks;
-  if (this->Controller == 0)
-  {
-    cout << "InitializeTime: " << initializeTime << endl;
-    cout << "ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-    cout << "NumberOfBlocks: " << numberOfBlocks << endl;
-    cout << "NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-    cout << "ProcessBlocksTime: " << processBlocksTime << endl;
-    cout << "ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-  }
-  else
+  return 1;
+}
+
+//----------------------------------------------------------------------------
+// Fragments are built one block at a time, with the blocks processed
+// concurrently. Fragment ids are then made unique over the blocks of this
+// process, and the pieces of fragments spanning several blocks are equated
+// so that they are merged when equivalences are resolved.
+void vtkMaterialInterfaceFilter::BuildFragments()
+{
+  vtkVLogScopeF(
+    PARAVIEW_LOG_EXECUTION_VERBOSITY(), "build-fragments (%d blocks)", this->NumberOfInputBlocks);
+
+  std::vector<vtkMaterialInterfaceFilterBlockFragments> blockFragments(this->NumberOfInputBlocks);
+  vtkSMPThreadLocal<std::shared_ptr<vtkMaterialInterfaceFilterWorkspace>> workspaces;
+  vtkSMPTools::For(0, this->NumberOfInputBlocks, [&](vtkIdType begin, vtkIdType end) {
+    std::shared_ptr<vtkMaterialInterfaceFilterWorkspace>& ws = workspaces.Local();
+    if (!ws)
+    {
+      ws = std::make_shared<vtkMaterialInterfaceFilterWorkspace>();
+      ws->Initialize(this->ClipWithPlane != 0, this->ComputeMoments, this->FragmentVolumeWtdAvgs,
+        this->FragmentMassWtdAvgs, this->FragmentSums);
+    }
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
+    {
+      ws->Fragments = &blockFragments[blockId];
+      this->ProcessBlock(static_cast<int>(blockId), ws.get());
+    }
+  });
+
+  // Number the fragments of each block after those of the previous blocks.
+  std::vector<int> offsets(this->NumberOfInputBlocks, 0);
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
   {
-    int numProcs = this->Controller->GetNumberOfProcesses();
-    if (this->Controller->GetLocalProcessId() == 0)
-    {
-      cout << "Process 0: \n";
-      cout << "  InitializeTime: " << initializeTime << endl;
-      cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-      cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-      cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-      cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-      cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
-      for (int procIdx = 1; procIdx < numProcs; ++procIdx)
+    offsets[blockId] = this->FragmentId;
+    vtkMaterialInterfaceFilterBlockFragments& fragments = blockFragments[blockId];
+    for (size_t fragmentIdx = 0; fragmentIdx < fragments.Meshes.size(); ++fragmentIdx)
+    {
+      this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+      // After resolution we add addributes such as id, volume, summations
+      // averages, etc..
+      this->FragmentMeshes.push_back(fragments.Meshes[fragmentIdx]);
+      this->FragmentVolumes->InsertTuple1(this->FragmentId, fragments.Volumes[fragmentIdx]);
+      if (this->ClipWithPlane)
+      {
+        this->ClipDepthMaximums->InsertTuple1(
+          this->FragmentId, fragments.ClipDepthMaximums[fragmentIdx]);
+        this->ClipDepthMinimums->InsertTuple1(
+          this->FragmentId, fragments.ClipDepthMinimums[fragmentIdx]);
+      }
+      if (this->ComputeMoments)
+      {
+        this->FragmentMoments->InsertTuple(this->FragmentId, &fragments.Moments[4 * fragmentIdx]);
+      }
+      for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
+      {
+        int nComps = this->FragmentVolumeWtdAvgs[i]->GetNumberOfComponents();
+        this->FragmentVolumeWtdAvgs[i]->InsertTuple(
+          this->FragmentId, &fragments.VolumeWtdAvgs[i][nComps * fragmentIdx]);
+      }
+      for (int i = 0; i < this->NMassWtdAvgs; ++i)
       {
-        this->Controller->Receive(&initializeTime, 1, procIdx, 234908);
-        this->Controller->Receive(&shareGhostBlocksTime, 1, procIdx, 234909);
-        this->Controller->Receive(&processBlocksTime, 1, procIdx, 234910);
-        this->Controller->Receive(&resolveEquivalencesTime, 1, procIdx, 234911);
-        this->Controller->Receive(&numberOfBlocks, 1, procIdx, 234912);
-        this->Controller->Receive(&numberOfGhostBlocks, 1, procIdx, 234913);
-        cout << "Process " << procIdx << ": \n";
-        cout << "  InitializeTime: " << initializeTime << endl;
-        cout << "  ShareGhostBlocksTime: " << shareGhostBlocksTime << endl;
-        cout << "  NumberOfBlocks: " << numberOfBlocks << endl;
-        cout << "  NumberOfGhostBlocks: " << numberOfGhostBlocks << endl;
-        cout << "  ProcessBlocksTime: " << processBlocksTime << endl;
-        cout << "  ResolveEquivalencesTimer: " << resolveEquivalencesTime << endl;
+        int nComps = this->FragmentMassWtdAvgs[i]->GetNumberOfComponents();
+        this->FragmentMassWtdAvgs[i]->InsertTuple(
+          this->FragmentId, &fragments.MassWtdAvgs[i][nComps * fragmentIdx]);
       }
+      for (int i = 0; i < this->NToSum; ++i)
+      {
+        int nComps = this->FragmentSums[i]->GetNumberOfComponents();
+        this->FragmentSums[i]->InsertTuple(
+          this->FragmentId, &fragments.Sums[i][nComps * fragmentIdx]);
+      }
+      ++this->FragmentId;
     }
-    else
+    this->Progress += this->ProgressBlockInc;
+    this->UpdateProgress(this->Progress);
+  }
+
+  // Relabel the voxels with the process wide fragment ids.
+  vtkSMPTools::For(0, this->NumberOfInputBlocks, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType blockId = begin; blockId < end; ++blockId)
     {
-      this->Controller->Send(&initializeTime, 1, 0, 234908);
-      this->Controller->Send(&shareGhostBlocksTime, 1, 0, 234909);
-      this->Controller->Send(&processBlocksTime, 1, 0, 234910);
-      this->Controller->Send(&resolveEquivalencesTime, 1, 0, 234911);
-      this->Controller->Send(&numberOfBlocks, 1, 0, 234912);
-      this->Controller->Send(&numberOfGhostBlocks, 1, 0, 234913);
+      vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+      const int offset = offsets[blockId];
+      if (block == nullptr || offset == 0)
+      {
+        continue;
+      }
+      const int* ext = block->GetBaseCellExtent();
+      int cellIncs[3];
+      block->GetCellIncrements(cellIncs);
+      int* zPtr = block->GetBaseFragmentIdPointer();
+      for (int iz = ext[4]; iz <= ext[5]; ++iz, zPtr += cellIncs[2])
+      {
+        int* yPtr = zPtr;
+        for (int iy = ext[2]; iy <= ext[3]; ++iy, yPtr += cellIncs[1])
+        {
+          int* xPtr = yPtr;
+          for (int ix = ext[0]; ix <= ext[1]; ++ix, xPtr += cellIncs[0])
+          {
+            if (*xPtr != -1)
+            {
+              *xPtr += offset;
+            }
+          }
+        }
+      }
     }
-  }
-#endif
+  });
 
-  return 1;
+  this->ConnectBlockBoundaries();
 }
 
 //----------------------------------------------------------------------------
-int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
+// Builds the fragments of a single block. The search does not leave the
+// block, voxels of other blocks are handled by ConnectBlockBoundaries.
+int vtkMaterialInterfaceFilter::ProcessBlock(int blockId, vtkMaterialInterfaceFilterWorkspace* ws)
 {
-#ifdef vtkMaterialInterfaceFilterDEBUG
-  ostringstream progressMesg;
-  progressMesg << "vtkMaterialInterfaceFilter::ProcessBlock(" << blockId << ") , Material "
-               << this->MaterialId;
-  this->SetProgressText(progressMesg.str().c_str());
-#endif
-  this->Progress += this->ProgressBlockInc;
-  this->UpdateProgress(this->Progress);
-
   vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
   if (block == nullptr)
   {
     return 0;
   }
 
-  vtkMaterialInterfaceFilterIterator* xIterator = new vtkMaterialInterfaceFilterIterator;
-  vtkMaterialInterfaceFilterIterator* yIterator = new vtkMaterialInterfaceFilterIterator;
-  vtkMaterialInterfaceFilterIterator* zIterator = new vtkMaterialInterfaceFilterIterator;
-  zIterator->Block = block;
+  vtkMaterialInterfaceFilterIterator xIterator;
+  vtkMaterialInterfaceFilterIterator yIterator;
+  vtkMaterialInterfaceFilterIterator zIterator;
+  zIterator.Block = block;
   // set iterator to reference first non ghost cell
-  zIterator->VolumeFractionPointer = block->GetBaseVolumeFractionPointer();
-  zIterator->FragmentIdPointer = block->GetBaseFragmentIdPointer();
-  zIterator->FlatIndex = block->GetBaseFlatIndex();
+  zIterator.VolumeFractionPointer = block->GetBaseVolumeFractionPointer();
+  zIterator.FragmentIdPointer = block->GetBaseFragmentIdPointer();
+  zIterator.FlatIndex = block->GetBaseFlatIndex();
 
-  vtkMaterialInterfaceFilterRingBuffer* queue = new vtkMaterialInterfaceFilterRingBuffer;
+  ws->FragmentId = 0;
 
   // Loop through all the voxels.
   int ix, iy, iz;
@@ -3763,97 +3867,41 @@ int vtkMaterialInterfaceFilter::ProcessBlock(int blockId)
   ext = block->GetBaseCellExtent();
   for (iz = ext[4]; iz <= ext[5]; ++iz)
   {
-    zIterator->Index[2] = iz;
-    *yIterator = *zIterator;
+    zIterator.Index[2] = iz;
+    yIterator = zIterator;
     for (iy = ext[2]; iy <= ext[3]; ++iy)
     {
-      yIterator->Index[1] = iy;
-      *xIterator = *yIterator;
+      yIterator.Index[1] = iy;
+      xIterator = yIterator;
       for (ix = ext[0]; ix <= ext[1]; ++ix)
       {
-        xIterator->Index[0] = ix;
+        xIterator.Index[0] = ix;
         //
-        if (*(xIterator->FragmentIdPointer) == -1 &&
-          *(xIterator->VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
+        if (*(xIterator.FragmentIdPointer) == -1 &&
+          *(xIterator.VolumeFractionPointer) > this->scaledMaterialFractionThreshold)
         { // We have a new fragment.
-          this->CurrentFragmentMesh = this->NewFragmentMesh();
-          this->EquivalenceSet->AddEquivalence(this->FragmentId, this->FragmentId);
+          ws->CurrentFragmentMesh = this->NewFragmentMesh();
           // We have to mark every voxel we push on the queue.
-          *(xIterator->FragmentIdPointer) = this->FragmentId;
+          *(xIterator.FragmentIdPointer) = ws->FragmentId;
           // There should be no need to clear the queue.
-          queue->Push(xIterator);
-          this->ConnectFragment(queue);
-          // save the current fragment mesh
-          // the id is implicit given by its position in the vector, but only
-          // until fragments are resolved. After resolution we add addributes such
-          // as id, volume, summations averages, etc..
-          this->CurrentFragmentMesh->Squeeze();
-          this->FragmentMeshes.push_back(this->CurrentFragmentMesh);
-          // Save the volume from the last fragment.
-          this->FragmentVolumes->InsertTuple1(this->FragmentId, this->FragmentVolume);
-          if (this->ClipWithPlane)
-          {
-            this->ClipDepthMaximums->InsertTuple1(this->FragmentId, this->ClipDepthMax);
-            this->ClipDepthMinimums->InsertTuple1(this->FragmentId, this->ClipDepthMin);
-          }
-          // clear the volume accumulator
-          this->FragmentVolume = 0.0;
-          this->ClipDepthMax = 0.0;
-          this->ClipDepthMin = VTK_FLOAT_MAX;
-          if (this->ComputeMoments)
-          {
-            // Save the moments from the last fragment
-            this->FragmentMoments->InsertTuple(this->FragmentId, &this->FragmentMoment[0]);
-            // clear the moment accumulator
-            FillVector(this->FragmentMoment, 0.0);
-          }
-          // for the volume weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentVolumeWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentVolumeWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentVolumeWtdAvg[i], 0.0);
-          }
-          // for the mass weighted averaged scalars/vectors...
-          for (int i = 0; i < this->NMassWtdAvgs; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentMassWtdAvgs[i]->InsertTuple(
-              this->FragmentId, &this->FragmentMassWtdAvg[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentMassWtdAvg[i], 0.0);
-          }
-          // for the summed scalars/vectors...
-          for (int i = 0; i < this->NToSum; ++i)
-          {
-            // update the integrated value, independent of ncomps
-            this->FragmentSums[i]->InsertTuple(this->FragmentId, &this->FragmentSum[i][0]);
-            // clear the accumulator
-            FillVector(this->FragmentSum[i], 0.0);
-          }
-          // Move to next fragment.
-          ++this->FragmentId;
+          ws->Queue.Push(&xIterator);
+          this->ConnectFragment(ws);
+          // save the current fragment and move to the next one.
+          ws->SaveFragment();
         }
-        xIterator->FlatIndex += cellIncs[0]; // 1/ncomp
-        xIterator->VolumeFractionPointer += cellIncs[0];
-        xIterator->FragmentIdPointer += cellIncs[0];
+        xIterator.FlatIndex += cellIncs[0]; // 1/ncomp
+        xIterator.VolumeFractionPointer += cellIncs[0];
+        xIterator.FragmentIdPointer += cellIncs[0];
       }
-      yIterator->FlatIndex += cellIncs[1]; // nx
-      yIterator->VolumeFractionPointer += cellIncs[1];
-      yIterator->FragmentIdPointer += cellIncs[1];
+      yIterator.FlatIndex += cellIncs[1]; // nx
+      yIterator.VolumeFractionPointer += cellIncs[1];
+      yIterator.FragmentIdPointer += cellIncs[1];
     }
-    zIterator->FlatIndex += cellIncs[2]; // nx*ny
-    zIterator->VolumeFractionPointer += cellIncs[2];
-    zIterator->FragmentIdPointer += cellIncs[2];
+    zIterator.FlatIndex += cellIncs[2]; // nx*ny
+    zIterator.VolumeFractionPointer += cellIncs[2];
+    zIterator.FragmentIdPointer += cellIncs[2];
   }
 
-  delete queue;
-  delete xIterator;
-  delete yIterator;
-  delete zIterator;
-
   return 1;
 }
 
@@ -4235,7 +4283,8 @@ int vtkMaterialInterfaceFilter::ComputeDisplacementFactors(
 // The return value indicates that an edge may be non manifold.
 // It returns the y or z axis index of the edge that may be non manifold.
 int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
-  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis)
+  vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx, int faceAxis,
+  vtkMaterialInterfaceFilterWorkspace* ws)
 {
   int retVal;
 
@@ -4283,13 +4332,13 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
     projection = (point[0] - this->ClipCenter[0]) * this->ClipPlaneNormal[0];
     projection += (point[1] - this->ClipCenter[1]) * this->ClipPlaneNormal[1];
     projection += (point[2] - this->ClipCenter[2]) * this->ClipPlaneNormal[2];
-    if (this->ClipDepthMax < projection)
+    if (ws->ClipDepthMax < projection)
     {
-      this->ClipDepthMax = projection;
+      ws->ClipDepthMax = projection;
     }
-    if (this->ClipDepthMin > projection)
+    if (ws->ClipDepthMin > projection)
     {
-      this->ClipDepthMin = projection;
+      ws->ClipDepthMin = projection;
     }
   }
 
@@ -4308,7 +4357,8 @@ int vtkMaterialInterfaceFilter::SubVoxelPositionCorner(double* point,
 // I need to have more than 4 points for a face.
 // I am only going to support transitions of 1 level.
 void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterWorkspace* ws)
 {
   if (in->Block == nullptr || in->Block->GetGhostFlag())
   {
@@ -4331,8 +4381,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // Add points to the output.  Create separate points for each triangle.
   // We can worry about merging points later.
   vtkMaterialInterfaceFilterIterator* cornerNeighbors[8];
-  vtkPoints* points = this->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
-  vtkCellArray* polys = this->CurrentFragmentMesh->GetPolys();
+  vtkPoints* points = ws->CurrentFragmentMesh->GetPoints(); // TODO for performance store?
+  vtkCellArray* polys = ws->CurrentFragmentMesh->GetPolys();
   vtkIdType quadCornerIds[4];
   vtkIdType quadMidIds[4];
   vtkIdType triPtIds[3];
@@ -4343,10 +4393,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
   // Compute the corner and edge points (before subpixel positioning).
   // Store the results in ivars.
-  this->ComputeFacePoints(in, out, axis, outMaxFlag);
+  this->ComputeFacePoints(in, out, axis, outMaxFlag, ws);
   // Find the neighbor iterators.
   // Store the results in ivars.
-  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag);
+  this->ComputeFaceNeighbors(in, out, axis, outMaxFlag, ws);
 
   // A word about indexing:
   // face neighbors 2x4x4 indexed face normal axis first, axis1, then axis2.
@@ -4381,55 +4431,55 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   // to perform connectivity on the 2x2x2 point neighbors.
   int inNeighborIdx;
 
-  cornerNeighbors[i0] = &(this->FaceNeighbors[0]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[1]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[2]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[3]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[8]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[9]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[10]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[11]);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[0]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[1]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[2]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[3]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[8]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[9]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[10]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[11]);
   inNeighborIdx = outMaxFlag ? i6 : i7; // Face neighbor 10 or 11
   manifoldIssue[0] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis);
+    this->SubVoxelPositionCorner(ws->FaceCornerPoints, cornerNeighbors, inNeighborIdx, axis, ws);
   // 1 =>
-  quadCornerIds[0] = points->InsertNextPoint(this->FaceCornerPoints);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[4]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[5]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[6]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[7]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[12]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[13]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[14]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[15]);
+  quadCornerIds[0] = points->InsertNextPoint(ws->FaceCornerPoints);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[4]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[5]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[6]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[7]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[12]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[13]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[14]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[15]);
   inNeighborIdx = outMaxFlag ? i4 : i5; // Face neighbor 12 or 13
-  manifoldIssue[1] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[1] = points->InsertNextPoint(this->FaceCornerPoints + 3);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[16]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[17]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[18]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[19]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[24]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[25]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[26]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[27]);
+  manifoldIssue[1] = this->SubVoxelPositionCorner(
+    ws->FaceCornerPoints + 3, cornerNeighbors, inNeighborIdx, axis, ws);
+  quadCornerIds[1] = points->InsertNextPoint(ws->FaceCornerPoints + 3);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[16]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[17]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[18]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[19]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[24]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[25]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[26]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[27]);
   inNeighborIdx = outMaxFlag ? i2 : i3; // Face neighbor 18 or 19
-  manifoldIssue[2] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[2] = points->InsertNextPoint(this->FaceCornerPoints + 6);
-  cornerNeighbors[i0] = &(this->FaceNeighbors[20]);
-  cornerNeighbors[i1] = &(this->FaceNeighbors[21]);
-  cornerNeighbors[i2] = &(this->FaceNeighbors[22]);
-  cornerNeighbors[i3] = &(this->FaceNeighbors[23]);
-  cornerNeighbors[i4] = &(this->FaceNeighbors[28]);
-  cornerNeighbors[i5] = &(this->FaceNeighbors[29]);
-  cornerNeighbors[i6] = &(this->FaceNeighbors[30]);
-  cornerNeighbors[i7] = &(this->FaceNeighbors[31]);
+  manifoldIssue[2] = this->SubVoxelPositionCorner(
+    ws->FaceCornerPoints + 6, cornerNeighbors, inNeighborIdx, axis, ws);
+  quadCornerIds[2] = points->InsertNextPoint(ws->FaceCornerPoints + 6);
+  cornerNeighbors[i0] = &(ws->FaceNeighbors[20]);
+  cornerNeighbors[i1] = &(ws->FaceNeighbors[21]);
+  cornerNeighbors[i2] = &(ws->FaceNeighbors[22]);
+  cornerNeighbors[i3] = &(ws->FaceNeighbors[23]);
+  cornerNeighbors[i4] = &(ws->FaceNeighbors[28]);
+  cornerNeighbors[i5] = &(ws->FaceNeighbors[29]);
+  cornerNeighbors[i6] = &(ws->FaceNeighbors[30]);
+  cornerNeighbors[i7] = &(ws->FaceNeighbors[31]);
   inNeighborIdx = outMaxFlag ? i0 : i1; // Face neighbor 20 or 21
-  manifoldIssue[3] =
-    this->SubVoxelPositionCorner(this->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis);
-  quadCornerIds[3] = points->InsertNextPoint(this->FaceCornerPoints + 9);
+  manifoldIssue[3] = this->SubVoxelPositionCorner(
+    ws->FaceCornerPoints + 9, cornerNeighbors, inNeighborIdx, axis, ws);
+  quadCornerIds[3] = points->InsertNextPoint(ws->FaceCornerPoints + 9);
 
   // If both corners of an edge have an issue, the we need an extra
   // point on the edge to generate a hole.
@@ -4442,93 +4492,93 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
   if (manifoldIssue[0] != 0 && manifoldIssue[1] != 0 && tmp[manifoldIssue[0]] == 1 &&
     tmp[manifoldIssue[1]] == 1)
   {
-    this->FaceEdgeFlags[0] = 1;
+    ws->FaceEdgeFlags[0] = 1;
   }
 
   if (manifoldIssue[0] != 0 && manifoldIssue[2] != 0 && tmp[manifoldIssue[0]] == 2 &&
     tmp[manifoldIssue[2]] == 2)
   {
-    this->FaceEdgeFlags[1] = 1;
+    ws->FaceEdgeFlags[1] = 1;
   }
   if (manifoldIssue[1] != 0 && manifoldIssue[3] != 0 && tmp[manifoldIssue[1]] == 2 &&
     tmp[manifoldIssue[3]] == 2)
   {
-    this->FaceEdgeFlags[2] = 1;
+    ws->FaceEdgeFlags[2] = 1;
   }
   if (manifoldIssue[2] != 0 && manifoldIssue[3] && tmp[manifoldIssue[2]] == 1 &&
     tmp[manifoldIssue[3]] == 1)
   {
-    this->FaceEdgeFlags[3] = 1;
+    ws->FaceEdgeFlags[3] = 1;
   }
 
   // Now for the mid edge point if the neighbors on that side are smaller.
-  if (this->FaceEdgeFlags[0])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[2]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[3]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[4]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[5]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[13]);
+  if (ws->FaceEdgeFlags[0])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[2]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[3]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[4]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[5]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[10]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[11]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[12]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[13]);
     // Two choices here (10, 12) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i4 : i5;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[0] = points->InsertNextPoint(this->FaceEdgePoints);
-  }
-  if (this->FaceEdgeFlags[1])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[8]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[9]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[10]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[11]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[16]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[17]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[19]);
+    this->SubVoxelPositionCorner(ws->FaceEdgePoints, cornerNeighbors, inNeighborIdx, axis, ws);
+    quadMidIds[0] = points->InsertNextPoint(ws->FaceEdgePoints);
+  }
+  if (ws->FaceEdgeFlags[1])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[8]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[9]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[10]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[11]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[16]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[17]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[18]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[19]);
     // Two choices here (10, 18) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i2 : i3;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[1] = points->InsertNextPoint(this->FaceEdgePoints + 3);
-  }
-  if (this->FaceEdgeFlags[2])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[12]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[13]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[14]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[15]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[22]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[23]);
+    this->SubVoxelPositionCorner(ws->FaceEdgePoints + 3, cornerNeighbors, inNeighborIdx, axis, ws);
+    quadMidIds[1] = points->InsertNextPoint(ws->FaceEdgePoints + 3);
+  }
+  if (ws->FaceEdgeFlags[2])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[12]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[13]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[14]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[15]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[20]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[21]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[22]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[23]);
     // Two choices here (12, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[2] = points->InsertNextPoint(this->FaceEdgePoints + 6);
-  }
-  if (this->FaceEdgeFlags[3])
-  {
-    cornerNeighbors[i0] = &(this->FaceNeighbors[18]);
-    cornerNeighbors[i1] = &(this->FaceNeighbors[19]);
-    cornerNeighbors[i2] = &(this->FaceNeighbors[20]);
-    cornerNeighbors[i3] = &(this->FaceNeighbors[21]);
-    cornerNeighbors[i4] = &(this->FaceNeighbors[26]);
-    cornerNeighbors[i5] = &(this->FaceNeighbors[27]);
-    cornerNeighbors[i6] = &(this->FaceNeighbors[28]);
-    cornerNeighbors[i7] = &(this->FaceNeighbors[29]);
+    this->SubVoxelPositionCorner(ws->FaceEdgePoints + 6, cornerNeighbors, inNeighborIdx, axis, ws);
+    quadMidIds[2] = points->InsertNextPoint(ws->FaceEdgePoints + 6);
+  }
+  if (ws->FaceEdgeFlags[3])
+  {
+    cornerNeighbors[i0] = &(ws->FaceNeighbors[18]);
+    cornerNeighbors[i1] = &(ws->FaceNeighbors[19]);
+    cornerNeighbors[i2] = &(ws->FaceNeighbors[20]);
+    cornerNeighbors[i3] = &(ws->FaceNeighbors[21]);
+    cornerNeighbors[i4] = &(ws->FaceNeighbors[26]);
+    cornerNeighbors[i5] = &(ws->FaceNeighbors[27]);
+    cornerNeighbors[i6] = &(ws->FaceNeighbors[28]);
+    cornerNeighbors[i7] = &(ws->FaceNeighbors[29]);
     // Two choices here (18, 20) because they both are the same voxel.
     inNeighborIdx = outMaxFlag ? i0 : i1;
-    this->SubVoxelPositionCorner(this->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis);
-    quadMidIds[3] = points->InsertNextPoint(this->FaceEdgePoints + 9);
+    this->SubVoxelPositionCorner(ws->FaceEdgePoints + 9, cornerNeighbors, inNeighborIdx, axis, ws);
+    quadMidIds[3] = points->InsertNextPoint(ws->FaceEdgePoints + 9);
   }
 
   // Now there are 9 possibilities
   // (10 if you count the two ways to triangulate the simple quad).
   // No edges, $ cases with one mid point, 4 cases with two mid points.
   // That is all because the face is always the smallest of the two in/out voxels.
-  int caseIdx = this->FaceEdgeFlags[0] | (this->FaceEdgeFlags[1] << 1) |
-    (this->FaceEdgeFlags[2] << 2) | (this->FaceEdgeFlags[3] << 3);
+  int caseIdx = ws->FaceEdgeFlags[0] | (ws->FaceEdgeFlags[1] << 1) |
+    (ws->FaceEdgeFlags[2] << 2) | (ws->FaceEdgeFlags[3] << 3);
 
   // c2 e3 c3
   // e1    e2
@@ -4674,10 +4724,10 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
       // This will help us decide which way to split up the quad into triangles.
       double d0011 = 0.0;
       double d0110 = 0.0;
-      double* pt00 = this->FaceCornerPoints;
-      double* pt01 = this->FaceCornerPoints + 3;
-      double* pt10 = this->FaceCornerPoints + 6;
-      double* pt11 = this->FaceCornerPoints + 9;
+      double* pt00 = ws->FaceCornerPoints;
+      double* pt01 = ws->FaceCornerPoints + 3;
+      double* pt10 = ws->FaceCornerPoints + 6;
+      double* pt11 = ws->FaceCornerPoints + 9;
       for (int ii = 0; ii < 3; ++ii)
       {
         double tmp2 = pt00[ii] - pt11[ii];
@@ -4727,7 +4777,7 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 
     // fragment
     vtkDoubleArray* destArray =
-      dynamic_cast<vtkDoubleArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray(i));
+      dynamic_cast<vtkDoubleArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray(i));
     for (vtkIdType ii = 0; ii < numTris; ++ii)
     {
       destArray->InsertNextTuple(&thisTup[0]);
@@ -4736,13 +4786,13 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Cell data attributes for debugging.
 #ifdef vtkMaterialInterfaceFilterDEBUG
   vtkIntArray* levelArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("Level"));
 
   vtkIntArray* blockIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("BlockId"));
 
   vtkIntArray* procIdArray =
-    dynamic_cast<vtkIntArray*>(this->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
+    dynamic_cast<vtkIntArray*>(ws->CurrentFragmentMesh->GetCellData()->GetArray("ProcId"));
 
   for (vtkIdType ii = 0; ii < numTris; ++ii)
   {
@@ -4757,7 +4807,8 @@ void vtkMaterialInterfaceFilter::CreateFace(vtkMaterialInterfaceFilterIterator*
 // Computes the face and edge middle points of the shared contact face
 // between the two iterators.
 void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterWorkspace* ws)
 {
   vtkMaterialInterfaceFilterIterator* smaller;
   double* origin;
@@ -4797,41 +4848,42 @@ void vtkMaterialInterfaceFilter::ComputeFacePoints(vtkMaterialInterfaceFilterIte
   // 6 9
   // 0 3
   // First set them all to the origin.
-  this->FaceCornerPoints[0] = this->FaceCornerPoints[3] = this->FaceCornerPoints[6] =
-    this->FaceCornerPoints[9] = faceOrigin[0];
-  this->FaceCornerPoints[1] = this->FaceCornerPoints[4] = this->FaceCornerPoints[7] =
-    this->FaceCornerPoints[10] = faceOrigin[1];
-  this->FaceCornerPoints[2] = this->FaceCornerPoints[5] = this->FaceCornerPoints[8] =
-    this->FaceCornerPoints[11] = faceOrigin[2];
+  ws->FaceCornerPoints[0] = ws->FaceCornerPoints[3] = ws->FaceCornerPoints[6] =
+    ws->FaceCornerPoints[9] = faceOrigin[0];
+  ws->FaceCornerPoints[1] = ws->FaceCornerPoints[4] = ws->FaceCornerPoints[7] =
+    ws->FaceCornerPoints[10] = faceOrigin[1];
+  ws->FaceCornerPoints[2] = ws->FaceCornerPoints[5] = ws->FaceCornerPoints[8] =
+    ws->FaceCornerPoints[11] = faceOrigin[2];
   // Now offset them to the corners.
-  this->FaceCornerPoints[3 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[9 + axis1] += spacing[axis1];
-  this->FaceCornerPoints[6 + axis2] += spacing[axis2];
-  this->FaceCornerPoints[9 + axis2] += spacing[axis2];
+  ws->FaceCornerPoints[3 + axis1] += spacing[axis1];
+  ws->FaceCornerPoints[9 + axis1] += spacing[axis1];
+  ws->FaceCornerPoints[6 + axis2] += spacing[axis2];
+  ws->FaceCornerPoints[9 + axis2] += spacing[axis2];
 
   // Now do the same for the edge points
   //   3
   // 1   2
   //   0
   // First set them all to the origin.
-  this->FaceEdgePoints[0] = this->FaceEdgePoints[3] = this->FaceEdgePoints[6] =
-    this->FaceEdgePoints[9] = faceOrigin[0];
-  this->FaceEdgePoints[1] = this->FaceEdgePoints[4] = this->FaceEdgePoints[7] =
-    this->FaceEdgePoints[10] = faceOrigin[1];
-  this->FaceEdgePoints[2] = this->FaceEdgePoints[5] = this->FaceEdgePoints[8] =
-    this->FaceEdgePoints[11] = faceOrigin[2];
+  ws->FaceEdgePoints[0] = ws->FaceEdgePoints[3] = ws->FaceEdgePoints[6] =
+    ws->FaceEdgePoints[9] = faceOrigin[0];
+  ws->FaceEdgePoints[1] = ws->FaceEdgePoints[4] = ws->FaceEdgePoints[7] =
+    ws->FaceEdgePoints[10] = faceOrigin[1];
+  ws->FaceEdgePoints[2] = ws->FaceEdgePoints[5] = ws->FaceEdgePoints[8] =
+    ws->FaceEdgePoints[11] = faceOrigin[2];
   // Now offset the points to the middle of the edges.
-  this->FaceEdgePoints[axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
-  this->FaceEdgePoints[6 + axis1] += spacing[axis1];
-  this->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
-  this->FaceEdgePoints[9 + axis2] += spacing[axis2];
+  ws->FaceEdgePoints[axis1] += halfSpacing[axis1];
+  ws->FaceEdgePoints[9 + axis1] += halfSpacing[axis1];
+  ws->FaceEdgePoints[6 + axis1] += spacing[axis1];
+  ws->FaceEdgePoints[3 + axis2] += halfSpacing[axis2];
+  ws->FaceEdgePoints[6 + axis2] += halfSpacing[axis2];
+  ws->FaceEdgePoints[9 + axis2] += spacing[axis2];
 }
 
 //----------------------------------------------------------------------------
 void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag)
+  vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+  vtkMaterialInterfaceFilterWorkspace* ws)
 {
   int axis1 = (axis + 1) % 3;
   int axis2 = (axis + 2) % 3;
@@ -4878,17 +4930,17 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // for subdivision.
   if (outMaxFlag)
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *in;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *out;
+    ws->FaceNeighbors[10] = ws->FaceNeighbors[12] = ws->FaceNeighbors[18] =
+      ws->FaceNeighbors[20] = *in;
+    ws->FaceNeighbors[11] = ws->FaceNeighbors[13] = ws->FaceNeighbors[19] =
+      ws->FaceNeighbors[21] = *out;
   }
   else
   {
-    this->FaceNeighbors[10] = this->FaceNeighbors[12] = this->FaceNeighbors[18] =
-      this->FaceNeighbors[20] = *out;
-    this->FaceNeighbors[11] = this->FaceNeighbors[13] = this->FaceNeighbors[19] =
-      this->FaceNeighbors[21] = *in;
+    ws->FaceNeighbors[10] = ws->FaceNeighbors[12] = ws->FaceNeighbors[18] =
+      ws->FaceNeighbors[20] = *out;
+    ws->FaceNeighbors[11] = ws->FaceNeighbors[13] = ws->FaceNeighbors[19] =
+      ws->FaceNeighbors[21] = *in;
   }
 
   // Ok, we have 24 neighbors to compute.
@@ -4898,91 +4950,91 @@ void vtkMaterialInterfaceFilter::ComputeFaceNeighbors(vtkMaterialInterfaceFilter
   // increments: 1, 2, 8
   // Start at the corner and march around the edges.
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 3, this->FaceNeighbors + 11);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 3, ws->FaceNeighbors + 11);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 5, this->FaceNeighbors + 3);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 5, ws->FaceNeighbors + 3);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 7, this->FaceNeighbors + 5);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 7, ws->FaceNeighbors + 5);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 15, this->FaceNeighbors + 7);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 15, ws->FaceNeighbors + 7);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 23, this->FaceNeighbors + 15);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 23, ws->FaceNeighbors + 15);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 31, this->FaceNeighbors + 23);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 31, ws->FaceNeighbors + 23);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 29, this->FaceNeighbors + 31);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 29, ws->FaceNeighbors + 31);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 27, this->FaceNeighbors + 29);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 27, ws->FaceNeighbors + 29);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 25, this->FaceNeighbors + 27);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 25, ws->FaceNeighbors + 27);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 17, this->FaceNeighbors + 25);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 17, ws->FaceNeighbors + 25);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 9, this->FaceNeighbors + 17);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 9, ws->FaceNeighbors + 17);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 1, this->FaceNeighbors + 9);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 1, ws->FaceNeighbors + 9);
   // Now for the other side (min axis).
   faceIndex[axis] -= 1;  // Move to the other layer
   faceIndex[axis1] += 1; // Start below reference block.
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 2, this->FaceNeighbors + 10);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 2, ws->FaceNeighbors + 10);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 4, this->FaceNeighbors + 2);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 4, ws->FaceNeighbors + 2);
   faceIndex[axis1] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 6, this->FaceNeighbors + 4);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 6, ws->FaceNeighbors + 4);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 14, this->FaceNeighbors + 6);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 14, ws->FaceNeighbors + 6);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 22, this->FaceNeighbors + 14);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 22, ws->FaceNeighbors + 14);
   faceIndex[axis2] += 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 30, this->FaceNeighbors + 22);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 30, ws->FaceNeighbors + 22);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 28, this->FaceNeighbors + 30);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 28, ws->FaceNeighbors + 30);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 26, this->FaceNeighbors + 28);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 26, ws->FaceNeighbors + 28);
   faceIndex[axis1] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 24, this->FaceNeighbors + 26);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 24, ws->FaceNeighbors + 26);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 16, this->FaceNeighbors + 24);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 16, ws->FaceNeighbors + 24);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 8, this->FaceNeighbors + 16);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 8, ws->FaceNeighbors + 16);
   faceIndex[axis2] -= 1;
-  this->FindNeighbor(faceIndex, faceLevel, this->FaceNeighbors + 0, this->FaceNeighbors + 8);
+  this->FindNeighbor(faceIndex, faceLevel, ws->FaceNeighbors + 0, ws->FaceNeighbors + 8);
 
   // Split edges if neighbors are a higher level than face.
   --faceLevel;
-  this->FaceEdgeFlags[0] = 0;
+  ws->FaceEdgeFlags[0] = 0;
   // Checking equivalences (this->FaceNeighbor[2] != this->FaceNeighbor[4])
   // May be faster and work fine.
-  if (this->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[5].Block->GetLevel() > faceLevel)
+  if (ws->FaceNeighbors[2].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[3].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[4].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[5].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[0] = 1;
+    ws->FaceEdgeFlags[0] = 1;
   }
-  this->FaceEdgeFlags[1] = 0;
-  if (this->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[17].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[1] = 0;
+  if (ws->FaceNeighbors[8].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[9].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[16].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[17].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[1] = 1;
+    ws->FaceEdgeFlags[1] = 1;
   }
-  this->FaceEdgeFlags[2] = 0;
-  if (this->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[23].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[2] = 0;
+  if (ws->FaceNeighbors[14].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[15].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[22].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[23].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[2] = 1;
+    ws->FaceEdgeFlags[2] = 1;
   }
-  this->FaceEdgeFlags[3] = 0;
-  if (this->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
-    this->FaceNeighbors[29].Block->GetLevel() > faceLevel)
+  ws->FaceEdgeFlags[3] = 0;
+  if (ws->FaceNeighbors[26].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[27].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[28].Block->GetLevel() > faceLevel ||
+    ws->FaceNeighbors[29].Block->GetLevel() > faceLevel)
   {
-    this->FaceEdgeFlags[3] = 1;
+    ws->FaceEdgeFlags[3] = 1;
   }
 }
 
@@ -5458,18 +5510,82 @@ inline int vtkMaterialInterfaceFilter::AccumulateMoments(double* moments, // =(M
 }
 
 //----------------------------------------------------------------------------
-// Depth first search marking voxels.
+// Calls visitor(next, axis, maxFlag) for each voxel sharing a face with the
+// iterator. When the neighbor is a higher level, we need to loop over all the
+// faces of the higher level that touch this face.
+// We will restrict our case to 4 neighbors (max difference in levels is 1).
+// If level skip, things should still work OK. Biggest issue is holes in surface.
+// This also sort of assumes that at most one other block touches this face.
+// Holes might appear if this is not true.
+template <typename Visitor>
+void vtkMaterialInterfaceFilter::VisitFaceNeighbors(
+  vtkMaterialInterfaceFilterIterator* iterator, Visitor&& visitor)
+{
+  // Create another iterator on the stack for recursion.
+  vtkMaterialInterfaceFilterIterator next;
+  for (int ii = 0; ii < 3; ++ii)
+  {
+    // "Left"/min then "Right"/max
+    for (int maxFlag = 0; maxFlag < 2; ++maxFlag)
+    {
+      this->GetNeighborIterator(&next, iterator, ii, maxFlag, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
+      visitor(&next, ii, maxFlag);
+
+      if (next.Block && next.Block->GetLevel() > iterator->Block->GetLevel())
+      {
+        vtkMaterialInterfaceFilterIterator next2;
+        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
+        // Take the first neighbor found and move +Y
+        if (ii != 1 || threeDimFlag)
+        { // stupid after the fact way of dealing with 2d AMR input.
+          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+          visitor(&next2, ii, maxFlag);
+        }
+        // Take the fist iterator found and move +Z
+        if (ii != 0 || threeDimFlag)
+        { // stupid after the fact way of dealing with 2d AMR input.
+          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
+          visitor(&next2, ii, maxFlag);
+        }
+        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
+        if (next2.Block && threeDimFlag)
+        {
+          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
+          visitor(&next, ii, maxFlag);
+        }
+      }
+    }
+  }
+}
+
+//----------------------------------------------------------------------------
+// Breadth first search marking the voxels of a block.
 // This extracts faces at the same time.
 // This integrates quantities at the same time.
 // This is called only when the voxel is part of a fragment.
-// I tried to create a generic API to replace the hard coded conditional ifs.
-void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* queue)
+void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterWorkspace* ws)
 {
-  while (queue->GetSize())
+  vtkMaterialInterfaceFilterIterator iterator;
+  // Neighbor is outside of fragment: make a face. We have not visited a
+  // neighbor of this block yet: mark the voxel and recurse. Neighbors in
+  // other blocks are connected afterwards by ConnectBlockBoundaries.
+  auto visitor = [&](vtkMaterialInterfaceFilterIterator* next, int axis, int maxFlag) {
+    if (next->VolumeFractionPointer == nullptr ||
+      next->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+    {
+      this->CreateFace(&iterator, next, axis, maxFlag, ws);
+    }
+    else if (next->Block == iterator.Block && next->FragmentIdPointer[0] == -1)
+    {
+      *(next->FragmentIdPointer) = ws->FragmentId;
+      ws->Queue.Push(next);
+    }
+  };
+
+  while (ws->Queue.GetSize())
   {
     // Get the next voxel/iterator to search.
-    vtkMaterialInterfaceFilterIterator iterator;
-    queue->Pop(&iterator);
+    ws->Queue.Pop(&iterator);
     // Lets integrate when we remove the iterator from the queue.
     // We could also do it when we add the iterator to the queue, but
     // the adds occur in so many places.
@@ -5483,14 +5599,14 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       double voxelVolumeFrac =
         dX[0] * dX[1] * dX[2] * (double)(*(iterator.VolumeFractionPointer)) / 255.0;
 #endif
-      this->FragmentVolume += voxelVolumeFrac;
+      ws->FragmentVolume += voxelVolumeFrac;
       // The clip depth is accumulated in SubvoxelPositionCorner.
       // accumulate volume weighted average
       for (int i = 0; i < this->NVolumeWtdAvgs; ++i)
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetVolumeWtdAvgArray(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(&this->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
+        this->Accumulate(&ws->FragmentVolumeWtdAvg[i][0], arrayToIntegrate, nComps,
           iterator.FlatIndex, voxelVolumeFrac);
       }
       // accumulate mass weighted average
@@ -5502,7 +5618,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         const double* X0 = iterator.Block->GetOrigin();
         double X[3] = { X0[0] + dX[0] * (0.5 + iterator.Index[0]),
           X0[1] + dX[1] * (0.5 + iterator.Index[1]), X0[2] + dX[2] * (0.5 + iterator.Index[2]) };
-        this->AccumulateMoments(&this->FragmentMoment[0], massArray, iterator.FlatIndex, X);
+        this->AccumulateMoments(&ws->FragmentMoment[0], massArray, iterator.FlatIndex, X);
         // mass weighted averages
         double voxelMass;
         massArray->GetTuple(iterator.FlatIndex, &voxelMass);
@@ -5510,7 +5626,7 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
         {
           vtkDataArray* arrayToIntegrate = iterator.Block->GetMassWtdAvgArray(i);
           int nComps = arrayToIntegrate->GetNumberOfComponents();
-          this->Accumulate(&this->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
+          this->Accumulate(&ws->FragmentMassWtdAvg[i][0], arrayToIntegrate, nComps,
             iterator.FlatIndex, voxelMass);
         }
       }
@@ -5519,210 +5635,105 @@ void vtkMaterialInterfaceFilter::ConnectFragment(vtkMaterialInterfaceFilterRingB
       {
         vtkDataArray* arrayToIntegrate = iterator.Block->GetArrayToSum(i);
         int nComps = arrayToIntegrate->GetNumberOfComponents();
-        this->Accumulate(
-          &this->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
+        this->Accumulate(&ws->FragmentSum[i][0], arrayToIntegrate, nComps, iterator.FlatIndex, 1.0);
       }
     }
+    this->VisitFaceNeighbors(&iterator, visitor);
+  }
+}
 
-    // Create another iterator on the stack for recursion.
-    vtkMaterialInterfaceFilterIterator next;
-
-    // Look at the face connected neighbors and recurse.
-    // We are not on the border and volume fraction of neighbor is high and
-    // we have not visited the voxel yet.
-    for (int ii = 0; ii < 3; ++ii)
+//----------------------------------------------------------------------------
+// Fragments are built one block at a time, so a fragment spanning several
+// blocks is made of several pieces. Pieces touching across a block boundary
+// are equated, and ghost voxels reached from a piece are labelled with its id
+// and searched in turn, as a search over all blocks would have done.
+void vtkMaterialInterfaceFilter::ConnectBlockBoundaries()
+{
+  vtkVLogScopeF(PARAVIEW_LOG_EXECUTION_VERBOSITY(), "connect-blocks");
+
+  vtkMaterialInterfaceFilterRingBuffer queue;
+  vtkMaterialInterfaceFilterIterator* iterator = nullptr;
+  // Voxels of the same local block have already been connected, and all
+  // voxels of local blocks in a fragment are labelled: only ghost voxels
+  // remain to be labelled.
+  auto visitor = [&](vtkMaterialInterfaceFilterIterator* next, int vtkNotUsed(axis),
+    int vtkNotUsed(maxFlag)) {
+    if (next->VolumeFractionPointer == nullptr ||
+      next->VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold ||
+      (next->Block == iterator->Block && !iterator->Block->GetGhostFlag()))
     {
-      // I would make these variables to make the computation more clear,
-      // but they would accumulate on the stack.
-      // axis0 = ii;
-      // axis1 = (ii+1)%3;
-      // axis2 = (ii+2)%3;
-      // idxMin = 2*ii;
-      // idxMax = 2*ii+1this->IndexMax+1;
-      // "Left"/min
-      this->GetNeighborIterator(&next, &iterator, ii, 0, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      {
-        // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 0);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-
-      // Handle the case when the new iterator is a higher level.
-      // We need to loop over all the faces of the higher level that touch this face.
-      // We will restrict our case to 4 neighbors (max difference in levels is 1).
-      // If level skip, things should still work OK. Biggest issue is holes in surface.
-      // This also sort of assumes that at most one other block touches this face.
-      // Holes might appear if this is not true.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
-      {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 0);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
-        {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 0);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-      }
+      return;
+    }
+    if (next->FragmentIdPointer[0] != -1)
+    {
+      this->AddEquivalence(iterator, next);
+    }
+    else if (next->Block->GetGhostFlag())
+    {
+      *(next->FragmentIdPointer) = *(iterator->FragmentIdPointer);
+      queue.Push(next);
+    }
+  };
 
-      // "Right"/max
-      this->GetNeighborIterator(&next, &iterator, ii, 1, (ii + 1) % 3, 0, (ii + 2) % 3, 0);
-      if (next.VolumeFractionPointer == nullptr ||
-        next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-      { // Neighbor is outside of fragment.  Make a face.
-        this->CreateFace(&iterator, &next, ii, 1);
-      }
-      else if (next.FragmentIdPointer[0] == -1)
-      { // We have not visited this neighbor yet. Mark the voxel and recurse.
-        *(next.FragmentIdPointer) = this->FragmentId;
-        queue->Push(&next);
-      }
-      else
-      { // The last case is that we have already visited this voxel and it
-        // is in the same fragment.
-        this->AddEquivalence(&iterator, &next);
-      }
-      // Same case as above with the same logic to visit the
-      // four smaller cells that touch this face of the current block.
-      if (next.Block && next.Block->GetLevel() > iterator.Block->GetLevel())
+  vtkMaterialInterfaceFilterIterator xIterator;
+  vtkMaterialInterfaceFilterIterator yIterator;
+  vtkMaterialInterfaceFilterIterator zIterator;
+  iterator = &xIterator;
+  for (int blockId = 0; blockId < this->NumberOfInputBlocks; ++blockId)
+  {
+    vtkMaterialInterfaceFilterBlock* block = this->InputBlocks[blockId];
+    if (block == nullptr)
+    {
+      continue;
+    }
+    zIterator.Block = block;
+    zIterator.VolumeFractionPointer = block->GetBaseVolumeFractionPointer();
+    zIterator.FragmentIdPointer = block->GetBaseFragmentIdPointer();
+    zIterator.FlatIndex = block->GetBaseFlatIndex();
+    int cellIncs[3];
+    block->GetCellIncrements(cellIncs);
+    const int* ext = block->GetBaseCellExtent();
+    const bool threeDimFlag = ext[4] < ext[5];
+    // Only visit the voxels on the boundary of the block.
+    for (int iz = ext[4]; iz <= ext[5]; ++iz)
+    {
+      zIterator.Index[2] = iz;
+      yIterator = zIterator;
+      for (int iy = ext[2]; iy <= ext[3]; ++iy)
       {
-        vtkMaterialInterfaceFilterIterator next2;
-        bool threeDimFlag = next.Block->GetBaseCellExtent()[4] < next.Block->GetBaseCellExtent()[5];
-        // Take the first neighbor found and move +Y
-        if (ii != 1 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // Take the fist iterator found and move +Z
-        if (ii != 0 || threeDimFlag)
-        { // stupid after the fact way of dealing with 2d AMR input.
-          this->GetNeighborIterator(&next2, &next, (ii + 2) % 3, 1, ii, 0, (ii + 1) % 3, 0);
-          if (next2.VolumeFractionPointer == nullptr ||
-            next2.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
-          {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next2, ii, 1);
-          }
-          else if (next2.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next2.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next2);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
-          }
-        }
-        // To get the +Y+Z start with the +Z iterator and move +Y put results in "next"
-        if (next2.Block && threeDimFlag)
+        yIterator.Index[1] = iy;
+        xIterator = yIterator;
+        const bool boundaryRow =
+          iy == ext[2] || iy == ext[3] || (threeDimFlag && (iz == ext[4] || iz == ext[5]));
+        const int step = boundaryRow ? 1 : std::max(ext[1] - ext[0], 1);
+        for (int ix = ext[0]; ix <= ext[1]; ix += step)
         {
-          this->GetNeighborIterator(&next, &next2, (ii + 1) % 3, 1, (ii + 2) % 3, 0, ii, 0);
-          if (next.VolumeFractionPointer == nullptr ||
-            next.VolumeFractionPointer[0] < this->scaledMaterialFractionThreshold)
+          xIterator.Index[0] = ix;
+          if (*(xIterator.FragmentIdPointer) != -1)
           {
-            // Neighbor is outside of fragment.  Make a face.
-            this->CreateFace(&iterator, &next, ii, 1);
-          }
-          else if (next.FragmentIdPointer[0] == -1)
-          { // We have not visited this neighbor yet. Mark the voxel and recurse.
-            *(next.FragmentIdPointer) = this->FragmentId;
-            queue->Push(&next);
-          }
-          else
-          { // The last case is that we have already visited this voxel and it
-            // is in the same fragment.
-            this->AddEquivalence(&next2, &next);
+            this->VisitFaceNeighbors(&xIterator, visitor);
           }
+          xIterator.FlatIndex += step * cellIncs[0];
+          xIterator.VolumeFractionPointer += step * cellIncs[0];
+          xIterator.FragmentIdPointer += step * cellIncs[0];
         }
+        yIterator.FlatIndex += cellIncs[1];
+        yIterator.VolumeFractionPointer += cellIncs[1];
+        yIterator.FragmentIdPointer += cellIncs[1];
       }
+      zIterator.FlatIndex += cellIncs[2];
+      zIterator.VolumeFractionPointer += cellIncs[2];
+      zIterator.FragmentIdPointer += cellIncs[2];
     }
   }
+
+  // Search the ghost voxels reached from the local blocks.
+  vtkMaterialInterfaceFilterIterator ghostIterator;
+  iterator = &ghostIterator;
+  while (queue.Pop(&ghostIterator))
+  {
+    this->VisitFaceNeighbors(&ghostIterator, visitor);
+  }
 }
 
 //----------------------------------------------------------------------------
@@ -7885,10 +7896,12 @@ int vtkMaterialInterfaceFilter::PrepareToResolveIntegratedAttributes()
       this->ClipDepthMaximums->GetName());
     pResolved = this->ClipDepthMaximums->GetPointer(0);
     memset(pResolved, 0, bytesPerComponent);
+    // same initial value as the per piece accumulator, so that a fragment
+    // without any face keeps it.
     NewVtkArrayPointer(this->ClipDepthMinimums, nComps, this->NumberOfResolvedFragments,
       this->ClipDepthMinimums->GetName());
     pResolved = this->ClipDepthMinimums->GetPointer(0);
-    memset(pResolved, 0, bytesPerComponent);
+    std::fill(pResolved, pResolved + this->NumberOfResolvedFragments, VTK_FLOAT_MAX);
   }
 
   // moments
@@ -7984,27 +7997,31 @@ int vtkMaterialInterfaceFilter::ResolveIntegratedAttributes(const int controllin
         ++pUnresolved;
         ++eqSetId;
       }
-      // clip depth
+      // clip depth, the extent of the pieces is merged. Pieces without any
+      // face still hold the initial values of the accumulator and are skipped.
       if (this->ClipWithPlane)
       {
-        pUnresolved = clipDepthMaxs[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMaximums->GetPointer(0);
+        const double* pUnresolvedMax = clipDepthMaxs[procId]->GetPointer(0);
+        const double* pUnresolvedMin = clipDepthMins[procId]->GetPointer(0);
+        double* pResolvedMax = this->ClipDepthMaximums->GetPointer(0);
+        double* pResolvedMin = this->ClipDepthMinimums->GetPointer(0);
         eqSetId = procBaseEqSetId;
         for (int i = 0; i < nUnresolved; ++i)
         {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
-          ++eqSetId;
-        }
-        pUnresolved = clipDepthMins[procId]->GetPointer(0);
-        pResolved = this->ClipDepthMinimums->GetPointer(0);
-        eqSetId = procBaseEqSetId;
-        for (int i = 0; i < nUnresolved; ++i)
-        {
-          int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
-          pResolved[resIdx] += pUnresolved[0];
-          ++pUnresolved;
+          if (pUnresolvedMin[i] != VTK_FLOAT_MAX)
+          {
+            int resIdx = this->EquivalenceSet->GetEquivalentSetId(eqSetId);
+            if (pResolvedMin[resIdx] == VTK_FLOAT_MAX)
+            {
+              pResolvedMax[resIdx] = pUnresolvedMax[i];
+              pResolvedMin[resIdx] = pUnresolvedMin[i];
+            }
+            else
+            {
+              pResolvedMax[resIdx] = std::max(pResolvedMax[resIdx], pUnresolvedMax[i]);
+              pResolvedMin[resIdx] = std::min(pResolvedMin[resIdx], pUnresolvedMin[i]);
+            }
+          }
           ++eqSetId;
         }
       }
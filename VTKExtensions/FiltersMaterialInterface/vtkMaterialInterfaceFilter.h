@@ -26,10 +26,9 @@
  * #define vtkMaterialInterfaceFilterDEBUG
  * \endcode
  *
- * This will turn on profiling of how long each part of the filter takes
- * \code{.cpp}
- * #define vtkMaterialInterfaceFilterPROFILE
- * \endcode
+ * Fragments are built concurrently for the blocks of a process, using
+ * vtkSMPTools. The time taken by each part of the filter is reported by the
+ * ParaView logger, at PARAVIEW_LOG_EXECUTION_VERBOSITY.
  */
 
 #ifndef vtkMaterialInterfaceFilter_h
@@ -40,9 +39,6 @@
 #include <string>                                             // needed for string
 #include <vector>                                             // needed for vector
 
-#include "vtkSmartPointer.h" // needed for smart pointer
-#include "vtkTimerLog.h"     // needed for vtkTimerLog.
-
 class vtkDataSet;
 class vtkImageData;
 class vtkPolyData;
@@ -63,6 +59,7 @@ class vtkMaterialInterfaceFilterBlock;
 class vtkMaterialInterfaceFilterIterator;
 class vtkMaterialInterfaceEquivalenceSet;
 class vtkMaterialInterfaceFilterRingBuffer;
+class vtkMaterialInterfaceFilterWorkspace;
 class vtkMaterialInterfacePieceLoading;
 class vtkMaterialInterfaceCommBuffer;
 
@@ -348,11 +345,18 @@ protected:
     std::vector<std::string>& integratedArrayNames);
   // Create a new fragment/piece.
   vtkPolyData* NewFragmentMesh();
-  // Process each cell, looking for fragments.
-  int ProcessBlock(int blockId);
+  // Build the fragments of all local blocks, numbered over the process.
+  void BuildFragments();
+  // Process each cell of a block, looking for fragments.
+  int ProcessBlock(int blockId, vtkMaterialInterfaceFilterWorkspace* ws);
   // Cell has been identified as inside the fragment. Integrate, and
   // generate fragment surface etc...
-  void ConnectFragment(vtkMaterialInterfaceFilterRingBuffer* iterator);
+  void ConnectFragment(vtkMaterialInterfaceFilterWorkspace* ws);
+  // Equate the fragments touching across block boundaries, and label the
+  // ghost voxels connected to them.
+  void ConnectBlockBoundaries();
+  template <typename Visitor>
+  void VisitFaceNeighbors(vtkMaterialInterfaceFilterIterator* iterator, Visitor&& visitor);
   void GetNeighborIterator(vtkMaterialInterfaceFilterIterator* next,
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
@@ -360,12 +364,12 @@ protected:
     vtkMaterialInterfaceFilterIterator* iterator, int axis0, int maxFlag0, int axis1, int maxFlag1,
     int axis2, int maxFlag2);
   void CreateFace(vtkMaterialInterfaceFilterIterator* in, vtkMaterialInterfaceFilterIterator* out,
-    int axis, int outMaxFlag);
+    int axis, int outMaxFlag, vtkMaterialInterfaceFilterWorkspace* ws);
   int ComputeDisplacementFactors(vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8],
     double displacmentFactors[3], int rootNeighborIdx, int faceAxis);
   int SubVoxelPositionCorner(double* point,
     vtkMaterialInterfaceFilterIterator* pointNeighborIterators[8], int rootNeighborIdx,
-    int faceAxis);
+    int faceAxis, vtkMaterialInterfaceFilterWorkspace* ws);
   void FindPointNeighbors(vtkMaterialInterfaceFilterIterator* iteratorMin0,
     vtkMaterialInterfaceFilterIterator* iteratorMax0, int axis0, int maxFlag1, int maxFlag2,
     vtkMaterialInterfaceFilterIterator pointNeighborIterators[8], double pt[3]);
@@ -525,10 +529,6 @@ protected:
   char* MaterialFractionArrayName;
   vtkSetStringMacro(MaterialFractionArrayName);
 
-  // while processing a material array this holds
-  // a pointer to the output poly data
-  // data set
-  vtkPolyData* CurrentFragmentMesh;
   // As pieces/fragments are found they are stored here
   // until resolution.
   std::vector<vtkPolyData*> FragmentMeshes;
@@ -538,23 +538,17 @@ protected:
   // all of the supported operations.
   /// class vtkMaterialInterfaceFilterIntegrator
   ///{
-  // Local id of current fragment
+  // Number of fragments found in this process
   int FragmentId;
-  // Accumulator for the volume of the current fragment.
-  double FragmentVolume;
   // Fragment volumes indexed by the fragment id. It's a local
   // per-process indexing until fragments have been resolved
   vtkDoubleArray* FragmentVolumes;
 
   // Min and max depth of crater.
   // These are only computed when the clip plane is on.
-  double ClipDepthMin;
-  double ClipDepthMax;
   vtkDoubleArray* ClipDepthMinimums;
   vtkDoubleArray* ClipDepthMaximums;
 
-  // Accumulator for moments of the current fragment
-  std::vector<double> FragmentMoment; // =(Myz, Mxz, Mxy, m)
   // Moments indexed by fragment id
   vtkDoubleArray* FragmentMoments;
   // Centers of fragment AABBs, only computed if moments are not
@@ -563,8 +557,6 @@ protected:
   bool ComputeMoments;
 
   // Weighted average, where weights correspond to fragment volume.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentVolumeWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentVolumeWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -573,8 +565,6 @@ protected:
   std::vector<std::string> VolumeWtdAvgArrayNames;
 
   // Weighted average, where weights correspond to fragment mass.
-  // Accumulators one for each array to average, scalar or vector
-  std::vector<std::vector<double>> FragmentMassWtdAvg;
   // weighted averages indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentMassWtdAvgs;
   // number of arrays for which to compute the weighted average
@@ -591,8 +581,6 @@ protected:
   int NToIntegrate;
 
   // Sum of data over the fragment.
-  // Accumulators, one for each array to sum
-  std::vector<std::vector<double>> FragmentSum;
   // sums indexed by fragment id.
   std::vector<vtkDoubleArray*> FragmentSums;
   // number of arrays for which to compute the weighted average
@@ -656,20 +644,18 @@ protected:
   // It could be changed into the primary storage of blocks.
   std::vector<vtkMaterialInterfaceLevel*> Levels;
 
-  // Ivars for computing the point on corners and edges of a face.
-  vtkMaterialInterfaceFilterIterator* FaceNeighbors;
   // Permutation of the neighbors. Axis0 normal to face.
   int faceAxis0;
   int faceAxis1;
   int faceAxis2;
-  double FaceCornerPoints[12];
-  double FaceEdgePoints[12];
-  int FaceEdgeFlags[4];
+  // Compute the point on corners and edges of a face, stored in the workspace.
   // outMaxFlag implies out is positive direction of axis.
   void ComputeFacePoints(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+    vtkMaterialInterfaceFilterWorkspace* ws);
   void ComputeFaceNeighbors(vtkMaterialInterfaceFilterIterator* in,
-    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag);
+    vtkMaterialInterfaceFilterIterator* out, int axis, int outMaxFlag,
+    vtkMaterialInterfaceFilterWorkspace* ws);
 
   long ComputeProximity(const int faceIdx[3], int faceLevel, const int ext[6], int refLevel);
 
@@ -713,16 +699,6 @@ protected:
   // By default set to 1
   unsigned char BlockGhostLevel;
 
-#ifdef vtkMaterialInterfaceFilterPROFILE
-  // Lets profile to see what takes the most time for large number of processes.
-  vtkSmartPointer<vtkTimerLog> InitializeBlocksTimer;
-  vtkSmartPointer<vtkTimerLog> ShareGhostBlocksTimer;
-  long NumberOfBlocks;
-  long NumberOfGhostBlocks;
-  vtkSmartPointer<vtkTimerLog> ProcessBlocksTimer;
-  vtkSmartPointer<vtkTimerLog> ResolveEquivalencesTimer;
-#endif
-
 private:
   vtkMaterialInterfaceFilter(const vtkMaterialInterfaceFilter&) = delete;
   void operator=(const vtkMaterialInterfaceFilter&) = delete;
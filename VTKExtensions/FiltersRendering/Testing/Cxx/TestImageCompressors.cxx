@@ -13,6 +13,7 @@
 
 =========================================================================*/
 
+#include "vtkDeltaImageCompressor.h"
 #include "vtkImageCompressor.h"
 #include "vtkImageData.h"
 #include "vtkLZ4Compressor.h"
@@ -26,6 +27,7 @@
 #include "vtkUnsignedCharArray.h"
 #include "vtkZlibImageCompressor.h"
 
+#include <cstring>
 #include <map>
 #include <string>
 #include <vtksys/CommandLineArguments.hxx>
@@ -48,7 +50,8 @@ public:
 };
 typedef std::map<std::string, Data> MapType;
 
-bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input)
+bool DoTest(
+  Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* input, bool lossless = false)
 {
   vtkNew<vtkUnsignedCharArray> outputCompressed;
   vtkNew<vtkUnsignedCharArray> outputDeCompressed;
@@ -78,6 +81,95 @@ bool DoTest(Data& data, vtkImageCompressor* compressor, vtkUnsignedCharArray* in
   data.DecompressTime += timer->GetElapsedTime();
   data.CompressedSize =
     outputCompressed->GetNumberOfTuples() * outputCompressed->GetNumberOfComponents();
+
+  if (lossless &&
+    memcmp(input->GetPointer(0), outputDeCompressed->GetPointer(0),
+      input->GetNumberOfTuples() * input->GetNumberOfComponents()) != 0)
+  {
+    cerr << "Lossless round trip failed for " << compressor->GetClassName() << endl;
+    return false;
+  }
+  return true;
+}
+
+// Builds a synthetic image large enough to be split into several tiles by the
+// compressors, with both uniform runs and noisy regions. Opacity is kept to
+// the 4 bits SQUIRT preserves.
+vtkSmartPointer<vtkUnsignedCharArray> MakeImage(int width, int height, int numComponents)
+{
+  vtkNew<vtkUnsignedCharArray> image;
+  image->SetNumberOfComponents(numComponents);
+  image->SetNumberOfTuples(width * height);
+  unsigned char* ptr = image->GetPointer(0);
+  unsigned int seed = 1;
+  for (int y = 0; y < height; ++y)
+  {
+    for (int x = 0; x < width; ++x)
+    {
+      seed = seed * 1103515245 + 12345;
+      for (int c = 0; c < numComponents; ++c)
+      {
+        unsigned char value = static_cast<unsigned char>(
+          x < width / 2 ? (y / 16 + c * 64) : ((seed >> (8 * c)) & 0xff));
+        *ptr++ = c == 3 ? (value & 0xf0) : value;
+      }
+    }
+  }
+  return image.Get();
+}
+
+// Compresses a sequence of slowly changing frames with one compressor and
+// decompresses them in order with another, as done between server and client.
+bool TestDeltaFrames()
+{
+  vtkNew<vtkDeltaImageCompressor> encoder;
+  vtkNew<vtkDeltaImageCompressor> decoder;
+  encoder->SetQuality(0);
+  encoder->SetKeyFrameInterval(4);
+  vtkSmartPointer<vtkUnsignedCharArray> frame = MakeImage(640, 480, 4);
+  vtkNew<vtkUnsignedCharArray> decompressed;
+  decompressed->SetNumberOfComponents(4);
+  decompressed->SetNumberOfTuples(frame->GetNumberOfTuples());
+  const vtkIdType size = frame->GetNumberOfTuples() * 4;
+  for (int cc = 0; cc < 10; ++cc)
+  {
+    // Change a band of the image between frames.
+    memset(frame->GetPointer(4 * 640 * 10 * cc), 0x10 * cc, 4 * 640 * 10);
+
+    encoder->SetInput(frame);
+    if (!encoder->Compress())
+    {
+      return false;
+    }
+    decoder->SetInput(encoder->GetOutput());
+    decoder->SetOutput(decompressed);
+    if (!decoder->Decompress() ||
+      memcmp(frame->GetPointer(0), decompressed->GetPointer(0), size) != 0)
+    {
+      cerr << "Delta frame " << cc << " round trip failed." << endl;
+      return false;
+    }
+  }
+  if (encoder->GetNumberOfKeyFrames() != 3 || decoder->GetNumberOfKeyFrames() != 3 ||
+    decoder->GetNumberOfDeltaFrames() != 7)
+  {
+    cerr << "Unexpected number of key frames: " << encoder->GetNumberOfKeyFrames() << endl;
+    return false;
+  }
+
+  // A delta frame that does not follow the decoder's previous frame is rejected.
+  encoder->SetInput(frame);
+  encoder->Compress();
+  encoder->Compress();
+  decoder->SetInput(encoder->GetOutput());
+  vtkObject::GlobalWarningDisplayOff();
+  const int status = decoder->Decompress();
+  vtkObject::GlobalWarningDisplayOn();
+  if (status)
+  {
+    cerr << "Out of sequence delta frame was not rejected." << endl;
+    return false;
+  }
   return true;
 }
 
@@ -120,12 +212,33 @@ int TestImageCompressors(int argc, char* argv[])
     vtkUnsignedCharArray::SafeDownCast(image->GetPointData()->GetScalars());
   vtkIdType uncompressedSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
 
+  // Lossless round trips of multi-tile images, both RGBA and RGB.
+  for (int numComponents = 3; numComponents <= 4; ++numComponents)
+  {
+    vtkSmartPointer<vtkUnsignedCharArray> synthetic = MakeImage(1920, 1080, numComponents);
+    Data unused;
+    vtkNew<vtkLZ4Compressor> lz4;
+    lz4->SetQuality(0);
+    vtkNew<vtkSquirtCompressor> squirt;
+    squirt->SetSquirtLevel(0);
+    if (!DoTest(unused, lz4.Get(), synthetic, true) ||
+      !DoTest(unused, squirt.Get(), synthetic, true))
+    {
+      return TEST_FAILED;
+    }
+  }
+
+  if (!TestDeltaFrames())
+  {
+    return TEST_FAILED;
+  }
+
   MapType datas;
   for (int cc = 0; cc < max_count; cc++)
   {
     vtkNew<vtkLZ4Compressor> lz4;
     lz4->SetQuality(0);
-    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input))
+    if (!DoTest(datas["LZ4 (quality: 0)"], lz4.Get(), input, true))
     {
       return TEST_FAILED;
     }
@@ -168,6 +281,13 @@ int TestImageCompressors(int argc, char* argv[])
       }
     }
 
+    vtkNew<vtkDeltaImageCompressor> delta;
+    delta->SetQuality(0);
+    if (!DoTest(datas["DELTA (quality: 0)"], delta.Get(), input, true))
+    {
+      return TEST_FAILED;
+    }
+
     vtkNew<vtkZlibImageCompressor> zlib;
     zlib->SetCompressionLevel(1);
     if (!DoTest(datas["ZLIB (compression-level: 1, color-space: 0)"], zlib.Get(), input))
@@ -198,11 +318,15 @@ int TestImageCompressors(int argc, char* argv[])
   cout << "Input: " << image->GetDimensions()[0] << "x" << image->GetDimensions()[1] << "x"
        << image->GetDimensions()[2] << " (uncompressed size: " << uncompressedSize << ") " << endl;
 
+  const double megabytes = uncompressedSize / (1024.0 * 1024.0);
   for (MapType::iterator iter = datas.begin(); iter != datas.end(); ++iter)
   {
+    const double compressTime = iter->second.CompressTime / max_count;
+    const double decompressTime = iter->second.DecompressTime / max_count;
     cout << iter->first.c_str() << " :"
-         << " compress: " << (iter->second.CompressTime / max_count)
-         << " decompress: " << (iter->second.DecompressTime / max_count) << " compression ratio: "
+         << " compress: " << compressTime << " (" << megabytes / compressTime << " MB/s)"
+         << " decompress: " << decompressTime << " (" << megabytes / decompressTime << " MB/s)"
+         << " compression ratio: "
          << ((uncompressedSize - iter->second.CompressedSize) * 100.0 / uncompressedSize)
          << "( compressed size: " << iter->second.CompressedSize << ")" << endl;
   }
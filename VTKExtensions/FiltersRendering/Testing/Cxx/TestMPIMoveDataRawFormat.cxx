@@ -0,0 +1,538 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestMPIMoveDataRawFormat.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellArray.h"
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkFloatArray.h"
+#include "vtkIdTypeArray.h"
+#include "vtkImageData.h"
+#include "vtkInformation.h"
+#include "vtkIntArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIMoveData.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkObjectFactory.h"
+#include "vtkPartitionedDataSet.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSOADataArrayTemplate.h"
+#include "vtkSmartPointer.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
+#include "vtkVariant.h"
+
+#include <cstring>
+#include <string>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Exposes the marshalling of vtkMPIMoveData, which is otherwise only run
+// between the processes moving the data.
+class vtkTestMoveData : public vtkMPIMoveData
+{
+public:
+  static vtkTestMoveData* New();
+  vtkTypeMacro(vtkTestMoveData, vtkMPIMoveData);
+
+  // Marshals `input`, checks that the buffer starts with `magic` and
+  // reconstructs it in `output`. When not null, `numberOfChunks` is set to the
+  // number of LZ4 chunks of the buffer.
+  bool RoundTrip(vtkDataObject* input, vtkDataObject* output, const char* magic,
+    unsigned int* numberOfChunks = nullptr)
+  {
+    this->MarshalDataToBuffer(input);
+    const size_t length = strlen(magic);
+    bool status = this->NumberOfBuffers == 1 &&
+      this->BufferTotalLength >= static_cast<vtkIdType>(length) &&
+      strncmp(this->Buffers, magic, length) == 0;
+    if (status && numberOfChunks)
+    {
+      // magic, chunk size, uncompressed size then number of chunks.
+      vtkTypeUInt32 chunks = 0;
+      const size_t offset = 4 + sizeof(vtkTypeUInt32) + sizeof(vtkTypeUInt64);
+      status = this->BufferTotalLength >= static_cast<vtkIdType>(offset + sizeof(chunks));
+      if (status)
+      {
+        memcpy(&chunks, this->Buffers + offset, sizeof(chunks));
+      }
+      *numberOfChunks = chunks;
+    }
+    if (status)
+    {
+      this->ReconstructDataFromBuffer(output);
+    }
+    this->ClearBuffer();
+    return status;
+  }
+
+protected:
+  vtkTestMoveData() = default;
+  ~vtkTestMoveData() override = default;
+
+private:
+  vtkTestMoveData(const vtkTestMoveData&) = delete;
+  void operator=(const vtkTestMoveData&) = delete;
+};
+vtkStandardNewMacro(vtkTestMoveData);
+
+//----------------------------------------------------------------------------
+bool SameString(const char* str0, const char* str1)
+{
+  return (!str0 && !str1) || (str0 && str1 && strcmp(str0, str1) == 0);
+}
+
+//----------------------------------------------------------------------------
+bool SameArray(vtkAbstractArray* array0, vtkAbstractArray* array1)
+{
+  if (!array0 || !array1)
+  {
+    return array0 == array1;
+  }
+  const int numComps = array0->GetNumberOfComponents();
+  if (array0->GetDataType() != array1->GetDataType() ||
+    !SameString(array0->GetName(), array1->GetName()) ||
+    numComps != array1->GetNumberOfComponents() ||
+    array0->GetNumberOfTuples() != array1->GetNumberOfTuples() ||
+    array0->HasAComponentName() != array1->HasAComponentName())
+  {
+    return false;
+  }
+  for (int cc = 0; array0->HasAComponentName() && cc < numComps; ++cc)
+  {
+    if (!SameString(array0->GetComponentName(cc), array1->GetComponentName(cc)))
+    {
+      return false;
+    }
+  }
+  for (vtkIdType cc = 0; cc < array0->GetNumberOfValues(); ++cc)
+  {
+    if (!(array0->GetVariantValue(cc) == array1->GetVariantValue(cc)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool SameFieldData(vtkFieldData* fd0, vtkFieldData* fd1)
+{
+  if (fd0->GetNumberOfArrays() != fd1->GetNumberOfArrays())
+  {
+    return false;
+  }
+  for (int cc = 0; cc < fd0->GetNumberOfArrays(); ++cc)
+  {
+    if (!SameArray(fd0->GetAbstractArray(cc), fd1->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+  auto dsa0 = vtkDataSetAttributes::SafeDownCast(fd0);
+  auto dsa1 = vtkDataSetAttributes::SafeDownCast(fd1);
+  if (dsa0 && dsa1)
+  {
+    int indices0[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    int indices1[vtkDataSetAttributes::NUM_ATTRIBUTES];
+    dsa0->GetAttributeIndices(indices0);
+    dsa1->GetAttributeIndices(indices1);
+    return memcmp(indices0, indices1, sizeof(indices0)) == 0;
+  }
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool SameCells(vtkCellArray* cells0, vtkCellArray* cells1)
+{
+  if (!cells0 || !cells1)
+  {
+    return (!cells0 || cells0->GetNumberOfCells() == 0) &&
+      (!cells1 || cells1->GetNumberOfCells() == 0);
+  }
+  return SameArray(cells0->GetOffsetsArray(), cells1->GetOffsetsArray()) &&
+    SameArray(cells0->GetConnectivityArray(), cells1->GetConnectivityArray());
+}
+
+//----------------------------------------------------------------------------
+bool SamePoints(vtkPoints* points0, vtkPoints* points1)
+{
+  return SameArray(points0 ? points0->GetData() : nullptr, points1 ? points1->GetData() : nullptr);
+}
+
+//----------------------------------------------------------------------------
+bool SameName(vtkCompositeDataSet* cd0, vtkCompositeDataSet* cd1, unsigned int index)
+{
+  auto name = [index](vtkCompositeDataSet* cd) -> const char* {
+    auto mb = vtkMultiBlockDataSet::SafeDownCast(cd);
+    auto pd = vtkPartitionedDataSet::SafeDownCast(cd);
+    vtkInformation* info = nullptr;
+    if (mb && mb->HasMetaData(index))
+    {
+      info = mb->GetMetaData(index);
+    }
+    else if (pd && pd->HasMetaData(index))
+    {
+      info = pd->GetMetaData(index);
+    }
+    return info ? info->Get(vtkCompositeDataSet::NAME()) : nullptr;
+  };
+  return SameString(name(cd0), name(cd1));
+}
+
+//----------------------------------------------------------------------------
+bool SameDataObject(vtkDataObject* dobj0, vtkDataObject* dobj1)
+{
+  if (!dobj0 || !dobj1)
+  {
+    return dobj0 == dobj1;
+  }
+  if (dobj0->GetDataObjectType() != dobj1->GetDataObjectType() ||
+    !SameFieldData(dobj0->GetFieldData(), dobj1->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (auto mb0 = vtkMultiBlockDataSet::SafeDownCast(dobj0))
+  {
+    auto mb1 = vtkMultiBlockDataSet::SafeDownCast(dobj1);
+    if (mb0->GetNumberOfBlocks() != mb1->GetNumberOfBlocks())
+    {
+      return false;
+    }
+    for (unsigned int cc = 0; cc < mb0->GetNumberOfBlocks(); ++cc)
+    {
+      if (!SameName(mb0, mb1, cc) || !SameDataObject(mb0->GetBlock(cc), mb1->GetBlock(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (auto pd0 = vtkPartitionedDataSet::SafeDownCast(dobj0))
+  {
+    auto pd1 = vtkPartitionedDataSet::SafeDownCast(dobj1);
+    if (pd0->GetNumberOfPartitions() != pd1->GetNumberOfPartitions())
+    {
+      return false;
+    }
+    for (unsigned int cc = 0; cc < pd0->GetNumberOfPartitions(); ++cc)
+    {
+      if (!SameName(pd0, pd1, cc) ||
+        !SameDataObject(pd0->GetPartitionAsDataObject(cc), pd1->GetPartitionAsDataObject(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto ds0 = vtkDataSet::SafeDownCast(dobj0);
+  auto ds1 = vtkDataSet::SafeDownCast(dobj1);
+  if (!SameFieldData(ds0->GetPointData(), ds1->GetPointData()) ||
+    !SameFieldData(ds0->GetCellData(), ds1->GetCellData()))
+  {
+    return false;
+  }
+  if (auto poly0 = vtkPolyData::SafeDownCast(ds0))
+  {
+    auto poly1 = vtkPolyData::SafeDownCast(ds1);
+    return SamePoints(poly0->GetPoints(), poly1->GetPoints()) &&
+      SameCells(poly0->GetVerts(), poly1->GetVerts()) &&
+      SameCells(poly0->GetLines(), poly1->GetLines()) &&
+      SameCells(poly0->GetPolys(), poly1->GetPolys()) &&
+      SameCells(poly0->GetStrips(), poly1->GetStrips());
+  }
+  if (auto ug0 = vtkUnstructuredGrid::SafeDownCast(ds0))
+  {
+    auto ug1 = vtkUnstructuredGrid::SafeDownCast(ds1);
+    return SamePoints(ug0->GetPoints(), ug1->GetPoints()) &&
+      SameArray(ug0->GetCellTypesArray(), ug1->GetCellTypesArray()) &&
+      SameCells(ug0->GetCells(), ug1->GetCells()) &&
+      SameArray(ug0->GetFaceLocations(), ug1->GetFaceLocations()) &&
+      SameArray(ug0->GetFaces(), ug1->GetFaces());
+  }
+  if (auto image0 = vtkImageData::SafeDownCast(ds0))
+  {
+    auto image1 = vtkImageData::SafeDownCast(ds1);
+    return memcmp(image0->GetExtent(), image1->GetExtent(), 6 * sizeof(int)) == 0 &&
+      memcmp(image0->GetOrigin(), image1->GetOrigin(), 3 * sizeof(double)) == 0 &&
+      memcmp(image0->GetSpacing(), image1->GetSpacing(), 3 * sizeof(double)) == 0;
+  }
+  if (auto rg0 = vtkRectilinearGrid::SafeDownCast(ds0))
+  {
+    auto rg1 = vtkRectilinearGrid::SafeDownCast(ds1);
+    return memcmp(rg0->GetExtent(), rg1->GetExtent(), 6 * sizeof(int)) == 0 &&
+      SameArray(rg0->GetXCoordinates(), rg1->GetXCoordinates()) &&
+      SameArray(rg0->GetYCoordinates(), rg1->GetYCoordinates()) &&
+      SameArray(rg0->GetZCoordinates(), rg1->GetZCoordinates());
+  }
+  if (auto sg0 = vtkStructuredGrid::SafeDownCast(ds0))
+  {
+    auto sg1 = vtkStructuredGrid::SafeDownCast(ds1);
+    return memcmp(sg0->GetExtent(), sg1->GetExtent(), 6 * sizeof(int)) == 0 &&
+      SamePoints(sg0->GetPoints(), sg1->GetPoints());
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+// Adds a string array, an SOA array with component names, and an integer array
+// made the active scalars, to `fd`.
+void AddArrays(vtkDataSetAttributes* fd, vtkIdType numTuples, const char* prefix)
+{
+  vtkNew<vtkStringArray> labels;
+  labels->SetName((std::string(prefix) + "Labels").c_str());
+  vtkNew<vtkSOADataArrayTemplate<double>> vectors;
+  vectors->SetName((std::string(prefix) + "Vectors").c_str());
+  vectors->SetNumberOfComponents(3);
+  vectors->SetComponentName(0, "U");
+  vectors->SetComponentName(1, "V");
+  vectors->SetComponentName(2, "W");
+  vtkNew<vtkIntArray> ids;
+  ids->SetName((std::string(prefix) + "Ids").c_str());
+  for (vtkIdType cc = 0; cc < numTuples; ++cc)
+  {
+    labels->InsertNextValue(cc % 3 ? "label " + std::to_string(cc) : std::string());
+    vectors->InsertNextTuple3(cc, -0.5 * cc, cc * cc);
+    ids->InsertNextValue(static_cast<int>(100 - cc));
+  }
+  fd->AddArray(labels);
+  fd->AddArray(vectors);
+  fd->SetScalars(ids);
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPolyData> MakePolyData(double offset)
+{
+  auto polyData = vtkSmartPointer<vtkPolyData>::New();
+  vtkNew<vtkPoints> points;
+  for (int cc = 0; cc < 6; ++cc)
+  {
+    points->InsertNextPoint(cc % 3 + offset, cc / 3, 0);
+  }
+  polyData->SetPoints(points);
+  polyData->AllocateExact(1, 1, 0, 0, 2, 7, 0, 0);
+  const vtkIdType vert[1] = { 5 };
+  const vtkIdType triangle[3] = { 0, 1, 4 };
+  const vtkIdType quad[4] = { 1, 2, 5, 4 };
+  polyData->InsertNextCell(VTK_VERTEX, 1, vert);
+  polyData->InsertNextCell(VTK_TRIANGLE, 3, triangle);
+  polyData->InsertNextCell(VTK_QUAD, 4, quad);
+  AddArrays(polyData->GetPointData(), 6, "Point");
+  AddArrays(polyData->GetCellData(), 3, "Cell");
+  vtkNew<vtkDoubleArray> time;
+  time->SetName("TimeValue");
+  time->InsertNextValue(offset);
+  polyData->GetFieldData()->AddArray(time);
+  return polyData;
+}
+
+//----------------------------------------------------------------------------
+// A unit cube made of a polyhedron, and a tetrahedron on top of it.
+vtkSmartPointer<vtkUnstructuredGrid> MakePolyhedronGrid()
+{
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  vtkNew<vtkPoints> points;
+  for (int cc = 0; cc < 8; ++cc)
+  {
+    points->InsertNextPoint(cc & 1, (cc >> 1) & 1, (cc >> 2) & 1);
+  }
+  points->InsertNextPoint(0.5, 0.5, 2);
+  grid->SetPoints(points);
+  grid->Allocate(2);
+
+  const vtkIdType cubeIds[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+  const vtkIdType faces[] = { 4, 0, 2, 3, 1, 4, 4, 5, 7, 6, 4, 0, 1, 5, 4, 4, 2, 6, 7, 3, 4, 0, 4,
+    6, 2, 4, 1, 3, 7, 5 };
+  grid->InsertNextCell(VTK_POLYHEDRON, 8, cubeIds, 6, faces);
+  const vtkIdType tetraIds[4] = { 4, 5, 6, 8 };
+  grid->InsertNextCell(VTK_TETRA, 4, tetraIds);
+  AddArrays(grid->GetPointData(), 9, "Point");
+  AddArrays(grid->GetCellData(), 2, "Cell");
+  return grid;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkImageData> MakeImage()
+{
+  auto image = vtkSmartPointer<vtkImageData>::New();
+  image->SetExtent(1, 4, 2, 4, -1, 0);
+  image->SetOrigin(0.5, -1, 2);
+  image->SetSpacing(0.25, 1, 2);
+  AddArrays(image->GetPointData(), image->GetNumberOfPoints(), "Point");
+  AddArrays(image->GetCellData(), image->GetNumberOfCells(), "Cell");
+  return image;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkRectilinearGrid> MakeRectilinearGrid()
+{
+  auto grid = vtkSmartPointer<vtkRectilinearGrid>::New();
+  grid->SetExtent(0, 2, 3, 4, 0, 0);
+  vtkNew<vtkDoubleArray> x, y;
+  vtkNew<vtkFloatArray> z;
+  x->InsertNextValue(0);
+  x->InsertNextValue(0.5);
+  x->InsertNextValue(2);
+  y->InsertNextValue(-1);
+  y->InsertNextValue(1);
+  z->InsertNextValue(3);
+  grid->SetXCoordinates(x);
+  grid->SetYCoordinates(y);
+  grid->SetZCoordinates(z);
+  AddArrays(grid->GetPointData(), grid->GetNumberOfPoints(), "Point");
+  return grid;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkStructuredGrid> MakeStructuredGrid()
+{
+  auto grid = vtkSmartPointer<vtkStructuredGrid>::New();
+  grid->SetExtent(0, 2, 0, 1, 5, 6);
+  vtkNew<vtkPoints> points;
+  for (int k = 0; k < 2; ++k)
+  {
+    for (int j = 0; j < 2; ++j)
+    {
+      for (int i = 0; i < 3; ++i)
+      {
+        points->InsertNextPoint(i + 0.1 * j, j + 0.1 * k, k);
+      }
+    }
+  }
+  grid->SetPoints(points);
+  AddArrays(grid->GetCellData(), grid->GetNumberOfCells(), "Cell");
+  return grid;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkPartitionedDataSet> MakePartitionedDataSet()
+{
+  auto pd = vtkSmartPointer<vtkPartitionedDataSet>::New();
+  pd->SetNumberOfPartitions(3);
+  pd->SetPartition(0, MakePolyData(10));
+  pd->SetPartition(2, MakePolyData(20));
+  pd->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "first");
+  pd->GetMetaData(2u)->Set(vtkCompositeDataSet::NAME(), "");
+  return pd;
+}
+
+//----------------------------------------------------------------------------
+vtkSmartPointer<vtkMultiBlockDataSet> MakeMultiBlock()
+{
+  vtkNew<vtkMultiBlockDataSet> nested;
+  nested->SetNumberOfBlocks(2);
+  nested->SetBlock(0, MakeImage());
+  nested->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "image");
+  nested->SetBlock(1, MakePartitionedDataSet());
+
+  auto mb = vtkSmartPointer<vtkMultiBlockDataSet>::New();
+  mb->SetNumberOfBlocks(5);
+  mb->SetBlock(0, MakePolyData(0));
+  mb->GetMetaData(0u)->Set(vtkCompositeDataSet::NAME(), "surface");
+  mb->SetBlock(1, MakePolyhedronGrid());
+  mb->GetMetaData(1u)->Set(vtkCompositeDataSet::NAME(), "polyhedra");
+  mb->SetBlock(3, nested);
+  mb->GetMetaData(3u)->Set(vtkCompositeDataSet::NAME(), "nested");
+  mb->SetBlock(4, MakeStructuredGrid());
+  vtkNew<vtkStringArray> notes;
+  notes->SetName("Notes");
+  notes->InsertNextValue("multiblock");
+  mb->GetFieldData()->AddArray(notes);
+  return mb;
+}
+
+//----------------------------------------------------------------------------
+bool TestRoundTrip(vtkTestMoveData* mover, vtkDataObject* input, const char* magic)
+{
+  vtkSmartPointer<vtkDataObject> output;
+  output.TakeReference(input->NewInstance());
+  VERIFY(mover->RoundTrip(input, output, magic), "unexpected marshalled buffer.");
+  VERIFY(SameDataObject(input, output), "data changed by the round trip.");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+bool TestAllTypes(vtkTestMoveData* mover, const char* magic)
+{
+  VERIFY(TestRoundTrip(mover, MakePolyData(0), magic), "polydata round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakePolyhedronGrid(), magic), "polyhedra round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakeImage(), magic), "image round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakeRectilinearGrid(), magic), "rectilinear round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakeStructuredGrid(), magic), "structured round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakePartitionedDataSet(), magic), "partitioned round trip failed.");
+  VERIFY(TestRoundTrip(mover, MakeMultiBlock(), magic), "multiblock round trip failed.");
+  return true;
+}
+
+//----------------------------------------------------------------------------
+// The raw buffer of a large image spans several LZ4 chunks, which are
+// compressed and decompressed concurrently.
+bool TestChunkedLZ4(vtkTestMoveData* mover)
+{
+  vtkNew<vtkImageData> image;
+  image->SetDimensions(256, 256, 96);
+  vtkNew<vtkFloatArray> values;
+  values->SetName("Values");
+  values->SetNumberOfTuples(image->GetNumberOfPoints());
+  for (vtkIdType cc = 0; cc < values->GetNumberOfTuples(); ++cc)
+  {
+    values->SetValue(cc, static_cast<float>(cc % 1021) * 0.5f);
+  }
+  image->GetPointData()->SetScalars(values);
+
+  vtkNew<vtkImageData> output;
+  unsigned int numberOfChunks = 0;
+  VERIFY(mover->RoundTrip(image, output, "lz4r", &numberOfChunks), "expected an LZ4 buffer.");
+  VERIFY(numberOfChunks > 1, "expected the buffer to be split in several chunks.");
+  VERIFY(SameDataObject(image, output), "data changed by the chunked round trip.");
+  return true;
+}
+}
+
+int TestMPIMoveDataRawFormat(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  const bool useRawFormat = vtkMPIMoveData::GetUseRawFormat();
+  const bool useLZ4Compression = vtkMPIMoveData::GetUseLZ4Compression();
+  const bool useZLibCompression = vtkMPIMoveData::GetUseZLibCompression();
+
+  vtkNew<vtkTestMoveData> mover;
+  vtkMPIMoveData::SetUseRawFormat(true);
+  vtkMPIMoveData::SetUseZLibCompression(false);
+  vtkMPIMoveData::SetUseLZ4Compression(false);
+  bool success = TestAllTypes(mover, "vtkRaw01");
+  vtkMPIMoveData::SetUseLZ4Compression(true);
+  success = success && TestAllTypes(mover, "lz4r") && TestChunkedLZ4(mover);
+
+  vtkMPIMoveData::SetUseRawFormat(useRawFormat);
+  vtkMPIMoveData::SetUseLZ4Compression(useLZ4Compression);
+  vtkMPIMoveData::SetUseZLibCompression(useZLibCompression);
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,255 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPVGeometryFilterBlockCache.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkCellData.h"
+#include "vtkCellType.h"
+#include "vtkDoubleArray.h"
+#include "vtkFieldData.h"
+#include "vtkLogger.h"
+#include "vtkMultiBlockDataSet.h"
+#include "vtkNew.h"
+#include "vtkPVGeometryFilter.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkUnsignedIntArray.h"
+#include "vtkUnstructuredGrid.h"
+
+#include <cstring>
+
+#define VERIFY(x, y)                                                                               \
+  if (!(x))                                                                                        \
+  {                                                                                                \
+    vtkLogF(ERROR, y);                                                                             \
+    return false;                                                                                  \
+  }
+
+namespace
+{
+// Creates a grid of dim^3 hexahedra with a point array "Temperature" and a cell
+// array "Pressure".
+vtkSmartPointer<vtkUnstructuredGrid> MakeGrid(int dim, double offset)
+{
+  const int npts = dim + 1;
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> temperature;
+  temperature->SetName("Temperature");
+  for (int k = 0; k < npts; ++k)
+  {
+    for (int j = 0; j < npts; ++j)
+    {
+      for (int i = 0; i < npts; ++i)
+      {
+        points->InsertNextPoint(i + offset, j, k);
+        temperature->InsertNextValue(i + 10 * j + 100 * k + offset);
+      }
+    }
+  }
+
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->SetPoints(points);
+  grid->Allocate(dim * dim * dim);
+  vtkNew<vtkDoubleArray> pressure;
+  pressure->SetName("Pressure");
+  auto pid = [npts](int i, int j, int k) {
+    return static_cast<vtkIdType>(i + npts * (j + npts * k));
+  };
+  for (int k = 0; k < dim; ++k)
+  {
+    for (int j = 0; j < dim; ++j)
+    {
+      for (int i = 0; i < dim; ++i)
+      {
+        const vtkIdType ids[8] = { pid(i, j, k), pid(i + 1, j, k), pid(i + 1, j + 1, k),
+          pid(i, j + 1, k), pid(i, j, k + 1), pid(i + 1, j, k + 1), pid(i + 1, j + 1, k + 1),
+          pid(i, j + 1, k + 1) };
+        grid->InsertNextCell(VTK_HEXAHEDRON, 8, ids);
+        pressure->InsertNextValue(-(i + j + k));
+      }
+    }
+  }
+  grid->GetPointData()->SetScalars(temperature);
+  grid->GetCellData()->AddArray(pressure);
+  return grid;
+}
+
+bool SameArray(vtkPolyData* pd0, vtkPolyData* pd1, int association, const char* name)
+{
+  auto array0 = vtkDoubleArray::SafeDownCast(pd0->GetAttributes(association)->GetArray(name));
+  auto array1 = vtkDoubleArray::SafeDownCast(pd1->GetAttributes(association)->GetArray(name));
+  if (!array0 || !array1 || array0->GetNumberOfTuples() != array1->GetNumberOfTuples())
+  {
+    return false;
+  }
+  for (vtkIdType cc = 0; cc < array0->GetNumberOfTuples(); ++cc)
+  {
+    if (array0->GetValue(cc) != array1->GetValue(cc))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool TestBlockCache()
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  for (unsigned int cc = 0; cc < 3; ++cc)
+  {
+    mb->SetBlock(cc, MakeGrid(4, 5.0 * cc));
+  }
+
+  // vtkGeometryRepresentation passes through the original ids, which is what
+  // makes mapping attributes onto a cached surface possible.
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetUseOutline(0);
+  filter->SetPassThroughPointIds(1);
+  filter->SetPassThroughCellIds(1);
+  filter->SetInputData(mb);
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 3, "expected all blocks to be extracted.");
+
+  // re-executing without any change to the blocks reuses all surfaces.
+  mb->Modified();
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 0 && filter->GetNumberOfReusedBlocks() == 3,
+    "expected all blocks to be reused.");
+
+  // changing attributes on a block maps the attributes onto the cached surface.
+  auto grid1 = vtkUnstructuredGrid::SafeDownCast(mb->GetBlock(1));
+  auto temperature = vtkDoubleArray::SafeDownCast(grid1->GetPointData()->GetArray("Temperature"));
+  for (vtkIdType cc = 0; cc < temperature->GetNumberOfTuples(); ++cc)
+  {
+    temperature->SetValue(cc, 2.0 * temperature->GetValue(cc) + 1);
+  }
+  temperature->Modified();
+  auto pressure = vtkDoubleArray::SafeDownCast(grid1->GetCellData()->GetArray("Pressure"));
+  pressure->SetValue(0, 42.0);
+  pressure->Modified();
+  mb->Modified();
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 0 && filter->GetNumberOfRemappedBlocks() == 1 &&
+      filter->GetNumberOfReusedBlocks() == 2,
+    "expected block 1 to be remapped.");
+
+  vtkNew<vtkPVGeometryFilter> reference;
+  reference->SetUseOutline(0);
+  reference->SetPassThroughPointIds(1);
+  reference->SetPassThroughCellIds(1);
+  reference->SetUseBlockCache(false);
+  reference->SetInputData(mb);
+  reference->Update();
+
+  auto output = vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+  auto expected = vtkMultiBlockDataSet::SafeDownCast(reference->GetOutputDataObject(0));
+  for (unsigned int cc = 0; cc < 3; ++cc)
+  {
+    auto pd0 = vtkPolyData::SafeDownCast(output->GetBlock(cc));
+    auto pd1 = vtkPolyData::SafeDownCast(expected->GetBlock(cc));
+    VERIFY(pd0 && pd1, "expected polydata blocks.");
+    VERIFY(pd0->GetNumberOfPoints() == pd1->GetNumberOfPoints() &&
+        pd0->GetNumberOfCells() == pd1->GetNumberOfCells(),
+      "mismatched surface.");
+    VERIFY(SameArray(pd0, pd1, vtkDataObject::POINT, "Temperature"), "mismatched point data.");
+    VERIFY(SameArray(pd0, pd1, vtkDataObject::CELL, "Pressure"), "mismatched cell data.");
+    VERIFY(pd0->GetPointData()->GetScalars() &&
+        strcmp(pd0->GetPointData()->GetScalars()->GetName(), "Temperature") == 0,
+      "active scalars not preserved.");
+  }
+
+  // adding an array requires extracting the block again.
+  vtkNew<vtkDoubleArray> extra;
+  extra->SetName("Extra");
+  extra->SetNumberOfTuples(grid1->GetNumberOfPoints());
+  extra->FillValue(1.0);
+  grid1->GetPointData()->AddArray(extra);
+  mb->Modified();
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 1, "expected block 1 to be extracted.");
+
+  // changing the geometry requires extracting the block again.
+  auto grid2 = vtkUnstructuredGrid::SafeDownCast(mb->GetBlock(2));
+  grid2->GetPoints()->SetPoint(0, -1, -1, -1);
+  grid2->GetPoints()->Modified();
+  mb->Modified();
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 1 && filter->GetNumberOfReusedBlocks() == 2,
+    "expected block 2 to be extracted.");
+
+  // changing a setting discards the cache.
+  filter->SetGenerateCellNormals(1);
+  filter->Update();
+  VERIFY(filter->GetNumberOfExtractedBlocks() == 3, "expected all blocks to be extracted.");
+  return true;
+}
+
+// Extracts the surfaces of the given dataset using `numThreads` threads.
+vtkSmartPointer<vtkMultiBlockDataSet> Extract(vtkMultiBlockDataSet* mb, int numThreads)
+{
+  vtkNew<vtkPVGeometryFilter> filter;
+  filter->SetNumberOfThreads(numThreads);
+  filter->SetUseOutline(0);
+  filter->SetUseBlockCache(false);
+  filter->SetInputData(mb);
+  filter->Update();
+  return vtkMultiBlockDataSet::SafeDownCast(filter->GetOutputDataObject(0));
+}
+
+bool SameIndex(vtkFieldData* fd0, vtkFieldData* fd1, const char* name)
+{
+  auto array0 = vtkUnsignedIntArray::SafeDownCast(fd0->GetArray(name));
+  auto array1 = vtkUnsignedIntArray::SafeDownCast(fd1->GetArray(name));
+  return array0 && array1 && array0->GetValue(0) == array1->GetValue(0);
+}
+
+bool TestConcurrentExtraction()
+{
+  vtkNew<vtkMultiBlockDataSet> mb;
+  for (unsigned int cc = 0; cc < 16; ++cc)
+  {
+    mb->SetBlock(cc, MakeGrid(1 + cc % 4, 5.0 * cc));
+  }
+
+  // extracting the surfaces concurrently, with or without a thread limit,
+  // must produce the same output as extracting them serially.
+  auto expected = Extract(mb, 1);
+  for (int numThreads : { 0, 3 })
+  {
+    auto output = Extract(mb, numThreads);
+    for (unsigned int cc = 0; cc < 16; ++cc)
+    {
+      auto pd0 = vtkPolyData::SafeDownCast(output->GetBlock(cc));
+      auto pd1 = vtkPolyData::SafeDownCast(expected->GetBlock(cc));
+      VERIFY(pd0 && pd1, "expected polydata blocks.");
+      VERIFY(pd0->GetNumberOfPoints() == pd1->GetNumberOfPoints() &&
+          pd0->GetNumberOfCells() == pd1->GetNumberOfCells(),
+        "mismatched surface.");
+      VERIFY(SameArray(pd0, pd1, vtkDataObject::POINT, "Temperature"), "mismatched point data.");
+      VERIFY(SameArray(pd0, pd1, vtkDataObject::CELL, "Pressure"), "mismatched cell data.");
+      VERIFY(SameIndex(pd0->GetPointData(), pd1->GetPointData(), "vtkCompositeIndex"),
+        "mismatched composite index.");
+      VERIFY(SameIndex(pd0->GetFieldData(), pd1->GetFieldData(), "vtkBlockColors"),
+        "mismatched block colors.");
+    }
+  }
+  return true;
+}
+}
+
+int TestPVGeometryFilterBlockCache(int vtkNotUsed(argc), char* vtkNotUsed(argv)[])
+{
+  return TestBlockCache() && TestConcurrentExtraction() ? EXIT_SUCCESS : EXIT_FAILURE;
+}
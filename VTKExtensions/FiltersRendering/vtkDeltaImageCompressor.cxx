@@ -0,0 +1,323 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+#include "vtkDeltaImageCompressor.h"
+
+#include "vtkLZ4Compressor.h"
+#include "vtkMultiProcessStream.h"
+#include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkUnsignedCharArray.h"
+
+#include <cassert>
+#include <cstring>
+#include <sstream>
+
+namespace
+{
+// Each compressed frame is the LZ4 compressed residual followed by a
+// little-endian trailer: the frame id, the id of the frame the residual is
+// relative to (or vtkDeltaImageCompressorKeyFrame) and a magic number.
+const vtkTypeUInt32 vtkDeltaImageCompressorMagic = 0x31544c44; // "DLT1"
+const vtkTypeUInt32 vtkDeltaImageCompressorKeyFrame = 0xffffffff;
+const int vtkDeltaImageCompressorTrailerSize = 12;
+
+void vtkDeltaImageCompressorWriteUInt32(unsigned char* data, vtkTypeUInt32 value)
+{
+  data[0] = static_cast<unsigned char>(value & 0xff);
+  data[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+  data[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+  data[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+}
+
+vtkTypeUInt32 vtkDeltaImageCompressorReadUInt32(const unsigned char* data)
+{
+  return static_cast<vtkTypeUInt32>(data[0]) | (static_cast<vtkTypeUInt32>(data[1]) << 8) |
+    (static_cast<vtkTypeUInt32>(data[2]) << 16) | (static_cast<vtkTypeUInt32>(data[3]) << 24);
+}
+
+//-----------------------------------------------------------------------------
+// Masks `frame` with `mask` (repeated every 4 bytes) and stores the result in
+// `previous`. When `delta` is true, `residual` receives the masked frame
+// XOR-ed with the former content of `previous`, otherwise the masked frame.
+// Words of 8 bytes are processed at once so that compilers vectorize the loop.
+void vtkDeltaImageCompressorEncode(const unsigned char* frame, unsigned char* previous,
+  unsigned char* residual, vtkIdType size, unsigned int mask, bool delta)
+{
+  const vtkTypeUInt64 mask64 = (static_cast<vtkTypeUInt64>(mask) << 32) | mask;
+  const vtkTypeUInt64* frame64 = reinterpret_cast<const vtkTypeUInt64*>(frame);
+  vtkTypeUInt64* previous64 = reinterpret_cast<vtkTypeUInt64*>(previous);
+  vtkTypeUInt64* residual64 = reinterpret_cast<vtkTypeUInt64*>(residual);
+  const vtkIdType numWords = size / 8;
+  vtkSMPTools::For(0, numWords, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkTypeUInt64 masked = frame64[cc] & mask64;
+      residual64[cc] = delta ? (masked ^ previous64[cc]) : masked;
+      previous64[cc] = masked;
+    }
+  });
+
+  const unsigned char* maskBytes = reinterpret_cast<const unsigned char*>(&mask);
+  for (vtkIdType cc = 8 * numWords; cc < size; ++cc)
+  {
+    const unsigned char masked = frame[cc] & maskBytes[cc % 4];
+    residual[cc] = delta ? (masked ^ previous[cc]) : masked;
+    previous[cc] = masked;
+  }
+}
+
+//-----------------------------------------------------------------------------
+// Reverses vtkDeltaImageCompressorEncode in place: `frame` holds the residual
+// and is XOR-ed with `previous`, which then receives the decoded frame.
+void vtkDeltaImageCompressorDecode(unsigned char* frame, unsigned char* previous, vtkIdType size)
+{
+  vtkTypeUInt64* frame64 = reinterpret_cast<vtkTypeUInt64*>(frame);
+  vtkTypeUInt64* previous64 = reinterpret_cast<vtkTypeUInt64*>(previous);
+  const vtkIdType numWords = size / 8;
+  vtkSMPTools::For(0, numWords, [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      frame64[cc] ^= previous64[cc];
+      previous64[cc] = frame64[cc];
+    }
+  });
+
+  for (vtkIdType cc = 8 * numWords; cc < size; ++cc)
+  {
+    frame[cc] ^= previous[cc];
+    previous[cc] = frame[cc];
+  }
+}
+}
+
+vtkStandardNewMacro(vtkDeltaImageCompressor);
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::vtkDeltaImageCompressor()
+  : Quality(3)
+  , KeyFrameInterval(30)
+  , PreviousFrameId(0)
+  , HasPreviousFrame(false)
+  , FramesSinceKeyFrame(0)
+  , NumberOfKeyFrames(0)
+  , NumberOfDeltaFrames(0)
+{
+  // The residual is compressed losslessly: quality masking happens before
+  // computing it so that both ends keep the exact same previous frame.
+  this->LZ4->SetQuality(0);
+  this->LZ4->SetLossLessMode(1);
+}
+
+//----------------------------------------------------------------------------
+vtkDeltaImageCompressor::~vtkDeltaImageCompressor() = default;
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::ResetFrames()
+{
+  this->HasPreviousFrame = false;
+  this->FramesSinceKeyFrame = 0;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Compress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot compress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
+    { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
+    { 0xE0, 0xF0, 0xE0, 0xE0 } };
+
+  vtkUnsignedCharArray* input = this->Input;
+  const int numComponents = input->GetNumberOfComponents();
+  const int compress_level = (this->LossLessMode || numComponents != 4) ? 0 : this->Quality;
+  assert(compress_level >= 0 && compress_level <= 5);
+  unsigned int compress_mask;
+  memcpy(&compress_mask, &compress_masks[compress_level], 4);
+
+  // A key frame is needed when the receiver cannot have a matching previous
+  // frame, or periodically to bound the damage of a lost frame.
+  const bool keyFrame = !this->HasPreviousFrame ||
+    this->PreviousFrame->GetNumberOfComponents() != numComponents ||
+    this->PreviousFrame->GetNumberOfTuples() != input->GetNumberOfTuples() ||
+    this->FramesSinceKeyFrame >= this->KeyFrameInterval - 1;
+  if (keyFrame)
+  {
+    this->PreviousFrame->SetNumberOfComponents(numComponents);
+    this->PreviousFrame->SetNumberOfTuples(input->GetNumberOfTuples());
+  }
+  this->Residual->SetNumberOfComponents(numComponents);
+  this->Residual->SetNumberOfTuples(input->GetNumberOfTuples());
+
+  vtkDeltaImageCompressorEncode(input->GetPointer(0), this->PreviousFrame->GetPointer(0),
+    this->Residual->GetPointer(0), input->GetNumberOfTuples() * numComponents, compress_mask,
+    !keyFrame);
+
+  this->LZ4->SetInput(this->Residual);
+  this->LZ4->SetOutput(this->Output);
+  const int status = this->LZ4->Compress();
+  this->LZ4->SetInput(nullptr);
+  if (status != VTK_OK)
+  {
+    this->ResetFrames();
+    return VTK_ERROR;
+  }
+
+  const vtkTypeUInt32 frameId = this->PreviousFrameId + 1;
+  const vtkIdType compressedSize = this->Output->GetNumberOfTuples();
+  unsigned char* trailer =
+    this->Output->WritePointer(compressedSize, vtkDeltaImageCompressorTrailerSize);
+  vtkDeltaImageCompressorWriteUInt32(trailer, frameId);
+  vtkDeltaImageCompressorWriteUInt32(
+    trailer + 4, keyFrame ? vtkDeltaImageCompressorKeyFrame : this->PreviousFrameId);
+  vtkDeltaImageCompressorWriteUInt32(trailer + 8, vtkDeltaImageCompressorMagic);
+
+  this->PreviousFrameId = frameId;
+  this->HasPreviousFrame = true;
+  if (keyFrame)
+  {
+    this->FramesSinceKeyFrame = 0;
+    this->NumberOfKeyFrames++;
+  }
+  else
+  {
+    this->FramesSinceKeyFrame++;
+    this->NumberOfDeltaFrames++;
+  }
+  return VTK_OK;
+}
+
+//----------------------------------------------------------------------------
+int vtkDeltaImageCompressor::Decompress()
+{
+  if (!(this->Input && this->Output))
+  {
+    vtkWarningMacro("Cannot decompress, empty input or output detected.");
+    return VTK_ERROR;
+  }
+
+  const vtkIdType inputSize = this->Input->GetNumberOfTuples();
+  const unsigned char* trailer = inputSize >= vtkDeltaImageCompressorTrailerSize
+    ? this->Input->GetPointer(inputSize - vtkDeltaImageCompressorTrailerSize)
+    : nullptr;
+  if (!trailer || vtkDeltaImageCompressorReadUInt32(trailer + 8) != vtkDeltaImageCompressorMagic)
+  {
+    vtkErrorMacro("Input is not a frame compressed by vtkDeltaImageCompressor.");
+    return VTK_ERROR;
+  }
+  const vtkTypeUInt32 frameId = vtkDeltaImageCompressorReadUInt32(trailer);
+  const vtkTypeUInt32 referenceId = vtkDeltaImageCompressorReadUInt32(trailer + 4);
+  const bool keyFrame = (referenceId == vtkDeltaImageCompressorKeyFrame);
+
+  vtkUnsignedCharArray* output = this->Output;
+  const vtkIdType size = output->GetNumberOfTuples() * output->GetNumberOfComponents();
+  if (!keyFrame &&
+    (!this->HasPreviousFrame || referenceId != this->PreviousFrameId ||
+      this->PreviousFrame->GetNumberOfTuples() * this->PreviousFrame->GetNumberOfComponents() !=
+        size))
+  {
+    vtkErrorMacro("Delta frame " << frameId << " does not match the previous frame, "
+                                 << "waiting for the next key frame.");
+    this->ResetFrames();
+    return VTK_ERROR;
+  }
+
+  // Decompress the residual straight into the output, without the trailer.
+  this->CompressedResidual->SetArray(const_cast<unsigned char*>(this->Input->GetPointer(0)),
+    inputSize - vtkDeltaImageCompressorTrailerSize, /*save=*/1);
+  this->LZ4->SetInput(this->CompressedResidual);
+  this->LZ4->SetOutput(output);
+  const int status = this->LZ4->Decompress();
+  this->LZ4->SetInput(nullptr);
+  this->CompressedResidual->Initialize();
+  if (status != VTK_OK)
+  {
+    this->ResetFrames();
+    return VTK_ERROR;
+  }
+
+  if (keyFrame)
+  {
+    this->PreviousFrame->DeepCopy(output);
+    this->NumberOfKeyFrames++;
+  }
+  else
+  {
+    vtkDeltaImageCompressorDecode(output->GetPointer(0), this->PreviousFrame->GetPointer(0), size);
+    this->NumberOfDeltaFrames++;
+  }
+  this->PreviousFrameId = frameId;
+  this->HasPreviousFrame = true;
+  return VTK_OK;
+}
+
+//-----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::SaveConfiguration(vtkMultiProcessStream* stream)
+{
+  this->Superclass::SaveConfiguration(stream);
+  *stream << this->Quality << this->KeyFrameInterval;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkDeltaImageCompressor::RestoreConfiguration(vtkMultiProcessStream* stream)
+{
+  if (this->Superclass::RestoreConfiguration(stream))
+  {
+    int quality, keyFrameInterval;
+    *stream >> quality >> keyFrameInterval;
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    return true;
+  }
+  return false;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::SaveConfiguration()
+{
+  std::ostringstream oss;
+  oss << this->Superclass::SaveConfiguration() << " " << this->Quality << " "
+      << this->KeyFrameInterval;
+  this->SetConfiguration(oss.str().c_str());
+  return this->Configuration;
+}
+
+//-----------------------------------------------------------------------------
+const char* vtkDeltaImageCompressor::RestoreConfiguration(const char* stream)
+{
+  stream = this->Superclass::RestoreConfiguration(stream);
+  if (stream)
+  {
+    std::istringstream iss(stream);
+    int quality, keyFrameInterval;
+    iss >> quality >> keyFrameInterval;
+    this->SetQuality(quality);
+    this->SetKeyFrameInterval(keyFrameInterval);
+    return stream + iss.tellg();
+  }
+  return nullptr;
+}
+
+//----------------------------------------------------------------------------
+void vtkDeltaImageCompressor::PrintSelf(ostream& os, vtkIndent indent)
+{
+  this->Superclass::PrintSelf(os, indent);
+  os << indent << "Quality: " << this->Quality << endl;
+  os << indent << "KeyFrameInterval: " << this->KeyFrameInterval << endl;
+  os << indent << "NumberOfKeyFrames: " << this->NumberOfKeyFrames << endl;
+  os << indent << "NumberOfDeltaFrames: " << this->NumberOfDeltaFrames << endl;
+}
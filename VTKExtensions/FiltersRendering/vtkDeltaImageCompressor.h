@@ -0,0 +1,135 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    vtkDeltaImageCompressor.h
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+/**
+ * @class   vtkDeltaImageCompressor
+ * @brief   Image compressor/decompressor that encodes frames as differences
+ * against the previous frame.
+ *
+ * vtkDeltaImageCompressor is meant for streams of images, such as the frames
+ * delivered to the client during interaction, where consecutive images are
+ * highly correlated. Each frame is XOR-ed with the previous frame and the
+ * resulting residual, mostly zeros for small camera motions, is compressed
+ * with LZ4. Every KeyFrameInterval frames, and whenever the image size
+ * changes, a key frame that does not depend on the previous frame is sent
+ * instead.
+ *
+ * Unlike other compressors, this one is stateful: the compressing and the
+ * decompressing instances each keep the last frame, and frames must be
+ * decompressed in the order they were compressed. Each compressed frame
+ * records the frame it is relative to, so that decompressing out of sequence
+ * fails instead of producing a corrupted image. Call ResetFrames() to force
+ * the next frame to be a key frame.
+ *
+ * The stream format is:
+ * `vtkDeltaImageCompressor <LossLessMode> <Quality> <KeyFrameInterval>`.
+ */
+
+#ifndef vtkDeltaImageCompressor_h
+#define vtkDeltaImageCompressor_h
+
+#include "vtkImageCompressor.h"
+#include "vtkNew.h"                                   // needed for vtkNew
+#include "vtkPVVTKExtensionsFiltersRenderingModule.h" // needed for exports
+
+class vtkLZ4Compressor;
+class vtkMultiProcessStream;
+
+class VTKPVVTKEXTENSIONSFILTERSRENDERING_EXPORT vtkDeltaImageCompressor : public vtkImageCompressor
+{
+public:
+  static vtkDeltaImageCompressor* New();
+  vtkTypeMacro(vtkDeltaImageCompressor, vtkImageCompressor);
+  void PrintSelf(ostream& os, vtkIndent indent) override;
+
+  //@{
+  /**
+   * Set the quality measure. The value can be between 0 and 5. 0 means preserve
+   * input image quality while 5 means improve compression at the cost of image
+   * quality, using the same color masks as vtkLZ4Compressor. Ignored in
+   * LossLessMode.
+   */
+  vtkSetClampMacro(Quality, int, 0, 5);
+  vtkGetMacro(Quality, int);
+  //@}
+
+  //@{
+  /**
+   * Set the number of frames between two key frames. 1 means every frame is
+   * a key frame. Default is 30.
+   */
+  vtkSetClampMacro(KeyFrameInterval, int, 1, VTK_INT_MAX);
+  vtkGetMacro(KeyFrameInterval, int);
+  //@}
+
+  /**
+   * Forget the previous frame so that the next frame compressed is a key
+   * frame.
+   */
+  void ResetFrames();
+
+  //@{
+  /**
+   * Returns the number of key frames and delta frames compressed or
+   * decompressed so far.
+   */
+  vtkGetMacro(NumberOfKeyFrames, vtkTypeUInt64);
+  vtkGetMacro(NumberOfDeltaFrames, vtkTypeUInt64);
+  //@}
+
+  //@{
+  /**
+   * Compress/Decompress data array on the objects input with results
+   * in the objects output. See also Set/GetInput/Output.
+   */
+  int Compress() override;
+  int Decompress() override;
+  //@}
+
+  //@{
+  /**
+   * Serialize/Restore compressor configuration (but not the data) into the stream.
+   */
+  void SaveConfiguration(vtkMultiProcessStream* stream) override;
+  bool RestoreConfiguration(vtkMultiProcessStream* stream) override;
+  const char* SaveConfiguration() override;
+  const char* RestoreConfiguration(const char* stream) override;
+  //@}
+
+protected:
+  vtkDeltaImageCompressor();
+  ~vtkDeltaImageCompressor() override;
+
+  int Quality;
+  int KeyFrameInterval;
+
+private:
+  vtkDeltaImageCompressor(const vtkDeltaImageCompressor&) = delete;
+  void operator=(const vtkDeltaImageCompressor&) = delete;
+
+  // The last frame compressed or decompressed, after quality masking.
+  vtkNew<vtkUnsignedCharArray> PreviousFrame;
+  vtkTypeUInt32 PreviousFrameId;
+  bool HasPreviousFrame;
+  int FramesSinceKeyFrame;
+
+  vtkNew<vtkUnsignedCharArray> Residual;
+  vtkNew<vtkUnsignedCharArray> CompressedResidual;
+  vtkNew<vtkLZ4Compressor> LZ4;
+
+  vtkTypeUInt64 NumberOfKeyFrames;
+  vtkTypeUInt64 NumberOfDeltaFrames;
+};
+
+#endif
@@ -16,11 +16,59 @@
 
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 
 #include "vtk_lz4.h"
+#include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Compressed images are made of independently compressed tiles so that they
+// can be compressed and decompressed in parallel. The compressed stream
+// starts with a little-endian header: a magic number, the number of tiles and
+// the compressed size of each tile, followed by the compressed tiles.
+// Tiles are a fixed number of bytes of the uncompressed image, hence their
+// number and uncompressed sizes follow from the image size. The tile size is a
+// multiple of 8, so tiles start on an RGBA pixel and masking can work on 8
+// bytes at a time. RGB pixels may be split between two tiles, which does not
+// matter since they are not masked.
+const vtkTypeUInt32 vtkLZ4CompressorMagic = 0x3454505a; // "ZPT4"
+const int vtkLZ4CompressorTileSize = 256 * 1024;
+
+int vtkLZ4CompressorNumberOfTiles(int imageSize)
+{
+  return std::max(1, (imageSize + vtkLZ4CompressorTileSize - 1) / vtkLZ4CompressorTileSize);
+}
+
+int vtkLZ4CompressorHeaderSize(int numTiles)
+{
+  return 4 * (2 + numTiles);
+}
+
+int vtkLZ4CompressorTileLength(int imageSize, int tile)
+{
+  return std::min(vtkLZ4CompressorTileSize, imageSize - tile * vtkLZ4CompressorTileSize);
+}
+
+void vtkLZ4CompressorWriteUInt32(unsigned char* data, vtkTypeUInt32 value)
+{
+  data[0] = static_cast<unsigned char>(value & 0xff);
+  data[1] = static_cast<unsigned char>((value >> 8) & 0xff);
+  data[2] = static_cast<unsigned char>((value >> 16) & 0xff);
+  data[3] = static_cast<unsigned char>((value >> 24) & 0xff);
+}
+
+vtkTypeUInt32 vtkLZ4CompressorReadUInt32(const unsigned char* data)
+{
+  return static_cast<vtkTypeUInt32>(data[0]) | (static_cast<vtkTypeUInt32>(data[1]) << 8) |
+    (static_cast<vtkTypeUInt32>(data[2]) << 16) | (static_cast<vtkTypeUInt32>(data[3]) << 24);
+}
+}
 
 vtkStandardNewMacro(vtkLZ4Compressor);
 //----------------------------------------------------------------------------
@@ -54,27 +102,76 @@ int vtkLZ4Compressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   vtkUnsignedCharArray* input = this->Input;
-  int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
-
-  if (this->Quality > 0 && input->GetNumberOfComponents() == 4)
+  const int inputSize = input->GetNumberOfTuples() * input->GetNumberOfComponents();
+  const bool applyMask = (this->Quality > 0 && input->GetNumberOfComponents() == 4);
+  if (applyMask)
   {
     this->TemporaryBuffer->SetNumberOfComponents(input->GetNumberOfComponents());
     this->TemporaryBuffer->SetNumberOfTuples(input->GetNumberOfTuples());
-    const unsigned int* in = reinterpret_cast<const unsigned int*>(input->GetPointer(0));
-    unsigned int* out = reinterpret_cast<unsigned int*>(this->TemporaryBuffer->GetPointer(0));
-    for (vtkIdType cc = 0, max = this->Input->GetNumberOfTuples(); cc < max; ++cc)
+  }
+
+  // Split the frame into tiles that are masked and compressed independently.
+  const int numTiles = vtkLZ4CompressorNumberOfTiles(inputSize);
+  const int headerSize = vtkLZ4CompressorHeaderSize(numTiles);
+  std::vector<int> bounds(numTiles + 1, headerSize);
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    bounds[tile + 1] =
+      bounds[tile] + LZ4_compressBound(vtkLZ4CompressorTileLength(inputSize, tile));
+  }
+
+  unsigned char* output = this->Output->WritePointer(0, bounds[numTiles]);
+  std::vector<int> compressedSizes(numTiles, 0);
+  vtkSMPTools::For(0, numTiles, [&](int begin, int end) {
+    for (int tile = begin; tile < end; ++tile)
     {
-      out[cc] = in[cc] & compress_mask;
+      const int offset = tile * vtkLZ4CompressorTileSize;
+      const int length = vtkLZ4CompressorTileLength(inputSize, tile);
+      const unsigned char* in = input->GetPointer(offset);
+      if (applyMask)
+      {
+        // Mask two RGBA pixels at a time; the tile size keeps this aligned.
+        unsigned char* masked = this->TemporaryBuffer->GetPointer(offset);
+        const vtkTypeUInt64 mask64 =
+          (static_cast<vtkTypeUInt64>(compress_mask) << 32) | compress_mask;
+        const vtkTypeUInt64* in64 = reinterpret_cast<const vtkTypeUInt64*>(in);
+        vtkTypeUInt64* out64 = reinterpret_cast<vtkTypeUInt64*>(masked);
+        const int numWords = length / 8;
+        for (int cc = 0; cc < numWords; ++cc)
+        {
+          out64[cc] = in64[cc] & mask64;
+        }
+        if (length % 8 != 0)
+        {
+          const unsigned int* in32 = reinterpret_cast<const unsigned int*>(in) + 2 * numWords;
+          unsigned int* out32 = reinterpret_cast<unsigned int*>(masked) + 2 * numWords;
+          *out32 = *in32 & compress_mask;
+        }
+        in = masked;
+      }
+      compressedSizes[tile] = LZ4_compress_fast(reinterpret_cast<const char*>(in),
+        reinterpret_cast<char*>(output + bounds[tile]), length, bounds[tile + 1] - bounds[tile],
+        16);
     }
-    input = this->TemporaryBuffer.Get();
-  }
+  });
 
-  int maxOutputSize = LZ4_compressBound(inputSize);
-  int compressedSize = LZ4_compress_fast(reinterpret_cast<const char*>(input->GetPointer(0)),
-    reinterpret_cast<char*>(this->Output->WritePointer(0, maxOutputSize)), inputSize, maxOutputSize,
-    16);
+  // Write the tile index, then pack the compressed tiles after it.
+  vtkLZ4CompressorWriteUInt32(output, vtkLZ4CompressorMagic);
+  vtkLZ4CompressorWriteUInt32(output + 4, static_cast<vtkTypeUInt32>(numTiles));
+  int compressedSize = headerSize;
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    if (compressedSizes[tile] <= 0)
+    {
+      this->Output->SetNumberOfTuples(0);
+      return VTK_ERROR;
+    }
+    vtkLZ4CompressorWriteUInt32(output + 8 + 4 * tile, compressedSizes[tile]);
+    memmove(output + compressedSize, output + bounds[tile], compressedSizes[tile]);
+    compressedSize += compressedSizes[tile];
+  }
   this->Output->SetNumberOfTuples(compressedSize);
-  return compressedSize > 0 ? VTK_OK : VTK_ERROR;
+  return VTK_OK;
 }
 
 //----------------------------------------------------------------------------
@@ -86,20 +183,54 @@ int vtkLZ4Compressor::Decompress()
     return VTK_ERROR;
   }
 
-  int maxDecompressedSize =
+  const int maxDecompressedSize =
     this->Output->GetNumberOfComponents() * this->Output->GetNumberOfTuples();
-  int decompressedSize =
-    LZ4_decompress_safe(reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-      reinterpret_cast<char*>(this->Output->GetPointer(0)), this->Input->GetNumberOfTuples(),
-      maxDecompressedSize);
-
-  //  // We use LZ4_decompress_safe for now since there seems to be some bug
-  //  // in LZ4_decompress_fast which is causing segfaults on Windows.
-  //  int decompressedSize = LZ4_decompress_fast(
-  //    reinterpret_cast<const char*>(this->Input->GetPointer(0)),
-  //    reinterpret_cast<char*>(this->Output->GetPointer(0)),
-  //    maxDecompressedSize);
-  return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+  const unsigned char* input = this->Input->GetPointer(0);
+  const int inputSize = this->Input->GetNumberOfTuples();
+  unsigned char* output = this->Output->GetPointer(0);
+
+  const int numTiles = vtkLZ4CompressorNumberOfTiles(maxDecompressedSize);
+  const int headerSize = vtkLZ4CompressorHeaderSize(numTiles);
+  if (inputSize < headerSize || vtkLZ4CompressorReadUInt32(input) != vtkLZ4CompressorMagic ||
+    vtkLZ4CompressorReadUInt32(input + 4) != static_cast<vtkTypeUInt32>(numTiles))
+  {
+    // Not a tiled image, e.g. produced by an older version: decompress it as a
+    // single block.
+    int decompressedSize = LZ4_decompress_safe(reinterpret_cast<const char*>(input),
+      reinterpret_cast<char*>(output), inputSize, maxDecompressedSize);
+    return decompressedSize > 0 ? VTK_OK : VTK_ERROR;
+  }
+
+  std::vector<int> offsets(numTiles + 1, headerSize);
+  for (int tile = 0; tile < numTiles; ++tile)
+  {
+    offsets[tile + 1] =
+      offsets[tile] + static_cast<int>(vtkLZ4CompressorReadUInt32(input + 8 + 4 * tile));
+  }
+  if (offsets[numTiles] > inputSize)
+  {
+    vtkErrorMacro("Compressed image is truncated.");
+    return VTK_ERROR;
+  }
+
+  std::atomic<bool> success(true);
+  vtkSMPTools::For(0, numTiles, [&](int begin, int end) {
+    for (int tile = begin; tile < end; ++tile)
+    {
+      // We use LZ4_decompress_safe for now since there seems to be some bug
+      // in LZ4_decompress_fast which is causing segfaults on Windows.
+      const int length = vtkLZ4CompressorTileLength(maxDecompressedSize, tile);
+      const int decompressedSize =
+        LZ4_decompress_safe(reinterpret_cast<const char*>(input + offsets[tile]),
+          reinterpret_cast<char*>(output + tile * vtkLZ4CompressorTileSize),
+          offsets[tile + 1] - offsets[tile], length);
+      if (decompressedSize != length)
+      {
+        success = false;
+      }
+    }
+  });
+  return success ? VTK_OK : VTK_ERROR;
 }
 
 //-----------------------------------------------------------------------------
@@ -15,39 +15,60 @@
 #include "vtkMPIMoveData.h"
 
 #include "vtkAllToNRedistributeCompositePolyData.h"
+#include "vtkCellArray.h"
 #include "vtkCellData.h"
 #include "vtkCharArray.h"
 #include "vtkCompositeDataIterator.h"
+#include "vtkDataArray.h"
 #include "vtkDataObjectTypes.h"
 #include "vtkGenericDataObjectReader.h"
 #include "vtkGenericDataObjectWriter.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationVector.h"
 #include "vtkMPIMToNSocketConnection.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
 #include "vtkMultiProcessControllerHelper.h"
 #include "vtkObjectFactory.h"
+#include "vtkNew.h"
 #include "vtkOutlineFilter.h"
 #include "vtkPVConfig.h"
 #include "vtkPVLogger.h"
 #include "vtkPVSession.h"
+#include "vtkPartitionedDataSet.h"
 #include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
 #include "vtkProcessModule.h"
+#include "vtkRectilinearGrid.h"
+#include "vtkSMPTools.h"
 #include "vtkSmartPointer.h"
 #include "vtkSocketCommunicator.h"
 #include "vtkSocketController.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
+#include "vtkStringArray.h"
+#include "vtkStructuredGrid.h"
 #include "vtkTimerLog.h"
+#include "vtkUnsignedCharArray.h"
+#include "vtkUnstructuredGrid.h"
 
+#include "vtk_lz4.h"
 #include "vtk_zlib.h"
-#include <sstream>
-#include <vector>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 bool vtkMPIMoveData::UseZLibCompression = false;
+bool vtkMPIMoveData::UseLZ4Compression = false;
+bool vtkMPIMoveData::UseRawFormat = true;
 
 namespace
 {
@@ -80,6 +101,785 @@ void unsetGlobalIdsAttribute(vtkDataObject* piece)
     it->Delete();
   }
 }
+
+//=============================================================================
+// Raw wire format used to move data objects between processes. The data object
+// is written as a sequence of small headers (types, sizes and names), each
+// followed by the contents of the arrays copied straight from their memory.
+// This avoids the encoding and parsing costs of the legacy file format.
+// Serialization is run twice on the same code path: once to compute the size
+// of the buffer, and once to fill it.
+namespace vtkMPIMoveDataRaw
+{
+const char Magic[8] = { 'v', 't', 'k', 'R', 'a', 'w', '0', '1' };
+const vtkTypeUInt16 ByteOrderMark = 0x0102;
+
+// Counts the number of bytes written.
+struct SizeSink
+{
+  size_t Size = 0;
+  void Write(const void*, size_t size) { this->Size += size; }
+};
+
+// Copies the bytes written to a preallocated buffer.
+struct CopySink
+{
+  char* Cursor;
+  void Write(const void* data, size_t size)
+  {
+    if (size > 0)
+    {
+      memcpy(this->Cursor, data, size);
+      this->Cursor += size;
+    }
+  }
+};
+
+// Reads back bytes written by CopySink, checking for overruns.
+class Source
+{
+public:
+  Source(const char* data, size_t size)
+    : Cursor(data)
+    , End(data + size)
+  {
+  }
+
+  size_t GetRemaining() const { return static_cast<size_t>(this->End - this->Cursor); }
+
+  bool Read(void* data, size_t size)
+  {
+    if (size > this->GetRemaining())
+    {
+      return false;
+    }
+    if (size > 0)
+    {
+      memcpy(data, this->Cursor, size);
+      this->Cursor += size;
+    }
+    return true;
+  }
+
+  template <typename T>
+  bool Read(T& value)
+  {
+    return this->Read(&value, sizeof(T));
+  }
+
+  bool ReadString(std::string& str, bool& valid)
+  {
+    vtkTypeInt64 length;
+    if (!this->Read(length) || length > static_cast<vtkTypeInt64>(this->GetRemaining()))
+    {
+      return false;
+    }
+    valid = length >= 0;
+    str.assign(this->Cursor, valid ? static_cast<size_t>(length) : 0);
+    this->Cursor += str.size();
+    return true;
+  }
+
+private:
+  const char* Cursor;
+  const char* End;
+};
+
+bool IsSupported(int type)
+{
+  switch (type)
+  {
+    case VTK_POLY_DATA:
+    case VTK_UNSTRUCTURED_GRID:
+    case VTK_IMAGE_DATA:
+    case VTK_STRUCTURED_POINTS:
+    case VTK_UNIFORM_GRID:
+    case VTK_RECTILINEAR_GRID:
+    case VTK_STRUCTURED_GRID:
+    case VTK_MULTIBLOCK_DATA_SET:
+    case VTK_MULTIPIECE_DATA_SET:
+    case VTK_PARTITIONED_DATA_SET:
+      return true;
+    default:
+      return false;
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT, typename T>
+void WriteValue(SinkT& sink, const T& value)
+{
+  sink.Write(&value, sizeof(T));
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+void WriteString(SinkT& sink, const char* str)
+{
+  const vtkTypeInt64 length = str ? static_cast<vtkTypeInt64>(strlen(str)) : -1;
+  WriteValue(sink, length);
+  if (length > 0)
+  {
+    sink.Write(str, static_cast<size_t>(length));
+  }
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool WriteArray(SinkT& sink, vtkAbstractArray* array)
+{
+  if (array == nullptr)
+  {
+    WriteValue(sink, -1);
+    return true;
+  }
+
+  auto dataArray = vtkDataArray::SafeDownCast(array);
+  auto stringArray = vtkStringArray::SafeDownCast(array);
+  if ((!dataArray && !stringArray) || array->GetDataType() == VTK_BIT)
+  {
+    return false;
+  }
+
+  const int numComps = array->GetNumberOfComponents();
+  const vtkIdType numTuples = array->GetNumberOfTuples();
+  const vtkIdType numValues = numTuples * numComps;
+  WriteValue(sink, array->GetDataType());
+  WriteString(sink, array->GetName());
+  WriteValue(sink, numComps);
+  WriteValue(sink, numTuples);
+  for (int cc = 0; cc < numComps; ++cc)
+  {
+    WriteString(sink, array->HasAComponentName() ? array->GetComponentName(cc) : nullptr);
+  }
+
+  if (stringArray)
+  {
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      WriteString(sink, stringArray->GetValue(cc).c_str());
+    }
+  }
+  else if (numValues > 0)
+  {
+    const size_t size = static_cast<size_t>(numValues) * dataArray->GetDataTypeSize();
+    if (dataArray->HasStandardMemoryLayout())
+    {
+      sink.Write(dataArray->GetVoidPointer(0), size);
+    }
+    else if (std::is_same<SinkT, SizeSink>::value)
+    {
+      // only the size matters, skip the conversion.
+      sink.Write(nullptr, size);
+    }
+    else
+    {
+      // implicit and SOA arrays are converted to the standard layout first.
+      vtkSmartPointer<vtkDataArray> aos;
+      aos.TakeReference(vtkDataArray::CreateDataArray(dataArray->GetDataType()));
+      aos->DeepCopy(dataArray);
+      sink.Write(aos->GetVoidPointer(0), size);
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool ReadArray(Source& source, vtkSmartPointer<vtkAbstractArray>& array)
+{
+  array = nullptr;
+  int type;
+  if (!source.Read(type))
+  {
+    return false;
+  }
+  if (type == -1)
+  {
+    return true;
+  }
+
+  std::string name;
+  bool hasName;
+  int numComps;
+  vtkIdType numTuples;
+  if (!source.ReadString(name, hasName) || !source.Read(numComps) || !source.Read(numTuples) ||
+    numComps < 1 || numTuples < 0)
+  {
+    return false;
+  }
+
+  array.TakeReference(vtkAbstractArray::CreateArray(type));
+  auto dataArray = vtkDataArray::SafeDownCast(array);
+  auto stringArray = vtkStringArray::SafeDownCast(array);
+  if ((!dataArray && !stringArray) || type == VTK_BIT)
+  {
+    return false;
+  }
+  if (hasName)
+  {
+    array->SetName(name.c_str());
+  }
+  array->SetNumberOfComponents(numComps);
+  for (int cc = 0; cc < numComps; ++cc)
+  {
+    std::string componentName;
+    bool hasComponentName;
+    if (!source.ReadString(componentName, hasComponentName))
+    {
+      return false;
+    }
+    if (hasComponentName)
+    {
+      array->SetComponentName(cc, componentName.c_str());
+    }
+  }
+
+  const vtkIdType numValues = numTuples * numComps;
+  if (stringArray)
+  {
+    stringArray->SetNumberOfTuples(numTuples);
+    for (vtkIdType cc = 0; cc < numValues; ++cc)
+    {
+      std::string value;
+      bool valid;
+      if (!source.ReadString(value, valid))
+      {
+        return false;
+      }
+      stringArray->SetValue(cc, value);
+    }
+    return true;
+  }
+
+  const size_t size = static_cast<size_t>(numValues) * dataArray->GetDataTypeSize();
+  if (size > source.GetRemaining())
+  {
+    return false;
+  }
+  dataArray->SetNumberOfTuples(numTuples);
+  return numValues == 0 || source.Read(dataArray->GetVoidPointer(0), size);
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool WriteFieldData(SinkT& sink, vtkFieldData* fd)
+{
+  const int numArrays = fd ? fd->GetNumberOfArrays() : 0;
+  WriteValue(sink, numArrays);
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    if (!WriteArray(sink, fd->GetAbstractArray(cc)))
+    {
+      return false;
+    }
+  }
+
+  int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  std::fill_n(indices, static_cast<int>(vtkDataSetAttributes::NUM_ATTRIBUTES), -1);
+  if (auto dsa = vtkDataSetAttributes::SafeDownCast(fd))
+  {
+    dsa->GetAttributeIndices(indices);
+  }
+  sink.Write(indices, sizeof(indices));
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool ReadFieldData(Source& source, vtkFieldData* fd)
+{
+  int numArrays;
+  if (!source.Read(numArrays))
+  {
+    return false;
+  }
+  for (int cc = 0; cc < numArrays; ++cc)
+  {
+    vtkSmartPointer<vtkAbstractArray> array;
+    if (!ReadArray(source, array) || array == nullptr)
+    {
+      return false;
+    }
+    fd->AddArray(array);
+  }
+
+  int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+  if (!source.Read(indices, sizeof(indices)))
+  {
+    return false;
+  }
+  if (auto dsa = vtkDataSetAttributes::SafeDownCast(fd))
+  {
+    for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+      if (indices[attr] >= 0 && indices[attr] < numArrays)
+      {
+        dsa->SetActiveAttribute(indices[attr], attr);
+      }
+    }
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool WritePoints(SinkT& sink, vtkPoints* points)
+{
+  return WriteArray(sink, points ? points->GetData() : nullptr);
+}
+
+//-----------------------------------------------------------------------------
+bool ReadPoints(Source& source, vtkPointSet* ps)
+{
+  vtkSmartPointer<vtkAbstractArray> array;
+  if (!ReadArray(source, array))
+  {
+    return false;
+  }
+  if (auto dataArray = vtkDataArray::SafeDownCast(array))
+  {
+    vtkNew<vtkPoints> points;
+    points->SetData(dataArray);
+    ps->SetPoints(points);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool WriteCells(SinkT& sink, vtkCellArray* cells)
+{
+  return WriteArray(sink, cells ? cells->GetOffsetsArray() : nullptr) &&
+    WriteArray(sink, cells ? cells->GetConnectivityArray() : nullptr);
+}
+
+//-----------------------------------------------------------------------------
+bool ReadCells(Source& source, vtkSmartPointer<vtkCellArray>& cells)
+{
+  cells = nullptr;
+  vtkSmartPointer<vtkAbstractArray> offsets, connectivity;
+  if (!ReadArray(source, offsets) || !ReadArray(source, connectivity))
+  {
+    return false;
+  }
+  if (offsets && connectivity)
+  {
+    cells = vtkSmartPointer<vtkCellArray>::New();
+    return cells->SetData(
+      vtkDataArray::SafeDownCast(offsets), vtkDataArray::SafeDownCast(connectivity));
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+void WriteImage(SinkT& sink, vtkImageData* image)
+{
+  sink.Write(image->GetExtent(), 6 * sizeof(int));
+  sink.Write(image->GetOrigin(), 3 * sizeof(double));
+  sink.Write(image->GetSpacing(), 3 * sizeof(double));
+  sink.Write(image->GetDirectionMatrix()->GetData(), 9 * sizeof(double));
+}
+
+//-----------------------------------------------------------------------------
+bool ReadImage(Source& source, vtkImageData* image)
+{
+  int extent[6];
+  double origin[3], spacing[3], direction[9];
+  if (!source.Read(extent, sizeof(extent)) || !source.Read(origin, sizeof(origin)) ||
+    !source.Read(spacing, sizeof(spacing)) || !source.Read(direction, sizeof(direction)))
+  {
+    return false;
+  }
+  image->SetExtent(extent);
+  image->SetOrigin(origin);
+  image->SetSpacing(spacing);
+  image->SetDirectionMatrix(direction);
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool WriteObject(SinkT& sink, vtkDataObject* dobj)
+{
+  if (dobj == nullptr)
+  {
+    WriteValue(sink, -1);
+    return true;
+  }
+
+  const int type = dobj->GetDataObjectType();
+  if (!IsSupported(type))
+  {
+    return false;
+  }
+  WriteValue(sink, type);
+  if (!WriteFieldData(sink, dobj->GetFieldData()))
+  {
+    return false;
+  }
+
+  if (auto mb = vtkMultiBlockDataSet::SafeDownCast(dobj))
+  {
+    const unsigned int numBlocks = mb->GetNumberOfBlocks();
+    WriteValue(sink, numBlocks);
+    for (unsigned int cc = 0; cc < numBlocks; ++cc)
+    {
+      WriteString(sink,
+        mb->HasMetaData(cc) ? mb->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME()) : nullptr);
+      if (!WriteObject(sink, mb->GetBlock(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+  if (auto pd = vtkPartitionedDataSet::SafeDownCast(dobj))
+  {
+    const unsigned int numPartitions = pd->GetNumberOfPartitions();
+    WriteValue(sink, numPartitions);
+    for (unsigned int cc = 0; cc < numPartitions; ++cc)
+    {
+      WriteString(sink,
+        pd->HasMetaData(cc) ? pd->GetMetaData(cc)->Get(vtkCompositeDataSet::NAME()) : nullptr);
+      if (!WriteObject(sink, pd->GetPartitionAsDataObject(cc)))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  auto ds = vtkDataSet::SafeDownCast(dobj);
+  bool status = true;
+  if (auto polyData = vtkPolyData::SafeDownCast(ds))
+  {
+    status = WritePoints(sink, polyData->GetPoints()) &&
+      WriteCells(sink, polyData->GetVerts()) && WriteCells(sink, polyData->GetLines()) &&
+      WriteCells(sink, polyData->GetPolys()) && WriteCells(sink, polyData->GetStrips());
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    status = WritePoints(sink, ug->GetPoints()) && WriteArray(sink, ug->GetCellTypesArray()) &&
+      WriteCells(sink, ug->GetCells()) && WriteArray(sink, ug->GetFaceLocations()) &&
+      WriteArray(sink, ug->GetFaces());
+  }
+  else if (auto image = vtkImageData::SafeDownCast(ds))
+  {
+    WriteImage(sink, image);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    sink.Write(rg->GetExtent(), 6 * sizeof(int));
+    status = WriteArray(sink, rg->GetXCoordinates()) && WriteArray(sink, rg->GetYCoordinates()) &&
+      WriteArray(sink, rg->GetZCoordinates());
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    sink.Write(sg->GetExtent(), 6 * sizeof(int));
+    status = WritePoints(sink, sg->GetPoints());
+  }
+  return status && WriteFieldData(sink, ds->GetPointData()) &&
+    WriteFieldData(sink, ds->GetCellData());
+}
+
+//-----------------------------------------------------------------------------
+bool ReadObject(Source& source, vtkSmartPointer<vtkDataObject>& dobj)
+{
+  dobj = nullptr;
+  int type;
+  if (!source.Read(type))
+  {
+    return false;
+  }
+  if (type == -1)
+  {
+    return true;
+  }
+  if (!IsSupported(type))
+  {
+    return false;
+  }
+  dobj.TakeReference(vtkDataObjectTypes::NewDataObject(type));
+  if (dobj == nullptr || !ReadFieldData(source, dobj->GetFieldData()))
+  {
+    return false;
+  }
+
+  auto mb = vtkMultiBlockDataSet::SafeDownCast(dobj);
+  auto pd = vtkPartitionedDataSet::SafeDownCast(dobj);
+  if (mb || pd)
+  {
+    unsigned int numChildren;
+    if (!source.Read(numChildren))
+    {
+      return false;
+    }
+    if (mb)
+    {
+      mb->SetNumberOfBlocks(numChildren);
+    }
+    else
+    {
+      pd->SetNumberOfPartitions(numChildren);
+    }
+    for (unsigned int cc = 0; cc < numChildren; ++cc)
+    {
+      std::string name;
+      bool hasName;
+      vtkSmartPointer<vtkDataObject> child;
+      if (!source.ReadString(name, hasName) || !ReadObject(source, child))
+      {
+        return false;
+      }
+      if (mb)
+      {
+        mb->SetBlock(cc, child);
+      }
+      else
+      {
+        pd->SetPartition(cc, child);
+      }
+      if (hasName)
+      {
+        (mb ? mb->GetMetaData(cc) : pd->GetMetaData(cc))
+          ->Set(vtkCompositeDataSet::NAME(), name.c_str());
+      }
+    }
+    return true;
+  }
+
+  auto ds = vtkDataSet::SafeDownCast(dobj);
+  bool status = true;
+  if (auto polyData = vtkPolyData::SafeDownCast(ds))
+  {
+    vtkSmartPointer<vtkCellArray> verts, lines, polys, strips;
+    status = ReadPoints(source, polyData) && ReadCells(source, verts) &&
+      ReadCells(source, lines) && ReadCells(source, polys) && ReadCells(source, strips);
+    polyData->SetVerts(verts);
+    polyData->SetLines(lines);
+    polyData->SetPolys(polys);
+    polyData->SetStrips(strips);
+  }
+  else if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+  {
+    vtkSmartPointer<vtkAbstractArray> types, faceLocations, faces;
+    vtkSmartPointer<vtkCellArray> cells;
+    status = ReadPoints(source, ug) && ReadArray(source, types) && ReadCells(source, cells) &&
+      ReadArray(source, faceLocations) && ReadArray(source, faces);
+    auto cellTypes = vtkUnsignedCharArray::SafeDownCast(types);
+    if (status && cellTypes && cells)
+    {
+      ug->SetCells(cellTypes, cells, vtkIdTypeArray::SafeDownCast(faceLocations),
+        vtkIdTypeArray::SafeDownCast(faces));
+    }
+  }
+  else if (auto image = vtkImageData::SafeDownCast(ds))
+  {
+    status = ReadImage(source, image);
+  }
+  else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+  {
+    int extent[6];
+    vtkSmartPointer<vtkAbstractArray> x, y, z;
+    status = source.Read(extent, sizeof(extent)) && ReadArray(source, x) &&
+      ReadArray(source, y) && ReadArray(source, z);
+    if (status)
+    {
+      rg->SetExtent(extent);
+      rg->SetXCoordinates(vtkDataArray::SafeDownCast(x));
+      rg->SetYCoordinates(vtkDataArray::SafeDownCast(y));
+      rg->SetZCoordinates(vtkDataArray::SafeDownCast(z));
+    }
+  }
+  else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+  {
+    int extent[6];
+    status = source.Read(extent, sizeof(extent)) && ReadPoints(source, sg);
+    if (status)
+    {
+      sg->SetExtent(extent);
+    }
+  }
+  return status && ReadFieldData(source, ds->GetPointData()) &&
+    ReadFieldData(source, ds->GetCellData());
+}
+
+//-----------------------------------------------------------------------------
+template <typename SinkT>
+bool Write(SinkT& sink, vtkDataObject* dobj)
+{
+  sink.Write(Magic, sizeof(Magic));
+  WriteValue(sink, ByteOrderMark);
+  WriteValue(sink, static_cast<vtkTypeUInt16>(sizeof(vtkIdType)));
+  return WriteObject(sink, dobj);
+}
+
+//-----------------------------------------------------------------------------
+// Returns a new[] allocated buffer with the serialized data object, or nullptr
+// if the data object cannot be represented in the raw format.
+char* Marshal(vtkDataObject* dobj, vtkIdType& length)
+{
+  SizeSink sizer;
+  if (!Write(sizer, dobj))
+  {
+    return nullptr;
+  }
+  char* buffer = new char[sizer.Size];
+  CopySink copier{ buffer };
+  Write(copier, dobj);
+  length = static_cast<vtkIdType>(sizer.Size);
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+bool IsRaw(const char* buffer, vtkIdType length)
+{
+  return length >= static_cast<vtkIdType>(sizeof(Magic)) &&
+    memcmp(buffer, Magic, sizeof(Magic)) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Returns nullptr if the buffer is corrupt or was written by a process with a
+// different byte order or vtkIdType size.
+vtkSmartPointer<vtkDataObject> Unmarshal(const char* buffer, vtkIdType length)
+{
+  Source source(buffer, static_cast<size_t>(length));
+  char magic[sizeof(Magic)];
+  vtkTypeUInt16 byteOrderMark, idTypeSize;
+  vtkSmartPointer<vtkDataObject> dobj;
+  if (!source.Read(magic, sizeof(magic)) || !source.Read(byteOrderMark) ||
+    !source.Read(idTypeSize) || byteOrderMark != ByteOrderMark ||
+    idTypeSize != sizeof(vtkIdType) || !ReadObject(source, dobj))
+  {
+    return nullptr;
+  }
+  return dobj;
+}
+}
+
+//=============================================================================
+// LZ4 compression of the marshalled buffers. The buffer is split in chunks
+// that are compressed and decompressed concurrently. The header is the magic
+// "lz4r", the chunk size, the uncompressed size, the number of chunks and the
+// compressed size of each chunk.
+namespace vtkMPIMoveDataLZ4
+{
+const char Magic[4] = { 'l', 'z', '4', 'r' };
+const vtkTypeUInt32 ChunkSize = 16 * 1024 * 1024;
+
+//-----------------------------------------------------------------------------
+// Returns a new[] allocated buffer, or nullptr if compression failed.
+char* Compress(const char* data, vtkIdType length, vtkIdType& outLength)
+{
+  const vtkTypeUInt64 rawLength = static_cast<vtkTypeUInt64>(length);
+  const vtkTypeUInt32 numChunks = static_cast<vtkTypeUInt32>((rawLength + ChunkSize - 1) / ChunkSize);
+  std::vector<std::vector<char>> chunks(numChunks);
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkTypeUInt64 offset = static_cast<vtkTypeUInt64>(cc) * ChunkSize;
+      const int size = static_cast<int>(std::min<vtkTypeUInt64>(ChunkSize, rawLength - offset));
+      auto& chunk = chunks[cc];
+      chunk.resize(LZ4_compressBound(size));
+      const int compressed =
+        LZ4_compress_default(data + offset, chunk.data(), size, static_cast<int>(chunk.size()));
+      if (compressed <= 0)
+      {
+        failed = true;
+      }
+      chunk.resize(std::max(compressed, 0));
+    }
+  });
+  if (failed)
+  {
+    return nullptr;
+  }
+
+  const size_t headerSize = sizeof(Magic) + 2 * sizeof(vtkTypeUInt32) + sizeof(vtkTypeUInt64) +
+    numChunks * sizeof(vtkTypeUInt32);
+  size_t total = headerSize;
+  for (const auto& chunk : chunks)
+  {
+    total += chunk.size();
+  }
+
+  char* buffer = new char[total];
+  vtkMPIMoveDataRaw::CopySink sink{ buffer };
+  sink.Write(Magic, sizeof(Magic));
+  vtkMPIMoveDataRaw::WriteValue(sink, ChunkSize);
+  vtkMPIMoveDataRaw::WriteValue(sink, rawLength);
+  vtkMPIMoveDataRaw::WriteValue(sink, numChunks);
+  for (const auto& chunk : chunks)
+  {
+    vtkMPIMoveDataRaw::WriteValue(sink, static_cast<vtkTypeUInt32>(chunk.size()));
+  }
+  for (const auto& chunk : chunks)
+  {
+    sink.Write(chunk.data(), chunk.size());
+  }
+  outLength = static_cast<vtkIdType>(total);
+  return buffer;
+}
+
+//-----------------------------------------------------------------------------
+bool IsCompressed(const char* buffer, vtkIdType length)
+{
+  return length >= static_cast<vtkIdType>(sizeof(Magic)) &&
+    memcmp(buffer, Magic, sizeof(Magic)) == 0;
+}
+
+//-----------------------------------------------------------------------------
+// Returns a new[] allocated buffer, or nullptr if the buffer is corrupt.
+char* Decompress(const char* data, vtkIdType length, vtkIdType& outLength)
+{
+  vtkMPIMoveDataRaw::Source source(data, static_cast<size_t>(length));
+  char magic[sizeof(Magic)];
+  vtkTypeUInt32 chunkSize, numChunks;
+  vtkTypeUInt64 rawLength;
+  if (!source.Read(magic, sizeof(magic)) || !source.Read(chunkSize) || !source.Read(rawLength) ||
+    !source.Read(numChunks) || chunkSize == 0 ||
+    numChunks != (rawLength + chunkSize - 1) / chunkSize ||
+    numChunks * sizeof(vtkTypeUInt32) > source.GetRemaining())
+  {
+    return nullptr;
+  }
+
+  std::vector<vtkTypeUInt32> sizes(numChunks);
+  source.Read(sizes.data(), numChunks * sizeof(vtkTypeUInt32));
+  std::vector<size_t> offsets(numChunks + 1, static_cast<size_t>(length) - source.GetRemaining());
+  for (vtkTypeUInt32 cc = 0; cc < numChunks; ++cc)
+  {
+    offsets[cc + 1] = offsets[cc] + sizes[cc];
+  }
+  if (offsets[numChunks] > static_cast<size_t>(length))
+  {
+    return nullptr;
+  }
+
+  char* buffer = new char[rawLength];
+  std::atomic<bool> failed(false);
+  vtkSMPTools::For(0, static_cast<vtkIdType>(numChunks), [&](vtkIdType begin, vtkIdType end) {
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      const vtkTypeUInt64 offset = static_cast<vtkTypeUInt64>(cc) * chunkSize;
+      const int size = static_cast<int>(std::min<vtkTypeUInt64>(chunkSize, rawLength - offset));
+      if (LZ4_decompress_safe(data + offsets[cc], buffer + offset, static_cast<int>(sizes[cc]),
+            size) != size)
+      {
+        failed = true;
+      }
+    }
+  });
+  if (failed)
+  {
+    delete[] buffer;
+    return nullptr;
+  }
+  outLength = static_cast<vtkIdType>(rawLength);
+  return buffer;
+}
+}
 };
 
 vtkStandardNewMacro(vtkMPIMoveData);
@@ -178,6 +978,30 @@ bool vtkMPIMoveData::GetUseZLibCompression()
   return vtkMPIMoveData::UseZLibCompression;
 }
 
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseLZ4Compression(bool b)
+{
+  vtkMPIMoveData::UseLZ4Compression = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseLZ4Compression()
+{
+  return vtkMPIMoveData::UseLZ4Compression;
+}
+
+//----------------------------------------------------------------------------
+void vtkMPIMoveData::SetUseRawFormat(bool b)
+{
+  vtkMPIMoveData::UseRawFormat = b;
+}
+
+//----------------------------------------------------------------------------
+bool vtkMPIMoveData::GetUseRawFormat()
+{
+  return vtkMPIMoveData::UseRawFormat;
+}
+
 //----------------------------------------------------------------------------
 int vtkMPIMoveData::FillInputPortInformation(int, vtkInformation* info)
 {
@@ -957,58 +1781,90 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
     this->NumberOfBuffers = 0;
   }
 
-  // Copy input to isolate reader from the pipeline.
-  vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
-  writer->SetInputData(data);
-  if (imageData)
+  char* buffer = nullptr;
+  vtkIdType buffer_length = 0;
+
+  if (vtkMPIMoveData::UseRawFormat)
   {
-    // We add the image extents to the header, since the writer doesn't preserve
-    // the extents.
-    int* extent = imageData->GetExtent();
-    double* origin = imageData->GetOrigin();
-    std::ostringstream stream;
-    stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
-           << " " << extent[4] << " " << extent[5];
-    stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
-    writer->SetHeader(stream.str().c_str());
+    vtkTimerLog::MarkStartEvent("Raw marshal");
+    buffer = vtkMPIMoveDataRaw::Marshal(data, buffer_length);
+    vtkTimerLog::MarkEndEvent("Raw marshal");
+    vtkVLogIfF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), buffer == nullptr,
+      "'%s' is not supported by the raw format, using the legacy format.",
+      data->GetClassName());
   }
 
-  writer->SetFileTypeToBinary();
-  writer->WriteToOutputStringOn();
-  writer->Write();
+  if (buffer == nullptr)
+  {
+    // Copy input to isolate reader from the pipeline.
+    vtkDataWriter* writer = vtkGenericDataObjectWriter::New();
+    writer->SetInputData(data);
+    if (imageData)
+    {
+      // We add the image extents to the header, since the writer doesn't preserve
+      // the extents.
+      int* extent = imageData->GetExtent();
+      double* origin = imageData->GetOrigin();
+      std::ostringstream stream;
+      stream << "EXTENT " << extent[0] << " " << extent[1] << " " << extent[2] << " " << extent[3]
+             << " " << extent[4] << " " << extent[5];
+      stream << " ORIGIN " << origin[0] << " " << origin[1] << " " << origin[2];
+      writer->SetHeader(stream.str().c_str());
+    }
+
+    writer->SetFileTypeToBinary();
+    writer->WriteToOutputStringOn();
+    writer->Write();
 
-  char* buffer = nullptr;
-  vtkIdType buffer_length = 0;
+    buffer_length = writer->GetOutputStringLength();
+    buffer = writer->RegisterAndGetOutputString();
+    writer->Delete();
+    writer = nullptr;
+  }
 
-  if (vtkMPIMoveData::UseZLibCompression)
+  if (vtkMPIMoveData::UseLZ4Compression)
+  {
+    vtkTimerLog::MarkStartEvent("LZ4 compress");
+    vtkIdType out_size = 0;
+    char* compressed = vtkMPIMoveDataLZ4::Compress(buffer, buffer_length, out_size);
+    vtkTimerLog::MarkEndEvent("LZ4 compress");
+    if (compressed)
+    {
+      delete[] buffer;
+      buffer = compressed;
+      buffer_length = out_size;
+    }
+    else
+    {
+      vtkWarningMacro("LZ4 compression failed, sending uncompressed data.");
+    }
+  }
+  else if (vtkMPIMoveData::UseZLibCompression)
   {
     vtkTimerLog::MarkStartEvent("Zlib compress");
     // Use z-lib compression.
-    uLongf out_size = compressBound(writer->GetOutputStringLength());
-    buffer = new char[out_size + 8];
-    memcpy(buffer, "zlib0000", 8);
+    uLongf out_size = compressBound(buffer_length);
+    char* compressed = new char[out_size + 8];
+    memcpy(compressed, "zlib0000", 8);
 
-    compress2(reinterpret_cast<Bytef*>(buffer + 8), &out_size,
-      reinterpret_cast<const Bytef*>(writer->GetOutputString()), writer->GetOutputStringLength(),
+    compress2(reinterpret_cast<Bytef*>(compressed + 8), &out_size,
+      reinterpret_cast<const Bytef*>(buffer), buffer_length,
       /* compression_level */ Z_DEFAULT_COMPRESSION);
     vtkTimerLog::MarkEndEvent("Zlib compress");
-    int in_size = static_cast<int>(writer->GetOutputStringLength());
+    int in_size = static_cast<int>(buffer_length);
     for (int cc = 0; cc < 4; cc++)
     {
       // the first 4 bytes in the header are "zlib" which helps the receiver
       // identify that zlib compression has been used.
       // the next 4 bytes are the original length since zlib doesn't provide
       // that to the receiver.
-      buffer[4 + cc] = (in_size & 0x0ff);
+      compressed[4 + cc] = (in_size & 0x0ff);
       in_size = in_size >> 8;
     }
+    delete[] buffer;
+    buffer = compressed;
     buffer_length = out_size + 8;
   }
-  else
-  {
-    buffer_length = writer->GetOutputStringLength();
-    buffer = writer->RegisterAndGetOutputString();
-  }
 
   // Get string.
   this->NumberOfBuffers = 1;
@@ -1018,9 +1874,6 @@ void vtkMPIMoveData::MarshalDataToBuffer(vtkDataObject* data)
   this->BufferOffsets[0] = 0;
   this->Buffers = buffer;
   this->BufferTotalLength = this->BufferLengths[0];
-
-  writer->Delete();
-  writer = nullptr;
 }
 
 //-----------------------------------------------------------------------------
@@ -1041,7 +1894,22 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
     vtkIdType bufferLength = this->BufferLengths[idx];
 
     char* realBuffer = nullptr;
-    if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
+    if (vtkMPIMoveDataLZ4::IsCompressed(bufferArray, bufferLength))
+    {
+      // sender used LZ4 compression. Decompress it.
+      vtkIdType uncompressed_length = 0;
+      vtkTimerLog::MarkStartEvent("LZ4 uncompress");
+      realBuffer = vtkMPIMoveDataLZ4::Decompress(bufferArray, bufferLength, uncompressed_length);
+      vtkTimerLog::MarkEndEvent("LZ4 uncompress");
+      if (realBuffer == nullptr)
+      {
+        vtkErrorMacro("Failed to decompress LZ4 buffer.");
+        continue;
+      }
+      bufferArray = realBuffer;
+      bufferLength = uncompressed_length;
+    }
+    else if (bufferLength > 4 && strncmp(bufferArray, "zlib", 4) == 0)
     {
       // sender used zlib compression. Decompress it.
       vtkIdType compressed_length = bufferLength - 8; // remove the zlib header.
@@ -1063,6 +1931,26 @@ void vtkMPIMoveData::ReconstructDataFromBuffer(vtkDataObject* data)
       bufferLength = uncompressed_length;
     }
 
+    if (vtkMPIMoveDataRaw::IsRaw(bufferArray, bufferLength))
+    {
+      vtkTimerLog::MarkStartEvent("Raw unmarshal");
+      auto output = vtkMPIMoveDataRaw::Unmarshal(bufferArray, bufferLength);
+      vtkTimerLog::MarkEndEvent("Raw unmarshal");
+      if (output)
+      {
+        // reconstructing data distributted on MPI node, so global ids are valid
+        unsetGlobalIdsAttribute(output);
+        pieces.push_back(output);
+      }
+      else
+      {
+        vtkErrorMacro("Failed to read raw buffer. The sender may use a different byte order or "
+                      "vtkIdType size.");
+      }
+      delete[] realBuffer;
+      continue;
+    }
+
     // Setup a reader.
     vtkDataReader* reader = vtkGenericDataObjectReader::New();
     reader->ReadFromInputStringOn();
@@ -113,6 +113,29 @@ public:
   static bool GetUseZLibCompression();
   //@}
 
+  //@{
+  /**
+   * When set to true, LZ4 compression is used. LZ4 is much faster than zlib
+   * at a lower compression ratio, and takes precedence over zlib when both
+   * are enabled. False by default. Like zlib, this value only has an effect on
+   * the data-sender processes.
+   */
+  static void SetUseLZ4Compression(bool b);
+  static bool GetUseLZ4Compression();
+  //@}
+
+  //@{
+  /**
+   * When set to true, datasets are marshalled using a raw binary format that
+   * copies the arrays straight from memory instead of going through
+   * vtkGenericDataObjectWriter. Data types the raw format does not support
+   * (e.g. AMR datasets, tables and graphs) always use the legacy format. True
+   * by default. The receiver detects the format used by the sender.
+   */
+  static void SetUseRawFormat(bool b);
+  static bool GetUseRawFormat();
+  //@}
+
   /**
    * vtkMPIMoveData doesn't necessarily generate a valid output data on all the
    * involved processes (depending on the MoveMode and Server ivars). This
@@ -197,6 +220,8 @@ private:
   void operator=(const vtkMPIMoveData&) = delete;
 
   static bool UseZLibCompression;
+  static bool UseLZ4Compression;
+  static bool UseRawFormat;
 };
 
 #endif
@@ -40,11 +40,14 @@
 #include "vtkHierarchicalBoxDataSet.h"
 #include "vtkHyperTreeGrid.h"
 #include "vtkHyperTreeGridGeometry.h"
+#include "vtkIdList.h"
+#include "vtkIdTypeArray.h"
 #include "vtkImageData.h"
 #include "vtkInformation.h"
 #include "vtkInformationIntegerVectorKey.h"
 #include "vtkInformationVector.h"
 #include "vtkMath.h"
+#include "vtkMatrix3x3.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiPieceDataSet.h"
 #include "vtkMultiProcessController.h"
@@ -52,6 +55,7 @@
 #include "vtkObjectFactory.h"
 #include "vtkOutlineSource.h"
 #include "vtkPVRecoverGeometryWireframe.h"
+#include "vtkPVSMPToolsInternal.h"
 #include "vtkPVTrivialProducer.h"
 #include "vtkPartitionedDataSetCollection.h"
 #include "vtkPointData.h"
@@ -59,6 +63,7 @@
 #include "vtkPolygon.h"
 #include "vtkRectilinearGrid.h"
 #include "vtkRectilinearGridOutlineFilter.h"
+#include "vtkSMPThreadLocal.h"
 #include "vtkSelectionNode.h"
 #include "vtkSmartPointer.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
@@ -76,9 +81,12 @@
 #include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <cstring>
+#include <iterator>
 #include <map>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 template <typename T>
@@ -96,6 +104,7 @@ void GetValidWholeExtent(T* ds, const int wholeExt[6], int validWholeExt[6])
 
 vtkStandardNewMacro(vtkPVGeometryFilter);
 vtkCxxSetObjectMacro(vtkPVGeometryFilter, Controller, vtkMultiProcessController);
+
 vtkInformationKeyMacro(vtkPVGeometryFilter, POINT_OFFSETS, IntegerVector);
 vtkInformationKeyMacro(vtkPVGeometryFilter, VERTS_OFFSETS, IntegerVector);
 vtkInformationKeyMacro(vtkPVGeometryFilter, LINES_OFFSETS, IntegerVector);
@@ -151,6 +160,494 @@ public:
   int Commutative() override { return 1; }
 };
 
+//----------------------------------------------------------------------------
+// Cache of the surfaces extracted for the leaves of a composite dataset, keyed
+// by the flat index of the leaf.
+class vtkPVGeometryFilter::vtkBlockCache
+{
+public:
+  // Identifies the state of the parts of a dataset that affect extraction.
+  // Objects are compared by address and modification time, which is enough
+  // to detect a change since modification times are never reused.
+  struct vtkSignature
+  {
+    std::vector<std::pair<const void*, vtkMTimeType>> Objects;
+    std::vector<double> Values;
+    std::vector<std::string> Names;
+
+    void Add(vtkObject* obj)
+    {
+      this->Objects.emplace_back(obj, obj ? obj->GetMTime() : vtkMTimeType(0));
+    }
+
+    template <typename T>
+    void Add(const T* values, int count)
+    {
+      this->Values.insert(this->Values.end(), values, values + count);
+    }
+
+    bool operator==(const vtkSignature& other) const
+    {
+      return this->Objects == other.Objects && this->Values == other.Values &&
+        this->Names == other.Names;
+    }
+    bool operator!=(const vtkSignature& other) const { return !(*this == other); }
+  };
+
+  // Names of the attribute arrays in the input and of the arrays the
+  // extraction generated, e.g. vtkOriginalPointIds or cellNormals.
+  struct vtkArrayNames
+  {
+    std::vector<std::string> Input;
+    std::set<std::string> Generated;
+  };
+
+  struct vtkEntry
+  {
+    vtkSignature Geometry;
+    vtkSignature Attributes;
+    vtkSmartPointer<vtkPolyData> Surface;
+    int OutlineFlag = 0;
+    bool Remappable = false;
+    vtkArrayNames PointArrays;
+    vtkArrayNames CellArrays;
+    bool Visited = false;
+  };
+
+  std::map<unsigned int, vtkEntry> Entries;
+  std::vector<double> Settings;
+
+  //----------------------------------------------------------------------------
+  // Discards the cache when any setting that affects extraction has changed
+  // since the last execution.
+  void Initialize(vtkPVGeometryFilter* self, const int* wholeExtent)
+  {
+    std::vector<double> settings = { static_cast<double>(self->GetMTime()),
+      static_cast<double>(self->UseOutline), static_cast<double>(self->UseStrips),
+      static_cast<double>(self->GenerateCellNormals), static_cast<double>(self->Triangulate),
+      static_cast<double>(self->NonlinearSubdivisionLevel),
+      static_cast<double>(self->PassThroughCellIds),
+      static_cast<double>(self->PassThroughPointIds),
+      static_cast<double>(self->GenerateProcessIds),
+      static_cast<double>(self->GenerateFeatureEdges) };
+    if (wholeExtent)
+    {
+      settings.insert(settings.end(), wholeExtent, wholeExtent + 6);
+    }
+    if (settings != this->Settings)
+    {
+      this->Entries.clear();
+      this->Settings = std::move(settings);
+    }
+    for (auto& item : this->Entries)
+    {
+      item.second.Visited = false;
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Drops entries for leaves that are no longer present in the input.
+  void Prune()
+  {
+    for (auto iter = this->Entries.begin(); iter != this->Entries.end();)
+    {
+      iter = iter->second.Visited ? std::next(iter) : this->Entries.erase(iter);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  static bool GetGeometrySignature(vtkDataObject* dobj, vtkSignature& signature)
+  {
+    auto ds = vtkDataSet::SafeDownCast(dobj);
+    if (!ds)
+    {
+      return false;
+    }
+    signature.Names.emplace_back(ds->GetClassName());
+    if (auto ug = vtkUnstructuredGrid::SafeDownCast(ds))
+    {
+      signature.Add(ug->GetPoints());
+      signature.Add(ug->GetCells());
+      signature.Add(ug->GetCellTypesArray());
+      signature.Add(ug->GetFaces());
+      signature.Add(ug->GetFaceLocations());
+    }
+    else if (auto pd = vtkPolyData::SafeDownCast(ds))
+    {
+      signature.Add(pd->GetPoints());
+      signature.Add(pd->GetVerts());
+      signature.Add(pd->GetLines());
+      signature.Add(pd->GetPolys());
+      signature.Add(pd->GetStrips());
+    }
+    else if (auto sg = vtkStructuredGrid::SafeDownCast(ds))
+    {
+      signature.Add(sg->GetExtent(), 6);
+      signature.Add(sg->GetPoints());
+    }
+    else if (auto rg = vtkRectilinearGrid::SafeDownCast(ds))
+    {
+      signature.Add(rg->GetExtent(), 6);
+      signature.Add(rg->GetXCoordinates());
+      signature.Add(rg->GetYCoordinates());
+      signature.Add(rg->GetZCoordinates());
+    }
+    else if (auto id = vtkImageData::SafeDownCast(ds))
+    {
+      signature.Add(id->GetExtent(), 6);
+      signature.Add(id->GetOrigin(), 3);
+      signature.Add(id->GetSpacing(), 3);
+      signature.Add(id->GetDirectionMatrix()->GetData(), 9);
+    }
+    else if (auto esg = vtkExplicitStructuredGrid::SafeDownCast(ds))
+    {
+      signature.Add(esg->GetExtent(), 6);
+      signature.Add(esg->GetPoints());
+      signature.Add(esg->GetCells());
+    }
+    else
+    {
+      // other types, such as mapped unstructured grids, are always extracted.
+      return false;
+    }
+
+    // ghost arrays decide which cells and faces are skipped.
+    signature.Add(ds->GetPointData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
+    signature.Add(ds->GetCellData()->GetArray(vtkDataSetAttributes::GhostArrayName()));
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  static void AddAttributesSignature(vtkFieldData* fd, vtkSignature& signature)
+  {
+    const int numArrays = fd ? fd->GetNumberOfArrays() : 0;
+    signature.Values.push_back(numArrays);
+    for (int cc = 0; cc < numArrays; ++cc)
+    {
+      auto array = fd->GetAbstractArray(cc);
+      signature.Add(array);
+      signature.Names.emplace_back(array->GetName() ? array->GetName() : "");
+    }
+    if (auto dsa = vtkDataSetAttributes::SafeDownCast(fd))
+    {
+      int indices[vtkDataSetAttributes::NUM_ATTRIBUTES];
+      dsa->GetAttributeIndices(indices);
+      signature.Add(indices, vtkDataSetAttributes::NUM_ATTRIBUTES);
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  static vtkSignature GetAttributesSignature(vtkDataSet* ds)
+  {
+    vtkSignature signature;
+    vtkBlockCache::AddAttributesSignature(ds->GetPointData(), signature);
+    vtkBlockCache::AddAttributesSignature(ds->GetCellData(), signature);
+    vtkBlockCache::AddAttributesSignature(ds->GetFieldData(), signature);
+    return signature;
+  }
+
+  //----------------------------------------------------------------------------
+  // Collects the sorted names of the input arrays. Returns false if any array is
+  // unnamed or clashes with the ids array, since such arrays cannot be mapped.
+  static bool GetInputArrayNames(
+    vtkDataSetAttributes* inAttrs, const char* idsName, std::vector<std::string>& names)
+  {
+    for (int cc = 0, max = inAttrs->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      const char* name = inAttrs->GetAbstractArray(cc)->GetName();
+      if (name == nullptr || strcmp(name, idsName) == 0)
+      {
+        return false;
+      }
+      names.emplace_back(name);
+    }
+    std::sort(names.begin(), names.end());
+    return true;
+  }
+
+  //----------------------------------------------------------------------------
+  // Collects the array names for one attribute type. Returns false if the
+  // attributes cannot be mapped from the input, e.g. if the ids array is
+  // missing or refers to interpolated tuples.
+  static bool GetArrayNames(vtkDataSetAttributes* inAttrs, vtkDataSetAttributes* outAttrs,
+    const char* idsName, vtkIdType numInputTuples, vtkArrayNames& names)
+  {
+    if (!vtkBlockCache::GetInputArrayNames(inAttrs, idsName, names.Input))
+    {
+      return false;
+    }
+    for (int cc = 0, max = outAttrs->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      const char* name = outAttrs->GetAbstractArray(cc)->GetName();
+      if (name == nullptr)
+      {
+        return false;
+      }
+      if (!std::binary_search(names.Input.begin(), names.Input.end(), name))
+      {
+        names.Generated.insert(name);
+      }
+    }
+
+    auto ids = vtkIdTypeArray::SafeDownCast(outAttrs->GetArray(idsName));
+    if (ids == nullptr || ids->GetNumberOfComponents() != 1)
+    {
+      return false;
+    }
+    const vtkIdType* begin = ids->GetPointer(0);
+    const vtkIdType* end = begin + ids->GetNumberOfTuples();
+    return std::all_of(
+      begin, end, [numInputTuples](vtkIdType id) { return id >= 0 && id < numInputTuples; });
+  }
+
+  //----------------------------------------------------------------------------
+  // Builds the attributes for the cached surface by copying the input tuples
+  // referred to by the ids array. Arrays generated by the extraction are
+  // reused from the cached surface.
+  static void RemapAttributes(vtkDataSetAttributes* inAttrs, vtkDataSetAttributes* cachedAttrs,
+    const char* idsName, const vtkArrayNames& names, vtkDataSetAttributes* outAttrs)
+  {
+    auto ids = vtkIdTypeArray::SafeDownCast(cachedAttrs->GetArray(idsName));
+    const vtkIdType numTuples = ids->GetNumberOfTuples();
+    vtkNew<vtkIdList> srcIds;
+    srcIds->SetNumberOfIds(numTuples);
+    vtkNew<vtkIdList> dstIds;
+    dstIds->SetNumberOfIds(numTuples);
+    for (vtkIdType cc = 0; cc < numTuples; ++cc)
+    {
+      srcIds->SetId(cc, ids->GetValue(cc));
+      dstIds->SetId(cc, cc);
+    }
+
+    outAttrs->Initialize();
+    for (int cc = 0, max = cachedAttrs->GetNumberOfArrays(); cc < max; ++cc)
+    {
+      vtkAbstractArray* cachedArray = cachedAttrs->GetAbstractArray(cc);
+      const char* name = cachedArray->GetName();
+      if (names.Generated.find(name) != names.Generated.end())
+      {
+        outAttrs->AddArray(cachedArray);
+      }
+      else if (vtkAbstractArray* inArray = inAttrs->GetAbstractArray(name))
+      {
+        auto array = vtkSmartPointer<vtkAbstractArray>::Take(inArray->NewInstance());
+        array->SetName(name);
+        array->SetNumberOfComponents(inArray->GetNumberOfComponents());
+        array->CopyComponentNames(inArray);
+        array->InsertTuples(dstIds, srcIds, inArray);
+        outAttrs->AddArray(array);
+      }
+    }
+
+    for (int attr = 0; attr < vtkDataSetAttributes::NUM_ATTRIBUTES; ++attr)
+    {
+      vtkAbstractArray* active = cachedAttrs->GetAbstractAttribute(attr);
+      if (active == nullptr || active->GetName() == nullptr)
+      {
+        active = inAttrs->GetAbstractAttribute(attr);
+      }
+      if (active && active->GetName() && outAttrs->GetAbstractArray(active->GetName()))
+      {
+        outAttrs->SetActiveAttribute(active->GetName(), attr);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  // Fills `output` from the cache. Returns MISS if the block needs to be
+  // extracted. Only the entry for `index` is modified, so leaves with distinct
+  // indices can be restored concurrently.
+  enum
+  {
+    MISS = 0,
+    REUSED,
+    REMAPPED
+  };
+  int Restore(unsigned int index, vtkDataObject* block, vtkPolyData* output, int& outlineFlag)
+  {
+    auto iter = this->Entries.find(index);
+    if (iter == this->Entries.end())
+    {
+      return MISS;
+    }
+    vtkEntry& entry = iter->second;
+    vtkSignature geometry;
+    if (!vtkBlockCache::GetGeometrySignature(block, geometry) || geometry != entry.Geometry)
+    {
+      return MISS;
+    }
+
+    auto ds = vtkDataSet::SafeDownCast(block);
+    vtkSignature attributes = vtkBlockCache::GetAttributesSignature(ds);
+    int status = REUSED;
+    if (attributes == entry.Attributes)
+    {
+      output->ShallowCopy(entry.Surface);
+    }
+    else
+    {
+      if (!entry.Remappable)
+      {
+        return MISS;
+      }
+
+      std::vector<std::string> pointArrays, cellArrays;
+      if (!vtkBlockCache::GetInputArrayNames(
+            ds->GetPointData(), "vtkOriginalPointIds", pointArrays) ||
+        !vtkBlockCache::GetInputArrayNames(ds->GetCellData(), "vtkOriginalCellIds", cellArrays) ||
+        pointArrays != entry.PointArrays.Input || cellArrays != entry.CellArrays.Input)
+      {
+        // arrays were added, removed or renamed.
+        return MISS;
+      }
+
+      output->ShallowCopy(entry.Surface);
+      vtkBlockCache::RemapAttributes(ds->GetPointData(), entry.Surface->GetPointData(),
+        "vtkOriginalPointIds", entry.PointArrays, output->GetPointData());
+      vtkBlockCache::RemapAttributes(ds->GetCellData(), entry.Surface->GetCellData(),
+        "vtkOriginalCellIds", entry.CellArrays, output->GetCellData());
+      vtkNew<vtkFieldData> fieldData;
+      fieldData->PassData(ds->GetFieldData());
+      output->SetFieldData(fieldData);
+
+      // keep the remapped surface for the next execution.
+      entry.Attributes = std::move(attributes);
+      entry.Surface = vtkSmartPointer<vtkPolyData>::New();
+      entry.Surface->ShallowCopy(output);
+      status = REMAPPED;
+    }
+    outlineFlag = entry.OutlineFlag;
+    entry.Visited = true;
+    return status;
+  }
+
+  //----------------------------------------------------------------------------
+  // Saves the surface extracted for a block.
+  void Store(unsigned int index, vtkDataObject* block, vtkPolyData* surface, int outlineFlag)
+  {
+    vtkEntry entry;
+    if (!vtkBlockCache::GetGeometrySignature(block, entry.Geometry))
+    {
+      this->Entries.erase(index);
+      return;
+    }
+    auto ds = vtkDataSet::SafeDownCast(block);
+    entry.Attributes = vtkBlockCache::GetAttributesSignature(ds);
+    entry.Surface = vtkSmartPointer<vtkPolyData>::New();
+    entry.Surface->ShallowCopy(surface);
+    entry.OutlineFlag = outlineFlag;
+    entry.Remappable =
+      vtkBlockCache::GetArrayNames(ds->GetPointData(), surface->GetPointData(),
+        "vtkOriginalPointIds", ds->GetNumberOfPoints(), entry.PointArrays) &&
+      vtkBlockCache::GetArrayNames(ds->GetCellData(), surface->GetCellData(), "vtkOriginalCellIds",
+        ds->GetNumberOfCells(), entry.CellArrays);
+    entry.Visited = true;
+    this->Entries[index] = std::move(entry);
+  }
+};
+
+//----------------------------------------------------------------------------
+// Extracts the surfaces for the leaves of a non-AMR composite dataset. When the
+// leaves are processed concurrently, each thread uses its own
+// vtkPVGeometryFilter configured like the filter being executed since the
+// internal filters used for the extraction cannot be shared between threads.
+class vtkPVGeometryFilter::vtkLeavesWorker
+{
+public:
+  struct vtkLeaf
+  {
+    unsigned int Index = 0;
+    vtkDataObject* Block = nullptr;
+    vtkSmartPointer<vtkPolyData> Output;
+    // the surface to save in the block cache, if it was extracted.
+    vtkSmartPointer<vtkPolyData> Extracted;
+    int Status = vtkBlockCache::MISS;
+    int OutlineFlag = 0;
+  };
+
+  vtkPVGeometryFilter* Self;
+  std::vector<vtkLeaf>& Leaves;
+  const int* WholeExtent;
+  vtkSMPThreadLocal<vtkSmartPointer<vtkPVGeometryFilter>> Filters;
+
+  vtkLeavesWorker(vtkPVGeometryFilter* self, std::vector<vtkLeaf>& leaves, const int* wholeExtent)
+    : Self(self)
+    , Leaves(leaves)
+    , WholeExtent(wholeExtent)
+  {
+  }
+
+  //----------------------------------------------------------------------------
+  // Processes the leaves in [begin, end) using `filter` to extract surfaces.
+  void Execute(vtkPVGeometryFilter* filter, vtkIdType begin, vtkIdType end)
+  {
+    vtkPVGeometryFilter* self = this->Self;
+    for (vtkIdType cc = begin; cc < end; ++cc)
+    {
+      vtkLeaf& leaf = this->Leaves[cc];
+      leaf.Output = vtkSmartPointer<vtkPolyData>::New();
+      if (self->UseBlockCache)
+      {
+        leaf.Status =
+          self->BlockCache->Restore(leaf.Index, leaf.Block, leaf.Output, leaf.OutlineFlag);
+      }
+      if (leaf.Status == vtkBlockCache::MISS)
+      {
+        filter->ExecuteBlock(leaf.Block, leaf.Output, 0, 0, 1, 0, this->WholeExtent);
+        filter->CleanupOutputData(leaf.Output, 0);
+        leaf.OutlineFlag = filter->OutlineFlag;
+        if (self->UseBlockCache)
+        {
+          leaf.Extracted = vtkSmartPointer<vtkPolyData>::New();
+          leaf.Extracted->ShallowCopy(leaf.Output);
+        }
+      }
+      if (leaf.Output->GetNumberOfPoints() > 0)
+      {
+        filter->AddCompositeIndex(leaf.Output, leaf.Index);
+      }
+    }
+  }
+
+  //----------------------------------------------------------------------------
+  void operator()(vtkIdType begin, vtkIdType end)
+  {
+    vtkSmartPointer<vtkPVGeometryFilter>& filter = this->Filters.Local();
+    if (!filter)
+    {
+      filter = this->NewFilter();
+    }
+    this->Execute(filter, begin, end);
+  }
+
+private:
+  //----------------------------------------------------------------------------
+  vtkSmartPointer<vtkPVGeometryFilter> NewFilter() const
+  {
+    vtkPVGeometryFilter* self = this->Self;
+    auto filter = vtkSmartPointer<vtkPVGeometryFilter>::New();
+    filter->SetController(self->Controller);
+    filter->SetUseOutline(self->UseOutline);
+    filter->SetGenerateFeatureEdges(self->GenerateFeatureEdges);
+    filter->SetUseStrips(self->UseStrips);
+    filter->SetGenerateCellNormals(self->GenerateCellNormals);
+    filter->SetTriangulate(self->Triangulate);
+    filter->SetNonlinearSubdivisionLevel(self->NonlinearSubdivisionLevel);
+    filter->SetPassThroughCellIds(self->PassThroughCellIds);
+    filter->SetPassThroughPointIds(self->PassThroughPointIds);
+    filter->SetGenerateProcessIds(self->GenerateProcessIds);
+    filter->SetUseBlockCache(false);
+
+    // the vtkPVGeometryFilter constructor does not forward the default id
+    // settings to the internal surface filter, mirror its actual state.
+    filter->DataSetSurfaceFilter->SetPassThroughCellIds(
+      self->DataSetSurfaceFilter->GetPassThroughCellIds());
+    filter->DataSetSurfaceFilter->SetPassThroughPointIds(
+      self->DataSetSurfaceFilter->GetPassThroughPointIds());
+    return filter;
+  }
+};
+
 //----------------------------------------------------------------------------
 vtkPVGeometryFilter::vtkPVGeometryFilter()
 {
@@ -199,6 +696,13 @@ vtkPVGeometryFilter::vtkPVGeometryFilter()
 
   this->HideInternalAMRFaces = true;
   this->UseNonOverlappingAMRMetaDataForOutlines = true;
+
+  this->UseBlockCache = true;
+  this->NumberOfThreads = 0;
+  this->NumberOfExtractedBlocks = 0;
+  this->NumberOfReusedBlocks = 0;
+  this->NumberOfRemappedBlocks = 0;
+  this->BlockCache = new vtkBlockCache();
 }
 
 //----------------------------------------------------------------------------
@@ -236,6 +740,7 @@ vtkPVGeometryFilter::~vtkPVGeometryFilter()
   }
   this->OutlineSource->Delete();
   this->SetController(nullptr);
+  delete this->BlockCache;
 }
 
 //----------------------------------------------------------------------------
@@ -961,45 +1466,102 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
   inIter->VisitOnlyLeavesOn();
   inIter->SkipEmptyNodesOn();
 
-  // get a block count for progress scaling.
-  unsigned int totNumBlocks = 0;
+  // collect the leaves first so that their surfaces can be extracted
+  // concurrently. Leaves that are not vtkDataSet and leaves that appear more
+  // than once in the tree are rare, extract the surfaces serially for those.
+  std::vector<vtkLeavesWorker::vtkLeaf> leaves;
+  std::set<vtkDataObject*> blocks;
+  bool concurrent = this->NumberOfThreads != 1;
   for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
   {
-    ++totNumBlocks;
+    vtkDataObject* block = inIter->GetCurrentDataObject();
+    if (!block)
+    {
+      continue;
+    }
+    vtkLeavesWorker::vtkLeaf leaf;
+    leaf.Index = inIter->GetCurrentFlatIndex();
+    leaf.Block = block;
+    leaves.push_back(std::move(leaf));
+    concurrent = concurrent && vtkDataSet::SafeDownCast(block) && blocks.insert(block).second;
   }
+  const unsigned int totNumBlocks = static_cast<unsigned int>(leaves.size());
 
   int* wholeExtent =
     vtkStreamingDemandDrivenPipeline::GetWholeExtent(inputVector[0]->GetInformationObject(0));
-  int numInputs = 0;
-  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  this->NumberOfExtractedBlocks = 0;
+  this->NumberOfReusedBlocks = 0;
+  this->NumberOfRemappedBlocks = 0;
+  if (this->UseBlockCache)
   {
-    vtkDataObject* block = inIter->GetCurrentDataObject();
-    if (!block)
+    this->BlockCache->Initialize(this, wholeExtent);
+  }
+  else
+  {
+    this->BlockCache->Entries.clear();
+  }
+
+  vtkLeavesWorker worker(this, leaves, wholeExtent);
+  if (concurrent && totNumBlocks > 1)
+  {
+    // datasets compute their bounds lazily and cache them, compute them now so
+    // that the concurrent extraction only reads them.
+    for (const auto& leaf : leaves)
     {
-      continue;
+      vtkDataSet::SafeDownCast(leaf.Block)->GetBounds();
     }
 
-    vtkPolyData* tmpOut = vtkPolyData::New();
-    this->ExecuteBlock(block, tmpOut, 0, 0, 1, 0, wholeExtent);
-    this->CleanupOutputData(tmpOut, 0);
-    // skip empty nodes.
-    if (tmpOut->GetNumberOfPoints() > 0)
+    // the deferred garbage collection enabled in RequestData only applies to
+    // references released on the main thread, the worker threads release
+    // theirs immediately.
+    vtkPVSMPToolsInternal::For(this->NumberOfThreads, totNumBlocks, worker);
+    this->UpdateProgress(1.0);
+  }
+  else
+  {
+    for (unsigned int cc = 0; cc < totNumBlocks; ++cc)
     {
-      output->SetDataSet(inIter, tmpOut);
-      tmpOut->FastDelete();
+      worker.Execute(this, cc, cc + 1);
+      this->UpdateProgress(static_cast<float>(cc + 1) / totNumBlocks);
+    }
+  }
 
-      const unsigned int current_flat_index = inIter->GetCurrentFlatIndex();
-      this->AddCompositeIndex(tmpOut, current_flat_index);
+  // assemble the output in traversal order, identical to the order in which
+  // the leaves were collected.
+  size_t leafIdx = 0;
+  for (inIter->InitTraversal(); !inIter->IsDoneWithTraversal(); inIter->GoToNextItem())
+  {
+    if (!inIter->GetCurrentDataObject())
+    {
+      continue;
     }
-    else
+
+    vtkLeavesWorker::vtkLeaf& leaf = leaves[leafIdx++];
+    switch (leaf.Status)
     {
-      tmpOut->Delete();
-      tmpOut = nullptr;
+      case vtkBlockCache::REUSED:
+        ++this->NumberOfReusedBlocks;
+        break;
+      case vtkBlockCache::REMAPPED:
+        ++this->NumberOfRemappedBlocks;
+        break;
+      default:
+        ++this->NumberOfExtractedBlocks;
+        if (this->UseBlockCache)
+        {
+          this->BlockCache->Store(leaf.Index, leaf.Block, leaf.Extracted, leaf.OutlineFlag);
+        }
+        break;
     }
+    this->OutlineFlag = leaf.OutlineFlag;
 
-    numInputs++;
-    this->UpdateProgress(static_cast<float>(numInputs) / totNumBlocks);
+    // skip empty nodes.
+    if (leaf.Output->GetNumberOfPoints() > 0)
+    {
+      output->SetDataSet(inIter, leaf.Output);
+    }
   }
+  this->BlockCache->Prune();
   vtkTimerLog::MarkEndEvent("vtkPVGeometryFilter::ExecuteCompositeDataSet");
 
   // Merge multi-pieces to avoid efficiency setbacks since multipieces can have
@@ -1115,6 +1677,8 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
     // At this point, all ranks have consistent tree structure with leaf nodes
     // non-nullptr at exactly same locations. This is a good point to assign block
     // colors.
+    std::vector<std::pair<vtkDataObject*, unsigned int>> colored;
+    colored.reserve(totNumBlocks);
     outIter->SkipEmptyNodesOff();
     outIter->VisitOnlyLeavesOn();
     for (outIter->InitTraversal(); !outIter->IsDoneWithTraversal();
@@ -1122,9 +1686,17 @@ int vtkPVGeometryFilter::RequestDataObjectTree(
     {
       if (auto dobj = outIter->GetCurrentDataObject())
       {
-        this->AddBlockColors(dobj, block_id);
+        colored.emplace_back(dobj, block_id);
       }
     }
+    auto addBlockColors = [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end; ++cc)
+      {
+        this->AddBlockColors(colored[cc].first, colored[cc].second);
+      }
+    };
+    vtkPVSMPToolsInternal::For(this->NumberOfThreads,
+      static_cast<vtkIdType>(colored.size()), addBlockColors);
   }
 
   if (block_id > 0)
@@ -1842,6 +2414,11 @@ void vtkPVGeometryFilter::PrintSelf(ostream& os, vtkIndent indent)
 
   os << indent << "PassThroughCellIds: " << (this->PassThroughCellIds ? "On\n" : "Off\n");
   os << indent << "PassThroughPointIds: " << (this->PassThroughPointIds ? "On\n" : "Off\n");
+  os << indent << "UseBlockCache: " << this->UseBlockCache << endl;
+  os << indent << "NumberOfExtractedBlocks: " << this->NumberOfExtractedBlocks << endl;
+  os << indent << "NumberOfReusedBlocks: " << this->NumberOfReusedBlocks << endl;
+  os << indent << "NumberOfRemappedBlocks: " << this->NumberOfRemappedBlocks << endl;
+  os << indent << "NumberOfThreads: " << this->NumberOfThreads << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -207,6 +207,47 @@ public:
   vtkBooleanMacro(UseNonOverlappingAMRMetaDataForOutlines, bool);
   //@}
 
+  //@{
+  /**
+   * When set to true (default), the surfaces extracted for the leaves of a
+   * non-AMR composite dataset are cached between executions. On the next
+   * execution, a leaf whose geometry and attribute arrays are unchanged reuses
+   * the cached surface as is. If only the attribute arrays changed, the new
+   * point and cell attributes are mapped onto the cached surface using the
+   * vtkOriginalPointIds and vtkOriginalCellIds arrays instead of extracting
+   * the surface again. The geometry of a leaf is considered unchanged when its
+   * points, cells, extents and ghost arrays are the same objects with the
+   * same modification times as before.
+   */
+  vtkSetMacro(UseBlockCache, bool);
+  vtkGetMacro(UseBlockCache, bool);
+  vtkBooleanMacro(UseBlockCache, bool);
+  //@}
+
+  //@{
+  /**
+   * Statistics about the block cache for the most recent execution on a
+   * non-AMR composite dataset: the number of leaves whose surface was
+   * extracted, the number of leaves that reused the cached surface as is and
+   * the number of leaves that reused the cached surface with attributes mapped
+   * from the input.
+   */
+  vtkGetMacro(NumberOfExtractedBlocks, vtkIdType);
+  vtkGetMacro(NumberOfReusedBlocks, vtkIdType);
+  vtkGetMacro(NumberOfRemappedBlocks, vtkIdType);
+  //@}
+
+  //@{
+  /**
+   * Set the maximum number of threads used to extract the surfaces of the
+   * leaves of a non-AMR composite dataset concurrently. 0 (default) uses all
+   * the threads available to vtkSMPTools, 1 extracts the leaves serially.
+   * The output is identical irrespective of the number of threads.
+   */
+  vtkSetClampMacro(NumberOfThreads, int, 0, VTK_INT_MAX);
+  vtkGetMacro(NumberOfThreads, int);
+  //@}
+
   // These keys are put in the output composite-data metadata for multipieces
   // since this filter merges multipieces together.
   static vtkInformationIntegerVectorKey* POINT_OFFSETS();
@@ -331,6 +372,11 @@ protected:
   bool HideInternalAMRFaces;
   bool UseNonOverlappingAMRMetaDataForOutlines;
   bool GenerateFeatureEdges;
+  bool UseBlockCache;
+  int NumberOfThreads;
+  vtkIdType NumberOfExtractedBlocks;
+  vtkIdType NumberOfReusedBlocks;
+  vtkIdType NumberOfRemappedBlocks;
 
 private:
   vtkPVGeometryFilter(const vtkPVGeometryFilter&) = delete;
@@ -348,6 +394,11 @@ private:
   void AddHierarchicalIndex(vtkPolyData* pd, unsigned int level, unsigned int index);
   class BoundsReductionOperation;
   //@}
+
+  class vtkBlockCache;
+  vtkBlockCache* BlockCache;
+
+  class vtkLeavesWorker;
 };
 
 #endif
@@ -47,6 +47,9 @@
 #include "vtkMinimalStandardRandomSequence.h"
 #include "vtkMultiBlockDataSet.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
+#include "vtkPVLogger.h"
+#include "vtkTimerLog.h"
 #include "vtkUnsignedIntArray.h"
 
 #include <algorithm>
@@ -70,13 +73,16 @@ public:
   virtual void SetSelectedComponent(int newValue) = 0;
   virtual void InvalidateCache() = 0;
   virtual int Extract(
-    vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
+    vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size, bool revertOrder) = 0;
   virtual int Compute(
-    vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize, bool revertOrder) = 0;
+    vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size, bool revertOrder) = 0;
   virtual bool IsInvalid(vtkTable* input, vtkDataArray* dataToProcess) = 0;
   virtual bool IsSortable() = 0;
   virtual bool TestInternalClasses() = 0;
 
+  // Time spent building the cache, reset by the caller before each execution
+  double BuildTime = 0.0;
+
   // --------------------------------------------------------------------------
   //  static void WaitForGDB()
   //    {
@@ -551,11 +557,34 @@ public:
     }
   };
 
+  // Entry exchanged while building the global sorted index. Rows are ordered by
+  // value, then by process id, then by position in the local sorted array, which
+  // is a total order consistent with the local ArraySorter of every process.
+  class GlobalIndexItem
+  {
+  public:
+    T Value;
+    int ProcessId;
+    vtkIdType SortedIndex;
+
+    bool operator<(const GlobalIndexItem& other) const
+    {
+      if (this->Value != other.Value)
+      {
+        return this->Value < other.Value;
+      }
+      if (this->ProcessId != other.ProcessId)
+      {
+        return this->ProcessId < other.ProcessId;
+      }
+      return this->SortedIndex < other.SortedIndex;
+    }
+  };
+
   Internals()
   {
     // Only used for testing
     this->LocalSorter = nullptr;
-    this->GlobalHistogram = nullptr;
     this->Debug = false;
   }
 
@@ -565,6 +594,7 @@ public:
     this->SelectedComponent = 0;
     this->NeedToBuildCache = true;
     this->DataToSort = dataToSort;
+    this->TotalNumberOfRows = 0;
 
     this->InputMTime = input->GetMTime();
 
@@ -580,14 +610,9 @@ public:
 
     // Create internal objects
     this->LocalSorter = new ArraySorter();
-    this->GlobalHistogram = new Histogram(HISTOGRAM_SIZE);
   }
 
-  ~Internals() override
-  {
-    delete this->LocalSorter;
-    delete this->GlobalHistogram;
-  }
+  ~Internals() override { delete this->LocalSorter; }
 
   // --------------------------------------------------------------------------
   bool IsSortable() override
@@ -653,13 +678,14 @@ public:
   }
 
   // --------------------------------------------------------------------------
-  int BuildCache(bool sortableArray, bool invertOrder)
+  int BuildCache(bool sortableArray)
   {
     // We are building the cache so no need to build it next time
     this->NeedToBuildCache = false;
 
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
+    vtkNew<vtkTimerLog> timer;
+    timer->StartTimer();
+    vtkTimerLog::MarkStartEvent("Build sorted table index");
 
     // Is there something to sort ???
     if (!sortableArray)
@@ -672,47 +698,272 @@ public:
     }
     else
     {
+      // The index is always built in increasing order, the decreasing order
+      // being its exact reverse.
       if (this->DataToSort)
       {
-        // Sort and build local histogram
         this->LocalSorter->Update(static_cast<T*>(this->DataToSort->GetVoidPointer(0)),
           this->DataToSort->GetNumberOfTuples(), this->DataToSort->GetNumberOfComponents(),
-          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, invertOrder);
+          this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, false);
       }
       else
       {
-        // Build empty local histogram
         this->LocalSorter->Clear();
-        this->LocalSorter->Histo = new Histogram(HISTOGRAM_SIZE);
-        this->LocalSorter->Histo->SetScalarRange(this->CommonRange);
-        this->LocalSorter->Histo->Inverted = invertOrder;
       }
+      this->BuildGlobalIndex();
+    }
 
-      // Initialize the global histogram with same range
-      this->LocalSorter->Histo->CopyRangeTo(*this->GlobalHistogram);
+    vtkTimerLog::MarkEndEvent("Build sorted table index");
+    timer->StopTimer();
+    this->BuildTime = timer->GetElapsedTime();
+    vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "sorted table index built in %g s",
+      this->BuildTime);
+    return 1;
+  }
 
-      // Make sure that the global histogram is properly initialized
-      this->GlobalHistogram->ClearHistogramValues();
-      this->GlobalHistogram->Inverted = invertOrder;
+  // --------------------------------------------------------------------------
+  // Sample-sort the rows of all processes and keep, for each local row, its
+  // position in the global sorted order. Processes with rows regularly sample
+  // their sorted array, the samples are gathered to choose one splitter per
+  // process with rows, and each of those processes merges the rows falling
+  // between two splitters. The merged positions are then sent back to the
+  // processes owning the rows, so that any block can later be located with a
+  // local binary search.
+  void BuildGlobalIndex()
+  {
+    const vtkIdType localSize = this->LocalSorter->Array ? this->LocalSorter->ArraySize : 0;
+    const vtkIdType sampleSize =
+      std::min(localSize, static_cast<vtkIdType>(NUMBER_OF_SAMPLES_PER_PROCESS));
 
-      // Send local histogram and receive every histogram from everybody
-      this->MPI->AllGather(this->LocalSorter->Histo->Values, bufferHistogramValues, HISTOGRAM_SIZE);
+    // Gather the number of rows and the size of the samples of everyone.
+    // Sizes are exchanged in bytes as processes without the array to sort
+    // do not share the same value type.
+    vtkIdType localInfo[2] = { localSize,
+      static_cast<vtkIdType>(sampleSize * sizeof(GlobalIndexItem)) };
+    std::vector<vtkIdType> info(2 * this->NumProcs);
+    this->MPI->AllGather(localInfo, info.data(), 2);
 
-      // Merge all histogram into the GlobalHistogram
-      for (int idx = 0, nb = this->NumProcs * HISTOGRAM_SIZE; idx < nb; ++idx)
+    std::vector<int> owners;
+    std::vector<vtkIdType> sampleLengths(this->NumProcs);
+    std::vector<vtkIdType> sampleOffsets(this->NumProcs);
+    vtkIdType totalSampleLength = 0;
+    int self = -1;
+    this->TotalNumberOfRows = 0;
+    for (int pid = 0; pid < this->NumProcs; ++pid)
+    {
+      if (info[2 * pid] > 0)
       {
-        this->GlobalHistogram->TotalValues += bufferHistogramValues[idx];
-        this->GlobalHistogram->Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
+        self = (pid == this->Me) ? static_cast<int>(owners.size()) : self;
+        owners.push_back(pid);
       }
+      this->TotalNumberOfRows += info[2 * pid];
+      sampleLengths[pid] = info[2 * pid + 1];
+      sampleOffsets[pid] = totalSampleLength;
+      totalSampleLength += info[2 * pid + 1];
+    }
+    this->GlobalPositions.clear();
+    if (owners.empty())
+    {
+      return;
     }
 
-    delete[] bufferHistogramValues;
-    return 1;
+    // Regularly sample the local sorted array and share the samples
+    std::vector<GlobalIndexItem> samples(sampleSize);
+    for (vtkIdType idx = 0; idx < sampleSize; ++idx)
+    {
+      samples[idx] = this->GetGlobalIndexItem((idx * localSize) / sampleSize);
+    }
+    std::vector<char> allSamples(totalSampleLength);
+    this->MPI->AllGatherV(reinterpret_cast<const char*>(samples.data()), allSamples.data(),
+      localInfo[1], sampleLengths.data(), sampleOffsets.data());
+
+    // Split the local sorted array between the owners
+    const int numberOfOwners = static_cast<int>(owners.size());
+    std::vector<vtkIdType> bounds(numberOfOwners + 1, 0);
+    if (localSize > 0)
+    {
+      GlobalIndexItem* splitters = reinterpret_cast<GlobalIndexItem*>(allSamples.data());
+      const vtkIdType numberOfSamples = totalSampleLength / sizeof(GlobalIndexItem);
+      std::sort(splitters, splitters + numberOfSamples);
+      for (int idx = 1; idx < numberOfOwners; ++idx)
+      {
+        bounds[idx] = this->LowerBound(splitters[(idx * numberOfSamples) / numberOfOwners]);
+      }
+      bounds[numberOfOwners] = localSize;
+    }
+
+    // Share how many rows each process sends to each owner
+    std::vector<vtkIdType> sendCounts(numberOfOwners);
+    for (int idx = 0; idx < numberOfOwners; ++idx)
+    {
+      sendCounts[idx] = bounds[idx + 1] - bounds[idx];
+    }
+    std::vector<vtkIdType> counts(this->NumProcs * numberOfOwners);
+    this->MPI->AllGather(sendCounts.data(), counts.data(), numberOfOwners);
+    if (self < 0)
+    {
+      return;
+    }
+
+    // Global position of the first row merged by this owner, and location of
+    // the rows received from each owner in the merge buffer.
+    vtkIdType ownerOffset = 0;
+    std::vector<vtkIdType> runOffsets(numberOfOwners + 1, 0);
+    for (int idx = 0; idx < numberOfOwners; ++idx)
+    {
+      for (int other = 0; other < self; ++other)
+      {
+        ownerOffset += counts[owners[idx] * numberOfOwners + other];
+      }
+      runOffsets[idx + 1] = runOffsets[idx] + counts[owners[idx] * numberOfOwners + self];
+    }
+
+    // Send the rows to their owner and merge the sorted runs received
+    std::vector<GlobalIndexItem> outgoing(localSize);
+    for (vtkIdType idx = 0; idx < localSize; ++idx)
+    {
+      outgoing[idx] = this->GetGlobalIndexItem(idx);
+    }
+    std::vector<GlobalIndexItem> merged(runOffsets[numberOfOwners]);
+    std::vector<const char*> sendData(numberOfOwners);
+    std::vector<vtkIdType> sendLengths(numberOfOwners);
+    std::vector<char*> recvData(numberOfOwners);
+    std::vector<vtkIdType> recvLengths(numberOfOwners);
+    for (int idx = 0; idx < numberOfOwners; ++idx)
+    {
+      sendData[idx] = reinterpret_cast<const char*>(outgoing.data() + bounds[idx]);
+      sendLengths[idx] = sendCounts[idx] * sizeof(GlobalIndexItem);
+      recvData[idx] = reinterpret_cast<char*>(merged.data() + runOffsets[idx]);
+      recvLengths[idx] = (runOffsets[idx + 1] - runOffsets[idx]) * sizeof(GlobalIndexItem);
+    }
+    this->ExchangeWithOwners(
+      owners, self, sendData, sendLengths, recvData, recvLengths, VTK_INDEX_EXCHANGE_TAG);
+    std::vector<GlobalIndexItem>().swap(outgoing);
+
+    for (int width = 1; width < numberOfOwners; width *= 2)
+    {
+      for (int idx = 0; idx + width < numberOfOwners; idx += 2 * width)
+      {
+        std::inplace_merge(merged.begin() + runOffsets[idx],
+          merged.begin() + runOffsets[idx + width],
+          merged.begin() + runOffsets[std::min(idx + 2 * width, numberOfOwners)]);
+      }
+    }
+
+    // Send back the global position of every row to the process owning it.
+    // Rows of a given process keep their relative order while merging.
+    std::vector<int> ownerIndices(this->NumProcs, -1);
+    for (int idx = 0; idx < numberOfOwners; ++idx)
+    {
+      ownerIndices[owners[idx]] = idx;
+    }
+    std::vector<vtkIdType> positions(merged.size());
+    std::vector<vtkIdType> cursors(runOffsets.begin(), runOffsets.end() - 1);
+    for (size_t idx = 0; idx < merged.size(); ++idx)
+    {
+      positions[cursors[ownerIndices[merged[idx].ProcessId]]++] =
+        ownerOffset + static_cast<vtkIdType>(idx);
+    }
+    std::vector<GlobalIndexItem>().swap(merged);
+
+    this->GlobalPositions.resize(localSize);
+    for (int idx = 0; idx < numberOfOwners; ++idx)
+    {
+      sendData[idx] = reinterpret_cast<const char*>(positions.data() + runOffsets[idx]);
+      sendLengths[idx] = (runOffsets[idx + 1] - runOffsets[idx]) * sizeof(vtkIdType);
+      recvData[idx] = reinterpret_cast<char*>(this->GlobalPositions.data() + bounds[idx]);
+      recvLengths[idx] = sendCounts[idx] * sizeof(vtkIdType);
+    }
+    this->ExchangeWithOwners(
+      owners, self, sendData, sendLengths, recvData, recvLengths, VTK_POSITION_EXCHANGE_TAG);
+  }
+
+  // --------------------------------------------------------------------------
+  GlobalIndexItem GetGlobalIndexItem(vtkIdType sortedIndex) const
+  {
+    GlobalIndexItem item;
+    item.Value = this->LocalSorter->Array[sortedIndex].Value;
+    item.ProcessId = this->Me;
+    item.SortedIndex = sortedIndex;
+    return item;
+  }
+
+  // --------------------------------------------------------------------------
+  // Index of the first local sorted row that is not before the given item
+  vtkIdType LowerBound(const GlobalIndexItem& item) const
+  {
+    vtkIdType first = 0;
+    vtkIdType count = this->LocalSorter->ArraySize;
+    while (count > 0)
+    {
+      const vtkIdType step = count / 2;
+      if (this->GetGlobalIndexItem(first + step) < item)
+      {
+        first += step + 1;
+        count -= step + 1;
+      }
+      else
+      {
+        count = step;
+      }
+    }
+    return first;
+  }
+
+  // --------------------------------------------------------------------------
+  // Exchange one buffer with every other owner: sendData[idx] is sent to
+  // owners[idx] and recvData[idx] is received from it. Owners are paired with
+  // a round-robin schedule so that each round only involves disjoint pairs.
+  void ExchangeWithOwners(const std::vector<int>& owners, int self,
+    const std::vector<const char*>& sendData, const std::vector<vtkIdType>& sendLengths,
+    const std::vector<char*>& recvData, const std::vector<vtkIdType>& recvLengths, int tag)
+  {
+    std::copy(sendData[self], sendData[self] + sendLengths[self], recvData[self]);
+
+    const int count = static_cast<int>(owners.size());
+    const int size = count + (count % 2);
+    for (int round = 0; round < size - 1; ++round)
+    {
+      int other;
+      if (self == size - 1)
+      {
+        other = round;
+      }
+      else if (self == round)
+      {
+        other = size - 1;
+      }
+      else
+      {
+        other = ((2 * round - self) % (size - 1) + (size - 1)) % (size - 1);
+      }
+      if (other >= count)
+      {
+        continue;
+      }
+
+      // The lower process id sends first
+      const bool sendFirst = this->Me < owners[other];
+      for (int step = 0; step < 2; ++step)
+      {
+        if ((step == 0) == sendFirst)
+        {
+          if (sendLengths[other] > 0)
+          {
+            this->MPI->Send(sendData[other], sendLengths[other], owners[other], tag);
+          }
+        }
+        else if (recvLengths[other] > 0)
+        {
+          this->MPI->Receive(recvData[other], recvLengths[other], owners[other], tag);
+        }
+      }
+    }
   }
 
   // --------------------------------------------------------------------------
   // The sorting is based on processId and the current order
-  int Extract(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
+  int Extract(vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size,
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
@@ -722,12 +973,12 @@ public:
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
-      this->BuildCache(false, revertOrder);
+      this->BuildCache(false);
     }
 
     // Build empty local table with empty arrays so they stay in the same order
     vtkSmartPointer<vtkTable> localResult;
-    localResult.TakeReference(NewSubsetTable(input, nullptr, 0, blockSize));
+    localResult.TakeReference(NewSubsetTable(input, nullptr, 0, size));
 
     // Get the array size of each processes
     vtkIdType* tableSizes = new vtkIdType[this->NumProcs];
@@ -735,7 +986,7 @@ public:
     this->MPI->AllGather(&nbElems, tableSizes, 1);
 
     // Get local idx based on the global one
-    vtkIdType localOffset = block * blockSize;
+    vtkIdType localOffset = offset;
     if (revertOrder)
     {
       for (int i = this->NumProcs - 1; this->Me < i; i--)
@@ -752,11 +1003,11 @@ public:
     }
 
     // Extract the subset
-    vtkIdType localSize = vtkMath::Min(tableSizes[this->Me], blockSize);
+    vtkIdType localSize = vtkMath::Min(tableSizes[this->Me], size);
     if (localOffset < 0)
     {
       localSize = vtkMath::Max(static_cast<vtkIdType>(0),
-        vtkMath::Min(localOffset + vtkMath::Max(tableSizes[this->Me], blockSize), blockSize));
+        vtkMath::Min(localOffset + vtkMath::Max(tableSizes[this->Me], size), size));
       localOffset = 0;
     }
     else if (localOffset >= tableSizes[this->Me])
@@ -791,7 +1042,7 @@ public:
         vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
         processIdArray->SetName("vtkOriginalProcessIds");
         processIdArray->SetNumberOfComponents(1);
-        processIdArray->Allocate(blockSize);
+        processIdArray->Allocate(size);
         vtkIdType processId = this->Me;
         for (vtkIdType idx = 0; idx < localResult->GetNumberOfRows(); idx++)
         {
@@ -808,7 +1059,7 @@ public:
           continue;
 
         this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localResult.GetPointer(), blockSize);
+        this->MergeTable(i, tmp.GetPointer(), localResult.GetPointer(), size);
       }
 
       // Sort new table/array
@@ -845,43 +1096,35 @@ public:
     return 1;
   }
   // --------------------------------------------------------------------------
-  int Compute(vtkTable* input, vtkTable* output, vtkIdType block, vtkIdType blockSize,
+  int Compute(vtkTable* input, vtkTable* output, vtkIdType offset, vtkIdType size,
     bool revertOrder) override
   {
     // ------------------------------------------------------------------------
-    // Make sure that the Cache is built
-    //    This will sort the local array, that's why we don't want to do it
-    //    at each execution. Specially when we only change the requested block.
+    // Make sure that the global index is built
+    //    This will sort the local array and exchange it with every process,
+    //    that's why we don't want to do it at each execution. The index is
+    //    then reused for every block, in both orders.
     // ------------------------------------------------------------------------
     if (this->NeedToBuildCache)
     {
-      this->BuildCache(true, revertOrder);
+      this->BuildCache(true);
     }
 
     // ------------------------------------------------------------------------
-    // Search for lower bound
-    // ------------------------------------------------------------------------
-    vtkIdType nbElementsToRemoveFromHead = 0;
-    vtkIdType localOffset = 0;
-    vtkIdType nbElementsInBar = 0;
-    this->SearchGlobalIndexLocation((block * blockSize), this->LocalSorter->Histo,
-      this->GlobalHistogram, nbElementsToRemoveFromHead, localOffset, nbElementsInBar);
-
+    // Locate the block in the global index, in increasing order
     // ------------------------------------------------------------------------
-    // Search for upper bound
-    // ------------------------------------------------------------------------
-    vtkIdType upperOffset = 0;
-    vtkIdType globalUpperOffset = 0;
-    vtkIdType searchIdx = (this->GlobalHistogram->TotalValues < (block + 1) * blockSize)
-      ? this->GlobalHistogram->TotalValues
-      : ((block + 1) * blockSize);
-    searchIdx--; // It is not a size it is an index (so -1)
-
-    this->SearchGlobalIndexLocation(searchIdx, this->LocalSorter->Histo, this->GlobalHistogram,
-      globalUpperOffset, upperOffset, nbElementsInBar);
-
-    // We have to include our searched index (so +1)
-    vtkIdType localSize = (upperOffset + nbElementsInBar) - localOffset + 1;
+    const vtkIdType total = this->TotalNumberOfRows;
+    const vtkIdType first = std::min(offset, total);
+    const vtkIdType last = std::min(first + size, total);
+    const vtkIdType lower = revertOrder ? (total - last) : first;
+    const vtkIdType upper = revertOrder ? (total - first) : last;
+
+    const auto positionsBegin = this->GlobalPositions.begin();
+    const auto positionsEnd = this->GlobalPositions.end();
+    const vtkIdType localOffset =
+      std::lower_bound(positionsBegin, positionsEnd, lower) - positionsBegin;
+    const vtkIdType localSize =
+      (std::lower_bound(positionsBegin, positionsEnd, upper) - positionsBegin) - localOffset;
 
     // ------------------------------------------------------------------------
     // Build local subset table
@@ -890,6 +1133,13 @@ public:
     localSubset.TakeReference(
       this->NewSubsetTable(input, this->LocalSorter, localOffset, localSize));
 
+    vtkNew<vtkIdTypeArray> positionArray;
+    positionArray->SetName("vtkSortedGlobalIndices");
+    positionArray->SetNumberOfTuples(localSize);
+    std::copy(positionsBegin + localOffset, positionsBegin + localOffset + localSize,
+      positionArray->GetPointer(0));
+    localSubset->GetRowData()->AddArray(positionArray);
+
     // ------------------------------------------------------------------------
     // Find the process that will merge all subset table
     // ------------------------------------------------------------------------
@@ -903,7 +1153,7 @@ public:
       vtkSmartPointer<vtkIdTypeArray> processIdArray = vtkSmartPointer<vtkIdTypeArray>::New();
       processIdArray->SetName("vtkOriginalProcessIds");
       processIdArray->SetNumberOfComponents(1);
-      processIdArray->Allocate((blockSize < localSize) ? localSize : blockSize);
+      processIdArray->Allocate((size < localSize) ? localSize : size);
       for (vtkIdType idx = 0; idx < localSubset->GetNumberOfRows(); idx++)
       {
         processIdArray->InsertNextTuple1(mergePid);
@@ -931,32 +1181,20 @@ public:
           continue;
 
         this->MPI->Receive(tmp.GetPointer(), i, VTK_TABLE_EXCHANGE_TAG);
-        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), blockSize);
-      }
-
-      // Sort new table/array
-      if (!this->DataToSort)
-      {
-        // This mean that no output can be provided
-        // cout << "ERROR the merge process have no DataArray." << endl;
-        return 1;
+        this->MergeTable(i, tmp.GetPointer(), localSubset.GetPointer(), size);
       }
-      vtkDataArray* subsetArray =
-        vtkDataArray::SafeDownCast(localSubset->GetColumnByName(this->DataToSort->GetName()));
 
-      if (!subsetArray)
+      // Put every row at its place in the block using its global position
+      vtkIdTypeArray* mergedPositions =
+        vtkIdTypeArray::SafeDownCast(localSubset->GetColumnByName("vtkSortedGlobalIndices"));
+      std::vector<vtkIdType> rows(mergedPositions->GetNumberOfTuples());
+      for (vtkIdType idx = 0; idx < mergedPositions->GetNumberOfTuples(); ++idx)
       {
-        vtkSortedTableStreamer::PrintInfo(localSubset.GetPointer());
+        const vtkIdType position = mergedPositions->GetValue(idx);
+        rows[revertOrder ? (upper - 1 - position) : (position - lower)] = idx;
       }
-
-      ArraySorter sorter;
-      sorter.Update(static_cast<T*>(subsetArray->GetVoidPointer(0)),
-        subsetArray->GetNumberOfTuples(), subsetArray->GetNumberOfComponents(),
-        this->SelectedComponent, HISTOGRAM_SIZE, this->CommonRange, revertOrder);
-
-      // trim it (remove head and tail that don't belong to the result)
-      localSubset.TakeReference(this->NewSubsetTable(
-        localSubset.GetPointer(), &sorter, nbElementsToRemoveFromHead, blockSize));
+      localSubset->RemoveColumnByName("vtkSortedGlobalIndices");
+      localSubset.TakeReference(this->NewPermutedTable(localSubset.GetPointer(), rows));
 
       // Add extra information such as structured indices, block number...
       this->DecorateTable(input, localSubset.GetPointer(), mergePid);
@@ -973,73 +1211,6 @@ public:
     return 1;
   }
 
-  // --------------------------------------------------------------------------
-  // nbGlobalToSkip is the number of elements that should be skipped at the end
-  // if you exactly want to reach the searchedGlobalIndex.
-  // localOffset is the corresponding local index in the sorted table to the
-  // global index of (searchedGlobalIndex - nbGlobalToSkip)
-  // nbInLocalBar is the local number of elements that are available
-  // in the histogram bar where the searchedGlobalIndex has been found.
-  // nbInLocalBar is used when you want to get an upper bound that
-  // will include the searchedGlobalIndex.
-  void SearchGlobalIndexLocation(vtkIdType searchedGlobalIndex, Histogram* localHistogram,
-    Histogram* globalHistogram, vtkIdType& nbGlobalToSkip, vtkIdType& localOffset,
-    vtkIdType& nbInLocalBar)
-  {
-    // Communication buffer
-    vtkIdType* bufferHistogramValues = new vtkIdType[this->NumProcs * HISTOGRAM_SIZE];
-
-    // Local internal working var
-    vtkIdType histogramBarIdx = -1;
-    double currentRange[2];
-    vtkIdType idx, idxEnd;
-
-    // Setup initial histogram range and values
-    Histogram _globalHistogram;
-    Histogram _localHistogram;
-    localHistogram->CopyTo(_localHistogram);
-    globalHistogram->CopyTo(_globalHistogram);
-
-    // Reset local offsets
-    localOffset = 0;
-    nbGlobalToSkip = searchedGlobalIndex;
-
-    do
-    {
-      nbGlobalToSkip -= _globalHistogram.GetNewRange(nbGlobalToSkip, histogramBarIdx, currentRange);
-
-      localOffset += _localHistogram.GetNumberOfElements(0, histogramBarIdx);
-      nbInLocalBar = _localHistogram.GetNumberOfElements(histogramBarIdx, histogramBarIdx + 1);
-
-      // Based on a narrowed range, build local histogram to get closer to the
-      // real index of the object
-      _localHistogram.SetScalarRange(currentRange);
-      _localHistogram.ClearHistogramValues();
-
-      idxEnd = localOffset + nbInLocalBar;
-      for (idx = localOffset; idx < idxEnd; ++idx)
-      {
-        _localHistogram.AddValue(this->LocalSorter->Array[idx].Value);
-      }
-
-      // Exchange local histo with everyone
-      this->MPI->AllGather(_localHistogram.Values, bufferHistogramValues, HISTOGRAM_SIZE);
-
-      // Build global histogram
-      _globalHistogram.SetScalarRange(currentRange);
-      _globalHistogram.ClearHistogramValues();
-
-      idxEnd = this->NumProcs * HISTOGRAM_SIZE;
-      for (idx = 0; idx < idxEnd; ++idx)
-      {
-        _globalHistogram.TotalValues += bufferHistogramValues[idx];
-        _globalHistogram.Values[idx % HISTOGRAM_SIZE] += bufferHistogramValues[idx];
-      }
-    } while (nbGlobalToSkip > 0 && _globalHistogram.CanBeReduced());
-
-    delete[] bufferHistogramValues;
-  }
-
   // --------------------------------------------------------------------------
   static vtkTable* NewSubsetTable(
     vtkTable* srcTable, ArraySorter* sorter, vtkIdType offset, vtkIdType size)
@@ -1092,6 +1263,32 @@ public:
     return subTable;
   }
 
+  // --------------------------------------------------------------------------
+  static vtkTable* NewPermutedTable(vtkTable* srcTable, const std::vector<vtkIdType>& rows)
+  {
+    vtkTable* permutedTable = vtkTable::New();
+    const vtkIdType numberOfRows = static_cast<vtkIdType>(rows.size());
+    for (vtkIdType colIdx = 0; colIdx < srcTable->GetNumberOfColumns(); ++colIdx)
+    {
+      vtkAbstractArray* srcArray = srcTable->GetColumn(colIdx);
+      vtkAbstractArray* dstArray = srcArray->NewInstance();
+      dstArray->SetNumberOfComponents(srcArray->GetNumberOfComponents());
+      dstArray->SetName(srcArray->GetName());
+      dstArray->SetNumberOfTuples(numberOfRows);
+      if (auto sinfo = srcArray->GetInformation())
+      {
+        dstArray->CopyInformation(sinfo);
+      }
+      for (vtkIdType idx = 0; idx < numberOfRows; ++idx)
+      {
+        dstArray->SetTuple(idx, rows[idx], srcArray);
+      }
+      permutedTable->GetRowData()->AddArray(dstArray);
+      dstArray->FastDelete();
+    }
+    return permutedTable;
+  }
+
   // --------------------------------------------------------------------------
   void SetSelectedComponent(int newValue) override
   {
@@ -1315,16 +1512,21 @@ private:
   vtkMTimeType DataMTime;     // Keep the original data MTime
   vtkDataArray* DataToSort;   // DataArray to sort
   ArraySorter* LocalSorter;   // Local ArraySorter based on global range
-  Histogram* GlobalHistogram; // Globaly merged Histogram based on global range
   double CommonRange[2];      // Scalar range used across processes
   int Me;                     // Current process ID
   int NumProcs;               // Number of processes involved
   vtkCommunicator* MPI;       // MPI communicator to send/receive/gather
   int SelectedComponent;      // Component used to sort array
+  vtkIdType TotalNumberOfRows; // Number of rows across processes
+
+  // Global sorted position of each row of the LocalSorter, in increasing order
+  std::vector<vtkIdType> GlobalPositions;
   bool NeedToBuildCache;
   bool Debug;
 
   const static int VTK_TABLE_EXCHANGE_TAG = 50;
+  const static int VTK_INDEX_EXCHANGE_TAG = 51;
+  const static int VTK_POSITION_EXCHANGE_TAG = 52;
   // HISTOGRAM_SIZE could be computed dynamically based on the type of the
   // array to sort but to make sure that unsigned char won't be distributed
   // correctly we set the histogram size to be their max number of element
@@ -1332,6 +1534,9 @@ private:
   // Maybe make some test on huge cluster to see which histogram size is
   // the best.
   const static int HISTOGRAM_SIZE = 256;
+
+  // Number of rows each process samples to choose the sample-sort splitters
+  const static int NUMBER_OF_SAMPLES_PER_PROCESS = 256;
 };
 //****************************************************************************
 vtkStandardNewMacro(vtkSortedTableStreamer);
@@ -1346,8 +1551,11 @@ vtkSortedTableStreamer::vtkSortedTableStreamer()
   this->SetColumnToSort("");
   this->Block = 0;
   this->BlockSize = 1024;
+  this->NumberOfBlocks = 1;
   this->Internal = nullptr;
   this->SelectedComponent = 0;
+  this->IndexBuildTime = 0.0;
+  this->BlockFetchTime = 0.0;
   this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
@@ -1531,7 +1739,6 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   vtkDataArray* arrayToProcess = this->GetDataArrayToProcess(input);
 
   const bool orderInverted = this->InvertOrder > 0;
-
   // --------------------------------------------------------------------------
   // Caution: Because this filter can be used behind a cell/point extractor
   // based on a selection, the input can be empty and arrayToProcess can be nullptr.
@@ -1553,15 +1760,29 @@ int vtkSortedTableStreamer::RequestData(vtkInformation* vtkNotUsed(request),
   this->Internal->SetSelectedComponent(realComponent);
 
   // Manage custom case where sorting occur on a virtual array (process id)
+  vtkNew<vtkTimerLog> timer;
+  timer->StartTimer();
+  this->Internal->BuildTime = 0.0;
+  const vtkIdType offset = this->Block * this->BlockSize;
+  const vtkIdType size = this->BlockSize * this->NumberOfBlocks;
   if (!this->Internal->IsSortable() ||
     (this->GetColumnToSort() && (strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) == 0)))
   {
-    this->Internal->Extract(input, output, this->Block, this->BlockSize, orderInverted);
+    this->Internal->Extract(input, output, offset, size, orderInverted);
   }
   else
   {
-    this->Internal->Compute(input, output, this->Block, this->BlockSize, orderInverted);
+    this->Internal->Compute(input, output, offset, size, orderInverted);
   }
+  timer->StopTimer();
+
+  if (this->Internal->BuildTime > 0.0)
+  {
+    this->IndexBuildTime = this->Internal->BuildTime;
+  }
+  this->BlockFetchTime = timer->GetElapsedTime() - this->Internal->BuildTime;
+  vtkVLogF(PARAVIEW_LOG_DATA_MOVEMENT_VERBOSITY(), "%d block(s) from %lld fetched in %g s",
+    this->NumberOfBlocks, static_cast<long long>(this->Block), this->BlockFetchTime);
 
   if (auto names = input->GetFieldData()->GetAbstractArray("vtkBlockNames"))
   {
@@ -1576,6 +1797,9 @@ void vtkSortedTableStreamer::PrintSelf(ostream& os, vtkIndent indent)
   this->Superclass::PrintSelf(os, indent);
   os << indent << "Sorting column: " << (this->ColumnToSort ? this->ColumnToSort : "(none)")
      << endl;
+  os << indent << "NumberOfBlocks: " << this->NumberOfBlocks << endl;
+  os << indent << "IndexBuildTime: " << this->IndexBuildTime << endl;
+  os << indent << "BlockFetchTime: " << this->BlockFetchTime << endl;
 }
 
 //----------------------------------------------------------------------------
@@ -1599,16 +1823,9 @@ void vtkSortedTableStreamer::SetColumnNameToSort(const char* columnName)
 //----------------------------------------------------------------------------
 void vtkSortedTableStreamer::SetInvertOrder(int newValue)
 {
-  bool changed = this->InvertOrder != newValue;
-  bool removeInternal = changed && strcmp("vtkOriginalProcessIds", this->GetColumnToSort()) != 0;
-
-  if (removeInternal && this->Internal)
-  {
-    delete this->Internal;
-    this->Internal = nullptr;
-  }
-
-  if (changed)
+  // The sorted index is shared by both orders, so there is nothing to
+  // invalidate here.
+  if (this->InvertOrder != newValue)
   {
     this->InvertOrder = newValue;
     this->Modified();
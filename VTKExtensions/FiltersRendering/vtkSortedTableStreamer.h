@@ -20,6 +20,11 @@
  * This filter is used quickly get a sorted subset of a given vtkTable.
  * By sorted we mean a subset build from a global sort even if some optimisation
  * allow us to skip a global table sorting.
+ *
+ * The first execution after a change of the column to sort sample-sorts the
+ * rows across processes and keeps the global position of every local row.
+ * Blocks are then located locally and gathered on a single process, in either
+ * order, without any further sorting.
  */
 
 #ifndef vtkSortedTableStreamer_h
@@ -80,6 +85,17 @@ public:
   vtkSetMacro(BlockSize, vtkIdType);
   //@}
 
+  //@{
+  /**
+   * Number of consecutive blocks, starting at Block, to extract in a single
+   * execution. The output then holds up to NumberOfBlocks * BlockSize rows,
+   * which lets a client fetch neighbouring blocks in one round trip.
+   * Default value is 1.
+   */
+  vtkGetMacro(NumberOfBlocks, int);
+  vtkSetClampMacro(NumberOfBlocks, int, 1, VTK_INT_MAX);
+  //@}
+
   //@{
   /**
    * Choose on which column the sort operation should occur
@@ -108,6 +124,17 @@ public:
   void SetInvertOrder(int newValue);
   vtkGetMacro(InvertOrder, int);
 
+  //@{
+  /**
+   * Time in seconds spent building the global sorted index the last time it
+   * was built, and spent fetching the last block, excluding that build. The
+   * index is built once per column to sort and component, and is shared by
+   * both orders.
+   */
+  vtkGetMacro(IndexBuildTime, double);
+  vtkGetMacro(BlockFetchTime, double);
+  //@}
+
 protected:
   vtkSortedTableStreamer();
   ~vtkSortedTableStreamer() override;
@@ -127,11 +154,14 @@ protected:
 
   vtkIdType Block;
   vtkIdType BlockSize;
+  int NumberOfBlocks;
   vtkMultiProcessController* Controller;
 
   char* ColumnToSort;
   int SelectedComponent;
   int InvertOrder;
+  double IndexBuildTime;
+  double BlockFetchTime;
 
 private:
   vtkSortedTableStreamer(const vtkSortedTableStreamer&) = delete;
@@ -19,9 +19,110 @@
 #include "vtkSquirtCompressor.h"
 #include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
 #include "vtkUnsignedCharArray.h"
 #include <algorithm>
 #include <sstream>
+#include <vector>
+
+namespace
+{
+// Number of pixels encoded by a single task.
+const int vtkSquirtCompressorTileSize = 64 * 1024;
+
+//-----------------------------------------------------------------------------
+// Run length encodes RGBA pixels [index, end_index) into
+// _rawCompressedBuffer, returning the number of words written.
+int vtkSquirtCompressorEncodeRGBA(const unsigned int* _rawColorBuffer, int index, int end_index,
+  unsigned int compress_mask, unsigned int* _rawCompressedBuffer)
+{
+  int count = 0;
+  int comp_index = 0;
+  unsigned int current_color;
+
+  // Go through color buffer and put RLE format into compressed buffer
+  while (index < end_index)
+  {
+    // Record color
+    current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
+    unsigned char opacity = *(((unsigned char*)&current_color) + 3);
+    index++;
+
+    // Compute Run
+    while ((index < end_index) && (count < 0x0F) &&
+      ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
+    {
+      index++;
+      count++;
+    }
+    if (opacity > 0)
+    {
+      opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
+      opacity = opacity << 4;
+      count |= opacity;
+    }
+
+    // Record Run length
+    *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
+    comp_index++;
+
+    count = 0;
+  }
+  return comp_index;
+}
+
+//-----------------------------------------------------------------------------
+// Run length encodes RGB pixels [first, last) into _rawCompressedBuffer,
+// returning the number of words written.
+int vtkSquirtCompressorEncodeRGB(const unsigned char* _rawColorBuffer, int first, int last,
+  unsigned int compress_mask, unsigned int* _rawCompressedBuffer)
+{
+  int count = 0;
+  int comp_index = 0;
+  int index = 3 * first;
+  const int end_index = 3 * last;
+  unsigned int current_color;
+  unsigned int next_color;
+
+  // Go through color buffer and put RLE format into compressed buffer
+  while (index < end_index)
+  {
+    // Record color
+    unsigned char* p = (unsigned char*)&current_color;
+    *p++ = _rawColorBuffer[index];
+    *p++ = _rawColorBuffer[index + 1];
+    *p++ = _rawColorBuffer[index + 2];
+    *p = 0x0;
+
+    _rawCompressedBuffer[comp_index] = current_color;
+    index += 3;
+
+    // Compute Run
+    while ((index < end_index) && (count < 255))
+    {
+      p = (unsigned char*)&next_color;
+      *p++ = _rawColorBuffer[index];
+      *p++ = _rawColorBuffer[index + 1];
+      *p++ = _rawColorBuffer[index + 2];
+      *p = 0x0;
+      if ((current_color & compress_mask) != (next_color & compress_mask))
+      {
+        break;
+      }
+      index += 3;
+      count++;
+    }
+
+    // Record Run length
+    reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
+      static_cast<unsigned char>(count);
+    comp_index++;
+
+    count = 0;
+  }
+  return comp_index;
+}
+}
 
 vtkStandardNewMacro(vtkSquirtCompressor);
 
@@ -51,12 +152,7 @@ int vtkSquirtCompressor::Compress()
     return VTK_ERROR;
   }
 
-  int count = 0;
-  int index = 0;
-  int comp_index = 0;
-  int end_index;
   int compress_level = this->LossLessMode ? 0 : this->SquirtLevel;
-  unsigned int current_color;
   unsigned char compress_masks[6][4] = { { 0xFF, 0xFF, 0xFF, 0xFF }, { 0xFE, 0xFF, 0xFE, 0xFE },
     { 0xFC, 0xFE, 0xFC, 0xFC }, { 0xF8, 0xFC, 0xF8, 0xF8 }, { 0xF0, 0xF8, 0xF0, 0xF0 },
     { 0xE0, 0xF0, 0xE0, 0xE0 } };
@@ -73,98 +169,39 @@ int vtkSquirtCompressor::Compress()
   memcpy(&compress_mask, &compress_masks[compress_level], 4);
 
   // Access raw arrays directly
-  if (input->GetNumberOfComponents() == 4)
-  {
-    unsigned int* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned int*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < end_index) && (comp_index < end_index))
+  const int numComponents = input->GetNumberOfComponents();
+  const int numPixels = input->GetNumberOfTuples();
+  const unsigned char* rawColorBuffer = input->GetPointer(0);
+  unsigned int* rawCompressedBuffer =
+    reinterpret_cast<unsigned int*>(this->Output->WritePointer(0, numPixels * 4));
+
+  // Encode tiles of the image in parallel. A run never produces more words
+  // than pixels, so each tile is encoded in place at its pixel offset and the
+  // tiles are packed afterwards. Runs simply break at tile boundaries, which
+  // keeps the compressed stream readable by the decompressors.
+  const int numTiles =
+    std::max(1, (numPixels + vtkSquirtCompressorTileSize - 1) / vtkSquirtCompressorTileSize);
+  std::vector<int> tileWords(numTiles, 0);
+  vtkSMPTools::For(0, numTiles, [&](int begin, int end) {
+    for (int tile = begin; tile < end; ++tile)
     {
-
-      // Record color
-      current_color = _rawCompressedBuffer[comp_index] = _rawColorBuffer[index];
-      unsigned char opacity = *(((unsigned char*)&current_color) + 3);
-      index++;
-
-      // Compute Run
-      while ((index < end_index) && (count < 0x0F) &&
-        ((current_color & compress_mask) == (_rawColorBuffer[index] & compress_mask)))
-      {
-        index++;
-        count++;
-      }
-      if (opacity > 0)
-      {
-        opacity /= 16; // since we want to encode 8-bit opacity into 4 bits.
-        opacity = opacity << 4;
-        count |= opacity;
-      }
-
-      // Record Run length
-      *((unsigned char*)_rawCompressedBuffer + comp_index * 4 + 3) = (unsigned char)count;
-      comp_index++;
-
-      count = 0;
+      const int first = tile * vtkSquirtCompressorTileSize;
+      const int last = std::min(numPixels, first + vtkSquirtCompressorTileSize);
+      tileWords[tile] = numComponents == 4
+        ? vtkSquirtCompressorEncodeRGBA(reinterpret_cast<const unsigned int*>(rawColorBuffer),
+            first, last, compress_mask, rawCompressedBuffer + first)
+        : vtkSquirtCompressorEncodeRGB(
+            rawColorBuffer, first, last, compress_mask, rawCompressedBuffer + first);
     }
-  }
-  else if (input->GetNumberOfComponents() == 3)
-  {
-    unsigned char* _rawColorBuffer;
-    unsigned int* _rawCompressedBuffer;
-    int numPixels = input->GetNumberOfTuples();
-    _rawColorBuffer = (unsigned char*)input->GetPointer(0);
-    _rawCompressedBuffer = (unsigned int*)this->Output->WritePointer(0, numPixels * 4);
-    end_index = numPixels;
-
-    // Go through color buffer and put RLE format into compressed buffer
-    while ((index < 3 * numPixels) && (comp_index < end_index))
-    {
+  });
 
-      int next_color = 0;
-      // Record color
-      unsigned char* p = (unsigned char*)&current_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      _rawCompressedBuffer[comp_index] = current_color;
-      index += 3;
-
-      p = (unsigned char*)&next_color;
-      *p++ = _rawColorBuffer[index];
-      *p++ = _rawColorBuffer[index + 1];
-      *p++ = _rawColorBuffer[index + 2];
-      *p = 0x0;
-
-      // Compute Run
-      while (((current_color & compress_mask) == (next_color & compress_mask)) &&
-        (index < 3 * numPixels) && (count < 255))
-      {
-        index += 3;
-        count++;
-        if (index < 3 * numPixels)
-        {
-          p = (unsigned char*)&next_color;
-          *p++ = _rawColorBuffer[index];
-          *p++ = _rawColorBuffer[index + 1];
-          *p++ = _rawColorBuffer[index + 2];
-          *p = 0x0;
-        }
-      }
-
-      // Record Run length
-      reinterpret_cast<unsigned char*>(_rawCompressedBuffer)[comp_index * 4 + 3] =
-        static_cast<unsigned char>(count);
-      comp_index++;
-
-      count = 0;
-    }
+  int comp_index = tileWords[0];
+  for (int tile = 1; tile < numTiles; ++tile)
+  {
+    memmove(rawCompressedBuffer + comp_index,
+      rawCompressedBuffer + tile * vtkSquirtCompressorTileSize,
+      tileWords[tile] * sizeof(unsigned int));
+    comp_index += tileWords[tile];
   }
 
   // Back to vtk arrays :)
@@ -34,6 +34,8 @@
 #include "vtkInformationVector.h"
 #include "vtkLogger.h"
 #include "vtkMath.h"
+#include "vtkMultiProcessController.h"
+#include "vtkMultiProcessStream.h"
 #include "vtkObjectFactory.h"
 #include "vtkStreamingDemandDrivenPipeline.h"
 #include "vtkStringArray.h"
@@ -48,6 +50,7 @@
 #include <algorithm>
 #include <cctype> // for isprint().
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -59,6 +62,7 @@ vtkStandardNewMacro(vtkFileSeriesReader);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_NUMBER_OF_FILES, Integer);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_CURRENT_FILE_NUMBER, Integer);
 vtkInformationKeyMacro(vtkFileSeriesReader, FILE_SERIES_FIRST_FILENAME, String);
+vtkCxxSetObjectMacro(vtkFileSeriesReader, Controller, vtkMultiProcessController);
 //=============================================================================
 // Internal class for holding time ranges.
 class vtkFileSeriesReaderTimeRanges
@@ -325,6 +329,271 @@ std::vector<double> vtkFileSeriesReaderTimeRanges::GetTimesForInput(
   return times;
 }
 
+//=============================================================================
+// Internal class for holding the time information of each file in the series,
+// which can be saved to and loaded from an index file. Besides the files, the
+// index records the internal reader state it was built with: the reader class,
+// the method used to set the file name and the time information of the first
+// file. The latter is read again each time the series is opened, and changes
+// when a reader option affecting time, e.g. the time array, changes.
+class vtkFileSeriesReaderIndex
+{
+public:
+  void Initialize(const std::vector<std::string>& fileNames, const std::string& readerName,
+    const std::string& fileNameMethod);
+  bool IsValid(int index) const { return this->Files[index].Valid; }
+  bool IsModified() const { return this->Modified; }
+  void Record(int index, vtkInformation* srcInfo);
+  void Fill(int index, vtkInformation* outInfo) const;
+  void Serialize(vtkMultiProcessStream& stream, bool recordedOnly = false) const;
+  void Deserialize(vtkMultiProcessStream& stream);
+  bool Load(const std::string& indexFileName, vtkInformation* firstFileInfo);
+  bool Save(const std::string& indexFileName) const;
+
+private:
+  struct FileInfo
+  {
+    std::string Name;
+    bool Valid = false;
+    // true when the information was recorded from the reader on this rank.
+    bool Recorded = false;
+    std::vector<double> TimeSteps;
+    std::vector<double> TimeRange;
+  };
+  static void GetTimeInformation(vtkInformation* srcInfo, FileInfo& file);
+  static bool ReadTimeInformation(const Json::Value& entry, FileInfo& file);
+
+  std::vector<FileInfo> Files;
+  std::string ReaderName;
+  std::string FileNameMethod;
+  bool Modified = false;
+};
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::Initialize(const std::vector<std::string>& fileNames,
+  const std::string& readerName, const std::string& fileNameMethod)
+{
+  this->ReaderName = readerName;
+  this->FileNameMethod = fileNameMethod;
+  this->Files.clear();
+  this->Files.resize(fileNames.size());
+  for (size_t cc = 0; cc < fileNames.size(); ++cc)
+  {
+    this->Files[cc].Name = fileNames[cc];
+  }
+  this->Modified = false;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::Record(int index, vtkInformation* srcInfo)
+{
+  FileInfo& file = this->Files[index];
+  vtkFileSeriesReaderIndex::GetTimeInformation(srcInfo, file);
+  this->Modified |= !file.Valid;
+  file.Valid = true;
+  file.Recorded = true;
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::GetTimeInformation(vtkInformation* srcInfo, FileInfo& file)
+{
+  file.TimeSteps.clear();
+  file.TimeRange.clear();
+  if (srcInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_STEPS()))
+  {
+    const double* timeSteps = srcInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+    file.TimeSteps.assign(
+      timeSteps, timeSteps + srcInfo->Length(vtkStreamingDemandDrivenPipeline::TIME_STEPS()));
+  }
+  if (srcInfo->Has(vtkStreamingDemandDrivenPipeline::TIME_RANGE()))
+  {
+    const double* timeRange = srcInfo->Get(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+    file.TimeRange.assign(timeRange, timeRange + 2);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::Fill(int index, vtkInformation* outInfo) const
+{
+  const FileInfo& file = this->Files[index];
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_STEPS());
+  outInfo->Remove(vtkStreamingDemandDrivenPipeline::TIME_RANGE());
+  if (!file.TimeSteps.empty())
+  {
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_STEPS(), file.TimeSteps.data(),
+      static_cast<int>(file.TimeSteps.size()));
+  }
+  if (file.TimeRange.size() == 2)
+  {
+    outInfo->Set(vtkStreamingDemandDrivenPipeline::TIME_RANGE(), file.TimeRange.data(), 2);
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::Serialize(vtkMultiProcessStream& stream, bool recordedOnly) const
+{
+  auto include = [recordedOnly](const FileInfo& file) {
+    return recordedOnly ? file.Recorded : file.Valid;
+  };
+  stream << static_cast<int>(std::count_if(this->Files.begin(), this->Files.end(), include));
+  for (size_t cc = 0; cc < this->Files.size(); ++cc)
+  {
+    const FileInfo& file = this->Files[cc];
+    if (include(file))
+    {
+      stream << static_cast<int>(cc) << static_cast<int>(file.TimeSteps.size());
+      for (double value : file.TimeSteps)
+      {
+        stream << value;
+      }
+      stream << static_cast<int>(file.TimeRange.size());
+      for (double value : file.TimeRange)
+      {
+        stream << value;
+      }
+    }
+  }
+}
+
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReaderIndex::Deserialize(vtkMultiProcessStream& stream)
+{
+  int count;
+  stream >> count;
+  for (int cc = 0; cc < count; ++cc)
+  {
+    int index, size;
+    stream >> index >> size;
+    FileInfo& file = this->Files[index];
+    file.TimeSteps.resize(size);
+    for (double& value : file.TimeSteps)
+    {
+      stream >> value;
+    }
+    stream >> size;
+    file.TimeRange.resize(size);
+    for (double& value : file.TimeRange)
+    {
+      stream >> value;
+    }
+    this->Modified |= !file.Valid;
+    file.Valid = true;
+  }
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReaderIndex::ReadTimeInformation(const Json::Value& entry, FileInfo& file)
+{
+  file.TimeSteps.clear();
+  for (const auto& value : entry["time_steps"])
+  {
+    file.TimeSteps.push_back(value.asDouble());
+  }
+  file.TimeRange.clear();
+  for (const auto& value : entry["time_range"])
+  {
+    file.TimeRange.push_back(value.asDouble());
+  }
+  return file.TimeRange.empty() || file.TimeRange.size() == 2;
+}
+
+//-----------------------------------------------------------------------------
+// Loads the time information of the files that are unchanged since the index
+// was saved. The whole index is ignored when it was built with another reader
+// state, detected by comparing the time information recorded for the first
+// file with `firstFileInfo`, the one just reported by the reader.
+bool vtkFileSeriesReaderIndex::Load(const std::string& indexFileName, vtkInformation* firstFileInfo)
+{
+  vtksys::ifstream ifile(indexFileName.c_str());
+  if (!ifile.good())
+  {
+    return false;
+  }
+
+  Json::Value root;
+  Json::CharReaderBuilder builder;
+  builder["collectComments"] = false;
+  if (!parseFromStream(builder, ifile, &root, nullptr) || !root.isObject() ||
+    root["file-series-index-version"].asString() != "1.0" ||
+    root["reader"].asString() != this->ReaderName ||
+    root["file_name_method"].asString() != this->FileNameMethod || !root["files"].isObject())
+  {
+    vtkLogF(TRACE, "ignoring index file '%s'", indexFileName.c_str());
+    return false;
+  }
+
+  const Json::Value& files = root["files"];
+  const Json::Value& firstEntry = files[this->Files[0].Name];
+  FileInfo recorded, current;
+  vtkFileSeriesReaderIndex::GetTimeInformation(firstFileInfo, current);
+  if (!firstEntry.isObject() ||
+    !vtkFileSeriesReaderIndex::ReadTimeInformation(firstEntry, recorded) ||
+    recorded.TimeSteps != current.TimeSteps || recorded.TimeRange != current.TimeRange)
+  {
+    vtkLogF(TRACE, "ignoring index file '%s' built with another reader state",
+      indexFileName.c_str());
+    return false;
+  }
+
+  for (auto& file : this->Files)
+  {
+    const Json::Value& entry = files[file.Name];
+    if (!entry.isObject() ||
+      entry["mtime"].asInt64() !=
+        static_cast<Json::Int64>(vtksys::SystemTools::ModifiedTime(file.Name)) ||
+      entry["size"].asUInt64() !=
+        static_cast<Json::UInt64>(vtksys::SystemTools::FileLength(file.Name)))
+    {
+      continue;
+    }
+    file.Valid = vtkFileSeriesReaderIndex::ReadTimeInformation(entry, file);
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkFileSeriesReaderIndex::Save(const std::string& indexFileName) const
+{
+  Json::Value root(Json::objectValue);
+  root["file-series-index-version"] = "1.0";
+  root["reader"] = this->ReaderName;
+  root["file_name_method"] = this->FileNameMethod;
+  Json::Value& files = root["files"] = Json::Value(Json::objectValue);
+  for (const auto& file : this->Files)
+  {
+    if (!file.Valid)
+    {
+      continue;
+    }
+    Json::Value entry(Json::objectValue);
+    entry["mtime"] = static_cast<Json::Int64>(vtksys::SystemTools::ModifiedTime(file.Name));
+    entry["size"] = static_cast<Json::UInt64>(vtksys::SystemTools::FileLength(file.Name));
+    Json::Value& timeSteps = entry["time_steps"] = Json::Value(Json::arrayValue);
+    for (double value : file.TimeSteps)
+    {
+      timeSteps.append(value);
+    }
+    Json::Value& timeRange = entry["time_range"] = Json::Value(Json::arrayValue);
+    for (double value : file.TimeRange)
+    {
+      timeRange.append(value);
+    }
+    files[file.Name] = entry;
+  }
+
+  vtksys::ofstream ofile(indexFileName.c_str());
+  if (!ofile.good())
+  {
+    vtkLogF(TRACE, "cannot write index file '%s'", indexFileName.c_str());
+    return false;
+  }
+  Json::StreamWriterBuilder builder;
+  builder["indentation"] = "";
+  std::unique_ptr<Json::StreamWriter> writer(builder.newStreamWriter());
+  writer->write(root, &ofile);
+  return ofile.good();
+}
+
 namespace
 {
 // Helper class used to ensure that ProcessRequest() never results in change
@@ -388,6 +657,7 @@ struct vtkFileSeriesReaderInternals
   std::vector<double> TimeValues;
   bool FileNameIsSet;
   vtkFileSeriesReaderTimeRanges* TimeRanges;
+  vtkFileSeriesReaderIndex Index;
 };
 
 //=============================================================================
@@ -404,11 +674,18 @@ vtkFileSeriesReader::vtkFileSeriesReader()
   this->UseJsonMetaFile = false;
 
   this->IgnoreReaderTime = false;
+
+  this->UseIndexFile = false;
+  this->IndexFileName = nullptr;
+  this->Controller = nullptr;
+  this->SetController(vtkMultiProcessController::GetGlobalController());
 }
 
 //-----------------------------------------------------------------------------
 vtkFileSeriesReader::~vtkFileSeriesReader()
 {
+  this->SetIndexFileName(nullptr);
+  this->SetController(nullptr);
   delete this->Internal->TimeRanges;
   delete this->Internal;
 }
@@ -650,13 +927,15 @@ int vtkFileSeriesReader::RequestInformation(vtkInformation* request,
     this->Internal->TimeRanges->AddTimeRange(0, outInfo);
 
     // Query all the other files for time info.
-    for (unsigned int i = 1; i < numFiles; i++)
+    if (numFiles > 1)
     {
-      // Expose current file number as information key for potential use in the internal reader
-      outputVector->GetInformationObject(requestFromPort)
-        ->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), static_cast<int>(i));
-      this->RequestInformationForInput(static_cast<int>(i), request, outputVector);
-      this->Internal->TimeRanges->AddTimeRange(static_cast<int>(i), outInfo);
+      this->ScanTimeInformation(request, outputVector, requestFromPort);
+      VTK_CREATE(vtkInformation, fileInfo);
+      for (unsigned int i = 1; i < numFiles; i++)
+      {
+        this->Internal->Index.Fill(static_cast<int>(i), fileInfo);
+        this->Internal->TimeRanges->AddTimeRange(static_cast<int>(i), fileInfo);
+      }
     }
   }
 
@@ -670,6 +949,115 @@ int vtkFileSeriesReader::RequestInformation(vtkInformation* request,
   return 1;
 }
 
+//-----------------------------------------------------------------------------
+void vtkFileSeriesReader::ScanTimeInformation(
+  vtkInformation* request, vtkInformationVector* outputVector, int requestFromPort)
+{
+  vtkFileSeriesReaderIndex& index = this->Internal->Index;
+  vtkInformation* outInfo = outputVector->GetInformationObject(requestFromPort);
+  const int numFiles = static_cast<int>(this->GetNumberOfFileNames());
+  // the scan is only distributed when the index file is used, since the reader
+  // may otherwise be updated on some ranks only. UseIndexFile is the same on
+  // all ranks, so they all take the same branch.
+  const bool distributed = this->UseIndexFile && this->Controller &&
+    this->Controller->GetNumberOfProcesses() > 1;
+  const int numRanks = distributed ? this->Controller->GetNumberOfProcesses() : 1;
+  const int rank = distributed ? this->Controller->GetLocalProcessId() : 0;
+  const std::string indexFileName = this->UseIndexFile ? this->GetIndexFileNameInternal() : "";
+
+  // the first file has just been read.
+  index.Initialize(this->Internal->RealFileNames, this->Reader->GetClassName(),
+    this->FileNameMethod ? this->FileNameMethod : "");
+  if (rank == 0 && !indexFileName.empty())
+  {
+    index.Load(indexFileName, outInfo);
+  }
+  index.Record(0, outInfo);
+  if (numRanks > 1)
+  {
+    vtkMultiProcessStream stream;
+    if (rank == 0)
+    {
+      index.Serialize(stream);
+    }
+    this->Controller->Broadcast(stream, 0);
+    if (rank != 0)
+    {
+      index.Deserialize(stream);
+    }
+  }
+
+  // scan the files missing from the index, distributed among the ranks.
+  int numMissing = 0;
+  for (int i = 1; i < numFiles; i++)
+  {
+    if (!index.IsValid(i) && (numMissing++ % numRanks) == rank)
+    {
+      // Expose current file number as information key for potential use in the internal reader
+      outInfo->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), i);
+      this->RequestInformationForInput(i, request, outputVector);
+      index.Record(i, outInfo);
+    }
+  }
+  vtkLogF(TRACE, "%s: %d of %d files scanned for time information", vtkLogIdentifier(this),
+    numMissing, numFiles - 1);
+
+  if (numRanks > 1 && numMissing > 0)
+  {
+    const int tag = 20210;
+    vtkMultiProcessStream stream;
+    if (rank == 0)
+    {
+      for (int cc = 1; cc < numRanks && cc < numMissing; ++cc)
+      {
+        vtkMultiProcessStream rankStream;
+        this->Controller->Receive(rankStream, cc, tag);
+        index.Deserialize(rankStream);
+      }
+      index.Serialize(stream);
+    }
+    else if (rank < numMissing)
+    {
+      vtkMultiProcessStream rankStream;
+      index.Serialize(rankStream, true);
+      this->Controller->Send(rankStream, 0, tag);
+    }
+    this->Controller->Broadcast(stream, 0);
+    if (rank != 0)
+    {
+      index.Deserialize(stream);
+    }
+  }
+
+  if (rank == 0 && numMissing > 0 && !indexFileName.empty() && index.IsModified())
+  {
+    index.Save(indexFileName);
+  }
+
+  // leave the reader on the last file, as if every file had been read in turn.
+  if (this->_FileIndex != numFiles - 1)
+  {
+    outInfo->Set(FILE_SERIES_CURRENT_FILE_NUMBER(), numFiles - 1);
+    this->RequestInformationForInput(numFiles - 1, request, outputVector);
+  }
+}
+
+//-----------------------------------------------------------------------------
+std::string vtkFileSeriesReader::GetIndexFileNameInternal()
+{
+  if (this->IndexFileName && *this->IndexFileName)
+  {
+    return this->IndexFileName;
+  }
+
+  const std::string fname = (this->UseMetaFile || this->UseJsonMetaFile) && this->_MetaFileName
+    ? std::string(this->_MetaFileName)
+    : this->Internal->RealFileNames[0];
+  const std::string path = vtksys::SystemTools::GetFilenamePath(fname);
+  const std::string name = "." + vtksys::SystemTools::GetFilenameName(fname) + ".series-index";
+  return path.empty() ? name : path + "/" + name;
+}
+
 //----------------------------------------------------------------------------
 int vtkFileSeriesReader::RequestUpdateExtent(vtkInformation* request,
   vtkInformationVector** vtkNotUsed(inputVector), vtkInformationVector* outputVector)
@@ -987,6 +1375,10 @@ void vtkFileSeriesReader::PrintSelf(ostream& os, vtkIndent indent)
      << endl;
   os << indent << "UseMetaFile: " << this->UseMetaFile << endl;
   os << indent << "IgnoreReaderTime: " << this->IgnoreReaderTime << endl;
+  os << indent << "UseIndexFile: " << this->UseIndexFile << endl;
+  os << indent << "IndexFileName: " << (this->IndexFileName ? this->IndexFileName : "(none)")
+     << endl;
+  os << indent << "Controller: " << this->Controller << endl;
 }
 
 //-----------------------------------------------------------------------------
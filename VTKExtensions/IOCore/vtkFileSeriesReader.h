@@ -75,6 +75,14 @@
  * with SetMetaFileName in this case. Do not use the AddFileName() method when
  * using SetMetaFileName() as names set with AddFileName() will be ignored.
  *
+ * When the internal reader reports time, every file in the series has to be
+ * opened to collect its time values. To avoid scanning each time the series
+ * is opened, the time values of each file can be saved to an index file next
+ * to the series (see UseIndexFile). Files whose modification time or size
+ * changed since the index was written are scanned again. When the index file
+ * is used and running in parallel, the files that need scanning are
+ * distributed among the ranks.
+ *
 */
 
 #ifndef vtkFileSeriesReader_h
@@ -83,10 +91,12 @@
 #include "vtkMetaReader.h"
 #include "vtkPVVTKExtensionsIOCoreModule.h" //needed for exports
 
+#include <string> // Needed for protected API
 #include <vector> // Needed for protected API
 
 class vtkInformationIntegerKey;
 class vtkInformationStringKey;
+class vtkMultiProcessController;
 class vtkStringArray;
 
 struct vtkFileSeriesReaderInternals;
@@ -153,6 +163,46 @@ public:
   vtkBooleanMacro(IgnoreReaderTime, bool);
   //@}
 
+  //@{
+  /**
+   * If true, the time values reported by the internal reader for each file
+   * are saved to an index file and reused when the series is opened again, as
+   * long as the files are unchanged. Only used when the internal reader
+   * reports time and IgnoreReaderTime is false. The index records the reader
+   * class, the FileNameMethod and the time values of the first file, and is
+   * discarded when they no longer match. Options of the internal reader that
+   * change the time of some files but not the one of the first file are not
+   * detected, hence the index is disabled by default.
+   *
+   * When enabled and running in parallel, the files missing from the index are
+   * scanned by all ranks of the Controller together, so RequestInformation
+   * must then be called on all of them.
+   */
+  vtkGetMacro(UseIndexFile, bool);
+  vtkSetMacro(UseIndexFile, bool);
+  vtkBooleanMacro(UseIndexFile, bool);
+  //@}
+
+  //@{
+  /**
+   * Set the name of the index file. When not set (default), the index is
+   * saved next to the meta file, or the first file of the series, as a hidden
+   * file named `.<name>.series-index`.
+   */
+  vtkSetStringMacro(IndexFileName);
+  vtkGetStringMacro(IndexFileName);
+  //@}
+
+  //@{
+  /**
+   * Get/Set the controller used to distribute the scan of the files among
+   * ranks when UseIndexFile is true. By default,
+   * `vtkMultiProcessController::GetGlobalController` is used.
+   */
+  void SetController(vtkMultiProcessController*);
+  vtkGetObjectMacro(Controller, vtkMultiProcessController);
+  //@}
+
   // Expose number of files, first filename and current file number as
   // information keys for potential use in the internal reader
   static vtkInformationIntegerKey* FILE_SERIES_NUMBER_OF_FILES();
@@ -235,6 +285,23 @@ protected:
 
   int ChooseInput(vtkInformation*);
 
+  /**
+   * Collects the time information of the files other than the first one,
+   * using the index file when possible. Files that need scanning are
+   * distributed among ranks and the information is shared with all ranks.
+   */
+  virtual void ScanTimeInformation(
+    vtkInformation* request, vtkInformationVector* outputVector, int requestFromPort);
+
+  /**
+   * Returns the name of the index file to use.
+   */
+  std::string GetIndexFileNameInternal();
+
+  bool UseIndexFile;
+  char* IndexFileName;
+  vtkMultiProcessController* Controller;
+
 private:
   vtkFileSeriesReader(const vtkFileSeriesReader&) = delete;
   void operator=(const vtkFileSeriesReader&) = delete;
@@ -2,6 +2,7 @@
 #include "vtkMultiBlockDataSet.h"
 #include "vtkNew.h"
 #include "vtkPGenericEnSightReader.h"
+#include "vtkPoints.h"
 #include "vtkTestUtilities.h"
 #include "vtkUnstructuredGrid.h"
 
@@ -43,5 +44,31 @@ int TestPEnSightBinaryGoldReader(int argc, char* argv[])
     }
   }
 
+  // reading with memory mapping must produce the same output.
+  vtkNew<vtkPGenericEnSightReader> mappedReader;
+  mappedReader->SetCaseFileName(fname);
+  mappedReader->UseMemoryMappingOn();
+  mappedReader->Update();
+  vtkUnstructuredGrid* mappedUG =
+    vtkUnstructuredGrid::SafeDownCast(mappedReader->GetOutput()->GetBlock(0));
+  if (!mappedUG || mappedUG->GetNumberOfPoints() != ug->GetNumberOfPoints() ||
+    mappedUG->GetNumberOfCells() != ug->GetNumberOfCells())
+  {
+    std::cerr << "Memory mapped read does not match the stream read." << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (vtkIdType i = 0; i < ug->GetNumberOfPoints(); i++)
+  {
+    double p0[3], p1[3];
+    ug->GetPoint(i, p0);
+    mappedUG->GetPoint(i, p1);
+    if (p0[0] != p1[0] || p0[1] != p1[1] || p0[2] != p1[2])
+    {
+      std::cerr << "Mismatched point " << i << " with memory mapping." << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  delete[] fname;
+
   return EXIT_SUCCESS;
 }
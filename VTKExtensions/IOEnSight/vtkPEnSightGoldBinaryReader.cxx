@@ -18,7 +18,18 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/SystemTools.hxx"
 
+#ifdef _WIN32
+#include "vtksys/Encoding.hxx"
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
 #include <cctype>
+#include <istream>
+#include <streambuf>
 #include <string>
 
 vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
@@ -26,6 +37,138 @@ vtkStandardNewMacro(vtkPEnSightGoldBinaryReader);
 // This is half the precision of an int.
 #define MAXIMUM_PART_ID 65536
 
+namespace
+{
+//----------------------------------------------------------------------------
+// Read-only stream buffer over a memory mapped file. Seeking only moves the
+// read pointer and reading copies straight out of the mapping, so the many
+// small seeks and reads done by the reader never turn into system calls.
+class vtkPEnSightMappedBuffer : public std::streambuf
+{
+public:
+  ~vtkPEnSightMappedBuffer() override { this->Close(); }
+
+  bool Open(const char* filename, size_t size)
+  {
+    this->Close();
+    if (size == 0)
+    {
+      return false;
+    }
+#ifdef _WIN32
+    HANDLE file = CreateFileW(vtksys::Encoding::ToWide(filename).c_str(),
+      GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+      return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+    {
+      return false;
+    }
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, size);
+    CloseHandle(mapping);
+    if (data == nullptr)
+    {
+      return false;
+    }
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0)
+    {
+      return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED)
+    {
+      return false;
+    }
+#endif
+    this->Data = static_cast<char*>(data);
+    this->Size = size;
+    this->setg(this->Data, this->Data, this->Data + this->Size);
+    return true;
+  }
+
+  void Close()
+  {
+    if (this->Data)
+    {
+#ifdef _WIN32
+      UnmapViewOfFile(this->Data);
+#else
+      munmap(this->Data, this->Size);
+#endif
+    }
+    this->Data = nullptr;
+    this->Size = 0;
+    this->setg(nullptr, nullptr, nullptr);
+  }
+
+protected:
+  pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override
+  {
+    if (this->Data == nullptr || (which & std::ios_base::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+    off_type position = off;
+    if (dir == std::ios_base::cur)
+    {
+      position += this->gptr() - this->eback();
+    }
+    else if (dir == std::ios_base::end)
+    {
+      position += static_cast<off_type>(this->Size);
+    }
+    if (position < 0 || position > static_cast<off_type>(this->Size))
+    {
+      return pos_type(off_type(-1));
+    }
+    this->setg(this->Data, this->Data + position, this->Data + this->Size);
+    return pos_type(position);
+  }
+
+  pos_type seekpos(pos_type position, std::ios_base::openmode which) override
+  {
+    return this->seekoff(off_type(position), std::ios_base::beg, which);
+  }
+
+private:
+  char* Data = nullptr;
+  size_t Size = 0;
+};
+
+//----------------------------------------------------------------------------
+// Input stream reading a memory mapped file.
+class vtkPEnSightMappedStream : public std::istream
+{
+public:
+  vtkPEnSightMappedStream()
+    : std::istream(nullptr)
+  {
+    this->init(&this->Buffer);
+  }
+
+  bool Open(const char* filename, size_t size)
+  {
+    if (!this->Buffer.Open(filename, size))
+    {
+      this->setstate(std::ios_base::failbit);
+      return false;
+    }
+    this->clear();
+    return true;
+  }
+
+private:
+  vtkPEnSightMappedBuffer Buffer;
+};
+}
+
 //----------------------------------------------------------------------------
 vtkPEnSightGoldBinaryReader::vtkPEnSightGoldBinaryReader()
 {
@@ -77,11 +220,27 @@ int vtkPEnSightGoldBinaryReader::OpenFile(const char* filename)
     // Find out how big the file is.
     this->FileSize = (long)(fs.st_size);
 
+    if (this->UseMemoryMapping)
+    {
+      auto mapped = new vtkPEnSightMappedStream;
+      if (mapped->Open(filename, static_cast<size_t>(this->FileSize)))
+      {
+        this->IFile = mapped;
+      }
+      else
+      {
+        vtkDebugMacro(<< "Could not map " << filename << ", using a file stream instead.");
+        delete mapped;
+      }
+    }
+    if (!this->IFile)
+    {
 #ifdef _WIN32
-    this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
+      this->IFile = new vtksys::ifstream(filename, ios::in | ios::binary);
 #else
-    this->IFile = new vtksys::ifstream(filename, ios::in);
+      this->IFile = new vtksys::ifstream(filename, ios::in);
 #endif
+    }
   }
   else
   {
@@ -391,6 +550,7 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
     free(name);
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -402,6 +562,22 @@ int vtkPEnSightGoldBinaryReader::ReadGeometryFile(
   return 1;
 }
 
+//----------------------------------------------------------------------------
+void vtkPEnSightGoldBinaryReader::RecordNextTimeStepOffset(
+  const char* fileName, int timeStep, const char* line)
+{
+  if (!this->UseFileSets || !this->IFile || strncmp(line, "END TIME STEP", 13) != 0)
+  {
+    return;
+  }
+  // time step offsets are indexed from 0 while timeStep starts at 1.
+  long position = this->IFile->tellg();
+  if (position >= 0)
+  {
+    this->FileOffsets[fileName][timeStep] = position;
+  }
+}
+
 //----------------------------------------------------------------------------
 int vtkPEnSightGoldBinaryReader::CountTimeSteps()
 {
@@ -1475,6 +1651,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -1681,6 +1858,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -1840,6 +2018,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerNode(const char* fileName, const
     lineRead = this->ReadLine(line);
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -2086,6 +2265,7 @@ int vtkPEnSightGoldBinaryReader::ReadScalarsPerElement(const char* fileName,
     }
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -2332,6 +2512,7 @@ int vtkPEnSightGoldBinaryReader::ReadVectorsPerElement(const char* fileName,
     }
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -2599,6 +2780,7 @@ int vtkPEnSightGoldBinaryReader::ReadTensorsPerElement(const char* fileName,
     }
   }
 
+  this->RecordNextTimeStepOffset(fileName, timeStep, line);
   delete this->IFile;
   this->IFile = nullptr;
 
@@ -181,6 +181,14 @@ protected:
    */
   int InjectCoordinatesAtEnd(vtkUnstructuredGrid* output, long coordinatesOffset, int partId);
 
+  /**
+   * When reading file sets, records the offset of the time step following
+   * `timeStep` once the reading of `timeStep` stopped on its "END TIME STEP"
+   * line. This lets time steps read in sequence seek to their beginning
+   * directly instead of skipping over the previous time step again.
+   */
+  void RecordNextTimeStepOffset(const char* fileName, int timeStep, const char* line);
+
   /**
    * Counts the number of timesteps in the geometry file
    * This function assumes the file is already open and returns the
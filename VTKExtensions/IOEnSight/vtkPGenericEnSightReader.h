@@ -38,6 +38,19 @@ public:
   vtkTypeMacro(vtkPGenericEnSightReader, vtkGenericEnSightReader);
   void PrintSelf(ostream& os, vtkIndent indent) override;
 
+  //@{
+  /**
+   * When set, binary EnSight Gold files are memory mapped instead of being
+   * read through a file stream. This turns the many small seeks and reads done
+   * while looking for the parts owned by this process into plain memory
+   * accesses, which is much faster for large files. Falls back to a file stream
+   * if a file cannot be mapped. Off by default.
+   */
+  vtkSetMacro(UseMemoryMapping, bool);
+  vtkGetMacro(UseMemoryMapping, bool);
+  vtkBooleanMacro(UseMemoryMapping, bool);
+  //@}
+
 protected:
   vtkPGenericEnSightReader();
   ~vtkPGenericEnSightReader() override;
@@ -56,6 +69,8 @@ protected:
   int MultiProcessLocalProcessId;
   int MultiProcessNumberOfProcesses;
 
+  bool UseMemoryMapping;
+
 private:
   vtkPGenericEnSightReader(const vtkPGenericEnSightReader&) = delete;
   void operator=(const vtkPGenericEnSightReader&) = delete;
@@ -5,6 +5,8 @@
 #include "vtkFloatArray.h"
 #include "vtkIntArray.h"
 #include "vtkObjectFactory.h"
+#include "vtkSMPTools.h"
+#include "vtkSmartPointer.h"
 #include "vtkSpyPlotBlock.h"
 #include "vtkSpyPlotIStream.h"
 #include "vtkUnsignedCharArray.h"
@@ -12,7 +14,10 @@
 #include "vtksys/FStream.hxx"
 #include "vtksys/RegularExpression.hxx"
 
+#include <algorithm>
+#include <atomic>
 #include <sstream>
+#include <utility>
 #include <vector>
 
 //=============================================================================
@@ -41,6 +46,16 @@ inline ostream& operator<<(ostream& os, const vtkSpyPlotWriteString& c)
   return os;
 }
 
+// A run-length encoded plane of a field array, and where to decode it.
+struct vtkSpyPlotEncodedPlane
+{
+  size_t EncodedOffset;
+  int EncodedSize;
+  float* FloatOut;
+  unsigned char* UnsignedCharOut;
+  int Size;
+};
+
 //-----------------------------------------------------------------------------
 vtkSpyPlotUniReader::vtkSpyPlotUniReader()
 {
@@ -215,6 +230,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
   }
 
   std::vector<unsigned char> arrayBuffer;
+  std::vector<vtkSpyPlotEncodedPlane> planes;
   vtksys::ifstream ifs(this->FileName, ios::binary | ios::in);
   vtkSpyPlotIStream spis;
   spis.SetStream(&ifs);
@@ -389,7 +405,16 @@ int vtkSpyPlotUniReader::MakeCurrent()
     // vtkDebugMacro( "  Field: " << fieldCnt << " / " << dp->NumVars
     // << " [" << var->Name << "]" );
     // vtkDebugMacro( "    Jump to: " << dp->SavedVariableOffsets[fieldCnt] );
+    // The encoded planes of all blocks are read first and decoded concurrently
+    // afterwards, since decoding dominates the load time of files with many
+    // blocks.
+    // The arrays are only published in var->DataBlocks once all of them
+    // are decoded, so that a failure does not leave undecoded arrays in the
+    // cache.
     spis.Seek(dp->SavedVariableOffsets[fieldCnt]);
+    planes.clear();
+    std::vector<std::pair<int, vtkSmartPointer<vtkDataArray>>> pending;
+    size_t encodedSize = 0;
     int numBytes;
     int block;
     int actualBlockId = 0;
@@ -413,6 +438,7 @@ int vtkSpyPlotUniReader::MakeCurrent()
             floatArray = vtkFloatArray::New();
             dataArray = floatArray;
           }
+          pending.emplace_back(actualBlockId, vtkSmartPointer<vtkDataArray>::Take(dataArray));
           dataArray->SetNumberOfComponents(1);
           dataArray->SetNumberOfTuples(
             bk->GetDimension(0) * bk->GetDimension(1) * bk->GetDimension(2));
@@ -426,48 +452,70 @@ int vtkSpyPlotUniReader::MakeCurrent()
         for (zax = 0; zax < bdims[2]; ++zax)
         {
           int planeSize = bdims[0] * bdims[1];
-          if (!spis.ReadInt32s(&numBytes, 1))
+          if (!spis.ReadInt32s(&numBytes, 1) || numBytes < 0)
           {
             vtkErrorMacro("Problem reading the number of bytes");
             return 0;
           }
-          if (static_cast<int>(arrayBuffer.size()) < numBytes)
-          {
-            arrayBuffer.resize(numBytes);
-          }
-          if (!spis.ReadString(&*arrayBuffer.begin(), numBytes))
+          if (!dataArray)
           {
-            vtkErrorMacro("Problem reading the bytes");
-            return 0;
+            spis.Seek(numBytes, true);
+            continue;
           }
-          if (floatArray)
+          if (arrayBuffer.size() < encodedSize + numBytes)
           {
-            float* ptr = floatArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding float data array");
-              return 0;
-            }
+            arrayBuffer.resize(std::max(2 * arrayBuffer.size(), encodedSize + numBytes));
           }
-          if (unsignedCharArray)
+          if (!spis.ReadString(arrayBuffer.data() + encodedSize, numBytes))
           {
-            unsigned char* ptr = unsignedCharArray->GetPointer(zax * planeSize);
-            if (!this->RunLengthDataDecode(&*arrayBuffer.begin(), numBytes, ptr, planeSize))
-            {
-              vtkErrorMacro("Problem RLD decoding unsigned char data array");
-              return 0;
-            }
+            vtkErrorMacro("Problem reading the bytes");
+            return 0;
           }
+          vtkSpyPlotEncodedPlane plane;
+          plane.EncodedOffset = encodedSize;
+          plane.EncodedSize = numBytes;
+          plane.FloatOut = floatArray ? floatArray->GetPointer(zax * planeSize) : nullptr;
+          plane.UnsignedCharOut =
+            unsignedCharArray ? unsignedCharArray->GetPointer(zax * planeSize) : nullptr;
+          plane.Size = planeSize;
+          planes.push_back(plane);
+          encodedSize += numBytes;
         }
         if (dataArray)
         {
-          var->DataBlocks[actualBlockId] = dataArray;
-          var->GhostCellsFixed[actualBlockId] = 0;
-          vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
           actualBlockId++;
         }
       }
     }
+
+    std::atomic<bool> decoded(true);
+    vtkSMPTools::For(0, static_cast<vtkIdType>(planes.size()), [&](vtkIdType begin, vtkIdType end) {
+      for (vtkIdType cc = begin; cc < end && decoded; ++cc)
+      {
+        const vtkSpyPlotEncodedPlane& plane = planes[cc];
+        const unsigned char* in = arrayBuffer.data() + plane.EncodedOffset;
+        if (plane.FloatOut
+            ? !this->RunLengthDataDecode(in, plane.EncodedSize, plane.FloatOut, plane.Size)
+            : !this->RunLengthDataDecode(in, plane.EncodedSize, plane.UnsignedCharOut, plane.Size))
+        {
+          decoded = false;
+        }
+      }
+    });
+    if (!decoded)
+    {
+      vtkErrorMacro("Problem RLD decoding data array " << var->Name);
+      return 0;
+    }
+
+    for (auto& item : pending)
+    {
+      vtkDataArray* dataArray = item.second;
+      dataArray->Register(nullptr);
+      var->DataBlocks[item.first] = dataArray;
+      var->GhostCellsFixed[item.first] = 0;
+      vtkDebugMacro(" " << dataArray << " initialized: " << dataArray->GetName());
+    }
   }
 
   if (blocksUpdated && needMarkers)
@@ -0,0 +1,116 @@
+/*=========================================================================
+
+  Program:   ParaView
+  Module:    TestPExtractHistogram.cxx
+
+  Copyright (c) Kitware, Inc.
+  All rights reserved.
+  See Copyright.txt or http://www.paraview.org/HTML/Copyright.html for details.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.  See the above copyright notice for more information.
+
+=========================================================================*/
+
+#include "vtkDataArray.h"
+#include "vtkDoubleArray.h"
+#include "vtkLogger.h"
+#include "vtkMPIController.h"
+#include "vtkNew.h"
+#include "vtkPExtractHistogram.h"
+#include "vtkPointData.h"
+#include "vtkPoints.h"
+#include "vtkPolyData.h"
+#include "vtkSmartPointer.h"
+#include "vtkTable.h"
+
+namespace
+{
+// Rank 0 has the values 0 and 1, other ranks have the value 1 twice, so that
+// the first of the two bins is empty on all ranks but rank 0. All points have
+// the vector (1, 2, 3).
+vtkSmartPointer<vtkPolyData> CreateInput(int rank)
+{
+  vtkNew<vtkPoints> points;
+  vtkNew<vtkDoubleArray> values;
+  values->SetName("value");
+  vtkNew<vtkDoubleArray> vectors;
+  vectors->SetName("vector");
+  vectors->SetNumberOfComponents(3);
+  for (int cc = 0; cc < 2; ++cc)
+  {
+    points->InsertNextPoint(cc, rank, 0);
+    values->InsertNextValue(rank == 0 && cc == 0 ? 0.0 : 1.0);
+    vectors->InsertNextTuple3(1, 2, 3);
+  }
+  auto input = vtkSmartPointer<vtkPolyData>::New();
+  input->SetPoints(points);
+  input->GetPointData()->AddArray(values);
+  input->GetPointData()->AddArray(vectors);
+  return input;
+}
+
+bool TestTotals(int rank, int numRanks)
+{
+  vtkNew<vtkPExtractHistogram> histogram;
+  histogram->SetInputData(CreateInput(rank));
+  histogram->SetInputArrayToProcess(0, 0, 0, vtkDataObject::FIELD_ASSOCIATION_POINTS, "value");
+  histogram->SetBinCount(2);
+  histogram->SetCalculateAverages(true);
+  histogram->Update();
+  if (rank != 0)
+  {
+    return true;
+  }
+
+  auto rowData = histogram->GetOutput()->GetRowData();
+  vtkDataArray* binValues = rowData->GetArray("bin_values");
+  vtkDataArray* totals = rowData->GetArray("vector_total");
+  vtkDataArray* averages = rowData->GetArray("vector_average");
+  if (!binValues || !totals || !averages || totals->GetNumberOfComponents() != 3 ||
+    averages->GetNumberOfComponents() != 3)
+  {
+    vtkLogF(ERROR, "missing bin values, or vector totals or averages with 3 components.");
+    return false;
+  }
+
+  const int counts[2] = { 1, 2 * numRanks - 1 };
+  for (int bin = 0; bin < 2; ++bin)
+  {
+    if (binValues->GetComponent(bin, 0) != counts[bin])
+    {
+      vtkLogF(ERROR, "bin %d: expected %d values, got %g.", bin, counts[bin],
+        binValues->GetComponent(bin, 0));
+      return false;
+    }
+    for (int comp = 0; comp < 3; ++comp)
+    {
+      if (totals->GetComponent(bin, comp) != counts[bin] * (comp + 1) ||
+        averages->GetComponent(bin, comp) != comp + 1)
+      {
+        vtkLogF(ERROR, "bin %d, component %d: wrong total %g or average %g.", bin, comp,
+          totals->GetComponent(bin, comp), averages->GetComponent(bin, comp));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+}
+
+int TestPExtractHistogram(int argc, char* argv[])
+{
+  vtkMPIController* contr = vtkMPIController::New();
+  contr->Initialize(&argc, &argv);
+  vtkMultiProcessController::SetGlobalController(contr);
+
+  int success = TestTotals(contr->GetLocalProcessId(), contr->GetNumberOfProcesses());
+  int all_success;
+  contr->AllReduce(&success, &all_success, 1, vtkCommunicator::LOGICAL_AND_OP);
+
+  vtkMultiProcessController::SetGlobalController(nullptr);
+  contr->Finalize();
+  contr->Delete();
+  return all_success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -41,6 +41,7 @@
 #include "vtkUnsignedIntArray.h"
 #include "vtkUnsignedShortArray.h"
 
+#include <algorithm>
 #include <array>
 #include <map>
 #include <string>
@@ -732,7 +733,13 @@ int vtkExtractHistogram::RequestData(vtkInformation* /*request*/,
       auto aa = vtkSmartPointer<vtkDoubleArray>::New();
       std::string newName2 = iter.first + "_average";
       aa->SetName(newName2.c_str());
-      int numComps = static_cast<int>(iter.second.TotalValues[0].size());
+      // empty bins have no totals, take the number of components from the
+      // others.
+      int numComps = 1;
+      for (const auto& totals : iter.second.TotalValues)
+      {
+        numComps = std::max(numComps, static_cast<int>(totals.size()));
+      }
       da->SetNumberOfComponents(numComps);
       da->SetNumberOfTuples(this->BinCount);
       aa->SetNumberOfComponents(numComps);
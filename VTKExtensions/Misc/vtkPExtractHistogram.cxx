@@ -14,7 +14,6 @@
 =========================================================================*/
 #include "vtkPExtractHistogram.h"
 
-#include "vtkAttributeDataReductionFilter.h"
 #include "vtkCellData.h"
 #include "vtkCommunicator.h"
 #include "vtkDataArrayRange.h"
@@ -24,12 +23,16 @@
 #include "vtkInformationVector.h"
 #include "vtkIntArray.h"
 #include "vtkMultiProcessController.h"
+#include "vtkNew.h"
 #include "vtkObjectFactory.h"
-#include "vtkReductionFilter.h"
 #include "vtkSmartPointer.h"
 #include "vtkTable.h"
 
+#include <algorithm>
+#include <map>
+#include <sstream>
 #include <string>
+#include <vector>
 #include <vtksys/RegularExpression.hxx>
 
 vtkStandardNewMacro(vtkPExtractHistogram);
@@ -61,13 +64,147 @@ bool vtkPExtractHistogram::GetInputArrayRange(vtkInformationVector** inputVector
   // return value in this call.
   this->Superclass::GetInputArrayRange(inputVector, local_range);
 
-  if (!this->Controller->AllReduce(&local_range[0], &range[0], 1, vtkCommunicator::MIN_OP) ||
-    !this->Controller->AllReduce(&local_range[1], &range[1], 1, vtkCommunicator::MAX_OP))
+  // Reduce the min and the negated max at once.
+  double local_bounds[2] = { local_range[0], -local_range[1] };
+  double bounds[2];
+  if (!this->Controller->AllReduce(local_bounds, bounds, 2, vtkCommunicator::MIN_OP))
   {
     vtkErrorMacro("Parallel communication error. Could not reduce ranges.");
     return false;
   }
+  range[0] = bounds[0];
+  range[1] = -bounds[1];
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceBinValues(vtkIntArray* binValues)
+{
+  std::vector<int> reduced(this->BinCount, 0);
+  if (!this->Controller->Reduce(
+        binValues->GetPointer(0), reduced.data(), this->BinCount, vtkCommunicator::SUM_OP, 0))
+  {
+    return false;
+  }
+  if (this->Controller->GetLocalProcessId() == 0)
+  {
+    std::copy(reduced.begin(), reduced.end(), binValues->GetPointer(0));
+  }
+  return true;
+}
+
+//-----------------------------------------------------------------------------
+bool vtkPExtractHistogram::ReduceBinValuesAndTotals(vtkTable* output)
+{
+  auto rowData = output->GetRowData();
+  vtkIntArray* binValues = vtkIntArray::SafeDownCast(rowData->GetArray("bin_values"));
+
+  // Ranks may not have computed totals for the same arrays, e.g. when they
+  // have no elements, so first agree on the arrays to reduce.
+  std::ostringstream localLayout;
+  vtksys::RegularExpression reg_ex("^(.*)_total$");
+  for (int i = 0, numArrays = rowData->GetNumberOfArrays(); i < numArrays; ++i)
+  {
+    vtkDataArray* array = rowData->GetArray(i);
+    if (array && array->GetName() && reg_ex.find(array->GetName()))
+    {
+      localLayout << reg_ex.match(1) << "\t" << array->GetNumberOfComponents() << "\n";
+    }
+  }
+  const std::string localBuffer = localLayout.str();
+  const int numProcs = this->Controller->GetNumberOfProcesses();
+  vtkIdType localLength = static_cast<vtkIdType>(localBuffer.size());
+  std::vector<vtkIdType> lengths(numProcs);
+  std::vector<vtkIdType> offsets(numProcs);
+  if (!this->Controller->AllGather(&localLength, lengths.data(), 1))
+  {
+    return false;
+  }
+  vtkIdType totalLength = 0;
+  for (int cc = 0; cc < numProcs; ++cc)
+  {
+    offsets[cc] = totalLength;
+    totalLength += lengths[cc];
+  }
+  std::vector<char> allLayouts(totalLength + 1, '\0');
+  if (totalLength > 0 &&
+    !this->Controller->AllGatherV(
+      localBuffer.c_str(), allLayouts.data(), localLength, lengths.data(), offsets.data()))
+  {
+    return false;
+  }
+
+  // Every rank builds the same sorted list of arrays to reduce. A rank with no
+  // values for an array reports a single component, hence the maximum.
+  std::map<std::string, int> layout;
+  std::istringstream layoutStream(allLayouts.data());
+  std::string name;
+  int numComps;
+  while (std::getline(layoutStream, name, '\t') && layoutStream >> numComps)
+  {
+    layoutStream.ignore();
+    auto& layoutComps = layout[name];
+    layoutComps = std::max(layoutComps, numComps);
+  }
+
+  // Pack the bin values and all totals to reduce them at once.
+  std::vector<double> localValues(
+    binValues->GetPointer(0), binValues->GetPointer(0) + this->BinCount);
+  for (const auto& item : layout)
+  {
+    const std::string totalName = item.first + "_total";
+    vtkDataArray* total = rowData->GetArray(totalName.c_str());
+    if (total && total->GetNumberOfComponents() != item.second)
+    {
+      total = nullptr;
+    }
+    for (vtkIdType idx = 0; idx < this->BinCount; ++idx)
+    {
+      for (int j = 0; j < item.second; ++j)
+      {
+        localValues.push_back(total ? total->GetComponent(idx, j) : 0.0);
+      }
+    }
+  }
+  std::vector<double> values(localValues.size(), 0.0);
+  if (!this->Controller->Reduce(localValues.data(), values.data(),
+        static_cast<vtkIdType>(values.size()), vtkCommunicator::SUM_OP, 0))
+  {
+    return false;
+  }
+  if (this->Controller->GetLocalProcessId() != 0)
+  {
+    return true;
+  }
 
+  // Unpack the reduced values and compute the averages.
+  for (vtkIdType idx = 0; idx < this->BinCount; ++idx)
+  {
+    binValues->SetValue(idx, static_cast<int>(values[idx]));
+  }
+  auto iter = values.begin() + this->BinCount;
+  for (const auto& item : layout)
+  {
+    vtkNew<vtkDoubleArray> total;
+    total->SetName((item.first + "_total").c_str());
+    total->SetNumberOfComponents(item.second);
+    total->SetNumberOfTuples(this->BinCount);
+    vtkNew<vtkDoubleArray> average;
+    average->SetName((item.first + "_average").c_str());
+    average->SetNumberOfComponents(item.second);
+    average->SetNumberOfTuples(this->BinCount);
+    for (vtkIdType idx = 0; idx < this->BinCount; ++idx)
+    {
+      const int count = binValues->GetValue(idx);
+      for (int j = 0; j < item.second; ++j, ++iter)
+      {
+        total->SetComponent(idx, j, *iter);
+        average->SetComponent(idx, j, count ? *iter / count : 0.0);
+      }
+    }
+    rowData->AddArray(total);
+    rowData->AddArray(average);
+  }
   return true;
 }
 
@@ -88,67 +225,25 @@ int vtkPExtractHistogram::RequestData(
   // Handle > 1 ranks
   if (this->Controller && this->Controller->GetNumberOfProcesses() > 1)
   {
-    vtkSmartPointer<vtkDataArray> oldExtents = output->GetRowData()->GetArray("bin_extents");
-    if (oldExtents == nullptr)
+    vtkIntArray* binValues =
+      vtkIntArray::SafeDownCast(output->GetRowData()->GetArray("bin_values"));
+    if (binValues == nullptr)
     {
       // Nothing to do if there is no data
       return 1;
     }
-    // Now we need to collect and reduce data from all nodes on the root.
-    vtkSmartPointer<vtkReductionFilter> reduceFilter = vtkSmartPointer<vtkReductionFilter>::New();
-    reduceFilter->SetController(this->Controller);
 
-    if (isRoot)
+    // The bin extents are computed from the global range and are thus the
+    // same on all ranks, only the bin values (and totals) need to be summed
+    // on the root node.
+    const bool reduced = this->CalculateAverages ? this->ReduceBinValuesAndTotals(output)
+                                                 : this->ReduceBinValues(binValues);
+    if (!reduced)
     {
-      // PostGatherHelper needs to be set only on the root node.
-      vtkSmartPointer<vtkAttributeDataReductionFilter> rf =
-        vtkSmartPointer<vtkAttributeDataReductionFilter>::New();
-      rf->SetAttributeType(vtkAttributeDataReductionFilter::ROW_DATA);
-      rf->SetReductionType(vtkAttributeDataReductionFilter::ADD);
-      reduceFilter->SetPostGatherHelper(rf);
-    }
-
-    vtkSmartPointer<vtkTable> copy = vtkSmartPointer<vtkTable>::New();
-    copy->ShallowCopy(output);
-    reduceFilter->SetInputData(copy);
-    reduceFilter->Update();
-    if (isRoot)
-    {
-      // We save the old bin_extents and then revert to be restored later since
-      // the reduction reduces the bin_extents as well.
-      output->ShallowCopy(reduceFilter->GetOutput());
-      if (output->GetRowData()->GetNumberOfArrays() == 0)
-      {
-        vtkErrorMacro(<< "Reduced data has 0 arrays");
-        return 0;
-      }
-      output->GetRowData()->GetArray("bin_extents")->DeepCopy(oldExtents);
-      if (this->CalculateAverages)
-      {
-        vtkDataArray* bin_values = output->GetRowData()->GetArray("bin_values");
-        vtksys::RegularExpression reg_ex("^(.*)_average$");
-        int numArrays = output->GetRowData()->GetNumberOfArrays();
-        for (int i = 0; i < numArrays; i++)
-        {
-          vtkDataArray* array = output->GetRowData()->GetArray(i);
-          if (array && reg_ex.find(array->GetName()))
-          {
-            int numComps = array->GetNumberOfComponents();
-            std::string name = reg_ex.match(1) + "_total";
-            vtkDataArray* tarray = output->GetRowData()->GetArray(name.c_str());
-            for (vtkIdType idx = 0; idx < this->BinCount; idx++)
-            {
-              for (int j = 0; j < numComps; j++)
-              {
-                array->SetComponent(
-                  idx, j, tarray->GetComponent(idx, j) / bin_values->GetTuple1(idx));
-              }
-            }
-          }
-        }
-      }
+      vtkErrorMacro("Parallel communication error. Could not reduce bin values.");
+      return 0;
     }
-    else
+    if (!isRoot)
     {
       output->Initialize();
     }
@@ -17,7 +17,9 @@
  * @brief   Extract histogram for parallel dataset.
  *
  * vtkPExtractHistogram is vtkExtractHistogram subclass for parallel datasets.
- * It gathers the histogram data on the root node.
+ * It gathers the histogram data on the root node. The bins of all ranks share
+ * the same extents, so the bin values (and the totals used for averages) are
+ * summed on the root node with a single reduction instead of gathering tables.
  */
 
 #ifndef vtkPExtractHistogram_h
@@ -26,7 +28,9 @@
 #include "vtkExtractHistogram.h"
 #include "vtkPVVTKExtensionsMiscModule.h" //needed for exports
 
+class vtkIntArray;
 class vtkMultiProcessController;
+class vtkTable;
 
 class VTKPVVTKEXTENSIONSMISC_EXPORT vtkPExtractHistogram : public vtkExtractHistogram
 {
@@ -64,6 +68,15 @@ protected:
   int RequestData(vtkInformation* request, vtkInformationVector** inputVector,
     vtkInformationVector* outputVector) override;
 
+  //@{
+  /**
+   * Sum the bin values, and the totals used to compute averages, of all ranks
+   * on the root node. Returns false on communication errors.
+   */
+  bool ReduceBinValues(vtkIntArray* binValues);
+  bool ReduceBinValuesAndTotals(vtkTable* output);
+  //@}
+
   vtkMultiProcessController* Controller;
   bool Normalize = false;
 
@@ -33,6 +33,7 @@
 #include "vtkCleanArrays.h"
 #include "vtkCleanUnstructuredGrid.h"
 #include "vtkDataSetToRectilinearGrid.h"
+#include "vtkDeltaImageCompressor.h"
 //#include "vtkEnzoReader.h"
 #include "vtkEquivalenceSet.h"
 #include "vtkExodusFileSeriesReader.h"
@@ -209,6 +210,7 @@ int ParaViewCoreVTKExtensionsPrintSelf(int, char*[])
   PRINT_SELF(vtkCSVExporter);
   PRINT_SELF(vtkCSVWriter);
   PRINT_SELF(vtkDataSetToRectilinearGrid);
+  PRINT_SELF(vtkDeltaImageCompressor);
   // PRINT_SELF(vtkEnzoReader);
   PRINT_SELF(vtkEquivalenceSet);
   PRINT_SELF(vtkExodusFileSeriesReader);
@@ -164,6 +164,50 @@ int sortMagnitudeOnUnsignedCharVector()
   return EXIT_SUCCESS;
 }
 
+// ----------------------------------------------------------------------------
+int sortBlocksInBothOrders(bool debug)
+{
+  const int size = 10;
+  double dataArray[size] = { 4, 1, 7, 1, 9, 0, 3, 8, 2, 5 };
+  double sortedArray[size] = { 0, 1, 1, 2, 3, 4, 5, 7, 8, 9 };
+  double invertedArray[size] = { 9, 8, 7, 5, 4, 3, 2, 1, 1, 0 };
+
+  vtkSmartPointer<vtkDoubleArray> dataToSort = vtkSmartPointer<vtkDoubleArray>::New();
+  fillArray(dataToSort.GetPointer(), dataArray, size, "data");
+
+  vtkSmartPointer<vtkTable> input = vtkSmartPointer<vtkTable>::New();
+  input->AddColumn(dataToSort);
+
+  vtkSmartPointer<vtkSortedTableStreamer> sortingfilter =
+    vtkSmartPointer<vtkSortedTableStreamer>::New();
+
+  sortingfilter->SetInputData(input.GetPointer());
+  sortingfilter->SetSelectedComponent(0);
+  sortingfilter->SetColumnNameToSort("data");
+  sortingfilter->SetBlockSize(4);
+
+  // Each block is extracted from the same index, whatever the order
+  for (int inverted = 0; inverted < 2; inverted++)
+  {
+    sortingfilter->SetInvertOrder(inverted);
+    double* expected = inverted ? invertedArray : sortedArray;
+    for (int block = 0; block < 3; block++)
+    {
+      sortingfilter->SetBlock(block);
+      sortingfilter->Update();
+
+      int blockSize = (block < 2) ? 4 : 2;
+      if (!compareArray(
+            sortingfilter->GetOutput(), "data", expected + 4 * block, blockSize, debug))
+      {
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
 // ----------------------------------------------------------------------------
 int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
 {
@@ -183,6 +227,9 @@ int TestSortingTable(int vtkNotUsed(argc), char** vtkNotUsed(argv))
   cout << "Testing sorting with magnitude on unsigned char: "
        << ((result += sortMagnitudeOnUnsignedCharVector()) ? "FAILED" : "SUCCESS") << endl;
   // --------------------------------------------------------------------------
+  cout << "Testing sorting blocks in both orders: "
+       << ((result += sortBlocksInBothOrders(debug)) ? "FAILED" : "SUCCESS") << endl;
+  // --------------------------------------------------------------------------
   // --------------------------------------------------------------------------
 
   // Delete Fake MPI controller
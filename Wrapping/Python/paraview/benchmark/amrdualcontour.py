@@ -0,0 +1,90 @@
+'''
+Benchmark for contouring and clipping AMR datasets with many blocks.
+
+Times vtkAMRDualContour and vtkAMRDualClip on the AMR dataset generated by
+vtkHierarchicalFractal, with the blocks processed using an increasing number
+of threads. Increasing the maximum level refines the fractal further and
+quickly increases the number of blocks, e.g.::
+
+    pvpython -m paraview.benchmark.amrdualcontour -l 8 -t 1 2 4 8 0
+'''
+
+from paraview.benchmark import timing
+
+
+def create_dataset(max_level, block_size):
+    '''Returns a vtkNonOverlappingAMR with the blocks vtkHierarchicalFractal
+    generates for `max_level` levels of `block_size`^3 cells each. Only the
+    leaf blocks are generated, so they can be moved over as is.'''
+    from vtkmodules.vtkCommonDataModel import vtkNonOverlappingAMR
+    from paraview.modules.vtkPVVTKExtensionsFiltersGeneral import vtkHierarchicalFractal
+
+    fractal = vtkHierarchicalFractal()
+    fractal.SetMaximumLevel(max_level)
+    fractal.SetDimensions(block_size)
+    fractal.SetOverlap(0)
+    fractal.SetGhostLevels(1)
+    fractal.Update()
+    hbds = fractal.GetOutputDataObject(0)
+
+    num_levels = hbds.GetNumberOfLevels()
+    amr = vtkNonOverlappingAMR()
+    amr.Initialize(num_levels, [hbds.GetNumberOfDataSets(level) for level in range(num_levels)])
+    for level in range(num_levels):
+        for idx in range(hbds.GetNumberOfDataSets(level)):
+            amr.SetDataSet(level, idx, hbds.GetDataSet(level, idx))
+    return amr
+
+
+def time_filter(dataset, filter_class, num_threads, num_iterations):
+    '''Returns the average time in seconds spent contouring or clipping all
+    blocks, and the number of output cells.'''
+    from vtkmodules.vtkCommonDataModel import vtkDataObject
+
+    afilter = filter_class()
+    afilter.SetIsoValue(0.5)
+    afilter.SetEnableMergePoints(1)
+    afilter.SetNumberOfThreads(num_threads)
+    afilter.SetInputArrayToProcess(0, 0, 0, vtkDataObject.FIELD_ASSOCIATION_CELLS,
+                                   'Fractal Volume Fraction')
+    afilter.SetInputData(dataset)
+    seconds = timing.time_updates(afilter, num_iterations)
+    output = afilter.GetOutputDataObject(0).GetBlock(0).GetPiece(0)
+    return seconds, output.GetNumberOfCells()
+
+
+def run(max_level=6, block_size=10, threads=(1, 2, 4, 0), num_iterations=5,
+        output_filename=None):
+    from paraview.modules.vtkPVVTKExtensionsAMR import vtkAMRDualClip, vtkAMRDualContour
+
+    dataset = create_dataset(max_level, block_size)
+    results = []
+    for name, filter_class in (('contour', vtkAMRDualContour), ('clip', vtkAMRDualClip)):
+        for num_threads in threads:
+            seconds, ncells = time_filter(dataset, filter_class, num_threads, num_iterations)
+            print('%-7s blocks: %6d  threads: %3d  %10.6f secs/update  (%d cells)' % (
+                name, dataset.GetTotalNumberOfBlocks(), num_threads, seconds, ncells))
+            results.append((name, dataset.GetTotalNumberOfBlocks(), num_threads, seconds))
+
+    timing.append_csv(output_filename, results)
+    return results
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark AMR dual contouring and clipping for many-block datasets',
+        iterations=5, iterations_help='Number of updates to average over')
+    parser.add_argument('-l', '--levels', default=6, type=int,
+                        help='Maximum level the fractal is refined to')
+    parser.add_argument('-s', '--size', default=10, type=int,
+                        help='Number of cells along each side of a block')
+    parser.add_argument('-t', '--threads', default=[1, 2, 4, 0], type=int,
+                        nargs='+', help='Thread counts to time (0 for no limit)')
+    args = parser.parse_args(argv)
+    run(max_level=args.levels, block_size=args.size, threads=args.threads,
+        num_iterations=args.iterations, output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
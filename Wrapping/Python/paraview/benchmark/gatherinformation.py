@@ -0,0 +1,68 @@
+'''
+Benchmark for collecting data information from all server ranks.
+
+Times vtkPVDataInformation gathering for a multiblock source, once with
+partial results gathered to the root and merged there, and once with partial
+results reduced up a tree. Run it with pvbatch under MPI with increasing
+rank counts to compare how both approaches scale, e.g.::
+
+    mpiexec -n 64 pvbatch -m paraview.benchmark.gatherinformation -i 50
+'''
+
+from paraview import servermanager
+from paraview.benchmark import timing
+from paraview.simple import *
+
+
+def time_gather(proxy, reduce_in_tree, num_iterations):
+    '''Returns the average time in seconds spent gathering data information
+    about the proxy's first output port.'''
+    session = servermanager.ActiveConnection.Session
+
+    def gather():
+        info = servermanager.vtkPVDataInformation()
+        info.SetReduceInTree(reduce_in_tree)
+        session.GatherInformation(servermanager.vtkPVSession.DATA_SERVER,
+                                  info, proxy.SMProxy.GetGlobalID())
+        return info
+    return timing.time_calls(gather, num_iterations)
+
+
+def run(num_iterations=20, num_shapes=12, output_filename=None):
+    nranks = timing.get_ranks()[2]
+
+    # A partitioned multiblock dataset with a few arrays makes for
+    # data-information objects of a representative size.
+    shapes = PartitionedDataSetCollectionSource(NumberOfShapes=num_shapes)
+    source = RandomAttributes(Input=shapes)
+    source.GeneratePointScalars = 1
+    source.GenerateCellVectors = 1
+    source.UpdatePipeline()
+
+    results = []
+    for reduce_in_tree in (False, True):
+        seconds, info = time_gather(source, reduce_in_tree, num_iterations)
+        label = 'tree' if reduce_in_tree else 'gather'
+        print('%-6s ranks: %5d  %10.6f secs/gather  (%d cells, %d datasets)' % (
+            label, nranks, seconds, info.GetNumberOfCells(),
+            info.GetNumberOfDataSets()))
+        results.append((label, nranks, seconds))
+
+    timing.append_csv(output_filename, results)
+    return results
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark gathering data information across ranks',
+        iterations=20, iterations_help='Number of gathers to average over')
+    parser.add_argument('-s', '--shapes', default=12, type=int,
+                        help='Number of shapes (1-12) in the source dataset')
+    args = parser.parse_args(argv)
+    run(num_iterations=args.iterations, num_shapes=args.shapes,
+        output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
@@ -0,0 +1,83 @@
+'''
+Benchmark for extracting surfaces from a dataset with many blocks.
+
+Times vtkPVGeometryFilter on a synthetic multiblock dataset made of many small
+unstructured grids, with the surfaces of the blocks extracted using an
+increasing number of threads. The block cache is disabled so that every
+iteration extracts all surfaces, e.g.::
+
+    pvpython -m paraview.benchmark.manyblocks -b 4096 -t 1 2 4 8 0
+'''
+
+from paraview.benchmark import timing
+
+
+def create_dataset(num_blocks, block_size):
+    '''Returns a vtkMultiBlockDataSet with `num_blocks` unstructured grids of
+    `block_size`^3 hexahedra each.'''
+    from vtkmodules.vtkCommonDataModel import vtkMultiBlockDataSet
+    from vtkmodules.vtkFiltersCore import vtkAppendFilter
+    from vtkmodules.vtkImagingCore import vtkRTAnalyticSource
+
+    mb = vtkMultiBlockDataSet()
+    mb.SetNumberOfBlocks(num_blocks)
+    side = max(1, int(round(num_blocks ** (1.0 / 3))))
+    for cc in range(num_blocks):
+        i, j, k = cc % side, (cc // side) % side, cc // (side * side)
+        source = vtkRTAnalyticSource()
+        source.SetWholeExtent(i * block_size, (i + 1) * block_size,
+                              j * block_size, (j + 1) * block_size,
+                              k * block_size, (k + 1) * block_size)
+        append = vtkAppendFilter()
+        append.SetInputConnection(source.GetOutputPort())
+        append.Update()
+        mb.SetBlock(cc, append.GetOutput())
+    return mb
+
+
+def time_extraction(dataset, num_threads, num_iterations):
+    '''Returns the average time in seconds spent extracting the surfaces of
+    all blocks, and the number of output cells.'''
+    from paraview.modules.vtkPVVTKExtensionsFiltersRendering import vtkPVGeometryFilter
+
+    gfilter = vtkPVGeometryFilter()
+    gfilter.SetNumberOfThreads(num_threads)
+    gfilter.SetUseOutline(0)
+    gfilter.SetUseBlockCache(False)
+    gfilter.SetInputData(dataset)
+    seconds = timing.time_updates(gfilter, num_iterations)
+    return seconds, gfilter.GetOutputDataObject(0).GetNumberOfCells()
+
+
+def run(num_blocks=1024, block_size=8, threads=(1, 2, 4, 0), num_iterations=5,
+        output_filename=None):
+    dataset = create_dataset(num_blocks, block_size)
+    results = []
+    for num_threads in threads:
+        seconds, ncells = time_extraction(dataset, num_threads, num_iterations)
+        print('blocks: %6d  threads: %3d  %10.6f secs/update  (%d cells)' % (
+            num_blocks, num_threads, seconds, ncells))
+        results.append((num_blocks, num_threads, seconds))
+
+    timing.append_csv(output_filename, results)
+    return results
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark surface extraction for many-block datasets',
+        iterations=5, iterations_help='Number of updates to average over')
+    parser.add_argument('-b', '--blocks', default=1024, type=int,
+                        help='Number of blocks in the dataset')
+    parser.add_argument('-s', '--size', default=8, type=int,
+                        help='Number of cells along each side of a block')
+    parser.add_argument('-t', '--threads', default=[1, 2, 4, 0], type=int,
+                        nargs='+', help='Thread counts to time (0 for no limit)')
+    args = parser.parse_args(argv)
+    run(num_blocks=args.blocks, block_size=args.size, threads=args.threads,
+        num_iterations=args.iterations, output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
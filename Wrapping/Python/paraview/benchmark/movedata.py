@@ -0,0 +1,106 @@
+'''
+Benchmark for moving data between ranks with vtkMPIMoveData.
+
+Times collecting (and optionally cloning) a large unstructured grid from every
+rank, with the data marshalled using the legacy writer, the raw format, and the
+raw format compressed with LZ4 or zlib. Run it with pvbatch under MPI in
+symmetric mode so that every rank takes part in the transfer, e.g.::
+
+    mpiexec -n 8 pvbatch --symmetric -m paraview.benchmark.movedata -s 96
+'''
+
+from paraview.benchmark import timing
+
+# label, raw format, LZ4, zlib
+VARIANTS = (
+    ('legacy', False, False, False),
+    ('raw', True, False, False),
+    ('raw+lz4', True, True, False),
+    ('raw+zlib', True, False, True),
+)
+
+
+def create_dataset(size, rank):
+    '''Returns an unstructured grid of `size`^3 hexahedra with a point and a
+    cell array, offset by the rank so that pieces do not overlap.'''
+    from vtkmodules.vtkFiltersCore import vtkAppendFilter
+    from vtkmodules.vtkFiltersGeneral import vtkRandomAttributeGenerator
+    from vtkmodules.vtkImagingCore import vtkRTAnalyticSource
+
+    source = vtkRTAnalyticSource()
+    source.SetWholeExtent(rank * size, (rank + 1) * size, 0, size, 0, size)
+    attributes = vtkRandomAttributeGenerator()
+    attributes.SetInputConnection(source.GetOutputPort())
+    attributes.GenerateCellVectorsOn()
+    append = vtkAppendFilter()
+    append.SetInputConnection(attributes.GetOutputPort())
+    append.Update()
+    return append.GetOutput()
+
+
+def time_move(dataset, move_mode, variant, num_iterations):
+    '''Returns the average time in seconds spent moving the dataset, and the
+    number of cells in the output on this rank.'''
+    from vtkmodules.vtkCommonDataModel import vtkDataObject
+    from paraview.modules.vtkPVVTKExtensionsFiltersRendering import vtkMPIMoveData
+
+    label, raw, lz4, zlib = variant
+    vtkMPIMoveData.SetUseRawFormat(raw)
+    vtkMPIMoveData.SetUseLZ4Compression(lz4)
+    vtkMPIMoveData.SetUseZLibCompression(zlib)
+
+    mover = vtkMPIMoveData()
+    mover.SetServerToDataServer()
+    mover.SetMoveMode(move_mode)
+    mover.SetOutputDataType(dataset.GetDataObjectType())
+    mover.SetInputData(dataset)
+    seconds = timing.time_updates(mover, num_iterations)
+    return seconds, mover.GetOutputDataObject(0).GetNumberOfCells()
+
+
+def run(size=64, clone=False, num_iterations=5, output_filename=None):
+    from paraview.modules.vtkPVVTKExtensionsFiltersRendering import vtkMPIMoveData
+
+    rank, nranks = timing.get_ranks()[1:]
+    dataset = create_dataset(size, rank)
+    original = (vtkMPIMoveData.GetUseRawFormat(),
+                vtkMPIMoveData.GetUseLZ4Compression(),
+                vtkMPIMoveData.GetUseZLibCompression())
+    modes = [('collect', vtkMPIMoveData.COLLECT)]
+    if clone:
+        modes.append(('clone', vtkMPIMoveData.CLONE))
+
+    results = []
+    try:
+        for mode_label, mode in modes:
+            for variant in VARIANTS:
+                seconds, ncells = time_move(dataset, mode, variant, num_iterations)
+                if rank == 0:
+                    print('%-7s %-8s ranks: %4d  %10.6f secs/move  (%d cells)' % (
+                        mode_label, variant[0], nranks, seconds, ncells))
+                results.append((mode_label, variant[0], nranks, seconds))
+    finally:
+        vtkMPIMoveData.SetUseRawFormat(original[0])
+        vtkMPIMoveData.SetUseLZ4Compression(original[1])
+        vtkMPIMoveData.SetUseZLibCompression(original[2])
+
+    timing.append_csv(output_filename, results)
+    return results
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark moving unstructured grids between ranks',
+        iterations=5, iterations_help='Number of moves to average over')
+    parser.add_argument('-s', '--size', default=64, type=int,
+                        help='Number of cells along each side of a rank\'s grid')
+    parser.add_argument('-c', '--clone', action='store_true',
+                        help='Also time cloning the data on all ranks')
+    args = parser.parse_args(argv)
+    run(size=args.size, clone=args.clone, num_iterations=args.iterations,
+        output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
@@ -0,0 +1,84 @@
+'''
+Benchmark for loading CTH SpyPlot files.
+
+Times reading all cell arrays of a SpyPlot file (or series) with
+vtkSpyPlotReader and reports the load throughput. A new reader is used for
+every iteration so that nothing is cached between loads. Run it with pvbatch
+under MPI in symmetric mode to measure the throughput per rank when the files
+are distributed, e.g.::
+
+    mpiexec -n 4 pvbatch --symmetric -m paraview.benchmark.spyplot \\
+        /path/to/spcth.0 -i 3
+'''
+
+import os
+from paraview.benchmark import timing
+
+
+def series_size(filename):
+    '''Returns the total size in bytes of the files making up the series
+    starting with `filename`.'''
+    base, ext = os.path.splitext(filename)
+    if not ext[1:].isdigit():
+        return os.path.getsize(filename)
+    total, index = 0, int(ext[1:])
+    while os.path.exists('%s.%d' % (base, index)):
+        total += os.path.getsize('%s.%d' % (base, index))
+        index += 1
+    return total
+
+
+def time_load(filename, num_iterations):
+    '''Returns the average time in seconds spent loading the file, and the
+    number of cells loaded on this rank.'''
+    from paraview.modules.vtkPVVTKExtensionsIOSPCTH import vtkSpyPlotReader
+
+    seconds, ncells = 0.0, 0
+    for i in range(num_iterations):
+        reader = vtkSpyPlotReader()
+        reader.SetFileName(filename)
+        reader.UpdateInformation()
+        for cc in range(reader.GetNumberOfCellArrays()):
+            reader.SetCellArrayStatus(reader.GetCellArrayName(cc), 1)
+        seconds += timing.time_calls(reader.Update, 1)[0]
+        ncells = reader.GetOutputDataObject(0).GetNumberOfCells()
+    return seconds / num_iterations, ncells
+
+
+def run(filename, num_iterations=3, output_filename=None):
+    controller, rank, nranks = timing.get_ranks()
+    seconds, ncells = time_load(filename, num_iterations)
+    if controller and nranks > 1:
+        # the load is as slow as the slowest rank.
+        from vtkmodules.vtkCommonCore import vtkDoubleArray
+        from vtkmodules.vtkParallelCore import vtkCommunicator
+        local, result = vtkDoubleArray(), vtkDoubleArray()
+        local.InsertNextValue(seconds)
+        controller.AllReduce(local, result, vtkCommunicator.MAX_OP)
+        seconds = result.GetValue(0)
+
+    megabytes = series_size(filename) / (1024.0 * 1024.0)
+    throughput = megabytes / seconds if seconds > 0 else 0.0
+    if rank == 0:
+        print('ranks: %4d  %10.6f secs/load  %10.2f MB/s  %10.2f MB/s/rank'
+              '  (%.1f MB, %d cells on rank 0)' % (
+                  nranks, seconds, throughput, throughput / nranks, megabytes,
+                  ncells))
+    timing.append_csv(output_filename, [(filename, nranks, seconds, throughput)])
+    return seconds, throughput
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark loading CTH SpyPlot files',
+        iterations=3, iterations_help='Number of loads to average over')
+    parser.add_argument('filename', type=str,
+                        help='SpyPlot file, or first file of a series')
+    args = parser.parse_args(argv)
+    run(args.filename, num_iterations=args.iterations,
+        output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
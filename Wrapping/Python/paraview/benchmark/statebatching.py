@@ -0,0 +1,83 @@
+'''
+Benchmark for loading a state file with many proxies over a client-server
+connection.
+
+Saves a state with a pipeline of many sources, filters and representations,
+then loads it back once with every push sent as its own message and once with
+the pushes batched, reporting the number of messages sent to the server and
+the time each load takes. Start a pvserver first, then connect to it, e.g.::
+
+    pvpython -m paraview.benchmark.statebatching -s localhost -n 500
+'''
+
+from paraview import servermanager
+from paraview.benchmark import timing
+from paraview.simple import *
+
+
+def create_state(filename, num_pipelines):
+    '''Saves a state with `num_pipelines` sphere sources, each shrunk and
+    shown in a render view, to `filename`.'''
+    view = CreateRenderView()
+    for i in range(num_pipelines):
+        sphere = Sphere(Center=[i, 0, 0])
+        shrink = Shrink(Input=sphere)
+        Show(shrink, view)
+    SaveState(filename)
+
+
+def time_load(filename, use_batching):
+    '''Returns the time in seconds spent loading the state, and the number of
+    messages sent to the server while doing so.'''
+    ResetSession()
+    session = servermanager.ActiveConnection.Session
+    session.SetUseBatchedPushes(use_batching)
+    count0 = session.GetNumberOfMessagesSent()
+    seconds = timing.time_calls(lambda: LoadState(filename), 1)[0]
+    count1 = session.GetNumberOfMessagesSent()
+    return seconds, count1 - count0
+
+
+def run(host='localhost', port=11111, num_pipelines=200, output_filename=None):
+    import os
+    import tempfile
+
+    connection = Connect(host, port)
+    if not connection or not connection.IsRemote():
+        raise RuntimeError('A connection to a remote server is required.')
+
+    fd, filename = tempfile.mkstemp(suffix='.pvsm')
+    os.close(fd)
+    try:
+        create_state(filename, num_pipelines)
+        results = []
+        for use_batching in (False, True):
+            seconds, messages = time_load(filename, use_batching)
+            label = 'batched' if use_batching else 'single'
+            print('%-7s pipelines: %5d  messages: %7d  %10.6f secs/load' % (
+                label, num_pipelines, messages, seconds))
+            results.append((label, num_pipelines, messages, seconds))
+    finally:
+        os.remove(filename)
+
+    timing.append_csv(output_filename, results)
+    return results
+
+
+def main(argv):
+    parser = timing.argument_parser(
+        'Benchmark loading a state file with and without batched pushes')
+    parser.add_argument('-s', '--server', default='localhost', type=str,
+                        help='Host of the pvserver to connect to')
+    parser.add_argument('-p', '--port', default=11111, type=int,
+                        help='Port of the pvserver to connect to')
+    parser.add_argument('-n', '--pipelines', default=200, type=int,
+                        help='Number of source-filter-representation pipelines in the state')
+    args = parser.parse_args(argv)
+    run(host=args.server, port=args.port, num_pipelines=args.pipelines,
+        output_filename=args.output)
+
+
+if __name__ == "__main__":
+    import sys
+    main(sys.argv[1:])
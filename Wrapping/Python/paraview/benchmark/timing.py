@@ -0,0 +1,68 @@
+'''
+This module has the routines shared by the benchmarks that time an operation
+directly instead of parsing ParaView's logs, e.g. manyblocks or movedata.
+
+Such a benchmark only sets up its dataset and filters: it creates its command
+line parser with `argument_parser`, times the operation with `time_updates` or
+`time_calls` and appends its results to a CSV file with `append_csv`.
+'''
+
+import datetime as dt
+
+
+def argument_parser(description, iterations=None,
+                    iterations_help='Number of iterations to average over'):
+    '''Returns an argparse.ArgumentParser with the options shared by all
+    benchmarks, `-o/--output`, and `-i/--iterations` unless `iterations` (the
+    default number of iterations) is None.'''
+    import argparse
+    parser = argparse.ArgumentParser(description=description)
+    if iterations is not None:
+        parser.add_argument('-i', '--iterations', default=iterations, type=int,
+                            help=iterations_help)
+    parser.add_argument('-o', '--output', default=None, type=str,
+                        help='CSV file to append results to')
+    return parser
+
+
+def get_ranks():
+    '''Returns the global controller, if any, the local rank and the number of
+    ranks.'''
+    from vtkmodules.vtkParallelCore import vtkMultiProcessController
+    controller = vtkMultiProcessController.GetGlobalController()
+    rank = controller.GetLocalProcessId() if controller else 0
+    nranks = controller.GetNumberOfProcesses() if controller else 1
+    return controller, rank, nranks
+
+
+def time_calls(function, num_iterations):
+    '''Calls `function` `num_iterations` times and returns the average time in
+    seconds spent per call, and the value returned by the last call.'''
+    result = None
+    t0 = dt.datetime.now()
+    for i in range(num_iterations):
+        result = function()
+    t1 = dt.datetime.now()
+    return (t1 - t0).total_seconds() / num_iterations, result
+
+
+def time_updates(algorithm, num_iterations):
+    '''Returns the average time in seconds spent updating `algorithm`, which is
+    marked as modified before every update so that it executes each time.'''
+    def update():
+        algorithm.Modified()
+        algorithm.Update()
+    return time_calls(update, num_iterations)[0]
+
+
+def append_csv(output_filename, rows):
+    '''Appends `rows`, sequences of strings and numbers, to the CSV file
+    `output_filename`. Does nothing when `output_filename` is not set, and
+    only the first rank writes the file.'''
+    if not output_filename or get_ranks()[1] != 0:
+        return
+    with open(output_filename, 'a') as ofile:
+        for row in rows:
+            ofile.write(','.join(
+                '%f' % value if isinstance(value, float) else str(value)
+                for value in row) + '\n')
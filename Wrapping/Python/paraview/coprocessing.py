@@ -55,6 +55,8 @@ class CoProcessor(object):
         self.__ViewsList = []
         self.__EnableLiveVisualization = False
         self.__LiveVisualizationFrequency = 1;
+        self.__LiveVisualizationAsynchronous = False
+        self.__LiveVisualizationCompress = False
         self.__LiveVisualizationLink = None
         # __CinemaTracksList is just for Spec-A compatibility (will be deprecated
         # when porting Spec-A to pv_introspect. Use __CinemaTracks instead.
@@ -107,13 +109,18 @@ class CoProcessor(object):
         self.__TimeStepToStartOutputAt=timeStepToStartOutputAt
         self.__ForceOutputAtFirstCall=forceOutputAtFirstCall
 
-    def EnableLiveVisualization(self, enable, frequency = 1):
+    def EnableLiveVisualization(self, enable, frequency = 1, asynchronous = False, compress = False):
         """Call this method to enable live-visualization. When enabled,
         DoLiveVisualization() will communicate with ParaView server if possible
         for live visualization. Frequency specifies how often the
-        communication happens (default is every second)."""
+        communication happens (default is every second). When asynchronous is
+        True, extracts are sent in the background and the simulation does not
+        wait for ParaView to receive them. When compress is True, extracts are
+        compressed before being sent."""
         self.__EnableLiveVisualization = enable
         self.__LiveVisualizationFrequency = frequency
+        self.__LiveVisualizationAsynchronous = asynchronous
+        self.__LiveVisualizationCompress = compress
 
     def CreatePipeline(self, datadescription):
         """This methods must be overridden by subclasses to create the
@@ -390,6 +397,10 @@ class CoProcessor(object):
             self.__LiveVisualizationLink.SetHostname(hostname)
             self.__LiveVisualizationLink.SetInsituPort(int(port))
 
+            # Tell vtkLiveInsituLink how to deliver extracts.
+            self.__LiveVisualizationLink.SetAsynchronousDelivery(self.__LiveVisualizationAsynchronous)
+            self.__LiveVisualizationLink.SetCompressExtracts(self.__LiveVisualizationCompress)
+
             # Initialize the "link"
             self.__LiveVisualizationLink.Initialize(servermanager.ActiveConnection.Session.GetSessionProxyManager())
 